@@ -18,8 +18,10 @@
 #include <signal.h>
 #include <platforms.h>
 #include <gdb_console.h>
+#include <expedite.h>
 #include "debug_cm3.h"
 #include "armv7-m.h"
+#include "thumb2.h"
 
 /* Disable any macro used for errno and use the int global instead. */
 #undef errno
@@ -123,22 +125,23 @@ void __mriExceptionHandler(void);
 
 
 static void clearState(void);
-static void configureDWTandFPB(void);
-static void defaultSvcAndSysTickInterruptsToPriority1(void);
-void __mriCortexMInit(Token* pParameterTokens)
+static void parseHaltPriority(Token* pParameterTokens);
+static void configureDWTandFPB(uint32_t* pFpbRemapTable);
+static void defaultSvcAndSysTickInterruptsBelowHaltPriority(void);
+void __mriCortexMInit(Token* pParameterTokens, uint32_t* pFpbRemapTable)
 {
 
     /* Reference routine in ASM module to make sure that is gets linked in. */
     void (* volatile dummyReference)(void) = __mriExceptionHandler;
     (void)dummyReference;
-    (void)pParameterTokens;
 
     clearState();
-    configureDWTandFPB();
-    defaultSvcAndSysTickInterruptsToPriority1();
+    parseHaltPriority(pParameterTokens);
+    configureDWTandFPB(pFpbRemapTable);
+    defaultSvcAndSysTickInterruptsBelowHaltPriority();
     Platform_DisableSingleStep();
     clearMonitorPending();
-    enableDebugMonitorAtPriority0();
+    enableDebugMonitorAtPriority(__mriCortexMState.haltPriority);
 }
 
 static void clearState(void)
@@ -146,18 +149,60 @@ static void clearState(void)
     memset(&__mriCortexMState, 0, sizeof(__mriCortexMState));
 }
 
-static void configureDWTandFPB(void)
+static void parseHaltPriority(Token* pParameterTokens)
+{
+    /* Interrupts with a higher priority (lower value) than MRI_HALT_PRIORITY keep running while the program is halted
+       in the debugger.  At least one priority level is left below it for the code which gets halted. */
+    static const char haltPriorityPrefix[] = "MRI_HALT_PRIORITY=";
+    const uint32_t    lowestHaltPriority = (1 << __NVIC_PRIO_BITS) - 2;
+    const char*       pCurr = NULL;
+    uint32_t          priority = 0;
+
+    if ((pCurr = Token_MatchingStringPrefix(pParameterTokens, haltPriorityPrefix)) == NULL)
+        return;
+
+    for (pCurr += sizeof(haltPriorityPrefix) - 1 ; *pCurr >= '0' && *pCurr <= '9' ; pCurr++)
+        priority = priority * 10 + (*pCurr - '0');
+    if (priority > lowestHaltPriority)
+        priority = lowestHaltPriority;
+    __mriCortexMState.haltPriority = priority;
+}
+
+static void configureDWTandFPB(uint32_t* pFpbRemapTable)
 {
     enableDWTandITM();
+    enableCycleCounter();
     initDWT();
-    initFPB();
+    /* Remember to tell the user if the device's remap table was linked outside of the region the FPB can remap to. */
+    if (!isAddressInFPBRemapRegion((uint32_t)pFpbRemapTable))
+        __mriCortexMState.flags |= CORTEXM_FLAGS_FPB_REMAP_UNREACHABLE;
+    initFPB(pFpbRemapTable);
+}
+
+static void defaultSvcAndSysTickInterruptsBelowHaltPriority(void)
+{
+    uint32_t priority = __mriCortexMState.haltPriority + 1;
+
+    NVIC_SetPriority(SVCall_IRQn, priority);
+    NVIC_SetPriority(PendSV_IRQn, priority);
+    NVIC_SetPriority(SysTick_IRQn, priority);
+}
+
+
+uint32_t __mriCortexMGetHaltPriority(void)
+{
+    return __mriCortexMState.haltPriority;
 }
 
-static void defaultSvcAndSysTickInterruptsToPriority1(void)
+
+void __mriCortexMSetCommInterrupt(uint32_t exceptionNumber,
+                                  const volatile uint32_t* pStatus, uint32_t receiveDataMask,
+                                  const volatile uint32_t* pClear)
 {
-    NVIC_SetPriority(SVCall_IRQn, 1);
-    NVIC_SetPriority(PendSV_IRQn, 1);
-    NVIC_SetPriority(SysTick_IRQn, 1);
+    __mriCortexMState.commInterrupt.pStatus = pStatus;
+    __mriCortexMState.commInterrupt.receiveDataMask = receiveDataMask;
+    __mriCortexMState.commInterrupt.pClear = pClear;
+    __mriCortexMState.commInterrupt.exceptionNumber = exceptionNumber;
 }
 
 
@@ -174,13 +219,15 @@ static void clearSingleSteppingFlag(void)
 }
 
 
+static int      canDebugMonitorPreemptResumedCode(void);
 static int      doesPCPointToSVCInstruction(void);
 static void     setHardwareBreakpointOnSvcHandler(void);
 static uint32_t getNvicVector(IRQn_Type irq);
 static void     setSvcStepFlag(void);
 static void     setSingleSteppingFlag(void);
 static void     setSingleSteppingFlag(void);
-static void     recordCurrentBasePriorityAndSwitchToPriority1(void);
+static void     setPendedStepFlag(void);
+static void     recordCurrentBasePriorityAndSwitchToStepPriority(void);
 static int      doesPCPointToBASEPRIUpdateInstruction(void);
 static uint16_t getFirstHalfWordOfCurrentInstruction(void);
 static uint16_t getSecondHalfWordOfCurrentInstruction(void);
@@ -194,10 +241,18 @@ static void     setRestoreBasePriorityFlag(void);
 static uint32_t calculateBasePriorityForThisCPU(uint32_t basePriority);
 void Platform_EnableSingleStep(void)
 {
+    if (!canDebugMonitorPreemptResumedCode())
+    {
+        /* MON_STEP has no effect at this execution priority so instead let the interrupt handler run to completion
+           and stop as soon as execution drops below the debug monitor's priority. */
+        setSingleSteppingFlag();
+        setPendedStepFlag();
+        return;
+    }
     if (!doesPCPointToSVCInstruction())
     {
         setSingleSteppingFlag();
-        recordCurrentBasePriorityAndSwitchToPriority1();
+        recordCurrentBasePriorityAndSwitchToStepPriority();
         enableSingleStep();
         return;
     }
@@ -218,6 +273,22 @@ void Platform_EnableSingleStep(void)
     return;
 }
 
+static int canDebugMonitorPreemptResumedCode(void)
+{
+    /* A breakpoint hit in an interrupt handler running at or above the debug monitor's priority escalates to a Hard
+       Fault and leaves the debugger resuming that handler.  Stepping and block stepping rely on the debug monitor
+       preempting the resumed code, which can't happen until the handler returns. */
+    static const uint32_t ipsrMask = 0x1FF;
+    static const uint32_t firstConfigurableException = 4;
+    uint32_t              exceptionNumber = __mriCortexMState.context.CPSR & ipsrMask;
+
+    if (exceptionNumber == 0)
+        return 1;
+    if (exceptionNumber < firstConfigurableException)
+        return 0;
+    return NVIC_GetPriority((IRQn_Type)((int)exceptionNumber - 16)) > __mriCortexMState.haltPriority;
+}
+
 static int doesPCPointToSVCInstruction(void)
 {
     static const uint16_t svcMachineCodeMask = 0xff00;
@@ -259,11 +330,17 @@ static void setSingleSteppingFlag(void)
     __mriCortexMState.flags |= CORTEXM_FLAGS_SINGLE_STEPPING;
 }
 
-static void recordCurrentBasePriorityAndSwitchToPriority1(void)
+static void setPendedStepFlag(void)
+{
+    __mriCortexMState.flags |= CORTEXM_FLAGS_PENDED_STEP;
+}
+
+static void recordCurrentBasePriorityAndSwitchToStepPriority(void)
 {
+    /* Only interrupts at or above the halt priority are allowed to run while stepping. */
     if (!doesPCPointToBASEPRIUpdateInstruction())
         recordCurrentBasePriority();
-    __set_BASEPRI(calculateBasePriorityForThisCPU(1));
+    __set_BASEPRI(calculateBasePriorityForThisCPU(__mriCortexMState.haltPriority + 1));
 }
 
 static int doesPCPointToBASEPRIUpdateInstruction(void)
@@ -349,9 +426,91 @@ static uint32_t calculateBasePriorityForThisCPU(uint32_t basePriority)
 }
 
 
+static int      startBlockStep(uint32_t endAddress);
+static int      isInsideITBlock(void);
+static int      isHardwareBreakpointSet(uint32_t address);
+static void     setBlockStepFlag(void);
+/* Runs the program up to the end of its current basic block, or up to endAddress if that comes first, and then
+   enters the debugger as though a single step had completed.  Only the instruction which ends the block, the one
+   which can change the flow of execution, is actually single stepped. */
+void Platform_EnableBlockStep(uint32_t endAddress)
+{
+    if (!startBlockStep(endAddress))
+        Platform_EnableSingleStep();
+}
+
+static int startBlockStep(uint32_t endAddress)
+{
+    uint32_t blockEnd;
+
+    /* The instructions of an IT block are conditional so a breakpoint placed on one of them might never fire. */
+    if (isInsideITBlock())
+        return 0;
+    /* The block step's breakpoint would escalate to a Hard Fault in code the debug monitor can't preempt. */
+    if (!canDebugMonitorPreemptResumedCode())
+        return 0;
+
+    /* A breakpoint which is already set at the end of the block would be mistaken for the end of the step so leave
+       that block to be single stepped instead. */
+    blockEnd = Thumb2_FindBasicBlockEnd(__mriCortexMState.context.PC, endAddress);
+    if (blockEnd == __mriCortexMState.context.PC || isHardwareBreakpointSet(blockEnd))
+        return 0;
+
+    __try
+    {
+        Platform_SetHardwareBreakpoint(blockEnd, 2);
+    }
+    __catch
+    {
+        clearExceptionCode();
+        return 0;
+    }
+    __mriCortexMState.blockStepAddress = blockEnd;
+    setBlockStepFlag();
+    return 1;
+}
+
+static int isInsideITBlock(void)
+{
+    static const uint32_t itStateMask = 0x0600FC00;
+    
+    return (__mriCortexMState.context.CPSR & itStateMask) != 0;
+}
+
+static int isHardwareBreakpointSet(uint32_t address)
+{
+    return FPB_IsBreakpointSet(address) || DWT_FindBreakpoint(address) != NULL;
+}
+
+static void setBlockStepFlag(void)
+{
+    __mriCortexMState.flags |= CORTEXM_FLAGS_BLOCK_STEP;
+}
+
+
+uint16_t __mriThumb2_ReadCodeHalfWord(uint32_t address)
+{
+    uint16_t halfWord = Platform_MemRead16((const uint16_t*)address);
+
+    /* Code which can't be read is decoded as a BKPT instruction so that the basic block ends there. */
+    if (Platform_WasMemoryFaultEncountered())
+        return 0xBE00;
+    return halfWord;
+}
+
+
+static int isStoppedAtEndOfBlockStep(void);
 int Platform_IsSingleStepping(void)
 {
-    return __mriCortexMState.flags & CORTEXM_FLAGS_SINGLE_STEPPING;
+    return (__mriCortexMState.flags & CORTEXM_FLAGS_SINGLE_STEPPING) || isStoppedAtEndOfBlockStep();
+}
+
+static int isStoppedAtEndOfBlockStep(void)
+{
+    /* Only the block step's own breakpoint completes the step.  Any other breakpoint hit along the way is reported
+       as a breakpoint. */
+    return (__mriCortexMState.flags & CORTEXM_FLAGS_BLOCK_STEP) &&
+           __mriCortexMState.context.PC == __mriCortexMState.blockStepAddress;
 }
 
 
@@ -367,10 +526,15 @@ uint32_t Platform_GetPacketBufferSize(void)
 }
 
 
-static uint8_t  determineCauseOfDebugEvent(void);
+static int      wasStepPended(void);
+static int      wasDebuggerPreempted(void);
+static uint8_t  determineCauseOfHardFault(void);
+static int      wasDebugEventEscalatedToHardFault(void);
+static uint8_t  determineCauseOfDebugEvent(int stepWasPended);
 uint8_t Platform_DetermineCauseOfException(void)
 {
     uint32_t exceptionNumber = getCurrentlyExecutingExceptionNumber();
+    int      stepWasPended = wasStepPended();
     
     switch(exceptionNumber)
     {
@@ -379,7 +543,7 @@ uint8_t Platform_DetermineCauseOfException(void)
         return SIGINT;
     case 3:
         /* HardFault */
-        return SIGSEGV;
+        return determineCauseOfHardFault();
     case 4:
         /* MemManage */
         return SIGSEGV;
@@ -391,7 +555,7 @@ uint8_t Platform_DetermineCauseOfException(void)
         return SIGILL;
     case 12:
         /* Debug Monitor */
-        return determineCauseOfDebugEvent();
+        return determineCauseOfDebugEvent(stepWasPended);
     case 21:
     case 22:
     case 23:
@@ -404,7 +568,43 @@ uint8_t Platform_DetermineCauseOfException(void)
     }
 }
 
-static uint8_t determineCauseOfDebugEvent(void)
+static int wasStepPended(void)
+{
+    int wasPended = __mriCortexMState.flags & CORTEXM_FLAGS_PENDED_STEP;
+
+    __mriCortexMState.flags &= ~CORTEXM_FLAGS_PENDED_STEP;
+    return wasPended;
+}
+
+static int wasDebuggerPreempted(void)
+{
+    return __mriCortexMState.flags & CORTEXM_FLAGS_PREEMPTED_DEBUGGER;
+}
+
+static uint8_t determineCauseOfHardFault(void)
+{
+    static const uint32_t debugEventBit = 1 << 31;
+
+    if (!wasDebugEventEscalatedToHardFault())
+        return SIGSEGV;
+
+    /* Report it as the breakpoint/watchpoint it really was.  A stop which can't be resumed keeps its status bits so
+       that it is reported the same way each time gdb tries. */
+    if (!wasDebuggerPreempted())
+        SCB->HFSR = debugEventBit;
+    __mriCortexMState.flags |= CORTEXM_FLAGS_ESCALATED_DEBUG_EVENT;
+    return determineCauseOfDebugEvent(0);
+}
+
+static int wasDebugEventEscalatedToHardFault(void)
+{
+    static const uint32_t debugEventBit = 1 << 31;
+    static const uint32_t forcedBit = 1 << 30;
+
+    return (SCB->HFSR & (debugEventBit | forcedBit)) == debugEventBit;
+}
+
+static uint8_t determineCauseOfDebugEvent(int stepWasPended)
 {
     static struct
     {
@@ -420,31 +620,47 @@ static uint8_t determineCauseOfDebugEvent(void)
     uint32_t debugFaultStatus = SCB->DFSR;
     size_t   i;
     
+    DWT_LatchMatchedComparators();
     for (i = 0 ; i < sizeof(debugEventToSignalMap)/sizeof(debugEventToSignalMap[0]) ; i++)
     {
         if (debugFaultStatus & debugEventToSignalMap[i].statusBit)
         {
-            SCB->DFSR = debugEventToSignalMap[i].statusBit;
+            if (!wasDebuggerPreempted())
+                SCB->DFSR = debugEventToSignalMap[i].statusBit;
             return debugEventToSignalMap[i].signalToReturn;
         }
     }
     
+    /* The debug monitor was pended to complete a step in an interrupt handler which it couldn't preempt. */
+    if (stepWasPended)
+        return SIGTRAP;
+    
     /* NOTE: Default catch all signal is SIGSTOP. */
     return SIGSTOP;
 }
 
 
+static void displayEscalatedDebugEventToGdbConsole(void);
 static void displayHardFaultCauseToGdbConsole(void);
 static void displayMemFaultCauseToGdbConsole(void);
 static void displayBusFaultCauseToGdbConsole(void);
 static void displayUsageFaultCauseToGdbConsole(void);
+static void displayUnreachableFpbRemapTableToGdbConsole(void);
 void Platform_DisplayFaultCauseToGdbConsole(void)
 {
+    if (__mriCortexMState.flags & CORTEXM_FLAGS_FPB_REMAP_UNREACHABLE)
+        displayUnreachableFpbRemapTableToGdbConsole();
+    if (wasDebuggerPreempted())
+        WriteStringToGdbConsole("\n**Handler at or above MRI_HALT_PRIORITY stopped while halted, it can't be resumed**");
+
     switch (getCurrentlyExecutingExceptionNumber())
     {
     case 3:
         /* HardFault */
-        displayHardFaultCauseToGdbConsole();
+        if (__mriCortexMState.flags & CORTEXM_FLAGS_ESCALATED_DEBUG_EVENT)
+            displayEscalatedDebugEventToGdbConsole();
+        else
+            displayHardFaultCauseToGdbConsole();
         break;
     case 4:
         /* MemManage */
@@ -464,6 +680,19 @@ void Platform_DisplayFaultCauseToGdbConsole(void)
     WriteStringToGdbConsole("\n");
 }
 
+static void displayUnreachableFpbRemapTableToGdbConsole(void)
+{
+    /* Only reported on the first stop after init since nothing will change until the program is relinked. */
+    __mriCortexMState.flags &= ~CORTEXM_FLAGS_FPB_REMAP_UNREACHABLE;
+    WriteStringToGdbConsole("\n**FPB remap table isn't in 0x20000000-0x3FFFFFFF SRAM, 16-bit breakpoints won't share "
+                            "FPB comparators**\n");
+}
+
+static void displayEscalatedDebugEventToGdbConsole(void)
+{
+    WriteStringToGdbConsole("\n**Debug event in handler at or above MRI_HALT_PRIORITY, all interrupts halted**");
+}
+
 static void displayHardFaultCauseToGdbConsole(void)
 {
     static const uint32_t debugEventBit = 1 << 31;
@@ -619,6 +848,7 @@ static void displayUsageFaultCauseToGdbConsole(void)
 
 
 static void     clearMemoryFaultFlag(void);
+static void     clearEscalatedDebugEventFlag(void);
 static void     configureMpuToAccessAllMemoryWithNoCaching(void);
 static void     saveOriginalMpuConfiguration(void);
 static void     configureHighestMpuRegionToAccessAllMemoryWithNoCaching(void);
@@ -630,9 +860,13 @@ static void     removeHardwareBreakpointOnSvcHandlerIfNeeded(void);
 static int      shouldRemoveHardwareBreakpointOnSvcHandler(void);
 static void     clearSvcStepFlag(void);
 static void     clearHardwareBreakpointOnSvcHandler(void);
+static void     removeBlockStepBreakpointIfNeeded(void);
+static int      shouldRemoveBlockStepBreakpoint(void);
+static void     clearBlockStepFlag(void);
 void Platform_EnteringDebugger(void)
 {
     clearMemoryFaultFlag();
+    clearEscalatedDebugEventFlag();
     __mriCortexMState.originalPC = __mriCortexMState.context.PC;
     configureMpuToAccessAllMemoryWithNoCaching();
     cleanupIfSingleStepping();
@@ -643,6 +877,11 @@ static void clearMemoryFaultFlag(void)
     __mriCortexMState.flags &= ~CORTEXM_FLAGS_FAULT_DURING_DEBUG;
 }
 
+static void clearEscalatedDebugEventFlag(void)
+{
+    __mriCortexMState.flags &= ~CORTEXM_FLAGS_ESCALATED_DEBUG_EVENT;
+}
+
 static void configureMpuToAccessAllMemoryWithNoCaching(void)
 {
     saveOriginalMpuConfiguration();
@@ -677,6 +916,7 @@ static void cleanupIfSingleStepping(void)
 {
     restoreBasePriorityIfNeeded();
     removeHardwareBreakpointOnSvcHandlerIfNeeded();
+    removeBlockStepBreakpointIfNeeded();
     Platform_DisableSingleStep();
 }
 
@@ -724,6 +964,26 @@ static void clearHardwareBreakpointOnSvcHandler(void)
     Platform_ClearHardwareBreakpoint(getNvicVector(SVCall_IRQn) & ~1, 2);
 }
 
+static void removeBlockStepBreakpointIfNeeded(void)
+{
+    if (shouldRemoveBlockStepBreakpoint())
+    {
+        clearBlockStepFlag();
+        Platform_ClearHardwareBreakpoint(__mriCortexMState.blockStepAddress, 2);
+        __mriCortexMState.blockStepAddress = 0;
+    }
+}
+
+static int shouldRemoveBlockStepBreakpoint(void)
+{
+    return __mriCortexMState.flags & CORTEXM_FLAGS_BLOCK_STEP;
+}
+
+static void clearBlockStepFlag(void)
+{
+    __mriCortexMState.flags &= ~CORTEXM_FLAGS_BLOCK_STEP;
+}
+
 
 static void restoreMPUConfiguration(void);
 static void checkStack(void);
@@ -732,6 +992,8 @@ void Platform_LeavingDebugger(void)
     restoreMPUConfiguration();
     checkStack();
     clearMonitorPending();
+    if (__mriCortexMState.flags & CORTEXM_FLAGS_PENDED_STEP)
+        setMonitorPending();
 }
 
 static void restoreMPUConfiguration(void)
@@ -765,9 +1027,59 @@ uint32_t Platform_GetProgramCounter(void)
 }
 
 
+static void markCoreRegistersDirty(void);
 void Platform_SetProgramCounter(uint32_t newPC)
 {
     __mriCortexMState.context.PC = newPC;
+    markCoreRegistersDirty();
+}
+
+static void markCoreRegistersDirty(void)
+{
+    __mriCortexMState.flags |= CORTEXM_FLAGS_CORE_DIRTY;
+}
+
+
+uint32_t Platform_GetLinkRegister(void)
+{
+    return __mriCortexMState.context.LR;
+}
+
+
+static int32_t getContextIndexOfRegister(uint32_t registerNumber);
+static void    saveFpuContextIfNeeded(void);
+/* Reads a register from the saved context using the gdb register numbering from g_targetXml.  Throws
+   invalidIndexException for registers which don't fit in 32-bits or don't exist on this device. */
+uint32_t Platform_ReadRegister(uint32_t registerNumber)
+{
+    const uint32_t* pContext = (const uint32_t*)&__mriCortexMState.context;
+    int32_t         index = getContextIndexOfRegister(registerNumber);
+
+    if (index < 0)
+        __throw_and_return(invalidIndexException, 0);
+#if MRI_DEVICE_HAS_FPU
+    if (index >= (int32_t)CONTEXT_MEMBER_INDEX(S0))
+        saveFpuContextIfNeeded();
+#endif
+    return pContext[index];
+}
+
+static int32_t getContextIndexOfRegister(uint32_t registerNumber)
+{
+    static const uint32_t xpsrRegisterNumber = 25;
+    static const uint32_t controlRegisterNumber = 31;
+
+    /* xpsr through control are stored in the same order as their register numbers. */
+    if (registerNumber <= CONTEXT_MEMBER_INDEX(PC))
+        return registerNumber;
+    if (registerNumber >= xpsrRegisterNumber && registerNumber <= controlRegisterNumber)
+        return CONTEXT_MEMBER_INDEX(CPSR) + (registerNumber - xpsrRegisterNumber);
+#if MRI_DEVICE_HAS_FPU
+    /* d0 - d15 are numbered 32 - 47 but are 64-bit so fpscr is the only readable register in the vfp feature. */
+    if (registerNumber == 48)
+        return CONTEXT_MEMBER_INDEX(FPSCR);
+#endif
+    return -1;
 }
 
 
@@ -797,6 +1109,7 @@ void Platform_AdvanceProgramCounterToNextInstruction(void)
         /* 16-bit Instruction. */
         __mriCortexMState.context.PC += 2;
     }
+    markCoreRegistersDirty();
 }
 
 static int isInstruction32Bit(uint16_t firstWordOfInstruction)
@@ -817,6 +1130,13 @@ int Platform_WasProgramCounterModifiedByUser(void)
 }
 
 
+int Platform_CanResume(void)
+{
+    /* The debugger code which a preempting handler would return to has been overwritten on the debugger's stack. */
+    return !wasDebuggerPreempted();
+}
+
+
 static int isInstructionMbedSemihostBreakpoint(uint16_t instruction);
 static int isInstructionNewlibSemihostBreakpoint(uint16_t instruction);
 static int isInstructionHardcodedBreakpoint(uint16_t instruction);
@@ -883,6 +1203,7 @@ PlatformSemihostParameters Platform_GetSemihostCallParameters(void)
 void Platform_SetSemihostCallReturnAndErrnoValues(int returnValue, int err)
 {
     __mriCortexMState.context.R0 = returnValue;
+    markCoreRegistersDirty();
     if (returnValue < 0)
         errno = err;
 }
@@ -900,22 +1221,25 @@ int Platform_WasMemoryFaultEncountered(void)
 }
 
 
-static void sendRegisterForTResponse(Buffer* pBuffer, uint8_t registerOffset, uint32_t registerValue);
-static void writeBytesToBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount);
+uint32_t Platform_GetCycleCount(void)
+{
+    return DWT->CYCCNT;
+}
+
+
 void Platform_WriteTResponseRegistersToBuffer(Buffer* pBuffer)
 {
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(R7), __mriCortexMState.context.R7);
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(SP), __mriCortexMState.context.SP);
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(LR), __mriCortexMState.context.LR);
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(PC), __mriCortexMState.context.PC);
+    static const uint8_t tResponseRegisters[] = { MRI_CORTEXM_T_RESPONSE_REGISTERS };
+
+    WriteRegistersForTResponse(pBuffer, tResponseRegisters, sizeof(tResponseRegisters));
 }
 
-static void sendRegisterForTResponse(Buffer* pBuffer, uint8_t registerOffset, uint32_t registerValue)
+
+static void writeBytesToBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount);
+void Platform_CopyContextToBuffer(Buffer* pBuffer)
 {
-    Buffer_WriteByteAsHex(pBuffer, registerOffset);
-    Buffer_WriteChar(pBuffer, ':');
-    writeBytesToBufferAsHex(pBuffer, &registerValue, sizeof(registerValue));
-    Buffer_WriteChar(pBuffer, ';');
+    saveFpuContextIfNeeded();
+    writeBytesToBufferAsHex(pBuffer, &__mriCortexMState.context, sizeof(__mriCortexMState.context));
 }
 
 static void writeBytesToBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount)
@@ -927,17 +1251,73 @@ static void writeBytesToBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCo
         Buffer_WriteByteAsHex(pBuffer, *pByte++);
 }
 
+#if MRI_DEVICE_HAS_FPU
+static int isFpuEnabled(void);
+#endif
+/* The exception handler leaves the FPU registers out of the context.  They are copied in here, the first time they
+   are needed for this stop. */
+static void saveFpuContextIfNeeded(void)
+{
+#if MRI_DEVICE_HAS_FPU
+    static const size_t fpuRegisterCount = CONTEXT_MEMBER_INDEX(FPSCR) - CONTEXT_MEMBER_INDEX(S0) + 1;
+    static const size_t stackedRegisterCount = 16;
+    uint32_t*           pS0 = &__mriCortexMState.context.S0;
+    
+    if (__mriCortexMState.flags & CORTEXM_FLAGS_FPU_SAVED)
+        return;
+    __mriCortexMState.flags |= CORTEXM_FLAGS_FPU_SAVED;
+    
+    if (!isFpuEnabled())
+    {
+        memset(pS0, 0, fpuRegisterCount * sizeof(uint32_t));
+        return;
+    }
+    
+    /* mri doesn't use the FPU itself so it still holds the task's S16-S31, and S0-S15 and FPSCR too unless they were
+       auto-stacked on exception entry. */
+    __mriCortexMState.context.FPSCR = __mriCortexMReadFpuRegisters(pS0);
+    if (__mriCortexMState.flags & CORTEXM_FLAGS_FPU_FRAME)
+    {
+        const uint32_t* pFrame = (const uint32_t*)__mriCortexMState.fpuFrameAddress;
+        
+        memcpy(pS0, pFrame, stackedRegisterCount * sizeof(uint32_t));
+        __mriCortexMState.context.FPSCR = pFrame[stackedRegisterCount];
+    }
+#endif /* MRI_DEVICE_HAS_FPU */
+}
 
-void Platform_CopyContextToBuffer(Buffer* pBuffer)
+#if MRI_DEVICE_HAS_FPU
+static int isFpuEnabled(void)
 {
-    writeBytesToBufferAsHex(pBuffer, &__mriCortexMState.context, sizeof(__mriCortexMState.context));
+    static const uint32_t cpacrFpuBits = 5 << 20;
+    
+    return (SCB->CPACR & cpacrFpuBits) == cpacrFpuBits;
 }
+#endif
 
 
 static void readBytesFromBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount);
+static int  readBytesFromBufferAsHexAndCheckForChange(Buffer* pBuffer, void* pBytes, size_t byteCount);
 void Platform_CopyContextFromBuffer(Buffer* pBuffer)
 {
-    readBytesFromBufferAsHex(pBuffer, &__mriCortexMState.context, sizeof(__mriCortexMState.context));
+    static const size_t systemOffset = offsetof(Context, MSP);
+#if MRI_DEVICE_HAS_FPU
+    static const size_t fpuOffset = offsetof(Context, S0);
+#else
+    static const size_t fpuOffset = sizeof(Context);
+#endif
+    uint8_t*            pContext = (uint8_t*)&__mriCortexMState.context;
+    
+    /* Only mark a group of registers for writing back on exit if gdb actually changed one of them.  MSP through
+       CONTROL are never written back to the processor. */
+    saveFpuContextIfNeeded();
+    if (readBytesFromBufferAsHexAndCheckForChange(pBuffer, pContext, systemOffset))
+        markCoreRegistersDirty();
+    readBytesFromBufferAsHex(pBuffer, pContext + systemOffset, fpuOffset - systemOffset);
+#if MRI_DEVICE_HAS_FPU
+    if (readBytesFromBufferAsHexAndCheckForChange(pBuffer, pContext + fpuOffset, sizeof(Context) - fpuOffset))
+        __mriCortexMState.flags |= CORTEXM_FLAGS_FPU_DIRTY;
+#endif
 }
 
 static void readBytesFromBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount)
@@ -949,11 +1329,26 @@ static void readBytesFromBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteC
         *pByte++ = Buffer_ReadByteAsHex(pBuffer);
 }
 
+static int readBytesFromBufferAsHexAndCheckForChange(Buffer* pBuffer, void* pBytes, size_t byteCount)
+{
+    uint8_t* pByte = (uint8_t*)pBytes;
+    int      changed = 0;
+    size_t   i;
+    
+    for (i = 0 ; i < byteCount; i++)
+    {
+        uint8_t byte = Buffer_ReadByteAsHex(pBuffer);
+        
+        changed |= (byte != *pByte);
+        *pByte++ = byte;
+    }
+    return changed;
+}
+
 
 static int doesKindIndicate32BitInstruction(uint32_t kind);
 void Platform_SetHardwareBreakpoint(uint32_t address, uint32_t kind)
 {
-    uint32_t* pFPBBreakpointComparator;
     int       is32BitInstruction;
     
     __try
@@ -961,8 +1356,13 @@ void Platform_SetHardwareBreakpoint(uint32_t address, uint32_t kind)
     __catch
         __rethrow;
         
-    pFPBBreakpointComparator = enableFPBBreakpoint(address, is32BitInstruction);
-    if (!pFPBBreakpointComparator)
+    /* Breakpoints overflow from the FPB onto the PC match comparators of the DWT, the same comparators used for
+       watchpoints.  Check the DWT first so that a breakpoint which overflowed isn't set a second time in the FPB. */
+    if (DWT_FindBreakpoint(address))
+        return;
+    if (FPB_SetBreakpoint(address, is32BitInstruction))
+        return;
+    if (!DWT_SetBreakpoint(address))
         __throw(exceededHardwareResourcesException);
 }
 
@@ -990,7 +1390,14 @@ void Platform_ClearHardwareBreakpoint(uint32_t address, uint32_t kind)
     __catch
         __rethrow;
         
-    disableFPBBreakpointComparator(address, is32BitInstruction);
+    if (!FPB_ClearBreakpoint(address, is32BitInstruction))
+        DWT_ClearBreakpoint(address);
+}
+
+
+uint32_t __mriFPB_ReadCodeWord(uint32_t address)
+{
+    return *(volatile uint32_t*)address;
 }
 
 
@@ -998,12 +1405,16 @@ static uint32_t convertWatchpointTypeToCortexMType(PlatformWatchpointType type);
 void Platform_SetHardwareWatchpoint(uint32_t address, uint32_t size, PlatformWatchpointType type)
 {
     uint32_t       nativeType = convertWatchpointTypeToCortexMType(type);
-    DWT_COMP_Type* pComparator;
+    DWT_COMP_Type* pComparator = NULL;
     
-    if (!isValidDWTComparatorSetting(address, size, nativeType))
+    if (!DWT_IsValidRangeWatchpoint(address, size, nativeType))
         __throw(invalidArgumentException);
     
-    pComparator = enableDWTWatchpoint(address, size, nativeType);
+    /* Ranges which don't fit in a single comparator are spread over several. */
+    if (DWT_IsValidWatchpoint(address, size, nativeType))
+        pComparator = DWT_SetWatchpoint(address, size, nativeType);
+    if (!pComparator)
+        pComparator = DWT_SetRangeWatchpoint(address, size, nativeType);
     if (!pComparator)
         __throw(exceededHardwareResourcesException);
 }
@@ -1028,10 +1439,61 @@ void Platform_ClearHardwareWatchpoint(uint32_t address, uint32_t size, PlatformW
 {
     uint32_t nativeType = convertWatchpointTypeToCortexMType(type);
     
-    if (!isValidDWTComparatorSetting(address, size, nativeType))
+    if (!DWT_IsValidRangeWatchpoint(address, size, nativeType))
         __throw(invalidArgumentException);
     
-    disableDWTWatchpoint(address, size, nativeType);
+    if (!DWT_ClearRangeWatchpoint(address, size, nativeType) && DWT_IsValidWatchpoint(address, size, nativeType))
+        DWT_ClearWatchpoint(address, size, nativeType);
+}
+
+
+/* Write watchpoint which only triggers when value is written to the size bytes at address.  Throws
+   exceededHardwareResourcesException when no comparator which supports data value matching is free so that the caller
+   can fall back to checking the value in software. */
+void Platform_SetHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    if (!DWT_IsValidWatchpoint(address, size, DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE) || size > sizeof(uint32_t))
+        __throw(invalidArgumentException);
+
+    if (!DWT_SetValueWatchpoint(address, size, value, DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE))
+        __throw(exceededHardwareResourcesException);
+}
+
+
+void Platform_ClearHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    if (!DWT_IsValidWatchpoint(address, size, DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE) || size > sizeof(uint32_t))
+        __throw(invalidArgumentException);
+
+    DWT_ClearValueWatchpoint(address, size, value, DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE);
+}
+
+
+int Platform_WasWatchpointHit(uint32_t address)
+{
+    return DWT_WasWatchpointMatched(address);
+}
+
+
+uint32_t Platform_GetSoftwareBreakpointMachineCode(uint32_t kind)
+{
+    static const uint16_t hardCodedBreakpointMachineCode = 0xbe00;
+
+    /* The 16-bit BKPT replaces the first halfword of 32-bit Thumb-2 instructions as well. */
+    __try
+        doesKindIndicate32BitInstruction(kind);
+    __catch
+        __rethrow_and_return(0);
+
+    return hardCodedBreakpointMachineCode;
+}
+
+
+void Platform_SyncInstructionCache(void)
+{
+    /* Make sure that instructions modified by data writes are seen by the instruction fetches which follow. */
+    __DSB();
+    __ISB();
 }
 
 uint32_t Platform_GetTargetXmlSize(void)
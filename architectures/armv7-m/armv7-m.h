@@ -24,6 +24,37 @@
 #define CORTEXM_FLAGS_SINGLE_STEPPING       4
 #define CORTEXM_FLAGS_RESTORE_BASEPRI       8
 #define CORTEXM_FLAGS_SVC_STEP              16
+#define CORTEXM_FLAGS_BLOCK_STEP            32
+/* S0-S15 and FPSCR were auto-stacked at CortexMState::fpuFrameAddress on exception entry. */
+#define CORTEXM_FLAGS_FPU_FRAME             64
+/* The FPU registers have been copied into CortexMState::context. */
+#define CORTEXM_FLAGS_FPU_SAVED             128
+/* gdb modified the FPU registers in CortexMState::context so they must be written back on exit. */
+#define CORTEXM_FLAGS_FPU_DIRTY             256
+/* R0-R12, SP, LR, PC, or xPSR were modified in CortexMState::context so the exception frame must be rebuilt on exit. */
+#define CORTEXM_FLAGS_CORE_DIRTY            512
+/* The code being stepped runs at or above the debug monitor's priority so the step completes by pending the monitor. */
+#define CORTEXM_FLAGS_PENDED_STEP           1024
+/* A breakpoint or watchpoint was hit at or above the debug monitor's priority and escalated to a Hard Fault. */
+#define CORTEXM_FLAGS_ESCALATED_DEBUG_EVENT 2048
+/* A handler at or above the debug monitor's priority faulted while the program was halted.  Its frames were on the
+   debugger's stack so it can't be resumed. */
+#define CORTEXM_FLAGS_PREEMPTED_DEBUGGER    4096
+/* Set at init when the device's FPB remap table isn't in the SRAM region that the FPB can remap to. */
+#define CORTEXM_FLAGS_FPB_REMAP_UNREACHABLE 8192
+
+/* Set to 1 to have the exception handler record the cycles spent restoring the task's context in
+   __mriCortexMExitCycles. */
+#ifndef MRI_CORTEXM_EXIT_BENCHMARK
+#define MRI_CORTEXM_EXIT_BENCHMARK          0
+#endif
+
+/* gdb register numbers of the registers expedited in T stop responses.  The r7 (Thumb) and r11 (ARM) frame pointers
+   along with sp, lr, pc, and xpsr let gdb display the frame after a step without a 'g' command.  Can be overridden
+   at build time or replaced at runtime with "monitor expedite". */
+#ifndef MRI_CORTEXM_T_RESPONSE_REGISTERS
+#define MRI_CORTEXM_T_RESPONSE_REGISTERS    7, 11, 13, 14, 15, 25
+#endif
 
 /* Constants related to special memory area used by the debugger for its stack so that it doesn't interfere with
    the task's stack contents. */
@@ -36,9 +67,18 @@
 #define CORTEXM_STATE_DEBUGGER_STACK_OFFSET 0
 #define CORTEXM_STATE_FLAGS_OFFSET          (CORTEXM_STATE_DEBUGGER_STACK_OFFSET + CORTEXM_DEBUGGER_STACK_SIZE_IN_BYTES)
 #define CORTEXM_STATE_TASK_SP_OFFSET        (CORTEXM_STATE_FLAGS_OFFSET + 4)
-#define CORTEXM_STATE_CONTEXT_OFFSET        (CORTEXM_STATE_TASK_SP_OFFSET + 4)
+#define CORTEXM_STATE_FPU_FRAME_OFFSET      (CORTEXM_STATE_TASK_SP_OFFSET + 4)
+#define CORTEXM_STATE_DEBUG_EXC_OFFSET      (CORTEXM_STATE_FPU_FRAME_OFFSET + 4)
+#define CORTEXM_STATE_COMM_INTERRUPT_OFFSET (CORTEXM_STATE_DEBUG_EXC_OFFSET + 4)
+#define CORTEXM_STATE_CONTEXT_OFFSET        (CORTEXM_STATE_COMM_INTERRUPT_OFFSET + 16)
 #define CORTEXM_STATE_SAVED_MSP_OFFSET      (CORTEXM_STATE_CONTEXT_OFFSET + 17 * 4)
 
+/* Offsets of fields within the CortexMCommInterrupt structure defined below. */
+#define CORTEXM_COMM_INTERRUPT_EXCEPTION_OFFSET 0
+#define CORTEXM_COMM_INTERRUPT_STATUS_OFFSET    4
+#define CORTEXM_COMM_INTERRUPT_MASK_OFFSET      8
+#define CORTEXM_COMM_INTERRUPT_CLEAR_OFFSET     12
+
 
 /* Definitions only required from C code. */
 #if !__ASSEMBLER__
@@ -121,11 +161,28 @@ typedef struct
    the debugger as two hex digits per byte.  Also need a character for the 'G' command itself. */
 #define CORTEXM_PACKET_BUFFER_SIZE (1 + 2 * sizeof(Context))
 
+/* Describes the interrupt raised by the UART used for gdb communications so that the exception handler can dismiss
+   it without saving the task's context when no received data is pending for the debugger. */
+typedef struct
+{
+    /* Exception number of the UART interrupt.  0 disables the check. */
+    uint32_t                 exceptionNumber;
+    /* Status register and the bits within it which are set when received data is pending. */
+    const volatile uint32_t* pStatus;
+    uint32_t                 receiveDataMask;
+    /* Register to be read in order to acknowledge the interrupt.  Can be NULL if no acknowledgement is required. */
+    const volatile uint32_t* pClear;
+} CortexMCommInterrupt;
+
 typedef struct
 {
     uint64_t            debuggerStack[CORTEXM_DEBUGGER_STACK_SIZE];
     volatile uint32_t   flags;
     volatile uint32_t   taskSP;
+    uint32_t            fpuFrameAddress;
+    /* Exception number the debugger was entered through, used to tell faults in its own code apart from others. */
+    uint32_t            debugExceptionNumber;
+    CortexMCommInterrupt commInterrupt;
     Context             context;
     uint32_t            originalPC;
     uint32_t            originalMPUControlValue;
@@ -133,6 +190,8 @@ typedef struct
     uint32_t            originalMPURegionAddress;
     uint32_t            originalMPURegionAttributesAndSize;
     uint32_t            originalBasePriority;
+    uint32_t            blockStepAddress;
+    uint32_t            haltPriority;
     int                 maxStackUsed;
     char                packetBuffer[CORTEXM_PACKET_BUFFER_SIZE];
 } CortexMState;
@@ -140,7 +199,14 @@ typedef struct
 extern CortexMState     __mriCortexMState;
 extern const uint32_t   __mriCortexMFakeStack[8];
 
-void     __mriCortexMInit(Token* pParameterTokens);
+void     __mriCortexMInit(Token* pParameterTokens, uint32_t* pFpbRemapTable);
+uint32_t __mriCortexMGetHaltPriority(void);
+void     __mriCortexMSetCommInterrupt(uint32_t exceptionNumber,
+                                      const volatile uint32_t* pStatus, uint32_t receiveDataMask,
+                                      const volatile uint32_t* pClear);
+#if MRI_DEVICE_HAS_FPU
+uint32_t __mriCortexMReadFpuRegisters(uint32_t* pS0);
+#endif
 
 #endif /* !__ASSEMBLER__ */
 
@@ -19,28 +19,8 @@
 #include <cmsis.h>
 #include <stdio.h>
 #include <try_catch.h>
-
-/* Data Watchpoint and Trace Registers */
-typedef struct
-{
-    /* Comparator register. */
-    __IO uint32_t   COMP;
-    /* Comparator Mask register. */
-    __IO uint32_t   MASK;
-    /* Comparator Function register. */
-    __IO uint32_t   FUNCTION;
-    /* Reserved 4 bytes to pad struct size out to 16 bytes. */
-    __I  uint32_t   Reserved;
-} DWT_COMP_Type;
-
-/* Flash Patch and Breakpoint Registers */
-typedef struct
-{
-    /* FlashPatch Control Register. */
-    __IO uint32_t   CTRL;
-    /* FlashPatch Remap Register. */
-    __IO uint32_t   REMAP;
-} FPB_Type;
+#include "dwt.h"
+#include "fpb.h"
 
 /* Memory mapping of Cortex-M3 Debug Hardware */
 #define DWT_COMP_BASE   (0xE0001020)
@@ -91,9 +71,9 @@ static __INLINE void waitForDebuggerToDetach(uint32_t timeOut)
         __throw(timeoutException);
 }
 
-static __INLINE void enableDebugMonitorAtPriority0(void)
+static __INLINE void enableDebugMonitorAtPriority(uint32_t priority)
 {
-    NVIC_SetPriority(DebugMonitor_IRQn, 0);
+    NVIC_SetPriority(DebugMonitor_IRQn, priority);
     CoreDebug->DEMCR |=  CoreDebug_DEMCR_MON_END;
 }
 
@@ -102,6 +82,11 @@ static __INLINE void enableDWTandITM(void)
     CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA;
 }
 
+static __INLINE void enableCycleCounter(void)
+{
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
 static __INLINE void disableSingleStep(void)
 {
     CoreDebug->DEMCR &=  ~CoreDebug_DEMCR_MON_STEP;
@@ -117,500 +102,32 @@ static __INLINE void clearMonitorPending(void)
     CoreDebug->DEMCR &= ~CoreDebug_DEMCR_MON_PEND;
 }
 
-
-/* Data Watchpoint and Trace Comparator Function Bits. */
-/*  Matched.  Read-only.  Set to 1 to indicate that this comparator has been matched.  Cleared on read. */
-#define DWT_COMP_FUNCTION_MATCHED               (1 << 24)
-/*  Data Address Linked Index 1. */
-#define DWT_COMP_FUNCTION_DATAVADDR1            (0xF << 16)
-/*  Data Address Linked Index 0. */
-#define DWT_COMP_FUNCTION_DATAVADDR0            (0xF << 12)
-/*  Selects size for data value matches. */
-#define DWT_COMP_FUNCTION_DATAVSIZE_MASK        (3 << 10)
-/*      Byte */
-#define DWT_COMP_FUNCTION_DATAVSIZE_BYTE        (0 << 10)
-/*      Halfword */
-#define DWT_COMP_FUNCTION_DATAVSIZE_HALFWORD    (1 << 10)
-/*      Word */
-#define DWT_COMP_FUNCTION_DATAVSIZE_WORD        (2 << 10)
-/*  Data Value Match.  Set to 0 for address compare and 1 for data value compare. */
-#define DWT_COMP_FUNCTION_DATAVMATCH            (1 << 8)
-/*  Cycle Count Match.  Set to 1 for enabling cycle count match and 0 otherwise.  Only valid on comparator 0. */
-#define DWT_COMP_FUNCTION_CYCMATCH              (1 << 7)
-/*  Enable Data Trace Address offset packets.  0 to disable. */
-#define DWT_COMP_FUNCTION_EMITRANGE             (1 << 5)
-/*  Selects action to be taken on match. */
-#define DWT_COMP_FUNCTION_FUNCTION_MASK             0xF
-/*      Disabled */
-#define DWT_COMP_FUNCTION_FUNCTION_DISABLED         0x0
-/*      Instruction Watchpoint */
-#define DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION      0x4
-/*      Data Read Watchpoint */
-#define DWT_COMP_FUNCTION_FUNCTION_DATA_READ        0x5
-/*      Data Write Watchpoint */
-#define DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE       0x6
-/*      Data Read/Write Watchpoint */
-#define DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE   0x7
-
-/* DWT - Data Watchpoint Trace Routines */
-static __INLINE uint32_t getDWTComparatorCount(void)
-{
-    return (DWT->CTRL >> 28);
-}
-
-static __INLINE void clearDWTComparator(DWT_COMP_Type* pComparatorStruct)
+static __INLINE void setMonitorPending(void)
 {
-    pComparatorStruct->COMP = 0;
-    pComparatorStruct->MASK = 0;
-    pComparatorStruct->FUNCTION &= ~(DWT_COMP_FUNCTION_DATAVMATCH | 
-                                     DWT_COMP_FUNCTION_CYCMATCH |
-                                     DWT_COMP_FUNCTION_EMITRANGE |
-                                     DWT_COMP_FUNCTION_FUNCTION_MASK);
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_MON_PEND;
 }
 
-static __INLINE void clearDWTComparators(void)
-{
-    DWT_COMP_Type*  pComparatorStruct = DWT_COMP_ARRAY;
-    uint32_t        comparatorCount;
-    uint32_t        i;
-    
-    comparatorCount = getDWTComparatorCount();
-    for (i = 0 ; i < comparatorCount ; i++)
-    {
-        clearDWTComparator(pComparatorStruct);
-        pComparatorStruct++;
-    }
-}
 
+/* DWT - Data Watchpoint Trace Routines */
 static __INLINE void initDWT(void)
 {
-    clearDWTComparators();
-}
-
-static __INLINE uint32_t maskOffDWTFunctionBits(uint32_t functionValue)
-{
-    return functionValue & (DWT_COMP_FUNCTION_DATAVADDR1 |
-                            DWT_COMP_FUNCTION_DATAVADDR0 |
-                            DWT_COMP_FUNCTION_DATAVSIZE_MASK |
-                            DWT_COMP_FUNCTION_DATAVMATCH |
-                            DWT_COMP_FUNCTION_CYCMATCH |
-                            DWT_COMP_FUNCTION_EMITRANGE |
-                            DWT_COMP_FUNCTION_FUNCTION_MASK);
-                            
+    DWT_Init(&DWT->CTRL, DWT_COMP_ARRAY);
 }
 
-static __INLINE int doesDWTComparatorAddressMatch(DWT_COMP_Type* pComparator, uint32_t address)
-{
-    return pComparator->COMP == address;
-}
-
-static __INLINE uint32_t calculateLog2(uint32_t value)
-{
-    uint32_t log2 = 0;
-    
-    while (value > 1)
-    {
-        value >>= 1;
-        log2++;
-    }
-    
-    return log2;
-}
-
-static __INLINE int doesDWTComparatorMaskMatch(DWT_COMP_Type* pComparator, uint32_t size)
-{
-    return pComparator->MASK == calculateLog2(size);
-}
-
-static __INLINE int doesDWTComparatorFunctionMatch(DWT_COMP_Type* pComparator, uint32_t function)
-{
-    uint32_t importantFunctionBits = maskOffDWTFunctionBits(pComparator->FUNCTION);
-
-    return importantFunctionBits == function;
-}
-
-
-static __INLINE int doesDWTComparatorMatch(DWT_COMP_Type* pComparator, 
-                                           uint32_t       address, 
-                                           uint32_t       size, 
-                                           uint32_t       function)
-{
-    return doesDWTComparatorFunctionMatch(pComparator, function) &&
-           doesDWTComparatorAddressMatch(pComparator, address) &&
-           doesDWTComparatorMaskMatch(pComparator, size);
-}
-
-static __INLINE DWT_COMP_Type* findDWTComparator(uint32_t watchpointAddress, 
-                                                 uint32_t watchpointSize, 
-                                                 uint32_t watchpointType)
-{
-    DWT_COMP_Type* pCurrentComparator = DWT_COMP_ARRAY;
-    uint32_t       comparatorCount;
-    uint32_t       i;
-    
-    comparatorCount = getDWTComparatorCount();
-    for (i = 0 ; i < comparatorCount ; i++)
-    {
-        if (doesDWTComparatorMatch(pCurrentComparator, watchpointAddress, watchpointSize, watchpointType))
-            return pCurrentComparator;
-
-        pCurrentComparator++;
-    }
-    
-    /* Return NULL if no DWT comparator is already enabled for this watchpoint. */
-    return NULL;
-}
-
-static __INLINE int isDWTComparatorFree(DWT_COMP_Type* pComparator)
-{
-    return (pComparator->FUNCTION & DWT_COMP_FUNCTION_FUNCTION_MASK) == DWT_COMP_FUNCTION_FUNCTION_DISABLED;
-}
-
-static __INLINE DWT_COMP_Type* findFreeDWTComparator(void)
-{
-    DWT_COMP_Type* pCurrentComparator = DWT_COMP_ARRAY;
-    uint32_t       comparatorCount;
-    uint32_t       i;
-    
-    comparatorCount = getDWTComparatorCount();
-    for (i = 0 ; i < comparatorCount ; i++)
-    {
-        if (isDWTComparatorFree(pCurrentComparator))
-        {
-            return pCurrentComparator;
-        }
-        pCurrentComparator++;
-    }
-    
-    /* Return NULL if there are no free DWT comparators. */
-    return NULL;
-}
-
-static __INLINE int isPowerOf2(uint32_t value)
-{
-    return (value & (value - 1)) == 0;
-}
-
-static __INLINE int isAddressAlignedToSize(uint32_t address, uint32_t size)
-{
-    uint32_t addressMask = ~(size - 1);
-    return address == (address & addressMask);
-}
-
-static __INLINE int isValidDWTComparatorSize(uint32_t watchpointSize)
-{
-    return isPowerOf2(watchpointSize);
-}
-
-static __INLINE int isValidDWTComparatorAddress(uint32_t watchpointAddress, uint32_t watchpointSize)
-{
-    return isAddressAlignedToSize(watchpointAddress, watchpointSize);
-}
-
-static __INLINE int isValidDWTComparatorType(uint32_t watchpointType)
-{
-    return (watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_READ) ||
-           (watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE) ||
-           (watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE);
-}
-
-static __INLINE int isValidDWTComparatorSetting(uint32_t watchpointAddress, 
-                                                uint32_t watchpointSize, 
-                                                uint32_t watchpointType)
-{
-    return isValidDWTComparatorSize(watchpointSize) &&
-           isValidDWTComparatorAddress(watchpointAddress, watchpointSize) &&
-           isValidDWTComparatorType(watchpointType);
-}
-
-static __INLINE int attemptToSetDWTComparatorMask(DWT_COMP_Type* pComparator, uint32_t watchpointSize)
-{
-    uint32_t maskBitCount;
-    
-    maskBitCount = calculateLog2(watchpointSize);
-    pComparator->MASK = maskBitCount;
-
-    /* Processor may limit number of bits to be masked off so check. */
-    return pComparator->MASK == maskBitCount;
-}
-
-static __INLINE int attemptToSetDWTComparator(DWT_COMP_Type* pComparator,
-                                              uint32_t       watchpointAddress,
-                                              uint32_t       watchpointSize,
-                                              uint32_t       watchpointType)
-{
-    if (!attemptToSetDWTComparatorMask(pComparator, watchpointSize))
-        return 0;
-    
-    pComparator->COMP = watchpointAddress;
-    pComparator->FUNCTION = watchpointType;
-    return 1;
-}
-
-static __INLINE DWT_COMP_Type* enableDWTWatchpoint(uint32_t watchpointAddress, 
-                                                   uint32_t watchpointSize, 
-                                                   uint32_t watchpointType)
-{
-    DWT_COMP_Type* pComparator = NULL;
-    
-    pComparator = findDWTComparator(watchpointAddress, watchpointSize, watchpointType);
-    if (pComparator)
-    {
-        /* This watchpoint has already been set so return a pointer to it. */
-        return pComparator;
-    }
-    
-    pComparator = findFreeDWTComparator();
-    if (!pComparator)
-    {
-        /* There are no free comparators left. */
-        return NULL;
-    }
-    
-    if (!attemptToSetDWTComparator(pComparator, watchpointAddress, watchpointSize, watchpointType))
-    {
-        /* Failed set due to the size being larger than supported by CPU. */
-        return NULL;
-    }
-    
-    /* Successfully configured a free comparator for this watchpoint. */
-    return pComparator;
-}
-
-static __INLINE DWT_COMP_Type* disableDWTWatchpoint(uint32_t watchpointAddress, 
-                                                    uint32_t watchpointSize, 
-                                                    uint32_t watchpointType)
-{
-    DWT_COMP_Type* pComparator = NULL;
-    
-    pComparator = findDWTComparator(watchpointAddress, watchpointSize, watchpointType);
-    if (!pComparator)
-    {
-        /* This watchpoint not set so return NULL. */
-        return NULL;
-    }
-    
-    clearDWTComparator(pComparator);
-    return pComparator;
-}
-
-
-/* FlashPatch Control Register Bits. */
-/*  Most significant bits of number of instruction address comparators.  Read-only */
-#define FP_CTRL_NUM_CODE_MSB_SHIFT  12
-#define FP_CTRL_NUM_CODE_MSB_MASK   (0x7 << FP_CTRL_NUM_CODE_MSB_SHIFT)
-/*  Least significant bits of number of instruction address comparators.  Read-only */
-#define FP_CTRL_NUM_CODE_LSB_SHIFT  4
-#define FP_CTRL_NUM_CODE_LSB_MASK   (0xF << FP_CTRL_NUM_CODE_LSB_SHIFT)
-/*  Number of instruction literal address comparators.  Read only */
-#define FP_CTRL_NUM_LIT_SHIFT       8
-#define FP_CTRL_NUM_LIT_MASK        (0xF << FP_CTRL_NUM_LIT_SHIFT)
-/*  This Key field must be set to 1 when writing or the write will be ignored. */
-#define FP_CTRL_KEY                 (1 << 1)
-/*  Enable bit for the FPB.  Set to 1 to enable FPB. */
-#define FP_CTRL_ENABLE              1
-
-/* FlashPatch Comparator Register Bits. */
-/*  Defines the behaviour for code address comparators. */
-#define FP_COMP_REPLACE_SHIFT       30
-#define FP_COMP_REPLACE_MASK        (0x3U << FP_COMP_REPLACE_SHIFT)
-/*      Remap to specified address in SRAM. */
-#define FP_COMP_REPLACE_REMAP       (0x0U << FP_COMP_REPLACE_SHIFT)
-/*      Breakpoint on lower halfword. */
-#define FP_COMP_REPLACE_BREAK_LOWER (0x1U << FP_COMP_REPLACE_SHIFT)
-/*      Breakpoint on upper halfword. */
-#define FP_COMP_REPLACE_BREAK_UPPER (0x2U << FP_COMP_REPLACE_SHIFT)
-/*      Breakpoint on word. */
-#define FP_COMP_REPLACE_BREAK       (0x3U << FP_COMP_REPLACE_SHIFT)
-/*  Specified bits 28:2 of the address to be use for match on this comparator. */
-#define FP_COMP_COMP_SHIFT          2
-#define FP_COMP_COMP_MASK           (0x07FFFFFF << FP_COMP_COMP_SHIFT)
-/*  Enables this comparator.  Set to 1 to enable. */
-#define FP_COMP_ENABLE              1
 
 /* FPB - Flash Patch Breakpoint Routines. */
-static __INLINE uint32_t getFPBCodeComparatorCount(void)
-{
-    uint32_t    controlValue = FPB->CTRL;
-    return (((controlValue & FP_CTRL_NUM_CODE_MSB_MASK) >> 8) |
-            ((controlValue & FP_CTRL_NUM_CODE_LSB_MASK) >> 4));
-}
-
-static __INLINE uint32_t getFPBLiteralComparatorCount(void)
-{
-    uint32_t    controlValue = FPB->CTRL;
-    return ((controlValue & FP_CTRL_NUM_LIT_MASK) >> FP_CTRL_NUM_LIT_SHIFT);
-}
-
-static __INLINE void clearFPBComparator(uint32_t* pComparator)
-{
-    *pComparator = 0;
-}
-
-static __INLINE int isAddressInUpperHalfGig(uint32_t address)
-{
-    return (int)(address & 0xE0000000);
-}
-
-static __INLINE int isAddressOdd(uint32_t address)
-{
-    return (int)(address & 0x1);
-}
-
-static __INLINE int isBreakpointAddressInvalid(uint32_t breakpointAddress)
-{
-     return (isAddressInUpperHalfGig(breakpointAddress) || isAddressOdd(breakpointAddress));
-}
-
-static __INLINE int isAddressInUpperHalfword(uint32_t address)
-{
-    return (int)(address & 0x2);
-}
-
-static __INLINE uint32_t calculateFPBComparatorReplaceValue(uint32_t breakpointAddress, int32_t is32BitInstruction)
-{
-    if (is32BitInstruction)
-        return FP_COMP_REPLACE_BREAK;
-    else if (isAddressInUpperHalfword(breakpointAddress))
-        return FP_COMP_REPLACE_BREAK_UPPER;
-    else
-        return FP_COMP_REPLACE_BREAK_LOWER;
-}
-
-static __INLINE uint32_t calculateFPBComparatorValue(uint32_t breakpointAddress, int32_t is32BitInstruction)
-{
-    uint32_t    comparatorValue;
-    
-    if (isBreakpointAddressInvalid(breakpointAddress))
-    {
-        /* Can only set a breakpoint on addresses where the upper 3-bits are all 0 (upper 0.5GB is off limits) and 
-           the address is half-word aligned */
-        return (uint32_t)~0U;
-    }
-    
-    comparatorValue = (breakpointAddress & FP_COMP_COMP_MASK);
-    comparatorValue |= FP_COMP_ENABLE;
-    comparatorValue |= calculateFPBComparatorReplaceValue(breakpointAddress, is32BitInstruction);
-    
-    return comparatorValue;
-}
-
-static __INLINE uint32_t maskOffFPBComparatorReservedBits(uint32_t comparatorValue)
-{
-    return (comparatorValue & (FP_COMP_REPLACE_MASK | FP_COMP_COMP_MASK | FP_COMP_ENABLE));
-}
-
-static __INLINE int isFPBComparatorEnabled(uint32_t comparator)
-{
-    return (int)(comparator & FP_COMP_ENABLE);
-}
-
-static __INLINE uint32_t* findFPBBreakpointComparator(uint32_t breakpointAddress, int32_t is32BitInstruction)
-{
-    uint32_t*    pCurrentComparator = FPB_COMP_ARRAY;
-    uint32_t     comparatorValueForThisBreakpoint;
-    uint32_t     codeComparatorCount;
-    uint32_t     i;
-    
-    comparatorValueForThisBreakpoint = calculateFPBComparatorValue(breakpointAddress, is32BitInstruction);
-    codeComparatorCount = getFPBCodeComparatorCount();
-    
-    for (i = 0 ; i < codeComparatorCount ; i++)
-    {
-        uint32_t maskOffReservedBits;
-        
-        maskOffReservedBits = maskOffFPBComparatorReservedBits(*pCurrentComparator);
-        if (comparatorValueForThisBreakpoint == maskOffReservedBits)
-            return pCurrentComparator;
-
-        pCurrentComparator++;
-    }
-    
-    /* Return NULL if no FPB comparator is already enabled for this breakpoint. */
-    return NULL;
-}
-
-static __INLINE uint32_t* findFreeFPBBreakpointComparator(void)
-{
-    uint32_t* pCurrentComparator = FPB_COMP_ARRAY;
-    uint32_t  codeComparatorCount;
-    uint32_t  i;
-    
-    codeComparatorCount = getFPBCodeComparatorCount();
-    for (i = 0 ; i < codeComparatorCount ; i++)
-    {
-        if (!isFPBComparatorEnabled(*pCurrentComparator))
-            return pCurrentComparator;
-
-        pCurrentComparator++;
-    }
-    
-    /* Return NULL if no FPB breakpoint comparators are free. */
-    return NULL;
-}
-
-static __INLINE uint32_t* enableFPBBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction)
-{
-    uint32_t* pExistingFPBBreakpoint;
-    uint32_t* pFreeFPBBreakpointComparator;
-    
-    pExistingFPBBreakpoint = findFPBBreakpointComparator(breakpointAddress, is32BitInstruction);
-    if (pExistingFPBBreakpoint)
-    {
-        /* This breakpoint is already set to just return pointer to existing comparator. */
-        return pExistingFPBBreakpoint;
-    }
-    
-    pFreeFPBBreakpointComparator = findFreeFPBBreakpointComparator();
-    if (!pFreeFPBBreakpointComparator)
-    {
-        /* All FPB breakpoint comparator slots are used so return NULL as error indicator. */
-        return NULL;
-    }
-    
-    
-    *pFreeFPBBreakpointComparator = calculateFPBComparatorValue(breakpointAddress, is32BitInstruction);
-    return pFreeFPBBreakpointComparator;
-}
-
-static __INLINE uint32_t* disableFPBBreakpointComparator(uint32_t breakpointAddress, int32_t is32BitInstruction)
-{
-    uint32_t* pExistingFPBBreakpoint;
-    
-    pExistingFPBBreakpoint = findFPBBreakpointComparator(breakpointAddress, is32BitInstruction);
-    if (pExistingFPBBreakpoint)
-        clearFPBComparator(pExistingFPBBreakpoint);
- 
-    return pExistingFPBBreakpoint;
-}
-
-static __INLINE void clearFPBComparators(void)
-{
-    uint32_t* pCurrentComparator = FPB_COMP_ARRAY;
-    uint32_t  codeComparatorCount;
-    uint32_t  literalComparatorCount;
-    uint32_t  totalComparatorCount;
-    uint32_t  i;
-    
-    codeComparatorCount = getFPBCodeComparatorCount();
-    literalComparatorCount = getFPBLiteralComparatorCount();
-    totalComparatorCount = codeComparatorCount + literalComparatorCount;
-    for (i = 0 ; i < totalComparatorCount ; i++)
-    {
-        clearFPBComparator(pCurrentComparator);
-        pCurrentComparator++;
-    }
-}
-
-static __INLINE void enableFPB(void)
+static __INLINE int isAddressInFPBRemapRegion(uint32_t address)
 {
-    FPB->CTRL |= (FP_CTRL_KEY | FP_CTRL_ENABLE);
+    return (address & FPB_REMAP_REGION_MASK) == FPB_REMAP_REGION_BASE;
 }
 
-static __INLINE void initFPB(void)
+static __INLINE void initFPB(uint32_t* pRemapTable)
 {
-    clearFPBComparators();
-    enableFPB();
+    /* Fall back to breakpoint mode if the remap table didn't get linked into the SRAM region which the FPB can
+       remap to. */
+    if (!isAddressInFPBRemapRegion((uint32_t)pRemapTable))
+        pRemapTable = NULL;
+    FPB_Init(FPB, FPB_COMP_ARRAY, pRemapTable);
 }
 
 
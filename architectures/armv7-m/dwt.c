@@ -0,0 +1,869 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Data Watchpoint and Trace (DWT) unit routines used to set hardware watchpoints and overflow breakpoints. */
+#include <stddef.h>
+#include "dwt.h"
+
+
+/* NUMCOMP is a 4-bit field. */
+#define DWT_MAX_COMPARATORS 15
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    uint32_t function;
+    /* Comparators used by this watchpoint.  The entry is free when this is 0. */
+    uint32_t comparators;
+} DWTRangeWatchpoint;
+
+typedef struct
+{
+    DWTRangeWatchpoint rangeWatchpoints[DWT_MAX_RANGE_WATCHPOINTS];
+    DWT_COMP_Type*     pComparators;
+    uint32_t           comparatorCount;
+    /* Largest block which can be watched by one comparator as limited by the number of implemented MASK bits. */
+    uint32_t           maxBlockSize;
+    uint32_t           matchedComparators;
+    /* Comparators which supply the address for a data value match.  Their FUNCTION is disabled but they are in use. */
+    uint32_t           linkedComparators;
+    /* Comparators owned by range watchpoints.  They are never shared with other watchpoints. */
+    uint32_t           rangeComparators;
+} DWTState;
+
+static DWTState g_dwt;
+
+
+static uint32_t determineMaxBlockSize(void);
+static void     clearComparators(void);
+static void     clearRangeWatchpoints(void);
+void __mriDWT_Init(volatile uint32_t* pControl, DWT_COMP_Type* pComparators)
+{
+    g_dwt.pComparators = pComparators;
+    g_dwt.comparatorCount = *pControl >> DWT_CTRL_NUMCOMP_SHIFT;
+    g_dwt.matchedComparators = 0;
+    g_dwt.linkedComparators = 0;
+    g_dwt.rangeComparators = 0;
+    g_dwt.maxBlockSize = determineMaxBlockSize();
+    clearComparators();
+    clearRangeWatchpoints();
+}
+
+static uint32_t determineMaxBlockSize(void)
+{
+    if (g_dwt.comparatorCount == 0)
+        return 1;
+
+    /* Processor may limit number of bits to be masked off so see how many of them stick. */
+    g_dwt.pComparators->MASK = 0x1F;
+    return 1U << g_dwt.pComparators->MASK;
+}
+
+static uint32_t comparatorIndex(DWT_COMP_Type* pComparator)
+{
+    return (uint32_t)(pComparator - g_dwt.pComparators);
+}
+
+static int isRangeComparator(DWT_COMP_Type* pComparator)
+{
+    return (g_dwt.rangeComparators & (1 << comparatorIndex(pComparator))) != 0;
+}
+
+static void clearComparator(DWT_COMP_Type* pComparatorStruct)
+{
+    g_dwt.linkedComparators &= ~(1 << comparatorIndex(pComparatorStruct));
+    g_dwt.rangeComparators &= ~(1 << comparatorIndex(pComparatorStruct));
+    pComparatorStruct->COMP = 0;
+    pComparatorStruct->MASK = 0;
+    pComparatorStruct->FUNCTION &= ~(DWT_COMP_FUNCTION_DATAVADDR1 |
+                                     DWT_COMP_FUNCTION_DATAVADDR0 |
+                                     DWT_COMP_FUNCTION_DATAVSIZE_MASK |
+                                     DWT_COMP_FUNCTION_DATAVMATCH |
+                                     DWT_COMP_FUNCTION_CYCMATCH |
+                                     DWT_COMP_FUNCTION_EMITRANGE |
+                                     DWT_COMP_FUNCTION_FUNCTION_MASK);
+}
+
+static void clearComparators(void)
+{
+    DWT_COMP_Type*  pComparatorStruct = g_dwt.pComparators;
+    uint32_t        i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        clearComparator(pComparatorStruct);
+        pComparatorStruct++;
+    }
+}
+
+static void clearRangeWatchpoints(void)
+{
+    uint32_t i;
+
+    for (i = 0 ; i < DWT_MAX_RANGE_WATCHPOINTS ; i++)
+        g_dwt.rangeWatchpoints[i].comparators = 0;
+}
+
+
+uint32_t __mriDWT_GetComparatorCount(void)
+{
+    return g_dwt.comparatorCount;
+}
+
+
+static int isValidComparatorSize(uint32_t watchpointSize);
+static int isValidComparatorAddress(uint32_t watchpointAddress, uint32_t watchpointSize);
+static int isValidWatchpointType(uint32_t watchpointType);
+int __mriDWT_IsValidWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType)
+{
+    return isValidComparatorSize(watchpointSize) &&
+           isValidComparatorAddress(watchpointAddress, watchpointSize) &&
+           isValidWatchpointType(watchpointType);
+}
+
+static int isPowerOf2(uint32_t value)
+{
+    return (value & (value - 1)) == 0;
+}
+
+static int isAddressAlignedToSize(uint32_t address, uint32_t size)
+{
+    uint32_t addressMask = ~(size - 1);
+    return address == (address & addressMask);
+}
+
+static int isValidComparatorSize(uint32_t watchpointSize)
+{
+    return isPowerOf2(watchpointSize);
+}
+
+static int isValidComparatorAddress(uint32_t watchpointAddress, uint32_t watchpointSize)
+{
+    return isAddressAlignedToSize(watchpointAddress, watchpointSize);
+}
+
+static int isValidWatchpointType(uint32_t watchpointType)
+{
+    return (watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_READ) ||
+           (watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE) ||
+           (watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE);
+}
+
+
+static DWT_COMP_Type* findComparator(uint32_t address, uint32_t size, uint32_t function);
+static DWT_COMP_Type* allocateComparator(uint32_t address, uint32_t size, uint32_t function);
+DWT_COMP_Type* __mriDWT_SetWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType)
+{
+    if (!__mriDWT_IsValidWatchpoint(watchpointAddress, watchpointSize, watchpointType))
+        return NULL;
+
+    return allocateComparator(watchpointAddress, watchpointSize, watchpointType);
+}
+
+static uint32_t maskOffFunctionBits(uint32_t functionValue)
+{
+    return functionValue & (DWT_COMP_FUNCTION_DATAVADDR1 |
+                            DWT_COMP_FUNCTION_DATAVADDR0 |
+                            DWT_COMP_FUNCTION_DATAVSIZE_MASK |
+                            DWT_COMP_FUNCTION_DATAVMATCH |
+                            DWT_COMP_FUNCTION_CYCMATCH |
+                            DWT_COMP_FUNCTION_EMITRANGE |
+                            DWT_COMP_FUNCTION_FUNCTION_MASK);
+}
+
+static int doesComparatorAddressMatch(DWT_COMP_Type* pComparator, uint32_t address)
+{
+    return pComparator->COMP == address;
+}
+
+static uint32_t calculateLog2(uint32_t value)
+{
+    uint32_t log2 = 0;
+
+    while (value > 1)
+    {
+        value >>= 1;
+        log2++;
+    }
+
+    return log2;
+}
+
+static int doesComparatorMaskMatch(DWT_COMP_Type* pComparator, uint32_t size)
+{
+    return pComparator->MASK == calculateLog2(size);
+}
+
+static int doesComparatorFunctionMatch(DWT_COMP_Type* pComparator, uint32_t function)
+{
+    uint32_t importantFunctionBits = maskOffFunctionBits(pComparator->FUNCTION);
+
+    return importantFunctionBits == function;
+}
+
+static int doesComparatorMatch(DWT_COMP_Type* pComparator, uint32_t address, uint32_t size, uint32_t function)
+{
+    return doesComparatorFunctionMatch(pComparator, function) &&
+           doesComparatorAddressMatch(pComparator, address) &&
+           doesComparatorMaskMatch(pComparator, size);
+}
+
+static DWT_COMP_Type* findComparator(uint32_t address, uint32_t size, uint32_t function)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        if (!isRangeComparator(pCurrentComparator) && doesComparatorMatch(pCurrentComparator, address, size, function))
+            return pCurrentComparator;
+
+        pCurrentComparator++;
+    }
+
+    /* Return NULL if no DWT comparator is already enabled for this address, size, and function. */
+    return NULL;
+}
+
+static int isComparatorFree(DWT_COMP_Type* pComparator)
+{
+    if (g_dwt.linkedComparators & (1 << comparatorIndex(pComparator)))
+        return 0;
+    return (pComparator->FUNCTION & DWT_COMP_FUNCTION_FUNCTION_MASK) == DWT_COMP_FUNCTION_FUNCTION_DISABLED;
+}
+
+static DWT_COMP_Type* findFreeComparatorOtherThan(DWT_COMP_Type* pExcludedComparator)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        if (pCurrentComparator != pExcludedComparator && isComparatorFree(pCurrentComparator))
+            return pCurrentComparator;
+
+        pCurrentComparator++;
+    }
+
+    /* Return NULL if there are no free DWT comparators. */
+    return NULL;
+}
+
+static DWT_COMP_Type* findFreeComparator(void)
+{
+    return findFreeComparatorOtherThan(NULL);
+}
+
+static int attemptToSetComparatorMask(DWT_COMP_Type* pComparator, uint32_t size)
+{
+    uint32_t maskBitCount;
+
+    maskBitCount = calculateLog2(size);
+    pComparator->MASK = maskBitCount;
+
+    /* Processor may limit number of bits to be masked off so check. */
+    return pComparator->MASK == maskBitCount;
+}
+
+static int attemptToSetComparator(DWT_COMP_Type* pComparator, uint32_t address, uint32_t size, uint32_t function)
+{
+    if (!attemptToSetComparatorMask(pComparator, size))
+        return 0;
+
+    pComparator->COMP = address;
+    pComparator->FUNCTION = function;
+    return 1;
+}
+
+static DWT_COMP_Type* allocateComparator(uint32_t address, uint32_t size, uint32_t function)
+{
+    DWT_COMP_Type* pComparator = NULL;
+
+    pComparator = findComparator(address, size, function);
+    if (pComparator)
+    {
+        /* This comparator has already been set so return a pointer to it. */
+        return pComparator;
+    }
+
+    pComparator = findFreeComparator();
+    if (!pComparator)
+    {
+        /* There are no free comparators left. */
+        return NULL;
+    }
+
+    if (!attemptToSetComparator(pComparator, address, size, function))
+    {
+        /* Failed set due to the size being larger than supported by CPU. */
+        return NULL;
+    }
+
+    /* Successfully configured a free comparator. */
+    return pComparator;
+}
+
+
+static DWT_COMP_Type* releaseComparator(uint32_t address, uint32_t size, uint32_t function);
+DWT_COMP_Type* __mriDWT_ClearWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType)
+{
+    if (!__mriDWT_IsValidWatchpoint(watchpointAddress, watchpointSize, watchpointType))
+        return NULL;
+
+    return releaseComparator(watchpointAddress, watchpointSize, watchpointType);
+}
+
+static DWT_COMP_Type* releaseComparator(uint32_t address, uint32_t size, uint32_t function)
+{
+    DWT_COMP_Type* pComparator = NULL;
+
+    pComparator = findComparator(address, size, function);
+    if (!pComparator)
+    {
+        /* This comparator isn't set so return NULL. */
+        return NULL;
+    }
+
+    clearComparator(pComparator);
+    return pComparator;
+}
+
+
+static uint32_t largestBlockSize(uint32_t address, uint32_t size);
+uint32_t __mriDWT_DecomposeRange(uint32_t address, uint32_t size, DWT_Block* pBlocks, uint32_t maxBlocks)
+{
+    uint32_t blockCount = 0;
+
+    while (size > 0)
+    {
+        uint32_t blockSize = largestBlockSize(address, size);
+
+        /* Return 0 if it would take more than maxBlocks to exactly cover this range. */
+        if (blockCount == maxBlocks)
+            return 0;
+        pBlocks[blockCount].address = address;
+        pBlocks[blockCount].size = blockSize;
+        blockCount++;
+
+        address += blockSize;
+        size -= blockSize;
+    }
+
+    return blockCount;
+}
+
+static uint32_t largestBlockSize(uint32_t address, uint32_t size)
+{
+    uint32_t blockSize = g_dwt.maxBlockSize;
+
+    /* Taking the largest aligned block at each step gives the fewest blocks. */
+    while (blockSize > size || !isAddressAlignedToSize(address, blockSize))
+        blockSize >>= 1;
+
+    return blockSize;
+}
+
+
+static int      findHighestAlignedBoundary(uint32_t firstAddress, uint32_t lastAddress, uint32_t* pBoundary);
+static uint32_t roundUpToPowerOf2(uint32_t value);
+static uint32_t calculateEnclosingBlockSize(uint32_t firstAddress, uint32_t lastAddress);
+uint32_t __mriDWT_CoverRange(uint32_t address, uint32_t size, DWT_Block* pBlocks, uint32_t maxBlocks)
+{
+    uint32_t lastAddress = address + size - 1;
+    uint32_t enclosingSize = calculateEnclosingBlockSize(address, lastAddress);
+    uint32_t boundary;
+
+    if (maxBlocks >= 2 && findHighestAlignedBoundary(address, lastAddress, &boundary))
+    {
+        uint32_t lowerSize = roundUpToPowerOf2(boundary - address);
+        uint32_t upperSize = roundUpToPowerOf2(lastAddress - boundary + 1);
+
+        /* Two blocks which meet at the most aligned address in the range waste less than one enclosing block. */
+        if (lowerSize <= g_dwt.maxBlockSize && upperSize <= g_dwt.maxBlockSize &&
+            (enclosingSize == 0 || lowerSize + upperSize < enclosingSize))
+        {
+            pBlocks[0].address = boundary - lowerSize;
+            pBlocks[0].size = lowerSize;
+            pBlocks[1].address = boundary;
+            pBlocks[1].size = upperSize;
+            return 2;
+        }
+    }
+
+    if (maxBlocks == 0 || enclosingSize == 0 || enclosingSize > g_dwt.maxBlockSize)
+        return 0;
+    pBlocks[0].address = address & ~(enclosingSize - 1);
+    pBlocks[0].size = enclosingSize;
+    return 1;
+}
+
+static int findHighestAlignedBoundary(uint32_t firstAddress, uint32_t lastAddress, uint32_t* pBoundary)
+{
+    uint32_t alignment;
+
+    for (alignment = 0x80000000 ; alignment > 1 ; alignment >>= 1)
+    {
+        uint32_t boundary = lastAddress & ~(alignment - 1);
+
+        if (boundary > firstAddress)
+        {
+            *pBoundary = boundary;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static uint32_t roundUpToPowerOf2(uint32_t value)
+{
+    uint32_t powerOf2 = 1;
+
+    while (powerOf2 < value)
+        powerOf2 <<= 1;
+
+    return powerOf2;
+}
+
+static uint32_t calculateEnclosingBlockSize(uint32_t firstAddress, uint32_t lastAddress)
+{
+    uint32_t blockSize = 1;
+
+    /* Returns 0 if only the whole 4GB address space encloses the range. */
+    while (blockSize != 0 && (firstAddress & ~(blockSize - 1)) != (lastAddress & ~(blockSize - 1)))
+        blockSize <<= 1;
+
+    return blockSize;
+}
+
+
+int __mriDWT_IsValidRangeWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType)
+{
+    return watchpointSize > 0 &&
+           watchpointAddress + (watchpointSize - 1) >= watchpointAddress &&
+           isValidWatchpointType(watchpointType);
+}
+
+
+static DWTRangeWatchpoint* findRangeWatchpoint(uint32_t address, uint32_t size, uint32_t function);
+static DWTRangeWatchpoint* findFreeRangeWatchpoint(void);
+static uint32_t            countFreeComparators(void);
+static DWT_COMP_Type*      allocateRangeComparators(DWTRangeWatchpoint* pRange, DWT_Block* pBlocks, uint32_t blockCount);
+static DWT_COMP_Type*      getFirstRangeComparator(DWTRangeWatchpoint* pRange);
+DWT_COMP_Type* __mriDWT_SetRangeWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize,
+                                           uint32_t watchpointType)
+{
+    DWT_Block           blocks[DWT_MAX_COMPARATORS];
+    DWTRangeWatchpoint* pRange;
+    uint32_t            freeCount;
+    uint32_t            blockCount;
+
+    if (!__mriDWT_IsValidRangeWatchpoint(watchpointAddress, watchpointSize, watchpointType))
+        return NULL;
+
+    pRange = findRangeWatchpoint(watchpointAddress, watchpointSize, watchpointType);
+    if (pRange)
+        return getFirstRangeComparator(pRange);
+    pRange = findFreeRangeWatchpoint();
+    if (!pRange)
+        return NULL;
+
+    freeCount = countFreeComparators();
+    blockCount = __mriDWT_DecomposeRange(watchpointAddress, watchpointSize, blocks, freeCount);
+    if (blockCount == 0 && watchpointType == DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE)
+        blockCount = __mriDWT_CoverRange(watchpointAddress, watchpointSize, blocks, freeCount);
+    if (blockCount == 0)
+        return NULL;
+
+    pRange->address = watchpointAddress;
+    pRange->size = watchpointSize;
+    pRange->function = watchpointType;
+    return allocateRangeComparators(pRange, blocks, blockCount);
+}
+
+static DWTRangeWatchpoint* findRangeWatchpoint(uint32_t address, uint32_t size, uint32_t function)
+{
+    uint32_t i;
+
+    for (i = 0 ; i < DWT_MAX_RANGE_WATCHPOINTS ; i++)
+    {
+        DWTRangeWatchpoint* pRange = &g_dwt.rangeWatchpoints[i];
+
+        if (pRange->comparators != 0 &&
+            pRange->address == address &&
+            pRange->size == size &&
+            pRange->function == function)
+        {
+            return pRange;
+        }
+    }
+
+    return NULL;
+}
+
+static DWTRangeWatchpoint* findFreeRangeWatchpoint(void)
+{
+    uint32_t i;
+
+    for (i = 0 ; i < DWT_MAX_RANGE_WATCHPOINTS ; i++)
+    {
+        if (g_dwt.rangeWatchpoints[i].comparators == 0)
+            return &g_dwt.rangeWatchpoints[i];
+    }
+
+    return NULL;
+}
+
+static uint32_t countFreeComparators(void)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       freeCount = 0;
+    uint32_t       i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount && freeCount < DWT_MAX_COMPARATORS ; i++)
+    {
+        if (isComparatorFree(pCurrentComparator))
+            freeCount++;
+        pCurrentComparator++;
+    }
+
+    return freeCount;
+}
+
+static void releaseRangeComparators(DWTRangeWatchpoint* pRange);
+static DWT_COMP_Type* allocateRangeComparators(DWTRangeWatchpoint* pRange, DWT_Block* pBlocks, uint32_t blockCount)
+{
+    uint32_t i;
+
+    for (i = 0 ; i < blockCount ; i++)
+    {
+        DWT_COMP_Type* pComparator = findFreeComparator();
+        uint32_t       bit = 1 << comparatorIndex(pComparator);
+
+        if (!attemptToSetComparator(pComparator, pBlocks[i].address, pBlocks[i].size, pRange->function))
+        {
+            /* Failed set due to the size being larger than supported by CPU. */
+            clearComparator(pComparator);
+            releaseRangeComparators(pRange);
+            return NULL;
+        }
+        pRange->comparators |= bit;
+        g_dwt.rangeComparators |= bit;
+    }
+
+    return getFirstRangeComparator(pRange);
+}
+
+static void releaseRangeComparators(DWTRangeWatchpoint* pRange)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        if (pRange->comparators & (1 << i))
+            clearComparator(pCurrentComparator);
+        pCurrentComparator++;
+    }
+    pRange->comparators = 0;
+}
+
+static DWT_COMP_Type* getFirstRangeComparator(DWTRangeWatchpoint* pRange)
+{
+    uint32_t i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        if (pRange->comparators & (1 << i))
+            return &g_dwt.pComparators[i];
+    }
+
+    return NULL;
+}
+
+
+DWT_COMP_Type* __mriDWT_ClearRangeWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize,
+                                             uint32_t watchpointType)
+{
+    DWTRangeWatchpoint* pRange;
+    DWT_COMP_Type*      pFirstComparator;
+
+    pRange = findRangeWatchpoint(watchpointAddress, watchpointSize, watchpointType);
+    if (!pRange)
+        return NULL;
+
+    pFirstComparator = getFirstRangeComparator(pRange);
+    releaseRangeComparators(pRange);
+    return pFirstComparator;
+}
+
+
+static int            isValidValueWatchpoint(uint32_t address, uint32_t size, uint32_t function);
+static DWT_COMP_Type* findValueComparator(uint32_t address, uint32_t size, uint32_t value, uint32_t function);
+static DWT_COMP_Type* findFreeValueComparator(void);
+static uint32_t       replicateValue(uint32_t value, uint32_t size);
+static uint32_t       calculateValueFunction(uint32_t size, uint32_t addressIndex, uint32_t function);
+DWT_COMP_Type* __mriDWT_SetValueWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t value,
+                                           uint32_t watchpointType)
+{
+    DWT_COMP_Type* pValueComparator;
+    DWT_COMP_Type* pAddressComparator;
+    uint32_t       addressIndex;
+
+    if (!isValidValueWatchpoint(watchpointAddress, watchpointSize, watchpointType))
+        return NULL;
+
+    pValueComparator = findValueComparator(watchpointAddress, watchpointSize, value, watchpointType);
+    if (pValueComparator)
+        return pValueComparator;
+
+    pValueComparator = findFreeValueComparator();
+    if (!pValueComparator)
+        return NULL;
+    pAddressComparator = findFreeComparatorOtherThan(pValueComparator);
+    if (!pAddressComparator)
+        return NULL;
+
+    addressIndex = comparatorIndex(pAddressComparator);
+    pAddressComparator->COMP = watchpointAddress;
+    pAddressComparator->MASK = 0;
+    g_dwt.linkedComparators |= 1 << addressIndex;
+
+    pValueComparator->COMP = replicateValue(value, watchpointSize);
+    pValueComparator->MASK = 0;
+    pValueComparator->FUNCTION = calculateValueFunction(watchpointSize, addressIndex, watchpointType);
+    return pValueComparator;
+}
+
+static int isValidValueWatchpoint(uint32_t address, uint32_t size, uint32_t function)
+{
+    return (size == 1 || size == 2 || size == 4) &&
+           isValidComparatorAddress(address, size) &&
+           isValidWatchpointType(function);
+}
+
+static DWT_COMP_Type* getLinkedComparator(DWT_COMP_Type* pValueComparator)
+{
+    uint32_t index = (pValueComparator->FUNCTION & DWT_COMP_FUNCTION_DATAVADDR0) >> DWT_COMP_FUNCTION_DATAVADDR0_SHIFT;
+
+    return &g_dwt.pComparators[index];
+}
+
+static DWT_COMP_Type* findValueComparator(uint32_t address, uint32_t size, uint32_t value, uint32_t function)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        uint32_t linkedIndex = (pCurrentComparator->FUNCTION & DWT_COMP_FUNCTION_DATAVADDR0) >>
+                               DWT_COMP_FUNCTION_DATAVADDR0_SHIFT;
+
+        if (maskOffFunctionBits(pCurrentComparator->FUNCTION) == calculateValueFunction(size, linkedIndex, function) &&
+            pCurrentComparator->COMP == replicateValue(value, size) &&
+            getLinkedComparator(pCurrentComparator)->COMP == address)
+        {
+            return pCurrentComparator;
+        }
+
+        pCurrentComparator++;
+    }
+
+    return NULL;
+}
+
+static int doesComparatorSupportValueMatch(DWT_COMP_Type* pComparator)
+{
+    int isSupported;
+
+    /* DATAVMATCH reads as zero on comparators which can't match data values (all but comparator 1 on Cortex-M3
+       and Cortex-M4). */
+    pComparator->FUNCTION = DWT_COMP_FUNCTION_DATAVMATCH;
+    isSupported = (pComparator->FUNCTION & DWT_COMP_FUNCTION_DATAVMATCH) != 0;
+    pComparator->FUNCTION = DWT_COMP_FUNCTION_FUNCTION_DISABLED;
+
+    return isSupported;
+}
+
+static DWT_COMP_Type* findFreeValueComparator(void)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        if (isComparatorFree(pCurrentComparator) && doesComparatorSupportValueMatch(pCurrentComparator))
+            return pCurrentComparator;
+
+        pCurrentComparator++;
+    }
+
+    return NULL;
+}
+
+static uint32_t replicateValue(uint32_t value, uint32_t size)
+{
+    /* Byte and halfword values must be repeated across the whole COMP register. */
+    switch (size)
+    {
+    case 1:
+        return (value & 0xFF) * 0x01010101;
+    case 2:
+        return (value & 0xFFFF) * 0x00010001;
+    default:
+        return value;
+    }
+}
+
+static uint32_t calculateValueFunction(uint32_t size, uint32_t addressIndex, uint32_t function)
+{
+    uint32_t valueSize;
+
+    switch (size)
+    {
+    case 1:
+        valueSize = DWT_COMP_FUNCTION_DATAVSIZE_BYTE;
+        break;
+    case 2:
+        valueSize = DWT_COMP_FUNCTION_DATAVSIZE_HALFWORD;
+        break;
+    default:
+        valueSize = DWT_COMP_FUNCTION_DATAVSIZE_WORD;
+        break;
+    }
+
+    /* Only one address comparator is linked so both link fields refer to it. */
+    return DWT_COMP_FUNCTION_DATAVMATCH |
+           valueSize |
+           (addressIndex << DWT_COMP_FUNCTION_DATAVADDR1_SHIFT) |
+           (addressIndex << DWT_COMP_FUNCTION_DATAVADDR0_SHIFT) |
+           function;
+}
+
+
+DWT_COMP_Type* __mriDWT_ClearValueWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t value,
+                                             uint32_t watchpointType)
+{
+    DWT_COMP_Type* pValueComparator;
+
+    if (!isValidValueWatchpoint(watchpointAddress, watchpointSize, watchpointType))
+        return NULL;
+
+    pValueComparator = findValueComparator(watchpointAddress, watchpointSize, value, watchpointType);
+    if (!pValueComparator)
+        return NULL;
+
+    clearComparator(getLinkedComparator(pValueComparator));
+    clearComparator(pValueComparator);
+    return pValueComparator;
+}
+
+
+/* Instruction breakpoints use a PC match comparator on a single halfword aligned address. */
+#define BREAKPOINT_SIZE 1
+
+static int isBreakpointAddressInvalid(uint32_t breakpointAddress);
+DWT_COMP_Type* __mriDWT_FindBreakpoint(uint32_t breakpointAddress)
+{
+    if (isBreakpointAddressInvalid(breakpointAddress))
+        return NULL;
+
+    return findComparator(breakpointAddress, BREAKPOINT_SIZE, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION);
+}
+
+static int isBreakpointAddressInvalid(uint32_t breakpointAddress)
+{
+    return (int)(breakpointAddress & 0x1);
+}
+
+
+DWT_COMP_Type* __mriDWT_SetBreakpoint(uint32_t breakpointAddress)
+{
+    if (isBreakpointAddressInvalid(breakpointAddress))
+        return NULL;
+
+    return allocateComparator(breakpointAddress, BREAKPOINT_SIZE, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION);
+}
+
+
+DWT_COMP_Type* __mriDWT_ClearBreakpoint(uint32_t breakpointAddress)
+{
+    if (isBreakpointAddressInvalid(breakpointAddress))
+        return NULL;
+
+    return releaseComparator(breakpointAddress, BREAKPOINT_SIZE, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION);
+}
+
+
+void __mriDWT_LatchMatchedComparators(void)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    /* Reading FUNCTION clears MATCHED so this also discards matches left over from earlier debug events. */
+    g_dwt.matchedComparators = 0;
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        if (pCurrentComparator->FUNCTION & DWT_COMP_FUNCTION_MATCHED)
+            g_dwt.matchedComparators |= 1 << i;
+        pCurrentComparator++;
+    }
+}
+
+
+static int wasRangeWatchpointMatched(uint32_t watchpointAddress);
+int __mriDWT_WasWatchpointMatched(uint32_t watchpointAddress)
+{
+    DWT_COMP_Type* pCurrentComparator = g_dwt.pComparators;
+    uint32_t       i;
+
+    if (wasRangeWatchpointMatched(watchpointAddress))
+        return 1;
+
+    for (i = 0 ; i < g_dwt.comparatorCount ; i++)
+    {
+        uint32_t address = pCurrentComparator->COMP;
+
+        /* A data value match is reported on the comparator holding the value rather than the address. */
+        if (pCurrentComparator->FUNCTION & DWT_COMP_FUNCTION_DATAVMATCH)
+            address = getLinkedComparator(pCurrentComparator)->COMP;
+        if ((g_dwt.matchedComparators & (1 << i)) &&
+            !isRangeComparator(pCurrentComparator) &&
+            address == watchpointAddress &&
+            isValidWatchpointType(pCurrentComparator->FUNCTION & DWT_COMP_FUNCTION_FUNCTION_MASK))
+        {
+            return 1;
+        }
+        pCurrentComparator++;
+    }
+
+    return 0;
+}
+
+static int wasRangeWatchpointMatched(uint32_t watchpointAddress)
+{
+    uint32_t i;
+
+    /* Any of the comparators covering the range can report the match. */
+    for (i = 0 ; i < DWT_MAX_RANGE_WATCHPOINTS ; i++)
+    {
+        DWTRangeWatchpoint* pRange = &g_dwt.rangeWatchpoints[i];
+
+        if ((pRange->comparators & g_dwt.matchedComparators) && pRange->address == watchpointAddress)
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Data Watchpoint and Trace (DWT) unit routines used to set hardware watchpoints and overflow breakpoints. */
+#ifndef _DWT_H_
+#define _DWT_H_
+
+#include <stdint.h>
+
+/* Data Watchpoint and Trace Registers */
+typedef struct
+{
+    /* Comparator register. */
+    volatile uint32_t   COMP;
+    /* Comparator Mask register. */
+    volatile uint32_t   MASK;
+    /* Comparator Function register. */
+    volatile uint32_t   FUNCTION;
+    /* Reserved 4 bytes to pad struct size out to 16 bytes. */
+    volatile uint32_t   Reserved;
+} DWT_COMP_Type;
+
+/* Data Watchpoint and Trace Control Register Bits. */
+/*  Number of comparators implemented.  Read-only */
+#define DWT_CTRL_NUMCOMP_SHIFT                  28
+
+/* Data Watchpoint and Trace Comparator Function Bits. */
+/*  Matched.  Read-only.  Set to 1 to indicate that this comparator has been matched.  Cleared on read. */
+#define DWT_COMP_FUNCTION_MATCHED               (1 << 24)
+/*  Data Address Linked Index 1. */
+#define DWT_COMP_FUNCTION_DATAVADDR1_SHIFT      16
+#define DWT_COMP_FUNCTION_DATAVADDR1            (0xF << DWT_COMP_FUNCTION_DATAVADDR1_SHIFT)
+/*  Data Address Linked Index 0. */
+#define DWT_COMP_FUNCTION_DATAVADDR0_SHIFT      12
+#define DWT_COMP_FUNCTION_DATAVADDR0            (0xF << DWT_COMP_FUNCTION_DATAVADDR0_SHIFT)
+/*  Selects size for data value matches. */
+#define DWT_COMP_FUNCTION_DATAVSIZE_MASK        (3 << 10)
+/*      Byte */
+#define DWT_COMP_FUNCTION_DATAVSIZE_BYTE        (0 << 10)
+/*      Halfword */
+#define DWT_COMP_FUNCTION_DATAVSIZE_HALFWORD    (1 << 10)
+/*      Word */
+#define DWT_COMP_FUNCTION_DATAVSIZE_WORD        (2 << 10)
+/*  Data Value Match.  Set to 0 for address compare and 1 for data value compare. */
+#define DWT_COMP_FUNCTION_DATAVMATCH            (1 << 8)
+/*  Cycle Count Match.  Set to 1 for enabling cycle count match and 0 otherwise.  Only valid on comparator 0. */
+#define DWT_COMP_FUNCTION_CYCMATCH              (1 << 7)
+/*  Enable Data Trace Address offset packets.  0 to disable. */
+#define DWT_COMP_FUNCTION_EMITRANGE             (1 << 5)
+/*  Selects action to be taken on match. */
+#define DWT_COMP_FUNCTION_FUNCTION_MASK             0xF
+/*      Disabled */
+#define DWT_COMP_FUNCTION_FUNCTION_DISABLED         0x0
+/*      Instruction Watchpoint */
+#define DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION      0x4
+/*      Data Read Watchpoint */
+#define DWT_COMP_FUNCTION_FUNCTION_DATA_READ        0x5
+/*      Data Write Watchpoint */
+#define DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE       0x6
+/*      Data Read/Write Watchpoint */
+#define DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE   0x7
+
+/* Naturally aligned, power of 2 sized block of memory which a single comparator can watch. */
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+} DWT_Block;
+
+/* Maximum number of data watchpoints which can be spread over several comparators at once. */
+#define DWT_MAX_RANGE_WATCHPOINTS               4
+
+
+/* Watchpoints and instruction (PC match) breakpoints are allocated from the same pool of comparators. */
+void           __mriDWT_Init(volatile uint32_t* pControl, DWT_COMP_Type* pComparators);
+uint32_t       __mriDWT_GetComparatorCount(void);
+int            __mriDWT_IsValidWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType);
+DWT_COMP_Type* __mriDWT_SetWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType);
+DWT_COMP_Type* __mriDWT_ClearWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t watchpointType);
+/* Watchpoints on ranges of any size and alignment are split into the fewest blocks which exactly cover the range.
+   Write watchpoints which need more comparators than are free fall back to one or two larger blocks which also cover
+   some neighbouring bytes.  gdb ignores those false hits since it resumes when the watched value hasn't changed.
+   The comparators are allocated and freed together as a single watchpoint and the first one is returned. */
+uint32_t       __mriDWT_DecomposeRange(uint32_t address, uint32_t size, DWT_Block* pBlocks, uint32_t maxBlocks);
+uint32_t       __mriDWT_CoverRange(uint32_t address, uint32_t size, DWT_Block* pBlocks, uint32_t maxBlocks);
+int            __mriDWT_IsValidRangeWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize,
+                                               uint32_t watchpointType);
+DWT_COMP_Type* __mriDWT_SetRangeWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize,
+                                           uint32_t watchpointType);
+DWT_COMP_Type* __mriDWT_ClearRangeWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize,
+                                             uint32_t watchpointType);
+/* Data value watchpoints take a comparator which supports DATAVMATCH to hold the value and a second comparator linked
+   to it which holds the address.  They return the value comparator. */
+DWT_COMP_Type* __mriDWT_SetValueWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t value,
+                                           uint32_t watchpointType);
+DWT_COMP_Type* __mriDWT_ClearValueWatchpoint(uint32_t watchpointAddress, uint32_t watchpointSize, uint32_t value,
+                                             uint32_t watchpointType);
+DWT_COMP_Type* __mriDWT_FindBreakpoint(uint32_t breakpointAddress);
+DWT_COMP_Type* __mriDWT_SetBreakpoint(uint32_t breakpointAddress);
+DWT_COMP_Type* __mriDWT_ClearBreakpoint(uint32_t breakpointAddress);
+/* The MATCHED bits are cleared when read so they are latched once per debug event and then queried. */
+void           __mriDWT_LatchMatchedComparators(void);
+int            __mriDWT_WasWatchpointMatched(uint32_t watchpointAddress);
+
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define DWT_Init                    __mriDWT_Init
+#define DWT_GetComparatorCount      __mriDWT_GetComparatorCount
+#define DWT_IsValidWatchpoint       __mriDWT_IsValidWatchpoint
+#define DWT_SetWatchpoint           __mriDWT_SetWatchpoint
+#define DWT_ClearWatchpoint         __mriDWT_ClearWatchpoint
+#define DWT_DecomposeRange          __mriDWT_DecomposeRange
+#define DWT_CoverRange              __mriDWT_CoverRange
+#define DWT_IsValidRangeWatchpoint  __mriDWT_IsValidRangeWatchpoint
+#define DWT_SetRangeWatchpoint      __mriDWT_SetRangeWatchpoint
+#define DWT_ClearRangeWatchpoint    __mriDWT_ClearRangeWatchpoint
+#define DWT_SetValueWatchpoint      __mriDWT_SetValueWatchpoint
+#define DWT_ClearValueWatchpoint    __mriDWT_ClearValueWatchpoint
+#define DWT_FindBreakpoint          __mriDWT_FindBreakpoint
+#define DWT_SetBreakpoint           __mriDWT_SetBreakpoint
+#define DWT_ClearBreakpoint         __mriDWT_ClearBreakpoint
+#define DWT_LatchMatchedComparators __mriDWT_LatchMatchedComparators
+#define DWT_WasWatchpointMatched    __mriDWT_WasWatchpointMatched
+
+#endif /* _DWT_H_ */
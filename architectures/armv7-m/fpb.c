@@ -0,0 +1,384 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Flash Patch and Breakpoint (FPB) unit routines used to set hardware breakpoints. */
+#include <stddef.h>
+#include <string.h>
+#include "fpb.h"
+
+
+/* Thumb BKPT #0 instruction patched into remap table entries. */
+#define BKPT_INSTRUCTION        0xbe00U
+
+/* Bits used in FPBState::breakpointHalfwords[] to track which halfwords of a remapped word have breakpoints. */
+#define LOWER_HALFWORD          (1 << 0)
+#define UPPER_HALFWORD          (1 << 1)
+
+typedef struct
+{
+    FPB_Type* pFPB;
+    uint32_t* pComparators;
+    uint32_t* pRemapTable;
+    uint32_t  codeComparatorCount;
+    uint32_t  originalWords[FPB_REMAP_TABLE_ENTRIES];
+    uint8_t   breakpointHalfwords[FPB_REMAP_TABLE_ENTRIES];
+} FPBState;
+
+static FPBState g_fpb;
+
+
+static uint32_t getCodeComparatorCount(void);
+static uint32_t getLiteralComparatorCount(void);
+static void     clearComparators(void);
+static void     clearComparator(uint32_t* pComparator);
+static int      canUseRemapTable(uint32_t* pRemapTable);
+static void     initRemapTable(uint32_t* pRemapTable);
+static void     enableFPB(void);
+void __mriFPB_Init(FPB_Type* pFPB, uint32_t* pComparators, uint32_t* pRemapTable)
+{
+    memset(&g_fpb, 0, sizeof(g_fpb));
+    g_fpb.pFPB = pFPB;
+    g_fpb.pComparators = pComparators;
+    g_fpb.codeComparatorCount = getCodeComparatorCount();
+
+    clearComparators();
+    if (canUseRemapTable(pRemapTable))
+        initRemapTable(pRemapTable);
+    enableFPB();
+}
+
+static uint32_t getCodeComparatorCount(void)
+{
+    uint32_t    controlValue = g_fpb.pFPB->CTRL;
+    return (((controlValue & FP_CTRL_NUM_CODE_MSB_MASK) >> 8) |
+            ((controlValue & FP_CTRL_NUM_CODE_LSB_MASK) >> 4));
+}
+
+static uint32_t getLiteralComparatorCount(void)
+{
+    uint32_t    controlValue = g_fpb.pFPB->CTRL;
+    return ((controlValue & FP_CTRL_NUM_LIT_MASK) >> FP_CTRL_NUM_LIT_SHIFT);
+}
+
+static void clearComparators(void)
+{
+    uint32_t* pCurrentComparator = g_fpb.pComparators;
+    uint32_t  totalComparatorCount;
+    uint32_t  i;
+
+    totalComparatorCount = g_fpb.codeComparatorCount + getLiteralComparatorCount();
+    for (i = 0 ; i < totalComparatorCount ; i++)
+    {
+        clearComparator(pCurrentComparator);
+        pCurrentComparator++;
+    }
+}
+
+static void clearComparator(uint32_t* pComparator)
+{
+    *pComparator = 0;
+}
+
+static int canUseRemapTable(uint32_t* pRemapTable)
+{
+    return pRemapTable &&
+           (g_fpb.pFPB->REMAP & FP_REMAP_RMPSPT) &&
+           g_fpb.codeComparatorCount + getLiteralComparatorCount() <= FPB_REMAP_TABLE_ENTRIES;
+}
+
+static void initRemapTable(uint32_t* pRemapTable)
+{
+    /* The literal comparators only remap data loads and not instruction fetches so they are left disabled and
+       their entries at the end of the table are unused. */
+    memset(pRemapTable, 0, FPB_REMAP_TABLE_ENTRIES * sizeof(*pRemapTable));
+    g_fpb.pRemapTable = pRemapTable;
+    g_fpb.pFPB->REMAP = (uint32_t)(size_t)pRemapTable & FP_REMAP_REMAP_MASK;
+}
+
+static void enableFPB(void)
+{
+    g_fpb.pFPB->CTRL |= (FP_CTRL_KEY | FP_CTRL_ENABLE);
+}
+
+
+int __mriFPB_IsRemapEnabled(void)
+{
+    return g_fpb.pRemapTable != NULL;
+}
+
+
+static int       isBreakpointAddressInvalid(uint32_t breakpointAddress);
+static uint32_t* setRemapBreakpoint(uint32_t breakpointAddress);
+static uint32_t* setBreakModeBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction);
+uint32_t* __mriFPB_SetBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction)
+{
+    if (isBreakpointAddressInvalid(breakpointAddress))
+        return NULL;
+
+    if (g_fpb.pRemapTable)
+        return setRemapBreakpoint(breakpointAddress);
+    else
+        return setBreakModeBreakpoint(breakpointAddress, is32BitInstruction);
+}
+
+static int isAddressInUpperHalfGig(uint32_t address)
+{
+    return (int)(address & 0xE0000000);
+}
+
+static int isAddressOdd(uint32_t address)
+{
+    return (int)(address & 0x1);
+}
+
+static int isBreakpointAddressInvalid(uint32_t breakpointAddress)
+{
+    /* Can only set a breakpoint on addresses where the upper 3-bits are all 0 (upper 0.5GB is off limits) and
+       the address is half-word aligned */
+    return (isAddressInUpperHalfGig(breakpointAddress) || isAddressOdd(breakpointAddress));
+}
+
+static uint32_t* findRemapComparator(uint32_t breakpointAddress);
+static uint32_t* allocateRemapComparator(uint32_t breakpointAddress);
+static uint32_t  getComparatorIndex(uint32_t* pComparator);
+static uint8_t   getHalfwordBit(uint32_t breakpointAddress);
+static void      updateRemapTableEntry(uint32_t comparatorIndex);
+static uint32_t* setRemapBreakpoint(uint32_t breakpointAddress)
+{
+    uint32_t* pComparator;
+    uint32_t  comparatorIndex;
+
+    /* Breakpoints in the same word share a single comparator and its remap table entry. */
+    pComparator = findRemapComparator(breakpointAddress);
+    if (!pComparator)
+        pComparator = allocateRemapComparator(breakpointAddress);
+    if (!pComparator)
+        return NULL;
+
+    comparatorIndex = getComparatorIndex(pComparator);
+    g_fpb.breakpointHalfwords[comparatorIndex] |= getHalfwordBit(breakpointAddress);
+    updateRemapTableEntry(comparatorIndex);
+
+    return pComparator;
+}
+
+static int isFPBComparatorEnabled(uint32_t comparator)
+{
+    return (int)(comparator & FP_COMP_ENABLE);
+}
+
+static uint32_t calculateRemapComparatorValue(uint32_t breakpointAddress)
+{
+    return (breakpointAddress & FP_COMP_COMP_MASK) | FP_COMP_REPLACE_REMAP | FP_COMP_ENABLE;
+}
+
+static uint32_t maskOffFPBComparatorReservedBits(uint32_t comparatorValue)
+{
+    return (comparatorValue & (FP_COMP_REPLACE_MASK | FP_COMP_COMP_MASK | FP_COMP_ENABLE));
+}
+
+static uint32_t* findComparatorWithValue(uint32_t comparatorValue)
+{
+    uint32_t* pCurrentComparator = g_fpb.pComparators;
+    uint32_t  i;
+
+    for (i = 0 ; i < g_fpb.codeComparatorCount ; i++)
+    {
+        if (comparatorValue == maskOffFPBComparatorReservedBits(*pCurrentComparator))
+            return pCurrentComparator;
+
+        pCurrentComparator++;
+    }
+
+    /* Return NULL if no FPB comparator is already enabled with this value. */
+    return NULL;
+}
+
+static uint32_t* findRemapComparator(uint32_t breakpointAddress)
+{
+    return findComparatorWithValue(calculateRemapComparatorValue(breakpointAddress));
+}
+
+static uint32_t* findFreeComparator(void)
+{
+    uint32_t* pCurrentComparator = g_fpb.pComparators;
+    uint32_t  i;
+
+    for (i = 0 ; i < g_fpb.codeComparatorCount ; i++)
+    {
+        if (!isFPBComparatorEnabled(*pCurrentComparator))
+            return pCurrentComparator;
+
+        pCurrentComparator++;
+    }
+
+    /* Return NULL if no FPB breakpoint comparators are free. */
+    return NULL;
+}
+
+static uint32_t* allocateRemapComparator(uint32_t breakpointAddress)
+{
+    uint32_t* pComparator;
+    uint32_t  comparatorIndex;
+    uint32_t  wordAddress = breakpointAddress & ~3U;
+
+    pComparator = findFreeComparator();
+    if (!pComparator)
+        return NULL;
+
+    /* Fill in the remap table entry with the original code before the comparator starts redirecting fetches to it. */
+    comparatorIndex = getComparatorIndex(pComparator);
+    g_fpb.originalWords[comparatorIndex] = __mriFPB_ReadCodeWord(wordAddress);
+    g_fpb.breakpointHalfwords[comparatorIndex] = 0;
+    updateRemapTableEntry(comparatorIndex);
+    *pComparator = calculateRemapComparatorValue(breakpointAddress);
+
+    return pComparator;
+}
+
+static uint32_t getComparatorIndex(uint32_t* pComparator)
+{
+    return pComparator - g_fpb.pComparators;
+}
+
+static uint8_t getHalfwordBit(uint32_t breakpointAddress)
+{
+    return (breakpointAddress & 0x2) ? UPPER_HALFWORD : LOWER_HALFWORD;
+}
+
+static void updateRemapTableEntry(uint32_t comparatorIndex)
+{
+    uint32_t remapWord = g_fpb.originalWords[comparatorIndex];
+    uint8_t  halfwords = g_fpb.breakpointHalfwords[comparatorIndex];
+
+    if (halfwords & LOWER_HALFWORD)
+        remapWord = (remapWord & 0xFFFF0000) | BKPT_INSTRUCTION;
+    if (halfwords & UPPER_HALFWORD)
+        remapWord = (remapWord & 0x0000FFFF) | (BKPT_INSTRUCTION << 16);
+    g_fpb.pRemapTable[comparatorIndex] = remapWord;
+}
+
+static int isAddressInUpperHalfword(uint32_t address)
+{
+    return (int)(address & 0x2);
+}
+
+static uint32_t calculateFPBComparatorReplaceValue(uint32_t breakpointAddress, int32_t is32BitInstruction)
+{
+    if (is32BitInstruction)
+        return FP_COMP_REPLACE_BREAK;
+    else if (isAddressInUpperHalfword(breakpointAddress))
+        return FP_COMP_REPLACE_BREAK_UPPER;
+    else
+        return FP_COMP_REPLACE_BREAK_LOWER;
+}
+
+static uint32_t calculateFPBComparatorValue(uint32_t breakpointAddress, int32_t is32BitInstruction)
+{
+    uint32_t    comparatorValue;
+
+    comparatorValue = (breakpointAddress & FP_COMP_COMP_MASK);
+    comparatorValue |= FP_COMP_ENABLE;
+    comparatorValue |= calculateFPBComparatorReplaceValue(breakpointAddress, is32BitInstruction);
+
+    return comparatorValue;
+}
+
+static uint32_t* setBreakModeBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction)
+{
+    uint32_t* pExistingFPBBreakpoint;
+    uint32_t* pFreeFPBBreakpointComparator;
+    uint32_t  comparatorValue;
+
+    comparatorValue = calculateFPBComparatorValue(breakpointAddress, is32BitInstruction);
+    pExistingFPBBreakpoint = findComparatorWithValue(comparatorValue);
+    if (pExistingFPBBreakpoint)
+    {
+        /* This breakpoint is already set to just return pointer to existing comparator. */
+        return pExistingFPBBreakpoint;
+    }
+
+    pFreeFPBBreakpointComparator = findFreeComparator();
+    if (!pFreeFPBBreakpointComparator)
+    {
+        /* All FPB breakpoint comparator slots are used so return NULL as error indicator. */
+        return NULL;
+    }
+
+    *pFreeFPBBreakpointComparator = comparatorValue;
+    return pFreeFPBBreakpointComparator;
+}
+
+
+static uint32_t* clearRemapBreakpoint(uint32_t breakpointAddress);
+static uint32_t* clearBreakModeBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction);
+uint32_t* __mriFPB_ClearBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction)
+{
+    if (isBreakpointAddressInvalid(breakpointAddress))
+        return NULL;
+
+    if (g_fpb.pRemapTable)
+        return clearRemapBreakpoint(breakpointAddress);
+    else
+        return clearBreakModeBreakpoint(breakpointAddress, is32BitInstruction);
+}
+
+static uint32_t* clearRemapBreakpoint(uint32_t breakpointAddress)
+{
+    uint32_t* pComparator;
+    uint32_t  comparatorIndex;
+
+    pComparator = findRemapComparator(breakpointAddress);
+    if (!pComparator)
+        return NULL;
+
+    comparatorIndex = getComparatorIndex(pComparator);
+    g_fpb.breakpointHalfwords[comparatorIndex] &= ~getHalfwordBit(breakpointAddress);
+    if (g_fpb.breakpointHalfwords[comparatorIndex] == 0)
+        clearComparator(pComparator);
+    updateRemapTableEntry(comparatorIndex);
+
+    return pComparator;
+}
+
+static uint32_t* clearBreakModeBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction)
+{
+    uint32_t* pExistingFPBBreakpoint;
+
+    pExistingFPBBreakpoint = findComparatorWithValue(calculateFPBComparatorValue(breakpointAddress,
+                                                                                 is32BitInstruction));
+    if (pExistingFPBBreakpoint)
+        clearComparator(pExistingFPBBreakpoint);
+
+    return pExistingFPBBreakpoint;
+}
+
+
+/* Returns non-zero if a breakpoint of either instruction size is already set at the specified address. */
+int __mriFPB_IsBreakpointSet(uint32_t breakpointAddress)
+{
+    uint32_t* pComparator;
+
+    if (isBreakpointAddressInvalid(breakpointAddress))
+        return 0;
+
+    if (g_fpb.pRemapTable)
+    {
+        pComparator = findRemapComparator(breakpointAddress);
+        return pComparator &&
+               (g_fpb.breakpointHalfwords[getComparatorIndex(pComparator)] & getHalfwordBit(breakpointAddress));
+    }
+    return findComparatorWithValue(calculateFPBComparatorValue(breakpointAddress, 0)) != NULL ||
+           findComparatorWithValue(calculateFPBComparatorValue(breakpointAddress, 1)) != NULL;
+}
@@ -0,0 +1,100 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Flash Patch and Breakpoint (FPB) unit routines used to set hardware breakpoints. */
+#ifndef _FPB_H_
+#define _FPB_H_
+
+#include <stdint.h>
+
+/* Flash Patch and Breakpoint Registers */
+typedef struct
+{
+    /* FlashPatch Control Register. */
+    volatile uint32_t   CTRL;
+    /* FlashPatch Remap Register. */
+    volatile uint32_t   REMAP;
+} FPB_Type;
+
+/* FlashPatch Control Register Bits. */
+/*  Most significant bits of number of instruction address comparators.  Read-only */
+#define FP_CTRL_NUM_CODE_MSB_SHIFT  12
+#define FP_CTRL_NUM_CODE_MSB_MASK   (0x7 << FP_CTRL_NUM_CODE_MSB_SHIFT)
+/*  Least significant bits of number of instruction address comparators.  Read-only */
+#define FP_CTRL_NUM_CODE_LSB_SHIFT  4
+#define FP_CTRL_NUM_CODE_LSB_MASK   (0xF << FP_CTRL_NUM_CODE_LSB_SHIFT)
+/*  Number of instruction literal address comparators.  Read only */
+#define FP_CTRL_NUM_LIT_SHIFT       8
+#define FP_CTRL_NUM_LIT_MASK        (0xF << FP_CTRL_NUM_LIT_SHIFT)
+/*  This Key field must be set to 1 when writing or the write will be ignored. */
+#define FP_CTRL_KEY                 (1 << 1)
+/*  Enable bit for the FPB.  Set to 1 to enable FPB. */
+#define FP_CTRL_ENABLE              1
+
+/* FlashPatch Remap Register Bits. */
+/*  Indicates that the FPB supports remapping of code and literal addresses to SRAM.  Read-only */
+#define FP_REMAP_RMPSPT             (1 << 29)
+/*  Bits 28:5 of the remap table address.  Bits 31:29 of the table address are fixed at 0b001. */
+#define FP_REMAP_REMAP_MASK         0x1FFFFFE0
+
+/* FlashPatch Comparator Register Bits. */
+/*  Defines the behaviour for code address comparators. */
+#define FP_COMP_REPLACE_SHIFT       30
+#define FP_COMP_REPLACE_MASK        (0x3U << FP_COMP_REPLACE_SHIFT)
+/*      Remap to specified address in SRAM. */
+#define FP_COMP_REPLACE_REMAP       (0x0U << FP_COMP_REPLACE_SHIFT)
+/*      Breakpoint on lower halfword. */
+#define FP_COMP_REPLACE_BREAK_LOWER (0x1U << FP_COMP_REPLACE_SHIFT)
+/*      Breakpoint on upper halfword. */
+#define FP_COMP_REPLACE_BREAK_UPPER (0x2U << FP_COMP_REPLACE_SHIFT)
+/*      Breakpoint on word. */
+#define FP_COMP_REPLACE_BREAK       (0x3U << FP_COMP_REPLACE_SHIFT)
+/*  Specified bits 28:2 of the address to be use for match on this comparator. */
+#define FP_COMP_COMP_SHIFT          2
+#define FP_COMP_COMP_MASK           (0x07FFFFFF << FP_COMP_COMP_SHIFT)
+/*  Enables this comparator.  Set to 1 to enable. */
+#define FP_COMP_ENABLE              1
+
+/* The remap table holds one word for each code and literal comparator.  Comparator n fetches its replacement
+   word from entry n of the table. */
+#define FPB_REMAP_TABLE_ENTRIES     8
+#define FPB_REMAP_TABLE_ALIGNMENT   32
+/* The remap table must be located in the 0x20000000 - 0x3FFFFFFF SRAM region. */
+#define FPB_REMAP_REGION_MASK       0xE0000000
+#define FPB_REMAP_REGION_BASE       0x20000000
+
+
+/* Passing a NULL pRemapTable (or running on an FPB without remap support) causes the code comparators to be used
+   in breakpoint mode.  Otherwise they are used in remap mode to fetch a copy of the original code word from
+   pRemapTable with BKPT instructions patched in place of the halfwords which have breakpoints set on them. */
+void      __mriFPB_Init(FPB_Type* pFPB, uint32_t* pComparators, uint32_t* pRemapTable);
+int       __mriFPB_IsRemapEnabled(void);
+uint32_t* __mriFPB_SetBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction);
+uint32_t* __mriFPB_ClearBreakpoint(uint32_t breakpointAddress, int32_t is32BitInstruction);
+int       __mriFPB_IsBreakpointSet(uint32_t breakpointAddress);
+
+/* Implemented by the architecture code to read the original contents of code memory when building remap table
+   entries. */
+uint32_t  __mriFPB_ReadCodeWord(uint32_t address);
+
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define FPB_Init                __mriFPB_Init
+#define FPB_IsRemapEnabled      __mriFPB_IsRemapEnabled
+#define FPB_SetBreakpoint       __mriFPB_SetBreakpoint
+#define FPB_ClearBreakpoint     __mriFPB_ClearBreakpoint
+#define FPB_IsBreakpointSet     __mriFPB_IsBreakpointSet
+#define FPB_ReadCodeWord        __mriFPB_ReadCodeWord
+
+#endif /* _FPB_H_ */
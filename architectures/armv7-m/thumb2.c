@@ -0,0 +1,163 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Thumb-2 instruction decoder used to find the end of the basic block which starts at the program counter. */
+#include "thumb2.h"
+
+
+/* Returns the size in bytes (2 or 4) of the instruction which starts with firstHalfWord. */
+uint32_t __mriThumb2_GetInstructionSize(uint16_t firstHalfWord)
+{
+    /* Only the 0b11101, 0b11110, and 0b11111 prefixes start a 32-bit instruction. */
+    uint16_t prefix = firstHalfWord >> 11;
+
+    return (prefix == 0x1D || prefix == 0x1E || prefix == 0x1F) ? 4 : 2;
+}
+
+
+static int is16BitBlockEndInstruction(uint16_t halfWord);
+static int is32BitBlockEndInstruction(uint16_t halfWord0, uint16_t halfWord1);
+/* Returns non-zero if the instruction must be single stepped since it can change the flow of execution.  The
+   secondHalfWord is ignored for 16-bit instructions. */
+int __mriThumb2_IsBlockEndInstruction(uint16_t firstHalfWord, uint16_t secondHalfWord)
+{
+    if (Thumb2_GetInstructionSize(firstHalfWord) == 4)
+        return is32BitBlockEndInstruction(firstHalfWord, secondHalfWord);
+    else
+        return is16BitBlockEndInstruction(firstHalfWord);
+}
+
+static int isConditionalBranchUdfOrSvc(uint16_t halfWord)
+{
+    return (halfWord & 0xF000) == 0xD000;
+}
+
+static int isUnconditionalBranch(uint16_t halfWord)
+{
+    return (halfWord & 0xF800) == 0xE000;
+}
+
+static int isCompareAndBranch(uint16_t halfWord)
+{
+    /* CBZ and CBNZ. */
+    return (halfWord & 0xF500) == 0xB100;
+}
+
+static int isBranchAndExchange(uint16_t halfWord)
+{
+    /* BX and BLX register. */
+    return (halfWord & 0xFF00) == 0x4700;
+}
+
+static int isHighRegisterAddOrMoveToPCOrLR(uint16_t halfWord)
+{
+    /* ADD and MOV with a destination register (D:Rdn) of 14 or 15. */
+    return (halfWord & 0xFD86) == 0x4486;
+}
+
+static int isPopIncludingPC(uint16_t halfWord)
+{
+    return (halfWord & 0xFF00) == 0xBD00;
+}
+
+static int isBreakpoint(uint16_t halfWord)
+{
+    return (halfWord & 0xFF00) == 0xBE00;
+}
+
+static int isIfThen(uint16_t halfWord)
+{
+    /* A zero mask encodes the NOP, YIELD, WFE, WFI, and SEV hints instead. */
+    return (halfWord & 0xFF00) == 0xBF00 && (halfWord & 0x000F) != 0;
+}
+
+static int is16BitBlockEndInstruction(uint16_t halfWord)
+{
+    return isConditionalBranchUdfOrSvc(halfWord) ||
+           isUnconditionalBranch(halfWord) ||
+           isCompareAndBranch(halfWord) ||
+           isBranchAndExchange(halfWord) ||
+           isHighRegisterAddOrMoveToPCOrLR(halfWord) ||
+           isPopIncludingPC(halfWord) ||
+           isBreakpoint(halfWord) ||
+           isIfThen(halfWord);
+}
+
+static int isInBranchAndMiscControlGroup(uint16_t halfWord0, uint16_t halfWord1)
+{
+    return (halfWord0 & 0xF800) == 0xF000 && (halfWord1 & 0x8000);
+}
+
+static int isMiscControlWhichDoesNotBranch(uint16_t halfWord0, uint16_t halfWord1)
+{
+    uint32_t op1 = (halfWord1 >> 12) & 0x7;
+    uint32_t op = (halfWord0 >> 4) & 0x7F;
+
+    /* MSR, the hints, the barriers, and MRS share the op1 == 0b0x0 space with B<cond> but they don't branch.  Every
+       other encoding in this group is a branch, BL, or UDF. */
+    if (op1 & 0x5)
+        return 0;
+    return op == 0x38 || op == 0x39 || op == 0x3A || op == 0x3B || op == 0x3E || op == 0x3F;
+}
+
+static int isLoadToPCOrLR(uint16_t halfWord0, uint16_t halfWord1)
+{
+    /* LDR (immediate, register, and literal) with an Rt of 14 or 15. */
+    return (halfWord0 & 0xFF70) == 0xF850 && (halfWord1 & 0xE000) == 0xE000;
+}
+
+static int isLoadMultipleToPCOrLR(uint16_t halfWord0, uint16_t halfWord1)
+{
+    /* LDMIA, LDMDB, and POP.W with PC or LR in the register list. */
+    return (halfWord0 & 0xFE50) == 0xE810 && (halfWord1 & 0xC000);
+}
+
+static int isTableBranch(uint16_t halfWord0, uint16_t halfWord1)
+{
+    /* TBB and TBH. */
+    return (halfWord0 & 0xFFF0) == 0xE8D0 && (halfWord1 & 0xFFE0) == 0xF000;
+}
+
+static int is32BitBlockEndInstruction(uint16_t halfWord0, uint16_t halfWord1)
+{
+    if (isInBranchAndMiscControlGroup(halfWord0, halfWord1))
+        return !isMiscControlWhichDoesNotBranch(halfWord0, halfWord1);
+    return isLoadToPCOrLR(halfWord0, halfWord1) ||
+           isLoadMultipleToPCOrLR(halfWord0, halfWord1) ||
+           isTableBranch(halfWord0, halfWord1);
+}
+
+
+/* Returns the address of the first instruction at or after startAddress which ends the basic block.  The search
+   gives up at endAddress, returning the address of the first instruction at or after it, so that the caller never
+   runs past the end of the address range it is stepping through. */
+uint32_t __mriThumb2_FindBasicBlockEnd(uint32_t startAddress, uint32_t endAddress)
+{
+    uint32_t address = startAddress;
+
+    while (address < endAddress)
+    {
+        uint16_t firstHalfWord = Thumb2_ReadCodeHalfWord(address);
+        uint16_t secondHalfWord = 0;
+        uint32_t instructionSize = Thumb2_GetInstructionSize(firstHalfWord);
+
+        if (instructionSize == 4)
+            secondHalfWord = Thumb2_ReadCodeHalfWord(address + 2);
+        if (Thumb2_IsBlockEndInstruction(firstHalfWord, secondHalfWord))
+            return address;
+        address += instructionSize;
+    }
+
+    return address;
+}
@@ -0,0 +1,38 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Thumb-2 instruction decoder used to find the end of the basic block which starts at the program counter. */
+#ifndef _THUMB2_H_
+#define _THUMB2_H_
+
+#include <stdint.h>
+
+/* The basic block ends at the first instruction which can change the flow of execution: branches, IT instructions,
+   exception generating instructions and any instruction which writes to PC or LR.  The instructions before it
+   always execute in order and can be run at full speed up to a breakpoint placed on that final instruction. */
+uint32_t __mriThumb2_GetInstructionSize(uint16_t firstHalfWord);
+int      __mriThumb2_IsBlockEndInstruction(uint16_t firstHalfWord, uint16_t secondHalfWord);
+uint32_t __mriThumb2_FindBasicBlockEnd(uint32_t startAddress, uint32_t endAddress);
+
+/* Implemented by the architecture code to read the instructions being decoded from code memory. */
+uint16_t __mriThumb2_ReadCodeHalfWord(uint32_t address);
+
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define Thumb2_GetInstructionSize       __mriThumb2_GetInstructionSize
+#define Thumb2_IsBlockEndInstruction    __mriThumb2_IsBlockEndInstruction
+#define Thumb2_FindBasicBlockEnd        __mriThumb2_FindBasicBlockEnd
+#define Thumb2_ReadCodeHalfWord         __mriThumb2_ReadCodeHalfWord
+
+#endif /* _THUMB2_H_ */
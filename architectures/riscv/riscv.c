@@ -22,6 +22,7 @@
 #include <signal.h>
 #include <platforms.h>
 #include <gdb_console.h>
+#include <expedite.h>
 #include "riscv.h"
 #include "riscv_inst.h"
 
@@ -37,21 +38,90 @@ extern int errno;
 
 RiscVState    __mriRiscVState;
 
-/* trigger free list and allocated list are singly-linked lists, NULL terminated */
+/* Set to 0 for cores which don't implement the optional tinfo CSR.  The trigger type is then read from tdata1. */
+#ifndef MRI_RISCV_HAS_TINFO
+#define MRI_RISCV_HAS_TINFO 1
+#endif
+
+/* gdb register numbers of the registers expedited in T stop responses: ra (x1), sp (x2), the s0/fp frame pointer
+   (x8), and pc.  Can be overridden at build time or replaced at runtime with "monitor expedite". */
+#ifndef MRI_RISCV_T_RESPONSE_REGISTERS
+#define MRI_RISCV_T_RESPONSE_REGISTERS 1, 2, 8, 32
+#endif
+
+/* mcontrol (tdata1 type 2) fields.  The type, dmode, and maskmax fields sit at the top of the XLEN-bit register. */
+#define TRIGGER_TYPE_MCONTROL   2
+#define MCONTROL_TYPE_SHIFT     (__riscv_xlen - 4)
+#define MCONTROL_TYPE           ((RISCV_X_VAL)TRIGGER_TYPE_MCONTROL << MCONTROL_TYPE_SHIFT)
+#define MCONTROL_TYPE_MASK      ((RISCV_X_VAL)0xF << MCONTROL_TYPE_SHIFT)
+#define MCONTROL_DMODE          ((RISCV_X_VAL)1 << (__riscv_xlen - 5))
+#define MCONTROL_MASKMAX_SHIFT  (__riscv_xlen - 11)
+#define MCONTROL_MASKMAX_MASK   0x3F
+#define MCONTROL_HIT            (1 << 20)
+#define MCONTROL_TIMING_AFTER   (1 << 18)
+#define MCONTROL_CHAIN          (1 << 11)
+#define MCONTROL_MATCH_SHIFT    7
+#define MCONTROL_MATCH_MASK     (0xF << MCONTROL_MATCH_SHIFT)
+#define MCONTROL_MATCH_EQUAL    (0 << MCONTROL_MATCH_SHIFT)
+#define MCONTROL_MATCH_NAPOT    (1 << MCONTROL_MATCH_SHIFT)
+#define MCONTROL_MATCH_GE       (2 << MCONTROL_MATCH_SHIFT)
+#define MCONTROL_MATCH_LT       (3 << MCONTROL_MATCH_SHIFT)
+#define MCONTROL_M              (1 << 6)
+#define MCONTROL_S              (1 << 4)
+#define MCONTROL_U              (1 << 3)
+#define MCONTROL_EXECUTE        (1 << 2)
+#define MCONTROL_STORE          (1 << 1)
+#define MCONTROL_LOAD           (1 << 0)
+#define MCONTROL_ALL_MODES      (MCONTROL_M | MCONTROL_S | MCONTROL_U)
+
+/* Capabilities discovered for each trigger by triggersInit(). */
+#define TRIGGER_CAP_EXECUTE       (1 << 0)
+#define TRIGGER_CAP_LOAD          (1 << 1)
+#define TRIGGER_CAP_STORE         (1 << 2)
+#define TRIGGER_CAP_NAPOT         (1 << 3)
+#define TRIGGER_CAP_RANGE         (1 << 4)  /* match >= and < for chained range pairs */
+#define TRIGGER_CAP_CHAIN         (1 << 5)
+#define TRIGGER_CAP_TIMING_AFTER  (1 << 6)
+#define TRIGGER_CAP_COUNT         7
+
+/* Triggers are handed out by a typed allocator which picks the least capable free trigger that has the required
+   capabilities, so that plain execute triggers are used for breakpoints and load/store triggers stay free for
+   watchpoints. */
 typedef struct RiscVTrigger RISCV_TRIGGER;
 struct RiscVTrigger {
   int idx;
   int allocated;
   int programmed;
+  uint32_t caps;        /* TRIGGER_CAP_* bits */
+  uint32_t maskMax;     /* log2 of the largest NAPOT range this trigger can match */
   uint32_t addr;
+  uint32_t size;        /* 0 for execute triggers */
+  uint32_t access;      /* MCONTROL_EXECUTE or MCONTROL_LOAD/MCONTROL_STORE */
+  RISCV_X_VAL tdata1;
+  RISCV_X_VAL tdata2;
+  RISCV_TRIGGER *chained;  /* upper bound trigger of a chained range pair */
 };
 
 #define MAX_TRIGGERS 16
 RISCV_TRIGGER triggerPool[MAX_TRIGGERS];
 int triggerMaxValid;  /* actually "one beyond the max valid trigger index" */
+static uint32_t triggerFreeMask;
+static uint32_t triggersWithCap[TRIGGER_CAP_COUNT];
+static uint32_t triggerHitMask;
 
 static RISCV_TRIGGER *triggerForSingleStep;
 
+/* When no execute trigger is free, single steps patch an ebreak over each possible successor instead.  c.ebreak only
+   replaces compressed instructions so that cores without the C extension never see a 16-bit patch. */
+typedef struct {
+  uint32_t addr;
+  uint32_t length;        /* 2 for c.ebreak, 4 for ebreak */
+  uint16_t original[2];
+} SOFTWARE_STEP_PATCH;
+
+static SOFTWARE_STEP_PATCH softwareStepPatches[RISCV_MAX_NEXT_PCS];
+static int softwareStepPatchCount;
+
 #define DISABLE_APPARENTLY_ARM_SPECIFIC_CODE 1
 
 /* NOTE: This is the original version of the following XML which has had things stripped to reduce the amount of
@@ -147,7 +217,6 @@ void __mriExceptionHandler(void);
 
 
 static void clearState(void);
-static void initSingleStep(void);
 static void disableSingleStep(void);
 static void enableSingleStep(void);
 static uint32_t getCurrentlyExecutingExceptionNumber(void);
@@ -155,12 +224,14 @@ static int isInstruction32Bit(uint16_t firstWordOfInstruction);
 static uint16_t getHalfWord(uint32_t address);
 static void triggersInit();
 static int triggersIsValidIdx(uint32_t idx);
-static RISCV_TRIGGER *triggerAlloc(uint32_t addr);
-static void triggerSetAddr(RISCV_TRIGGER *t, uint32_t addr);
-static RISCV_TRIGGER *triggerFindByAddr(uint32_t addr);
+static RISCV_TRIGGER *triggerAlloc(uint32_t requiredCaps, uint32_t minMaskMax);
+static RISCV_TRIGGER *triggerAllocRangePair(uint32_t requiredCaps);
+static void triggerSetExecute(RISCV_TRIGGER *t, uint32_t addr);
+static RISCV_TRIGGER *triggerFind(uint32_t addr, uint32_t size, uint32_t access);
 static void triggerProgramHw(RISCV_TRIGGER *t);
 static void triggerClearHw(RISCV_TRIGGER *t);
 static void triggerFree(RISCV_TRIGGER *t);
+static void triggersLatchHits(void);
 
 
 void __mriRiscVInit(Token* pParameterTokens)
@@ -172,8 +243,6 @@ void __mriRiscVInit(Token* pParameterTokens)
     clearState();
     Platform_DisableSingleStep();
     triggersInit();
-    initSingleStep();  /* Must happen after triggersInit, for implementation reasons, */
-                       /* because it is using an execution trigger internally */
 }
 
 
@@ -238,103 +307,119 @@ static __INLINE uint32_t getMPURegionAttributeAndSize(void)
 }
 
 
-static void triggerSetAddr(RISCV_TRIGGER *trigger, uint32_t addr)
+static void triggerSetExecute(RISCV_TRIGGER *trigger, uint32_t addr)
 {
   if (trigger) {
     trigger->addr = addr;
+    trigger->size = 0;
+    trigger->access = MCONTROL_EXECUTE;
+    /* Match the exact address of any sized instruction and raise a breakpoint exception in any mode. */
+    trigger->tdata1 = MCONTROL_TYPE | MCONTROL_MATCH_EQUAL | MCONTROL_ALL_MODES | MCONTROL_EXECUTE;
+    trigger->tdata2 = addr;
   }
 }
 
-static RISCV_TRIGGER *triggerFindByAddr(uint32_t addr)
+static RISCV_TRIGGER *triggerFind(uint32_t addr, uint32_t size, uint32_t access)
 {
   int i;
   
+  /* The single step trigger is internal and chained upper bound triggers are found through their pair. */
   for (i = 0; i < triggerMaxValid; i++)
-    if (triggerPool[i].allocated && triggerPool[i].addr == addr)
+    if (triggerPool[i].allocated && &triggerPool[i] != triggerForSingleStep &&
+        triggerPool[i].addr == addr && triggerPool[i].size == size && triggerPool[i].access == access)
       return &triggerPool[i];
 
   return NULL;
 }
 
+static void tselectWrite(uint32_t val);
+static RISCV_X_VAL tdata1Read(void);
+static void tdata1Write(RISCV_X_VAL val);
+static void tdata2Write(RISCV_X_VAL val);
+static void triggerWriteHw(RISCV_TRIGGER *trigger);
 static void triggerProgramHw(RISCV_TRIGGER *trigger)
 {
-  volatile uint32_t idxVal;
-  volatile uint32_t tdata1Val;
-  volatile uint32_t addrVal;
-
   if (trigger == NULL)
     return;
-  
-  idxVal = trigger->idx;
-  addrVal = trigger->addr;
-
-  /*
-    Bit 19 should be 0 (match virtual address)
-    bits 16 and 17 should be 0 (sizelo = 0, meaning any sized access)
-    action (bits 12 - 15) should be zero (break exception)
-    chain = 0
-    match = 0
-    m=1
-    s=1
-    u=1
-    execute=1
-    store=0
-    load=0
-
-    So basically OR in 0b101_1100 or 0x5C
-  */  
-  
-    __asm volatile ("csrw tselect, %0" : : "r" (idxVal));
-    __asm volatile ("csrw tdata2, %0" : : "r" (addrVal));    
-    __asm volatile ("csrr %0, tdata1" : "=r"(tdata1Val) : );
-    tdata1Val |= 0x5C;
-    __asm volatile ("csrw tdata1, %0" : : "r" (tdata1Val));
 
-    trigger->programmed = 1;
+  /* The upper bound (<) trigger of a range pair would fire on its own for every access below the end address,
+     including the debugger's own, so it is disabled until the chained lower bound (>=) trigger has been armed.  Until
+     then the lower trigger can't fire either since its chain partner doesn't match. */
+  if (trigger->chained) {
+    tselectWrite(trigger->chained->idx);
+    tdata1Write(MCONTROL_TYPE);
+  }
+  triggerWriteHw(trigger);
+  if (trigger->chained)
+    triggerWriteHw(trigger->chained);
 }
 
-static void triggerClearHw(RISCV_TRIGGER *trigger)
+static void triggerWriteHw(RISCV_TRIGGER *trigger)
 {
-  volatile uint32_t idxVal = trigger->idx;
-  volatile uint32_t tdata1Val;
+  tselectWrite(trigger->idx);
+  tdata1Write(MCONTROL_TYPE);
+  tdata2Write(trigger->tdata2);
+  tdata1Write(trigger->tdata1);
 
+  trigger->programmed = 1;
+}
+
+static void triggerClearHw(RISCV_TRIGGER *trigger)
+{
   if (trigger == NULL)
     return;
 
+  /* Disarm the upper bound of a range pair before the lower one so that it is never left armed by itself. */
+  if (trigger->chained)
+    triggerClearHw(trigger->chained);
+
   /* RISC-V triggers don't really have a "clear", but setting m, s, and u to 0,
      or setting execute, load, and store to 0 will make the trigger a no-op.
-     We'll do both.  So, set bits 6..0 to 0 */
-    __asm volatile ("csrw tselect, %0" : : "r" (idxVal));
-    __asm volatile ("csrr %0, tdata1" : "=r"(tdata1Val) : );
-    tdata1Val &= ~0x7F;
-    __asm volatile ("csrw tdata1, %0" : : "r" (tdata1Val));
+     Writing just the type does both and also drops any chain. */
+  tselectWrite(trigger->idx);
+  tdata1Write(MCONTROL_TYPE);
 
-    /* Might as well clear the "programmed" field which can help debugging this debugger
-       (in conjunction with NOT clearing the address field so we can see which address was
-       most recently used for this trigger slot) */
-    trigger->programmed = 0;
+  /* Might as well clear the "programmed" field which can help debugging this debugger
+     (in conjunction with NOT clearing the address field so we can see which address was
+     most recently used for this trigger slot) */
+  trigger->programmed = 0;
 }
 
 
-static void initSingleStep(void)
-{
-  triggerForSingleStep = triggerAlloc(0 /* placeholder address for now */);
-}
-
+static void restoreSoftwareStepPatches(void);
 static void disableSingleStep(void)
 {
-    // Clear execution trigger we're  using internally for single step
+    // Release the execution trigger we're using internally for single step so that it is
+    // available for user breakpoints while the program is halted.
     if (triggerForSingleStep != NULL) {
-      triggerClearHw(triggerForSingleStep);      
+      triggerClearHw(triggerForSingleStep);
+      triggerFree(triggerForSingleStep);
+      triggerForSingleStep = NULL;
     }
-    
+    restoreSoftwareStepPatches();
 }
 
+static void restoreSoftwareStepPatches(void)
+{
+  int i;
+
+  for (i = 0; i < softwareStepPatchCount; i++) {
+    uint16_t *pInstruction = (uint16_t *)softwareStepPatches[i].addr;
+
+    Platform_MemWrite16(pInstruction, softwareStepPatches[i].original[0]);
+    if (softwareStepPatches[i].length == 4)
+      Platform_MemWrite16(pInstruction + 1, softwareStepPatches[i].original[1]);
+  }
+  if (softwareStepPatchCount > 0)
+    Platform_SyncInstructionCache();
+  softwareStepPatchCount = 0;
+}
+
+static void softwareStep(uint32_t pc, uint32_t inst, RISCV_X_UNSIGNED *gprs);
 static void enableSingleStep(void)
 {
-  // For now, we'll assume there is at least one RISC-V execution trigger available
-  // and we'll use that to set a temporary breakpoint on where we expect the pc to move
-  // after the current instruction.
+  // Set a temporary breakpoint, with an execution trigger when one is free, on where we expect
+  // the pc to move after the current instruction.
     uint16_t firstWordOfCurrentInstruction;
     uint16_t secondWordOfCurrentInstruction;    
     RISCV_X_VAL addrToBreakOn;
@@ -361,14 +446,76 @@ static void enableSingleStep(void)
       gprs[i] = __mriRiscVState.context.x_1_31[i-1];
     }
 
+    triggerForSingleStep = triggerAlloc(TRIGGER_CAP_EXECUTE, 0);
+    if (triggerForSingleStep == NULL) {
+      softwareStep(__mriRiscVState.context.mepc, inst32, gprs);
+      return;
+    }
+
     addrToBreakOn = riscv_next_pc(__mriRiscVState.context.mepc, inst32, gprs);    
+    triggerSetExecute(triggerForSingleStep, addrToBreakOn);
+    triggerProgramHw(triggerForSingleStep);
+}
 
-    // set an execution trigger
-    if (triggerForSingleStep != NULL) {
-      triggerSetAddr(triggerForSingleStep, addrToBreakOn);
-      triggerProgramHw(triggerForSingleStep);      
-    }
+static void patchSoftwareStep(uint32_t addr);
+static void softwareStep(uint32_t pc, uint32_t inst, RISCV_X_UNSIGNED *gprs)
+{
+  uint32_t nextPcs[RISCV_MAX_NEXT_PCS];
+  int count;
+  int i;
+
+  count = riscv_next_pcs(pc, inst, gprs, nextPcs);
+  for (i = 0; i < count; i++)
+    patchSoftwareStep(nextPcs[i]);
+  Platform_SyncInstructionCache();
+}
+
+static void patchSoftwareStep(uint32_t addr)
+{
+  SOFTWARE_STEP_PATCH *patch = &softwareStepPatches[softwareStepPatchCount];
+  uint16_t *pInstruction = (uint16_t *)addr;
+  uint16_t lowerHalfWord;
+
+  if (softwareStepPatchCount >= RISCV_MAX_NEXT_PCS)
+    return;
+
+  __try
+  {
+    patch->original[0] = getHalfWord(addr);
+    if (isInstruction32Bit(patch->original[0]))
+      patch->original[1] = getHalfWord(addr + 2);
+  }
+  __catch
+  {
+    /* The successor isn't readable so the step will stop on the resulting fault instead. */
+    clearExceptionCode();
+    return;
+  }
 
+  patch->addr = addr;
+  patch->length = isInstruction32Bit(patch->original[0]) ? 4 : 2;
+  if (patch->length == 4) {
+    lowerHalfWord = MATCH_EBREAK & 0xffff;
+    Platform_MemWrite16(pInstruction + 1, MATCH_EBREAK >> 16);
+  } else {
+    lowerHalfWord = MATCH_C_EBREAK;
+  }
+  Platform_MemWrite16(pInstruction, lowerHalfWord);
+
+  /* Code which can't be written, in ROM for example, can't be stepped without a trigger. */
+  if (Platform_MemRead16(pInstruction) != lowerHalfWord) {
+    Platform_MemWrite16(pInstruction, patch->original[0]);
+    if (patch->length == 4)
+      Platform_MemWrite16(pInstruction + 1, patch->original[1]);
+    return;
+  }
+  softwareStepPatchCount++;
+}
+
+
+void Platform_SyncInstructionCache(void)
+{
+  __asm volatile ("fence.i" : : : "memory");
 }
 
 
@@ -381,7 +528,7 @@ void Platform_DisableSingleStep(void)
 
 static void clearSingleSteppingFlag(void)
 {
-  __mriRiscVState.flags &= ~MRI_RISCV_FLAG_SINGLE_STEPPING;
+  __mriRiscVState.flags &= ~(MRI_RISCV_FLAG_SINGLE_STEPPING | MRI_RISCV_FLAG_BLOCK_STEP);
 }
 
 
@@ -398,6 +545,56 @@ void Platform_EnableSingleStep(void)
 }
 
 
+static int startBlockStep(uint32_t endAddress);
+/* Runs the program up to the next control transfer instruction, or up to endAddress if that comes first, by placing
+   the single step trigger there.  Only the instruction which ends the block is stepped with riscv_next_pc(). */
+void Platform_EnableBlockStep(uint32_t endAddress)
+{
+  if (!startBlockStep(endAddress))
+    Platform_EnableSingleStep();
+}
+
+static int startBlockStep(uint32_t endAddress)
+{
+  uint32_t pc = __mriRiscVState.context.mepc;
+  uint32_t blockEnd;
+
+  /* A breakpoint which is already set at the end of the block would be mistaken for the end of the step so leave
+     that block to be single stepped instead. */
+  blockEnd = riscv_find_block_end(pc, endAddress);
+  if (blockEnd == pc || triggerFind(blockEnd, 0, MCONTROL_EXECUTE) != NULL)
+    return 0;
+
+  /* Without a free trigger the block is stepped an instruction at a time with software breakpoints. */
+  triggerForSingleStep = triggerAlloc(TRIGGER_CAP_EXECUTE, 0);
+  if (triggerForSingleStep == NULL)
+    return 0;
+
+  triggerSetExecute(triggerForSingleStep, blockEnd);
+  triggerProgramHw(triggerForSingleStep);
+  __mriRiscVState.blockStepAddress = blockEnd;
+  __mriRiscVState.flags |= MRI_RISCV_FLAG_BLOCK_STEP;
+  return 1;
+}
+
+uint16_t riscv_read_code_halfword(uint32_t addr)
+{
+  uint16_t halfWord = 0;
+
+  __try
+  {
+    halfWord = getHalfWord(addr);
+  }
+  __catch
+  {
+    /* Unreadable code ends the block so that the fault is taken while single stepping. */
+    clearExceptionCode();
+    return MATCH_C_EBREAK;
+  }
+  return halfWord;
+}
+
+
 
 static void setSingleSteppingFlag(void)
 {
@@ -420,9 +617,18 @@ static uint16_t getHalfWord(uint32_t address)
 }
 
 
+static int isStoppedAtEndOfBlockStep(void);
 int Platform_IsSingleStepping(void)
 {
-    return __mriRiscVState.flags & MRI_RISCV_FLAG_SINGLE_STEPPING;    
+    return (__mriRiscVState.flags & MRI_RISCV_FLAG_SINGLE_STEPPING) || isStoppedAtEndOfBlockStep();
+}
+
+static int isStoppedAtEndOfBlockStep(void)
+{
+  /* Only the block step's own trigger completes the step.  Any other breakpoint hit along the way is reported as a
+     breakpoint. */
+  return (__mriRiscVState.flags & MRI_RISCV_FLAG_BLOCK_STEP) &&
+         __mriRiscVState.context.mepc == __mriRiscVState.blockStepAddress;
 }
 
 
@@ -442,6 +648,7 @@ uint8_t Platform_DetermineCauseOfException(void)
 {
     uint32_t exceptionNumber = getCurrentlyExecutingExceptionNumber();
     
+    triggersLatchHits();
     switch(exceptionNumber)
     {
     case 0x3:
@@ -613,6 +820,14 @@ void __mriPlatform_LeavingDebuggerHook(void)
 }
 
 
+void Platform_EnteringDebugger(void)
+{
+    __mriRiscVState.originalPC = __mriRiscVState.context.mepc;
+    /* Puts back any instructions patched by a software single step before gdb can see them. */
+    Platform_DisableSingleStep();
+}
+
+
 static void checkStack(void);
 void Platform_LeavingDebugger(void)
 {
@@ -656,6 +871,36 @@ void Platform_SetProgramCounter(uint32_t newPC)
 }
 
 
+/* Reads a register from the saved context using the gdb register numbering: x0 - x31 followed by pc. */
+uint32_t Platform_ReadRegister(uint32_t registerNumber)
+{
+    // This interface will need attention in order to support RV64
+    if (registerNumber == 0)
+        return 0;
+    if (registerNumber <= 31)
+        return __mriRiscVState.context.x_1_31[registerNumber - 1];
+    if (registerNumber == 32)
+        return __mriRiscVState.context.mepc;
+    __throw_and_return(invalidIndexException, 0);
+}
+
+
+uint32_t Platform_GetLinkRegister(void)
+{
+    /* ra is x1. */
+    return __mriRiscVState.context.x_1_31[0];
+}
+
+
+uint32_t Platform_GetCycleCount(void)
+{
+    uint32_t cycles;
+
+    __asm volatile ("csrr %0, mcycle" : "=r" (cycles) : );
+    return cycles;
+}
+
+
 static int isInstruction32Bit(uint16_t firstWordOfInstruction);
 void Platform_AdvanceProgramCounterToNextInstruction(void)
 {
@@ -699,6 +944,12 @@ int Platform_WasProgramCounterModifiedByUser(void)
 }
 
 
+int Platform_CanResume(void)
+{
+    return 1;
+}
+
+
 static int isInstructionMbedSemihostBreakpoint(uint16_t instruction);
 static int isInstructionNewlibSemihostBreakpoint(uint16_t instruction);
 static int isInstructionHardcodedBreakpoint(uint16_t instruction);
@@ -775,34 +1026,14 @@ void Platform_SetSemihostCallReturnAndErrnoValues(int returnValue, int err)
 
 
 
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE
-static void sendRegisterForTResponse(Buffer* pBuffer, uint8_t registerOffset, uint32_t registerValue);
-static void writeBytesToBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount);
-#endif
-
 void Platform_WriteTResponseRegistersToBuffer(Buffer* pBuffer)
 {
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(R7), __mriCortexMState.context.R7);
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(SP), __mriCortexMState.context.SP);
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(LR), __mriCortexMState.context.LR);
-    sendRegisterForTResponse(pBuffer, CONTEXT_MEMBER_INDEX(PC), __mriCortexMState.context.PC);
-#else
-    // implement for RISC-V
-#endif  
-}
+    static const uint8_t tResponseRegisters[] = { MRI_RISCV_T_RESPONSE_REGISTERS };
 
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE
-static void sendRegisterForTResponse(Buffer* pBuffer, uint8_t registerOffset, uint32_t registerValue)
-{
-    Buffer_WriteByteAsHex(pBuffer, registerOffset);
-    Buffer_WriteChar(pBuffer, ':');
-    writeBytesToBufferAsHex(pBuffer, &registerValue, sizeof(registerValue));
-    Buffer_WriteChar(pBuffer, ';');
+    // This interface will need attention in order to support RV64
+    WriteRegistersForTResponse(pBuffer, tResponseRegisters, sizeof(tResponseRegisters));
 }
 
-#endif
-
 static void writeBytesToBufferAsHex(Buffer* pBuffer, void* pBytes, size_t byteCount)
 {
     uint8_t* pByte = (uint8_t*)pBytes;
@@ -853,12 +1084,14 @@ void Platform_SetHardwareBreakpoint(uint32_t address, uint32_t kind)
 {
     RISCV_TRIGGER *trigger;
 
-    trigger = triggerAlloc(address);
+    if (triggerFind(address, 0, MCONTROL_EXECUTE))
+        return;
+    trigger = triggerAlloc(TRIGGER_CAP_EXECUTE, 0);
 
     if (trigger == NULL)
         __throw(exceededHardwareResourcesException);
 
-    triggerSetAddr(trigger, address);
+    triggerSetExecute(trigger, address);
     triggerProgramHw(trigger);
 }
 
@@ -883,7 +1116,7 @@ void Platform_ClearHardwareBreakpoint(uint32_t address, uint32_t kind)
 {
   RISCV_TRIGGER *trigger;
 
-  trigger = triggerFindByAddr(address);
+  trigger = triggerFind(address, 0, MCONTROL_EXECUTE);
   if (trigger != NULL) {
     triggerClearHw(trigger);
     triggerFree(trigger);
@@ -893,56 +1126,179 @@ void Platform_ClearHardwareBreakpoint(uint32_t address, uint32_t kind)
   }
 }
 
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE  
-static uint32_t convertWatchpointTypeToCortexMType(PlatformWatchpointType type);
-#endif
-
+static uint32_t convertWatchpointTypeToMcontrolAccess(PlatformWatchpointType type);
+static int isValidWatchpointRange(uint32_t address, uint32_t size);
+static RISCV_TRIGGER *allocWatchpointTrigger(uint32_t address, uint32_t size, uint32_t access);
 void Platform_SetHardwareWatchpoint(uint32_t address, uint32_t size, PlatformWatchpointType type)
 {
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE  
-    uint32_t       nativeType = convertWatchpointTypeToCortexMType(type);
-    DWT_COMP_Type* pComparator;
+    uint32_t       access = convertWatchpointTypeToMcontrolAccess(type);
+    RISCV_TRIGGER* trigger;
     
-    if (!isValidDWTComparatorSetting(address, size, nativeType))
+    if (access == 0 || !isValidWatchpointRange(address, size))
         __throw(invalidArgumentException);
     
-    pComparator = enableDWTWatchpoint(address, size, nativeType);
-    if (!pComparator)
+    if (triggerFind(address, size, access))
+        return;
+    trigger = allocWatchpointTrigger(address, size, access);
+    if (!trigger)
         __throw(exceededHardwareResourcesException);
-#else
-    // implement for RISC-V
-#endif    
+    triggerProgramHw(trigger);
 }
 
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE  
-static uint32_t convertWatchpointTypeToCortexMType(PlatformWatchpointType type)
+static uint32_t convertWatchpointTypeToMcontrolAccess(PlatformWatchpointType type)
 {
     switch (type)
     {
     case MRI_PLATFORM_WRITE_WATCHPOINT:
-        return DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE;
+        return MCONTROL_STORE;
     case MRI_PLATFORM_READ_WATCHPOINT:
-        return DWT_COMP_FUNCTION_FUNCTION_DATA_READ;
+        return MCONTROL_LOAD;
     case MRI_PLATFORM_READWRITE_WATCHPOINT:
-        return DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE;
+        return MCONTROL_LOAD | MCONTROL_STORE;
     default:
         return 0;
     }
 }
-#endif
+
+static int isValidWatchpointRange(uint32_t address, uint32_t size)
+{
+    /* The chained range pair needs address + size to fit in 32 bits for its upper bound. */
+    return size > 0 && address + size > address;
+}
+
+static uint32_t accessToCaps(uint32_t access)
+{
+    return ((access & MCONTROL_LOAD) ? TRIGGER_CAP_LOAD : 0) | ((access & MCONTROL_STORE) ? TRIGGER_CAP_STORE : 0);
+}
+
+static int isNapotRange(uint32_t address, uint32_t size)
+{
+    return size >= 2 && (size & (size - 1)) == 0 && (address & (size - 1)) == 0;
+}
+
+static uint32_t calculateLog2(uint32_t value)
+{
+    uint32_t log2 = 0;
+
+    while (value > 1) {
+      value >>= 1;
+      log2++;
+    }
+    return log2;
+}
+
+static RISCV_X_VAL watchpointControl(RISCV_TRIGGER *trigger, uint32_t match, uint32_t access)
+{
+    RISCV_X_VAL control = MCONTROL_TYPE | match | MCONTROL_ALL_MODES | access;
+
+    /* Firing after the access, like the ARMv7-M DWT, lets mri resume from its own watchpoints without stepping. */
+    if (trigger->caps & TRIGGER_CAP_TIMING_AFTER)
+        control |= MCONTROL_TIMING_AFTER;
+    return control;
+}
+
+static RISCV_TRIGGER *allocWatchpointTrigger(uint32_t address, uint32_t size, uint32_t access)
+{
+    uint32_t       caps = accessToCaps(access);
+    RISCV_TRIGGER* trigger = NULL;
+
+    if (size == 1) {
+        trigger = triggerAlloc(caps, 0);
+        if (trigger) {
+            trigger->tdata1 = watchpointControl(trigger, MCONTROL_MATCH_EQUAL, access);
+            trigger->tdata2 = address;
+        }
+    } else if (isNapotRange(address, size)) {
+        /* NAPOT matches the address bits above the first 0 bit so encode the size as size/2 - 1 in the low bits. */
+        trigger = triggerAlloc(caps | TRIGGER_CAP_NAPOT, calculateLog2(size));
+        if (trigger) {
+            trigger->tdata1 = watchpointControl(trigger, MCONTROL_MATCH_NAPOT, access);
+            trigger->tdata2 = address | ((size >> 1) - 1);
+        }
+    }
+
+    /* Other ranges, or NAPOT ranges larger than maskmax, need a chained address >= start and address < end pair. */
+    if (!trigger) {
+        trigger = triggerAllocRangePair(caps);
+        if (trigger) {
+            trigger->tdata1 = watchpointControl(trigger, MCONTROL_MATCH_GE, access) | MCONTROL_CHAIN;
+            trigger->tdata2 = address;
+            trigger->chained->tdata1 = watchpointControl(trigger->chained, MCONTROL_MATCH_LT, access);
+            trigger->chained->tdata2 = address + size;
+            trigger->chained->addr = address;
+            trigger->chained->size = size;
+            trigger->chained->access = 0;
+        }
+    }
+
+    if (trigger) {
+        trigger->addr = address;
+        trigger->size = size;
+        trigger->access = access;
+    }
+    return trigger;
+}
+
 
 void Platform_ClearHardwareWatchpoint(uint32_t address, uint32_t size, PlatformWatchpointType type)
 {
-#ifndef DISABLE_APPARENTLY_ARM_SPECIFIC_CODE
-    uint32_t nativeType = convertWatchpointTypeToCortexMType(type);
+    uint32_t       access = convertWatchpointTypeToMcontrolAccess(type);
+    RISCV_TRIGGER* trigger;
     
-    if (!isValidDWTComparatorSetting(address, size, nativeType))
+    if (access == 0 || !isValidWatchpointRange(address, size))
         __throw(invalidArgumentException);
     
-    disableDWTWatchpoint(address, size, nativeType);
-#else
-    // implement for RISC-V
-#endif
+    trigger = triggerFind(address, size, access);
+    if (trigger) {
+        triggerClearHw(trigger);
+        triggerFree(trigger);
+    }
+}
+
+void Platform_SetHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    // The core checks the value in software when the hardware can't match data values.
+    (void)address;
+    (void)size;
+    (void)value;
+    __throw(exceededHardwareResourcesException);
+}
+
+void Platform_ClearHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    (void)address;
+    (void)size;
+    (void)value;
+}
+
+int Platform_WasWatchpointHit(uint32_t address)
+{
+    int i;
+
+    /* Triggers which fire before the access can't be resumed without stepping over the access first, so they are
+       always reported to gdb. */
+    for (i = 0; i < triggerMaxValid; i++) {
+      RISCV_TRIGGER *trigger = &triggerPool[i];
+
+      if (trigger->allocated && (trigger->access & (MCONTROL_LOAD | MCONTROL_STORE)) && trigger->addr == address &&
+          (trigger->tdata1 & MCONTROL_TIMING_AFTER) && (triggerHitMask & (1 << i)))
+        return 1;
+    }
+    return 0;
+}
+
+uint32_t Platform_GetSoftwareBreakpointMachineCode(uint32_t kind)
+{
+    /* Only compressed instructions are replaced with c.ebreak so that cores without the C extension never see it. */
+    switch (kind)
+    {
+    case 2:
+        return MATCH_C_EBREAK;
+    case 4:
+        return MATCH_EBREAK;
+    default:
+        __throw_and_return(invalidArgumentException, 0);
+    }
 }
 
 uint32_t Platform_GetTargetXmlSize(void)
@@ -957,14 +1313,41 @@ const char* Platform_GetTargetXml(void)
 }
 
 
+/* No memory map is described for RISC-V parts yet so every access takes the fault checked path. */
+uint32_t Platform_GetDeviceMemoryRegionCount(void)
+{
+    return 0;
+}
+
+
+const PlatformMemoryRegion* Platform_GetDeviceMemoryRegions(void)
+{
+    return NULL;
+}
+
+
+static uint32_t triggerDiscoverCaps(RISCV_TRIGGER *t);
 static void triggersInit()
 {
   int i;
+  uint32_t cap;
+
+  triggerFreeMask = 0;
+  triggerHitMask = 0;
+  for (cap = 0; cap < TRIGGER_CAP_COUNT; cap++)
+    triggersWithCap[cap] = 0;
 
   for (i = 0; i < MAX_TRIGGERS && triggersIsValidIdx(i); i++) {
     triggerPool[i].idx = i;
     triggerPool[i].allocated = 0;
     triggerPool[i].programmed = 0;
+    triggerPool[i].chained = NULL;
+    triggerPool[i].caps = triggerDiscoverCaps(&triggerPool[i]);
+    for (cap = 0; cap < TRIGGER_CAP_COUNT; cap++)
+      if (triggerPool[i].caps & (1 << cap))
+        triggersWithCap[cap] |= 1 << i;
+    if (triggerPool[i].caps)
+      triggerFreeMask |= 1 << i;
     triggerMaxValid = i+1;  /* max valid is really 'one beyond the max valid index' */
   }
 }
@@ -981,6 +1364,23 @@ static uint32_t tselectRead(void)
   return tselect;
 }
 
+static RISCV_X_VAL tdata1Read(void)
+{
+  RISCV_X_VAL tdata1;
+  __asm volatile ("csrr %0, tdata1" : "=r" (tdata1) : );
+  return tdata1;
+}
+
+static void tdata1Write(RISCV_X_VAL val)
+{
+  __asm volatile ("csrw tdata1, %0" : : "r" (val));
+}
+
+static void tdata2Write(RISCV_X_VAL val)
+{
+  __asm volatile ("csrw tdata2, %0" : : "r" (val));
+}
+
 static int triggersIsValidIdx(uint32_t idx)
 {
   /* save tselect value */
@@ -996,23 +1396,159 @@ static int triggersIsValidIdx(uint32_t idx)
   return retval;
 }
 
-RISCV_TRIGGER *triggerAlloc(uint32_t addr)
+static int triggerSupportsMcontrol(void)
 {
+#if MRI_RISCV_HAS_TINFO
+  RISCV_X_VAL tinfo;
+
+  /* tinfo has one bit for each tdata1 type supported by the selected trigger.  Some cores hardwire it to 0. */
+  __asm volatile ("csrr %0, tinfo" : "=r" (tinfo) : );
+  if ((tinfo & 0xFFFF) != 0)
+    return (tinfo & (1 << TRIGGER_TYPE_MCONTROL)) != 0;
+#endif
+  return (tdata1Read() & MCONTROL_TYPE_MASK) == MCONTROL_TYPE;
+}
+
+static RISCV_X_VAL triggerProbe(RISCV_X_VAL fields)
+{
+  /* The probed fields are WARL so only the supported ones read back.  m, s, and u are left clear so that the trigger
+     can't fire while it is being probed. */
+  tdata1Write(MCONTROL_TYPE | fields);
+  return tdata1Read() & fields;
+}
+
+static uint32_t triggerDiscoverCaps(RISCV_TRIGGER *t)
+{
+  uint32_t caps = 0;
+  RISCV_X_VAL tdata1;
+
+  tselectWrite(t->idx);
+  if (!triggerSupportsMcontrol())
+    return 0;
+  tdata1Write(MCONTROL_TYPE);
+  tdata1 = tdata1Read();
+  /* Triggers in debug mode belong to an external debugger and can't be written from M-mode. */
+  if ((tdata1 & MCONTROL_TYPE_MASK) != MCONTROL_TYPE || (tdata1 & MCONTROL_DMODE))
+    return 0;
+  t->maskMax = (uint32_t)(tdata1 >> MCONTROL_MASKMAX_SHIFT) & MCONTROL_MASKMAX_MASK;
+
+  tdata1 = triggerProbe(MCONTROL_EXECUTE | MCONTROL_LOAD | MCONTROL_STORE);
+  if (tdata1 & MCONTROL_EXECUTE)
+    caps |= TRIGGER_CAP_EXECUTE;
+  if (tdata1 & MCONTROL_LOAD)
+    caps |= TRIGGER_CAP_LOAD;
+  if (tdata1 & MCONTROL_STORE)
+    caps |= TRIGGER_CAP_STORE;
+  /* match is a single WARL field so each encoding is probed on its own. */
+  if (triggerProbe(MCONTROL_MATCH_NAPOT) == MCONTROL_MATCH_NAPOT && t->maskMax > 0)
+    caps |= TRIGGER_CAP_NAPOT;
+  if (triggerProbe(MCONTROL_MATCH_GE) == MCONTROL_MATCH_GE && triggerProbe(MCONTROL_MATCH_LT) == MCONTROL_MATCH_LT)
+    caps |= TRIGGER_CAP_RANGE;
+  if (triggerProbe(MCONTROL_CHAIN))
+    caps |= TRIGGER_CAP_CHAIN;
+  if (triggerProbe(MCONTROL_TIMING_AFTER))
+    caps |= TRIGGER_CAP_TIMING_AFTER;
+
+  tdata1Write(MCONTROL_TYPE);
+  return caps;
+}
+
+static uint32_t countCaps(uint32_t caps)
+{
+  uint32_t count = 0;
+
+  for ( ; caps; caps &= caps - 1)
+    count++;
+  return count;
+}
+
+static uint32_t triggerCandidates(uint32_t requiredCaps)
+{
+  uint32_t candidates = triggerFreeMask;
+  uint32_t cap;
+
+  for (cap = 0; cap < TRIGGER_CAP_COUNT; cap++)
+    if (requiredCaps & (1 << cap))
+      candidates &= triggersWithCap[cap];
+  return candidates;
+}
+
+static void triggerMarkAllocated(RISCV_TRIGGER *t)
+{
+  t->allocated = 1;
+  t->chained = NULL;
+  triggerFreeMask &= ~(1 << t->idx);
+  triggerHitMask &= ~(1 << t->idx);
+}
+
+static RISCV_TRIGGER *triggerAlloc(uint32_t requiredCaps, uint32_t minMaskMax)
+{
+  uint32_t candidates = triggerCandidates(requiredCaps);
+  RISCV_TRIGGER *best = NULL;
   int i;
-  
-  for (i = 0; i < triggerMaxValid; i++) {
-    if (triggerPool[i].allocated == 0) {
-      triggerPool[i].allocated = 1;
-      triggerPool[i].addr = addr;
+
+  /* Prefer the least capable trigger which will do so that the more capable ones are left for later requests. */
+  for (i = 0; candidates; i++, candidates >>= 1) {
+    if ((candidates & 1) && triggerPool[i].maskMax >= minMaskMax &&
+        (best == NULL || countCaps(triggerPool[i].caps) < countCaps(best->caps)))
+      best = &triggerPool[i];
+  }
+
+  if (best)
+    triggerMarkAllocated(best);
+  return best;
+}
+
+static RISCV_TRIGGER *triggerAllocRangePair(uint32_t requiredCaps)
+{
+  uint32_t upperCandidates = triggerCandidates(requiredCaps | TRIGGER_CAP_RANGE);
+  uint32_t lowerCandidates = triggerCandidates(requiredCaps | TRIGGER_CAP_RANGE | TRIGGER_CAP_CHAIN);
+  uint32_t pairs = lowerCandidates & (upperCandidates >> 1);
+  int i;
+
+  /* A chain only links a trigger to the one which follows it. */
+  for (i = 0; pairs; i++, pairs >>= 1) {
+    if (pairs & 1) {
+      triggerMarkAllocated(&triggerPool[i]);
+      triggerMarkAllocated(&triggerPool[i + 1]);
+      triggerPool[i].chained = &triggerPool[i + 1];
       return &triggerPool[i];
     }
   }
   return NULL;
 }
 
-void triggerFree(RISCV_TRIGGER *t)
+static void triggerFree(RISCV_TRIGGER *t)
 {
   if (t) {
+    if (t->chained)
+      triggerFree(t->chained);
     t->allocated = 0;
+    t->chained = NULL;
+    triggerFreeMask |= 1 << t->idx;
+  }
+}
+
+static void triggersLatchHits(void)
+{
+  int i;
+
+  /* hit is optional and sticky so read and clear it once per debug event.  A range pair is reported through its
+     lower bound trigger. */
+  triggerHitMask = 0;
+  for (i = 0; i < triggerMaxValid; i++) {
+    RISCV_X_VAL tdata1;
+
+    if (!triggerPool[i].allocated || !triggerPool[i].programmed)
+      continue;
+    tselectWrite(triggerPool[i].idx);
+    tdata1 = tdata1Read();
+    if (tdata1 & MCONTROL_HIT) {
+      tdata1Write(tdata1 & ~(RISCV_X_VAL)MCONTROL_HIT);
+      triggerHitMask |= 1 << i;
+    }
   }
+  for (i = 0; i < triggerMaxValid; i++)
+    if (triggerPool[i].chained && (triggerHitMask & (1 << triggerPool[i].chained->idx)))
+      triggerHitMask |= 1 << i;
 }
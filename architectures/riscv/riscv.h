@@ -14,6 +14,7 @@ typedef uint64_t RISCV_X_VAL;
 #define MRI_RISCV_FLAG_EXITING (1 << 1)    /* Is the debugger exiting back to the state prior to initial debugger entry? */
 #define MRI_RISCV_FLAG_REENTERED (1 << 2)  /* Has the debugger been re-entered (and thus, are the reentered_* fields valid? */
 #define MRI_RISCV_FLAG_SINGLE_STEPPING (1 << 3)    /* Is the debugger in the process of driving a single step? */
+#define MRI_RISCV_FLAG_BLOCK_STEP (1 << 4)    /* Is the single step trigger set at the end of a basic block? */
 
 typedef struct {
   RISCV_X_VAL x_1_31[31];  // Not including x0!  Its value is fixed at zero always, of course.
@@ -42,6 +43,7 @@ typedef struct
     volatile uint32_t   flags;
     MRI_CONTEXT_RISCV   context;
     RISCV_X_VAL         originalPC;  
+    RISCV_X_VAL         blockStepAddress;
     char                packetBuffer[RISCV_PACKET_BUFFER_SIZE];
 } RiscVState;
 
@@ -189,6 +189,72 @@ uint32_t riscv_next_pc(uint32_t pc_cur, uint32_t inst, RISCV_X_UNSIGNED *gprs)
   }
 }
 
+/* Like riscv_next_pc() but returns both outcomes of a conditional branch, so that a caller placing breakpoints
+   doesn't depend on the condition being evaluated correctly.  Returns the number of addresses stored in next_pcs. */
+int riscv_next_pcs(uint32_t pc_cur, uint32_t inst, RISCV_X_UNSIGNED *gprs, uint32_t *next_pcs)
+{
+  INST_DECODE_INFO info;
+
+  riscv_inst_decode(inst, &info);
+  switch (info.op) {
+  case INST_OP_BEQ:
+  case INST_OP_BNE:
+  case INST_OP_BLT:
+  case INST_OP_BLTU:
+  case INST_OP_BGE:
+  case INST_OP_BGEU:
+  case INST_OP_C_BEQZ:
+  case INST_OP_C_BNEZ:
+    next_pcs[0] = pc_cur + info.length;
+    if (info.imm == info.length)
+      return 1;
+    next_pcs[1] = pc_cur + info.imm;
+    return 2;
+  default:
+    next_pcs[0] = riscv_next_pc(pc_cur, inst, gprs);
+    return 1;
+  }
+}
+
+
+#define OPCODE_MASK     0x7f
+#define OPCODE_SYSTEM   0x73
+#define LONG_INST_MASK  0x1f  /* 48-bit and longer encodings */
+
+/* Does this instruction end a basic block?  Besides the branches and jumps decoded above, the SYSTEM opcode
+   (ecall, ebreak, mret, wfi and the CSR instructions which can enable interrupts or move mtvec), c.ebreak, the
+   all-zero illegal instruction and encodings longer than 32 bits all end the block so they get single stepped. */
+int riscv_inst_is_block_end(uint32_t inst)
+{
+  INST_DECODE_INFO info;
+
+  riscv_inst_decode(inst, &info);
+  if (info.op != INST_OP_UNSPECIFIED)
+    return 1;
+  if (info.length == 4)
+    return (inst & OPCODE_MASK) == OPCODE_SYSTEM || (inst & LONG_INST_MASK) == LONG_INST_MASK;
+  return (inst & MASK_C_EBREAK) == MATCH_C_EBREAK || (inst & 0xffff) == 0;
+}
+
+/* Scan forward from start for the first instruction that ends the basic block.  If there isn't one before end then
+   the first instruction boundary at or after end is returned instead. */
+uint32_t riscv_find_block_end(uint32_t start, uint32_t end)
+{
+  uint32_t addr = start;
+
+  while (addr < end) {
+    uint32_t inst = riscv_read_code_halfword(addr);
+
+    if (riscv_inst_length(inst) == 32)
+      inst |= (uint32_t)riscv_read_code_halfword(addr + 2) << 16;
+    if (riscv_inst_is_block_end(inst))
+      return addr;
+    addr += riscv_inst_length(inst) / 8;
+  }
+
+  return addr;
+}
+
 
 // #define RISCV_INST_TEST 1
 #ifdef RISCV_INST_TEST
@@ -353,9 +419,65 @@ int riscv_inst_test() {
 }
 
 
+/*
+    00001000:	4285                	li	t0,1
+    00001002:	00000297          	auipc	t0,0x0
+    00001006:	4309                	li	t1,2
+    00001008:	fc628ae3          	beq	t0,t1,...
+    0000100c:	0001                	nop
+    0000100e:	00000073          	ecall
+    00001012:	0001                	nop
+    00001014:	9002                	ebreak
+*/
+static const uint16_t block_code[] = {
+  0x4285, 0x0297, 0x0000, 0x4309, 0x8ae3, 0xfc62, 0x0001, 0x0073, 0x0000, 0x0001, 0x9002
+};
+
+uint16_t riscv_read_code_halfword(uint32_t addr)
+{
+  return block_code[(addr - 0x1000) / 2];
+}
+
+int riscv_next_pcs_test() {
+  RISCV_X_UNSIGNED gprs[32] = {0};
+  uint32_t next_pcs[RISCV_MAX_NEXT_PCS];
+
+  assert(riscv_next_pcs(0x800000d0, 0xfc628ae3, gprs, next_pcs) == 2);  /* beq t0,t1,800000a4 */
+  assert(next_pcs[0] == 0x800000d4 && next_pcs[1] == 0x800000a4);
+  assert(riscv_next_pcs(0x8000012a, 0xfc2d, gprs, next_pcs) == 2);      /* bnez s0,800000a4 */
+  assert(next_pcs[0] == 0x8000012c && next_pcs[1] == 0x800000a4);
+  assert(riscv_next_pcs(0x800000ac, 0xff9ff06f, gprs, next_pcs) == 1);  /* j 800000a4 */
+  assert(next_pcs[0] == 0x800000a4);
+  assert(riscv_next_pcs(0x800000cc, 0x4285, gprs, next_pcs) == 1);      /* li t0,1 */
+  assert(next_pcs[0] == 0x800000ce);
+  assert(riscv_next_pcs(0x1000, 0x00000263, gprs, next_pcs) == 1);      /* beq zero,zero,.+4 */
+  assert(next_pcs[0] == 0x1004);
+}
+
+int riscv_block_test() {
+  assert(riscv_inst_is_block_end(0x00000013) == 0);  /* nop */
+  assert(riscv_inst_is_block_end(0x30529073) == 1);  /* csrw mtvec,t0 */
+  assert(riscv_inst_is_block_end(0x30200073) == 1);  /* mret */
+  assert(riscv_inst_is_block_end(0x9002) == 1);      /* c.ebreak */
+  assert(riscv_inst_is_block_end(0x0000) == 1);      /* illegal */
+  assert(riscv_inst_is_block_end(0x8282) == 1);      /* jr t0 */
+
+  assert(riscv_find_block_end(0x1000, 0x1016) == 0x1008);
+  assert(riscv_find_block_end(0x1008, 0x1016) == 0x1008);
+  assert(riscv_find_block_end(0x100c, 0x1016) == 0x100e);
+  assert(riscv_find_block_end(0x1012, 0x1016) == 0x1014);
+  /* The range ends before the branch, possibly in the middle of an instruction. */
+  assert(riscv_find_block_end(0x1000, 0x1006) == 0x1006);
+  assert(riscv_find_block_end(0x1000, 0x1004) == 0x1006);
+  assert(riscv_find_block_end(0x1000, 0x1000) == 0x1000);
+}
+
+
 int main()
 {
   riscv_inst_test();
+  riscv_next_pcs_test();
+  riscv_block_test();
   return 0;
 }
 
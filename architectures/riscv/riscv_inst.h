@@ -1290,3 +1290,12 @@ typedef int32_t RISCV_X_SIGNED;
 
 
 uint32_t riscv_next_pc(uint32_t pc_cur, uint32_t inst, RISCV_X_UNSIGNED *gprs);
+
+/* Most successors any one instruction can have, as returned by riscv_next_pcs(). */
+#define RISCV_MAX_NEXT_PCS 2
+int riscv_next_pcs(uint32_t pc_cur, uint32_t inst, RISCV_X_UNSIGNED *gprs, uint32_t *next_pcs);
+int riscv_inst_is_block_end(uint32_t inst);
+uint32_t riscv_find_block_end(uint32_t start, uint32_t end);
+
+/* Implemented by the architecture code to fetch the code scanned by riscv_find_block_end(). */
+uint16_t riscv_read_code_halfword(uint32_t addr);
@@ -0,0 +1,711 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Interpreter for the agent expression bytecode which gdb sends down to have conditions, tracepoint actions, and
+   dprintf commands evaluated on the target.  The opcodes and their encodings are documented in the "Agent Expressions" appendix of the gdb manual. */
+#include <string.h>
+#include "platforms.h"
+#include "memory.h"
+#include "core.h"
+#include "agent.h"
+
+
+/* Agent expression opcodes. */
+#define AGENT_OP_FLOAT          0x01
+#define AGENT_OP_ADD            0x02
+#define AGENT_OP_SUB            0x03
+#define AGENT_OP_MUL            0x04
+#define AGENT_OP_DIV_SIGNED     0x05
+#define AGENT_OP_DIV_UNSIGNED   0x06
+#define AGENT_OP_REM_SIGNED     0x07
+#define AGENT_OP_REM_UNSIGNED   0x08
+#define AGENT_OP_LSH            0x09
+#define AGENT_OP_RSH_SIGNED     0x0a
+#define AGENT_OP_RSH_UNSIGNED   0x0b
+#define AGENT_OP_TRACE          0x0c
+#define AGENT_OP_TRACE_QUICK    0x0d
+#define AGENT_OP_LOG_NOT        0x0e
+#define AGENT_OP_BIT_AND        0x0f
+#define AGENT_OP_BIT_OR         0x10
+#define AGENT_OP_BIT_XOR        0x11
+#define AGENT_OP_BIT_NOT        0x12
+#define AGENT_OP_EQUAL          0x13
+#define AGENT_OP_LESS_SIGNED    0x14
+#define AGENT_OP_LESS_UNSIGNED  0x15
+#define AGENT_OP_EXT            0x16
+#define AGENT_OP_REF8           0x17
+#define AGENT_OP_REF16          0x18
+#define AGENT_OP_REF32          0x19
+#define AGENT_OP_REF64          0x1a
+#define AGENT_OP_IF_GOTO        0x20
+#define AGENT_OP_GOTO           0x21
+#define AGENT_OP_CONST8         0x22
+#define AGENT_OP_CONST16        0x23
+#define AGENT_OP_CONST32        0x24
+#define AGENT_OP_CONST64        0x25
+#define AGENT_OP_REG            0x26
+#define AGENT_OP_END            0x27
+#define AGENT_OP_DUP            0x28
+#define AGENT_OP_POP            0x29
+#define AGENT_OP_ZERO_EXT       0x2a
+#define AGENT_OP_SWAP           0x2b
+#define AGENT_OP_GETV           0x2c
+#define AGENT_OP_SETV           0x2d
+#define AGENT_OP_TRACEV         0x2e
+#define AGENT_OP_TRACENZ        0x2f
+#define AGENT_OP_TRACE16        0x30
+#define AGENT_OP_PICK           0x32
+#define AGENT_OP_ROT            0x33
+#define AGENT_OP_PRINTF         0x34
+
+typedef struct
+{
+    uint64_t               stack[MRI_AGENT_STACK_SIZE];
+    const AgentHooks*      pHooks;
+    const uint8_t*         pBytecode;
+    uint32_t               length;
+    uint32_t               pc;
+    uint32_t               depth;
+    int                    isCommand;
+} AgentState;
+
+/* The evaluation stack is kept out of the small debugger stack. */
+static AgentState g_agent;
+
+
+static uint64_t evaluate(const uint8_t* pBytecode, uint32_t length, const AgentHooks* pHooks, int isCommand);
+/* Evaluates the agent expression in pBytecode against the current register context and memory of the halted program
+   and returns the value left on the top of the stack by the 'end' opcode.  Throws invalidArgumentException for
+   malformed or unsupported bytecode, stack overflow/underflow, or division by zero and memFaultException if the
+   expression dereferences an invalid address. */
+uint64_t EvaluateAgentExpression(const uint8_t* pBytecode, uint32_t length)
+{
+    return evaluate(pBytecode, length, NULL, 0);
+}
+
+
+/* Same as EvaluateAgentExpression() but also accepts the opcodes which collect trace data, access trace state
+   variables, and print, handing them off to pHooks. */
+uint64_t EvaluateAgentExpressionWithHooks(const uint8_t* pBytecode, uint32_t length, const AgentHooks* pHooks)
+{
+    return evaluate(pBytecode, length, pHooks, 0);
+}
+
+
+/* Runs a breakpoint command, such as the one gdb generates for an agent style dprintf, for its side effects.  The
+   printf opcode consumes everything on the stack so the 'end' opcode of a command is allowed to find it empty. */
+void ExecuteAgentCommand(const uint8_t* pBytecode, uint32_t length, const AgentHooks* pHooks)
+{
+    evaluate(pBytecode, length, pHooks, 1);
+}
+
+
+static uint8_t  fetchOpcode(void);
+static void     executeOpcode(uint8_t opcode);
+static uint64_t pop(void);
+static uint64_t evaluate(const uint8_t* pBytecode, uint32_t length, const AgentHooks* pHooks, int isCommand)
+{
+    uint32_t opcodeCount;
+
+    memset(&g_agent, 0, sizeof(g_agent));
+    g_agent.pHooks = pHooks;
+    g_agent.pBytecode = pBytecode;
+    g_agent.length = length;
+    g_agent.isCommand = isCommand;
+
+    for (opcodeCount = 0 ; opcodeCount < MRI_AGENT_MAX_OPCODES ; opcodeCount++)
+    {
+        uint8_t opcode;
+
+        __try
+        {
+            __throwing_func( opcode = fetchOpcode() );
+            if (opcode == AGENT_OP_END)
+                return (g_agent.isCommand && g_agent.depth == 0) ? 0 : pop();
+            __throwing_func( executeOpcode(opcode) );
+        }
+        __catch
+        {
+            __rethrow_and_return(0);
+        }
+    }
+
+    __throw_and_return(invalidArgumentException, 0);
+}
+
+static uint64_t fetchOperand(uint32_t byteCount);
+static uint8_t fetchOpcode(void)
+{
+    return (uint8_t)fetchOperand(1);
+}
+
+static uint64_t fetchOperand(uint32_t byteCount)
+{
+    uint64_t value = 0;
+
+    /* Operands are stored in big endian order. */
+    if (byteCount > g_agent.length - g_agent.pc)
+        __throw_and_return(invalidArgumentException, 0);
+    while (byteCount-- > 0)
+        value = (value << 8) | g_agent.pBytecode[g_agent.pc++];
+
+    return value;
+}
+
+static void     executeBinaryOpcode(uint8_t opcode);
+static void     executeUnaryOpcode(uint8_t opcode);
+static void     executeBitWidthOpcode(uint8_t opcode);
+static void     executeRefOpcode(uint8_t opcode);
+static void     executeGotoOpcode(uint8_t opcode);
+static void     executeConstOpcode(uint8_t opcode);
+static void     executeRegOpcode(void);
+static void     executeStackOpcode(uint8_t opcode);
+static void     executePickOpcode(void);
+static void     executeTraceOpcode(uint8_t opcode);
+static void     executeVariableOpcode(uint8_t opcode);
+static void     executePrintfOpcode(void);
+static void executeOpcode(uint8_t opcode)
+{
+    switch (opcode)
+    {
+    case AGENT_OP_ADD:
+    case AGENT_OP_SUB:
+    case AGENT_OP_MUL:
+    case AGENT_OP_DIV_SIGNED:
+    case AGENT_OP_DIV_UNSIGNED:
+    case AGENT_OP_REM_SIGNED:
+    case AGENT_OP_REM_UNSIGNED:
+    case AGENT_OP_LSH:
+    case AGENT_OP_RSH_SIGNED:
+    case AGENT_OP_RSH_UNSIGNED:
+    case AGENT_OP_BIT_AND:
+    case AGENT_OP_BIT_OR:
+    case AGENT_OP_BIT_XOR:
+    case AGENT_OP_EQUAL:
+    case AGENT_OP_LESS_SIGNED:
+    case AGENT_OP_LESS_UNSIGNED:
+        executeBinaryOpcode(opcode);
+        break;
+    case AGENT_OP_LOG_NOT:
+    case AGENT_OP_BIT_NOT:
+        executeUnaryOpcode(opcode);
+        break;
+    case AGENT_OP_EXT:
+    case AGENT_OP_ZERO_EXT:
+        executeBitWidthOpcode(opcode);
+        break;
+    case AGENT_OP_REF8:
+    case AGENT_OP_REF16:
+    case AGENT_OP_REF32:
+    case AGENT_OP_REF64:
+        executeRefOpcode(opcode);
+        break;
+    case AGENT_OP_IF_GOTO:
+    case AGENT_OP_GOTO:
+        executeGotoOpcode(opcode);
+        break;
+    case AGENT_OP_CONST8:
+    case AGENT_OP_CONST16:
+    case AGENT_OP_CONST32:
+    case AGENT_OP_CONST64:
+        executeConstOpcode(opcode);
+        break;
+    case AGENT_OP_REG:
+        executeRegOpcode();
+        break;
+    case AGENT_OP_DUP:
+    case AGENT_OP_POP:
+    case AGENT_OP_SWAP:
+    case AGENT_OP_ROT:
+        executeStackOpcode(opcode);
+        break;
+    case AGENT_OP_PICK:
+        executePickOpcode();
+        break;
+    case AGENT_OP_TRACE:
+    case AGENT_OP_TRACE_QUICK:
+    case AGENT_OP_TRACE16:
+    case AGENT_OP_TRACENZ:
+        executeTraceOpcode(opcode);
+        break;
+    case AGENT_OP_GETV:
+    case AGENT_OP_SETV:
+    case AGENT_OP_TRACEV:
+        executeVariableOpcode(opcode);
+        break;
+    case AGENT_OP_PRINTF:
+        executePrintfOpcode();
+        break;
+    default:
+        /* Floating point opcodes aren't supported. */
+        __throw(invalidArgumentException);
+    }
+}
+
+static uint64_t pop(void)
+{
+    if (g_agent.depth == 0)
+        __throw_and_return(invalidArgumentException, 0);
+    return g_agent.stack[--g_agent.depth];
+}
+
+static void push(uint64_t value)
+{
+    if (g_agent.depth >= MRI_AGENT_STACK_SIZE)
+        __throw(invalidArgumentException);
+    g_agent.stack[g_agent.depth++] = value;
+}
+
+static int ensureStackDepth(uint32_t depth)
+{
+    if (g_agent.depth < depth)
+        __throw_and_return(invalidArgumentException, 0);
+    return 1;
+}
+
+static uint64_t* top(uint32_t index)
+{
+    return &g_agent.stack[g_agent.depth - 1 - index];
+}
+
+static uint64_t calculateBinaryOpcode(uint8_t opcode, uint64_t a, uint64_t b);
+static void executeBinaryOpcode(uint8_t opcode)
+{
+    uint64_t b;
+    uint64_t a;
+
+    __try
+    {
+        __throwing_func( ensureStackDepth(2) );
+        b = pop();
+        a = pop();
+        __throwing_func( push(calculateBinaryOpcode(opcode, a, b)) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+}
+
+static uint64_t shiftRightSigned(uint64_t a, uint64_t b);
+static uint64_t calculateBinaryOpcode(uint8_t opcode, uint64_t a, uint64_t b)
+{
+    if (b == 0 && opcode >= AGENT_OP_DIV_SIGNED && opcode <= AGENT_OP_REM_UNSIGNED)
+        __throw_and_return(invalidArgumentException, 0);
+
+    switch (opcode)
+    {
+    case AGENT_OP_ADD:
+        return a + b;
+    case AGENT_OP_SUB:
+        return a - b;
+    case AGENT_OP_MUL:
+        return a * b;
+    case AGENT_OP_DIV_SIGNED:
+        /* Dividing by -1 is done as a negation to avoid the INT64_MIN / -1 overflow trap. */
+        if ((int64_t)b == -1)
+            return 0 - a;
+        return (uint64_t)((int64_t)a / (int64_t)b);
+    case AGENT_OP_DIV_UNSIGNED:
+        return a / b;
+    case AGENT_OP_REM_SIGNED:
+        if ((int64_t)b == -1)
+            return 0;
+        return (uint64_t)((int64_t)a % (int64_t)b);
+    case AGENT_OP_REM_UNSIGNED:
+        return a % b;
+    case AGENT_OP_LSH:
+        return b >= 64 ? 0 : a << b;
+    case AGENT_OP_RSH_SIGNED:
+        return shiftRightSigned(a, b);
+    case AGENT_OP_RSH_UNSIGNED:
+        return b >= 64 ? 0 : a >> b;
+    case AGENT_OP_BIT_AND:
+        return a & b;
+    case AGENT_OP_BIT_OR:
+        return a | b;
+    case AGENT_OP_BIT_XOR:
+        return a ^ b;
+    case AGENT_OP_EQUAL:
+        return a == b;
+    case AGENT_OP_LESS_SIGNED:
+        return (int64_t)a < (int64_t)b;
+    default:
+        return a < b;
+    }
+}
+
+static uint64_t shiftRightSigned(uint64_t a, uint64_t b)
+{
+    uint64_t signFill = (a >> 63) ? ~(uint64_t)0 : 0;
+
+    if (b >= 64)
+        return signFill;
+    if (b == 0)
+        return a;
+    return (a >> b) | (signFill << (64 - b));
+}
+
+static void executeUnaryOpcode(uint8_t opcode)
+{
+    uint64_t* pTop;
+
+    if (!ensureStackDepth(1))
+        return;
+    pTop = top(0);
+    if (opcode == AGENT_OP_LOG_NOT)
+        *pTop = !*pTop;
+    else
+        *pTop = ~*pTop;
+}
+
+static void executeBitWidthOpcode(uint8_t opcode)
+{
+    uint32_t  bitCount;
+    uint64_t* pTop;
+    uint64_t  signBit;
+    uint64_t  mask;
+
+    __try
+    {
+        __throwing_func( bitCount = (uint32_t)fetchOperand(1) );
+        __throwing_func( ensureStackDepth(1) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+
+    if (bitCount == 0 || bitCount >= 64)
+        return;
+    pTop = top(0);
+    signBit = (uint64_t)1 << (bitCount - 1);
+    mask = (signBit << 1) - 1;
+    *pTop &= mask;
+    if (opcode == AGENT_OP_EXT && (*pTop & signBit))
+        *pTop |= ~mask;
+}
+
+static uint64_t readMemory(uint64_t address, uint32_t size);
+static void executeRefOpcode(uint8_t opcode)
+{
+    uint32_t  size = 1 << (opcode - AGENT_OP_REF8);
+    uint64_t* pTop;
+
+    if (!ensureStackDepth(1))
+        return;
+    pTop = top(0);
+    *pTop = readMemory(*pTop, size);
+}
+
+static const void* addressToPointer(uint32_t address);
+static uint64_t    readUnalignedMemory(const uint8_t* p, uint32_t size);
+static uint64_t readMemory(uint64_t address, uint32_t size)
+{
+    const void* p = addressToPointer((uint32_t)address);
+    uint64_t    value;
+
+    if (GetMemoryTypeOfRange(p, size) == MRI_PLATFORM_MEMORY_UNMAPPED)
+        __throw_and_return(memFaultException, 0);
+
+    if ((uint32_t)address & (size - 1))
+        value = readUnalignedMemory(p, size);
+    else if (size == 1)
+        value = Platform_MemRead8(p);
+    else if (size == 2)
+        value = Platform_MemRead16(p);
+    else if (size == 4)
+        value = Platform_MemRead32(p);
+    else
+        value = Platform_MemRead32(p) | ((uint64_t)Platform_MemRead32((const uint32_t*)p + 1) << 32);
+
+    if (Platform_WasMemoryFaultEncountered())
+        __throw_and_return(memFaultException, 0);
+    return value;
+}
+
+static const void* addressToPointer(uint32_t address)
+{
+    return PointerFromTargetAddress(address);
+}
+
+static uint64_t readUnalignedMemory(const uint8_t* p, uint32_t size)
+{
+    uint64_t value = 0;
+
+    /* The targets are little endian. */
+    while (size-- > 0)
+        value = (value << 8) | Platform_MemRead8(p + size);
+
+    return value;
+}
+
+static void executeGotoOpcode(uint8_t opcode)
+{
+    uint32_t offset;
+    uint64_t condition = 1;
+
+    __try
+    {
+        __throwing_func( offset = (uint32_t)fetchOperand(2) );
+        if (opcode == AGENT_OP_IF_GOTO)
+        {
+            __throwing_func( condition = pop() );
+        }
+    }
+    __catch
+    {
+        __rethrow;
+    }
+
+    if (!condition)
+        return;
+    if (offset >= g_agent.length)
+        __throw(invalidArgumentException);
+    g_agent.pc = offset;
+}
+
+static void executeConstOpcode(uint8_t opcode)
+{
+    uint64_t value;
+
+    __try
+    {
+        __throwing_func( value = fetchOperand(1 << (opcode - AGENT_OP_CONST8)) );
+        __throwing_func( push(value) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+}
+
+static void executeRegOpcode(void)
+{
+    uint32_t registerNumber;
+    uint32_t value;
+
+    __try
+    {
+        __throwing_func( registerNumber = (uint32_t)fetchOperand(2) );
+        __throwing_func( value = Platform_ReadRegister(registerNumber) );
+        __throwing_func( push(value) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+}
+
+static void executeStackOpcode(uint8_t opcode)
+{
+    uint64_t temp;
+
+    switch (opcode)
+    {
+    case AGENT_OP_DUP:
+        if (ensureStackDepth(1))
+            push(*top(0));
+        break;
+    case AGENT_OP_POP:
+        pop();
+        break;
+    case AGENT_OP_SWAP:
+        if (!ensureStackDepth(2))
+            break;
+        temp = *top(0);
+        *top(0) = *top(1);
+        *top(1) = temp;
+        break;
+    default:
+        /* rot: a b c => c a b */
+        if (!ensureStackDepth(3))
+            break;
+        temp = *top(0);
+        *top(0) = *top(1);
+        *top(1) = *top(2);
+        *top(2) = temp;
+        break;
+    }
+}
+
+static void executePickOpcode(void)
+{
+    uint32_t index;
+
+    __try
+    {
+        __throwing_func( index = (uint32_t)fetchOperand(1) );
+        __throwing_func( ensureStackDepth(index + 1) );
+        __throwing_func( push(*top(index)) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+}
+
+static uint32_t fetchTraceSize(uint8_t opcode, uint32_t* pAddress);
+static uint32_t findTraceStringSize(uint32_t address, uint32_t maxSize);
+static void executeTraceOpcode(uint8_t opcode)
+{
+    uint32_t address;
+    uint32_t size;
+
+    if (!g_agent.pHooks || !g_agent.pHooks->CollectMemory)
+        __throw(invalidArgumentException);
+
+    __try
+    {
+        __throwing_func( size = fetchTraceSize(opcode, &address) );
+        if (opcode == AGENT_OP_TRACENZ)
+        {
+            __throwing_func( size = findTraceStringSize(address, size) );
+        }
+        __throwing_func( g_agent.pHooks->CollectMemory(address, size) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+}
+
+static uint32_t fetchTraceSize(uint8_t opcode, uint32_t* pAddress)
+{
+    uint32_t size;
+
+    __try
+    {
+        /* trace and tracenz pop both the address and size while the quick forms leave the address on the stack. */
+        if (opcode == AGENT_OP_TRACE_QUICK || opcode == AGENT_OP_TRACE16)
+        {
+            __throwing_func( size = (uint32_t)fetchOperand(opcode == AGENT_OP_TRACE16 ? 2 : 1) );
+            __throwing_func( ensureStackDepth(1) );
+        }
+        else
+        {
+            __throwing_func( size = (uint32_t)pop() );
+            __throwing_func( ensureStackDepth(1) );
+        }
+    }
+    __catch
+    {
+        __rethrow_and_return(0);
+    }
+
+    *pAddress = (uint32_t)*top(0);
+    if (opcode == AGENT_OP_TRACE || opcode == AGENT_OP_TRACENZ)
+        pop();
+    return size;
+}
+
+static uint32_t findTraceStringSize(uint32_t address, uint32_t maxSize)
+{
+    uint32_t size;
+
+    for (size = 0 ; size < maxSize ; )
+    {
+        uint64_t byte;
+
+        __try
+            byte = readMemory(address + size, 1);
+        __catch
+            __rethrow_and_return(0);
+        size++;
+        if (byte == 0)
+            break;
+    }
+
+    return size;
+}
+
+static void executeVariableOpcode(uint8_t opcode)
+{
+    uint32_t index;
+    uint64_t value;
+
+    if (!g_agent.pHooks || !g_agent.pHooks->GetVariable)
+        __throw(invalidArgumentException);
+
+    __try
+    {
+        __throwing_func( index = (uint32_t)fetchOperand(2) );
+        switch (opcode)
+        {
+        case AGENT_OP_GETV:
+            value = g_agent.pHooks->GetVariable(index);
+            if (getExceptionCode() == noException)
+                push(value);
+            break;
+        case AGENT_OP_SETV:
+            if (ensureStackDepth(1))
+                g_agent.pHooks->SetVariable(index, *top(0));
+            break;
+        default:
+            g_agent.pHooks->CollectVariable(index);
+            break;
+        }
+    }
+    __catch
+    {
+        __rethrow;
+    }
+}
+
+static void executePrintfOpcode(void)
+{
+    uint32_t    argCount;
+    uint32_t    formatLength;
+    const char* pFormat;
+    uint32_t    i;
+
+    if (!g_agent.pHooks || !g_agent.pHooks->Printf)
+        __throw(invalidArgumentException);
+
+    __try
+    {
+        __throwing_func( argCount = (uint32_t)fetchOperand(1) );
+        __throwing_func( formatLength = (uint32_t)fetchOperand(2) );
+    }
+    __catch
+    {
+        __rethrow;
+    }
+
+    /* The format string follows the operands in the bytecode, including its NUL terminator. */
+    if (formatLength == 0 || formatLength > g_agent.length - g_agent.pc ||
+        g_agent.pBytecode[g_agent.pc + formatLength - 1] != '\0')
+    {
+        __throw(invalidArgumentException);
+    }
+    pFormat = (const char*)&g_agent.pBytecode[g_agent.pc];
+    g_agent.pc += formatLength;
+
+    /* The function and channel on the top of the stack are only meaningful to gdb's in-process agent.  The arguments
+       below them were pushed last one first so they are reversed in place to hand them off in order. */
+    if (!ensureStackDepth(argCount + 2))
+        return;
+    g_agent.depth -= 2;
+    for (i = 0 ; i < argCount / 2 ; i++)
+    {
+        uint64_t* pFirst = top(i);
+        uint64_t* pLast = top(argCount - 1 - i);
+        uint64_t  temp = *pFirst;
+
+        *pFirst = *pLast;
+        *pLast = temp;
+    }
+    g_agent.depth -= argCount;
+    g_agent.pHooks->Printf(pFormat, &g_agent.stack[g_agent.depth], argCount);
+}
@@ -0,0 +1,329 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Software breakpoints which are placed in RAM by temporarily replacing the instruction with a breakpoint.  Also
+   handles single stepping over a breakpoint which the monitor has dealt with itself so that the program can continue
+   without gdb ever knowing that it was stopped. */
+#include <string.h>
+#include "platforms.h"
+#include "memory.h"
+#include "buffer.h"
+#include "gdb_console.h"
+#include "breakpoints.h"
+
+
+/* Breakpoint machine codes which don't fit in 16 bits are written as a full 32-bit instruction.  Instructions are only
+   guaranteed to be halfword aligned so they are always accessed a halfword at a time. */
+typedef struct
+{
+    uint16_t* pInstruction;
+    uint32_t  originalInstruction;
+    uint32_t  breakpointInstruction;
+    uint8_t   isInserted;
+    uint8_t   isInsertFailed;
+} SoftwareBreakpoint;
+
+typedef struct
+{
+    SoftwareBreakpoint  entries[MRI_SOFTWARE_BREAKPOINT_COUNT];
+    void*               pSteppingOver;
+    uint32_t            steppingOverKind;
+    int                 areInserted;
+    int                 isSteppingOver;
+    int                 isHardwareBreakpointRemoved;
+} SoftwareBreakpoints;
+
+static SoftwareBreakpoints g_breakpoints;
+
+
+void InitSoftwareBreakpoints(void)
+{
+    memset(&g_breakpoints, 0, sizeof(g_breakpoints));
+}
+
+
+static SoftwareBreakpoint* findEntry(const uint16_t* pInstruction);
+static uint32_t            getInstructionLength(uint32_t breakpointInstruction);
+static int                 isInstructionWritable(uint16_t* pInstruction, uint32_t breakpointInstruction);
+static uint32_t            readInstruction(const uint16_t* pInstruction, uint32_t length);
+static void                writeInstruction(uint16_t* pInstruction, uint32_t instruction, uint32_t length);
+/* Records a software breakpoint at the specified RAM address.  The breakpoint instruction is only written to memory
+   while the program is running so gdb always sees the original code.  Returns 0 if the address isn't in writable RAM
+   or the table is full, in which case the caller should fall back to a hardware breakpoint.  Throws
+   invalidArgumentException if the address or kind isn't valid for the platform. */
+int SetSoftwareBreakpoint(void* pvAddress, uint32_t kind)
+{
+    uint16_t*           pInstruction = (uint16_t*)pvAddress;
+    SoftwareBreakpoint* pEntry;
+    uint32_t            breakpointInstruction;
+
+    __try
+    {
+        __throwing_func( breakpointInstruction = Platform_GetSoftwareBreakpointMachineCode(kind) );
+    }
+    __catch
+    {
+        __rethrow_and_return(0);
+    }
+    if ((size_t)pInstruction & 1)
+        __throw_and_return(invalidArgumentException, 0);
+
+    /* NULL marks a free entry in the table so a breakpoint at address 0 is left to the hardware. */
+    if (pInstruction == NULL)
+        return 0;
+    if (findEntry(pInstruction))
+        return 1;
+    if (GetMemoryTypeOfRange(pInstruction, getInstructionLength(breakpointInstruction)) != MRI_PLATFORM_MEMORY_RAM)
+        return 0;
+    pEntry = findEntry(NULL);
+    if (!pEntry || !isInstructionWritable(pInstruction, breakpointInstruction))
+        return 0;
+
+    pEntry->pInstruction = pInstruction;
+    pEntry->breakpointInstruction = breakpointInstruction;
+    return 1;
+}
+
+static SoftwareBreakpoint* findEntry(const uint16_t* pInstruction)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_SOFTWARE_BREAKPOINT_COUNT ; i++)
+    {
+        if (g_breakpoints.entries[i].pInstruction == pInstruction)
+            return &g_breakpoints.entries[i];
+    }
+
+    return NULL;
+}
+
+static uint32_t getInstructionLength(uint32_t breakpointInstruction)
+{
+    return breakpointInstruction > 0xFFFF ? 4 : 2;
+}
+
+static int isInstructionWritable(uint16_t* pInstruction, uint32_t breakpointInstruction)
+{
+    uint32_t length = getInstructionLength(breakpointInstruction);
+    uint32_t originalInstruction = readInstruction(pInstruction, length);
+    uint32_t readBackInstruction;
+
+    /* Regions described as RAM can still be write protected so make sure that the breakpoint would stick. */
+    writeInstruction(pInstruction, breakpointInstruction, length);
+    readBackInstruction = readInstruction(pInstruction, length);
+    writeInstruction(pInstruction, originalInstruction, length);
+
+    return !Platform_WasMemoryFaultEncountered() && readBackInstruction == breakpointInstruction;
+}
+
+static uint32_t readInstruction(const uint16_t* pInstruction, uint32_t length)
+{
+    uint32_t instruction = Platform_MemRead16(pInstruction);
+
+    if (length == 4)
+        instruction |= (uint32_t)Platform_MemRead16(pInstruction + 1) << 16;
+    return instruction;
+}
+
+static void writeInstruction(uint16_t* pInstruction, uint32_t instruction, uint32_t length)
+{
+    Platform_MemWrite16(pInstruction, (uint16_t)instruction);
+    if (length == 4)
+        Platform_MemWrite16(pInstruction + 1, (uint16_t)(instruction >> 16));
+}
+
+
+/* Sets a breakpoint at the specified address, preferring the software breakpoint table and falling back to a hardware
+   breakpoint when the address isn't in RAM or the table is full.  Throws exceededHardwareResourcesException if the
+   hardware has no free comparators either. */
+void SetBreakpoint(void* pvAddress, uint32_t kind)
+{
+    int wasSet;
+
+    __try
+        wasSet = SetSoftwareBreakpoint(pvAddress, kind);
+    __catch
+        __rethrow;
+
+    if (!wasSet)
+        Platform_SetHardwareBreakpoint((uint32_t)(size_t)pvAddress, kind);
+}
+
+
+/* Removes a breakpoint which was set with SetBreakpoint(). */
+void ClearBreakpoint(void* pvAddress, uint32_t kind)
+{
+    if (!ClearSoftwareBreakpoint(pvAddress))
+        Platform_ClearHardwareBreakpoint((uint32_t)(size_t)pvAddress, kind);
+}
+
+
+/* Removes the software breakpoint at the specified address from the table.  Returns 0 if there was no software
+   breakpoint at that address, in which case it was probably placed in hardware instead. */
+int ClearSoftwareBreakpoint(void* pvAddress)
+{
+    SoftwareBreakpoint* pEntry;
+
+    if (pvAddress == NULL || (pEntry = findEntry((uint16_t*)pvAddress)) == NULL)
+        return 0;
+    pEntry->pInstruction = NULL;
+    pEntry->isInsertFailed = 0;
+
+    return 1;
+}
+
+
+/* Returns non-zero if the breakpoint at the specified address was placed in the software breakpoint table rather than
+   in hardware. */
+int IsSoftwareBreakpointSet(const void* pvAddress)
+{
+    return pvAddress != NULL && findEntry((const uint16_t*)pvAddress) != NULL;
+}
+
+
+/* Writes the breakpoint instructions into RAM just before the program is resumed.  The current instruction is saved
+   each time since gdb might have loaded new code at the address while the program was halted.  The memory can have
+   been write protected since the breakpoint was set so each write is checked and a breakpoint which didn't stick is
+   skipped, to be reported to gdb at the next stop by ReportFailedBreakpoints(). */
+void InsertSoftwareBreakpoints(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_SOFTWARE_BREAKPOINT_COUNT ; i++)
+    {
+        SoftwareBreakpoint* pEntry = &g_breakpoints.entries[i];
+        uint32_t            length = getInstructionLength(pEntry->breakpointInstruction);
+        uint32_t            readBackInstruction;
+
+        pEntry->isInserted = 0;
+        if (!pEntry->pInstruction)
+            continue;
+        pEntry->originalInstruction = readInstruction(pEntry->pInstruction, length);
+        writeInstruction(pEntry->pInstruction, pEntry->breakpointInstruction, length);
+        readBackInstruction = readInstruction(pEntry->pInstruction, length);
+        if (Platform_WasMemoryFaultEncountered() || readBackInstruction != pEntry->breakpointInstruction)
+        {
+            /* Put back whatever part of the breakpoint did land so the program doesn't run a torn instruction. */
+            writeInstruction(pEntry->pInstruction, pEntry->originalInstruction, length);
+            Platform_WasMemoryFaultEncountered();
+            pEntry->isInsertFailed = 1;
+            continue;
+        }
+        pEntry->isInserted = 1;
+    }
+    Platform_SyncInstructionCache();
+    g_breakpoints.areInserted = 1;
+}
+
+
+/* Restores the original instructions when the debugger is entered.  A breakpoint which the program has overwritten in
+   the meantime is left alone so that the new code isn't clobbered. */
+void RemoveSoftwareBreakpoints(void)
+{
+    size_t i;
+
+    if (!g_breakpoints.areInserted)
+        return;
+
+    for (i = 0 ; i < MRI_SOFTWARE_BREAKPOINT_COUNT ; i++)
+    {
+        SoftwareBreakpoint* pEntry = &g_breakpoints.entries[i];
+        uint32_t            length = getInstructionLength(pEntry->breakpointInstruction);
+
+        if (pEntry->isInserted && readInstruction(pEntry->pInstruction, length) == pEntry->breakpointInstruction)
+            writeInstruction(pEntry->pInstruction, pEntry->originalInstruction, length);
+        pEntry->isInserted = 0;
+    }
+    Platform_SyncInstructionCache();
+    g_breakpoints.areInserted = 0;
+}
+
+
+/* Tells gdb about each software breakpoint which InsertSoftwareBreakpoints() couldn't write since the last stop.  The
+   program ran without them so gdb would otherwise believe that they were armed. */
+void ReportFailedBreakpoints(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_SOFTWARE_BREAKPOINT_COUNT ; i++)
+    {
+        SoftwareBreakpoint* pEntry = &g_breakpoints.entries[i];
+        Buffer              lineBuffer;
+        char                line[48];
+
+        if (!pEntry->isInsertFailed)
+            continue;
+        pEntry->isInsertFailed = 0;
+        if (!pEntry->pInstruction)
+            continue;
+
+        Buffer_Init(&lineBuffer, line, sizeof(line));
+        Buffer_WriteString(&lineBuffer, "Couldn't insert breakpoint at 0x");
+        Buffer_WriteUIntegerAsHex(&lineBuffer, (uint32_t)(size_t)pEntry->pInstruction);
+        Buffer_WriteString(&lineBuffer, ".\n");
+        Buffer_WriteChar(&lineBuffer, '\0');
+        WriteStringToGdbConsole(line);
+    }
+}
+
+
+/* Starts a single step over the breakpoint at pvAddress so that the program can be resumed past a breakpoint which the
+   monitor has handled without involving gdb.  Returns 0 if the step couldn't be started, in which case the caller
+   should report the stop to gdb instead. */
+int StartSteppingOverBreakpoint(void* pvAddress, uint32_t kind)
+{
+    /* Software breakpoints have already been removed from memory and aren't inserted again while single stepping but
+       a hardware breakpoint would just fire again so it must be removed until the step has completed. */
+    g_breakpoints.isHardwareBreakpointRemoved = 0;
+    if (!IsSoftwareBreakpointSet(pvAddress))
+    {
+        __try
+            Platform_ClearHardwareBreakpoint((uint32_t)(size_t)pvAddress, kind);
+        __catch
+        {
+            clearExceptionCode();
+            return 0;
+        }
+        g_breakpoints.isHardwareBreakpointRemoved = 1;
+    }
+
+    g_breakpoints.pSteppingOver = pvAddress;
+    g_breakpoints.steppingOverKind = kind;
+    g_breakpoints.isSteppingOver = 1;
+    Platform_EnableSingleStep();
+    return 1;
+}
+
+
+/* Returns non-zero if the monitor is in the middle of stepping over a breakpoint on its own behalf. */
+int IsSteppingOverBreakpoint(void)
+{
+    return g_breakpoints.isSteppingOver;
+}
+
+
+/* Called on the next debug exception after StartSteppingOverBreakpoint() to put back the hardware breakpoint which
+   was removed for the step. */
+void FinishSteppingOverBreakpoint(void)
+{
+    g_breakpoints.isSteppingOver = 0;
+    if (!g_breakpoints.isHardwareBreakpointRemoved)
+        return;
+
+    g_breakpoints.isHardwareBreakpointRemoved = 0;
+    __try
+        Platform_SetHardwareBreakpoint((uint32_t)(size_t)g_breakpoints.pSteppingOver, g_breakpoints.steppingOverKind);
+    __catch
+        clearExceptionCode();
+}
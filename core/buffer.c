@@ -163,13 +163,27 @@ void Buffer_WriteSizedString(Buffer* pBuffer, const char* pString, size_t length
 }
 
 
-static uint32_t parseNextHexDigitAndAddNibbleToValue(Buffer* pBuffer, uint32_t currentValue);
+uint32_t Buffer_ReadUIntegerAsHex(Buffer* pBuffer)
+{
+    uint64_t value;
+
+    /* Digits beyond the lower 32-bits, such as the sign extension of a negative 64-bit value, are just dropped. */
+    __try
+        value = Buffer_ReadUInteger64AsHex(pBuffer);
+    __catch
+        __rethrow_and_return(0U);
+
+    return (uint32_t)value;
+}
+
+
+static uint64_t parseNextHexDigitAndAddNibbleToValue(Buffer* pBuffer, uint64_t currentValue);
 static void     pushBackLastChar(Buffer* pBuffer);
 static void     clearOverrun(Buffer* pBuffer);
-uint32_t Buffer_ReadUIntegerAsHex(Buffer* pBuffer)
+uint64_t Buffer_ReadUInteger64AsHex(Buffer* pBuffer)
 {
     int      hexDigitsParsed;
-    uint32_t value = 0;
+    uint64_t value = 0;
 
     for (hexDigitsParsed = 0 ; ; hexDigitsParsed++)
     {
@@ -190,7 +204,7 @@ uint32_t Buffer_ReadUIntegerAsHex(Buffer* pBuffer)
     return value;
 }
 
-static uint32_t parseNextHexDigitAndAddNibbleToValue(Buffer* pBuffer, uint32_t currentValue)
+static uint64_t parseNextHexDigitAndAddNibbleToValue(Buffer* pBuffer, uint64_t currentValue)
 {
     char     nextChar;
     uint32_t nibbleValue;
@@ -368,15 +382,23 @@ static void advanceToNextChar(Buffer* pBuffer)
 }
 
 
-static int doesBufferContainThisString(Buffer* pBuffer, const char* pDesiredString, size_t stringLength);
 int Buffer_MatchesString(Buffer* pBuffer, const char* pString, size_t stringLength)
+{
+    return Buffer_MatchesStringFollowedBy(pBuffer, pString, stringLength, ':');
+}
+
+
+static int doesBufferContainThisString(Buffer* pBuffer, const char* pDesiredString, size_t stringLength, char separator);
+/* Like Buffer_MatchesString() but the string must be followed by the given separator, such as the ',' after "qRcmd" or
+   the ' ' between the words of a monitor command, rather than by ':'. */
+int Buffer_MatchesStringFollowedBy(Buffer* pBuffer, const char* pString, size_t stringLength, char separator)
 {
     __try
         throwExceptionIfBufferLeftIsSmallerThan(pBuffer, stringLength);
     __catch
         __rethrow_and_return(0);
     
-    if(doesBufferContainThisString(pBuffer, pString, stringLength))
+    if(doesBufferContainThisString(pBuffer, pString, stringLength, separator))
     {
         pBuffer->pCurrent += stringLength;
         return 1;
@@ -385,11 +407,56 @@ int Buffer_MatchesString(Buffer* pBuffer, const char* pString, size_t stringLeng
     return 0;
 }
 
-static int doesBufferContainThisString(Buffer* pBuffer, const char* pDesiredString, size_t stringLength)
+static int doesBufferContainThisString(Buffer* pBuffer, const char* pDesiredString, size_t stringLength, char separator)
 {
     const char* pBufferString = pBuffer->pCurrent;
     
     return (strncmp(pBufferString, pDesiredString, stringLength) == 0) &&
            (Buffer_BytesLeft(pBuffer) == stringLength || 
-            pBufferString[stringLength] == ':');
+            pBufferString[stringLength] == separator);
+}
+
+
+void Buffer_DecodeHexInPlace(Buffer* pBuffer)
+{
+    char* pDecodedStart = pBuffer->pCurrent;
+    char* pDest = pDecodedStart;
+    
+    while (Buffer_BytesLeft(pBuffer) > 0)
+    {
+        char decodedChar;
+        
+        __try
+            decodedChar = (char)Buffer_ReadByteAsHex(pBuffer);
+        __catch
+            __rethrow;
+        *pDest++ = decodedChar;
+    }
+    
+    pBuffer->pCurrent = pDecodedStart;
+    pBuffer->pEnd = pDest;
+}
+
+
+void Buffer_UnescapeBinaryInPlace(Buffer* pBuffer)
+{
+    char* pDecodedStart = pBuffer->pCurrent;
+    char* pDest = pDecodedStart;
+    
+    while (Buffer_BytesLeft(pBuffer) > 0)
+    {
+        char currChar = *pBuffer->pCurrent++;
+        
+        /* gdb escapes '#', '$', and '}' in binary data with a '}' prefix and the original byte XORed with 0x20. */
+        if (currChar == '}')
+        {
+            if (Buffer_BytesLeft(pBuffer) == 0)
+                __throw(bufferOverrunException);
+            currChar = *pBuffer->pCurrent++ ^ 0x20;
+        }
+        *pDest++ = currChar;
+    }
+    
+    pBuffer->pCurrent = pDecodedStart;
+    pBuffer->pEnd = pDest;
 }
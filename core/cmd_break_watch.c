@@ -17,24 +17,31 @@
 #include "core.h"
 #include "mri.h"
 #include "cmd_common.h"
+#include "breakpoints.h"
+#include "conditions.h"
+#include "dprintf.h"
 #include "cmd_break_watch.h"
 
 typedef struct
 {
+    void*    pAddress;
     uint32_t address;
     uint32_t kind;
     char     type;
 } BreakpointWatchpointArguments;
 
 static void parseBreakpointWatchpointCommandArguments(BreakpointWatchpointArguments* pArguments);
-static void handleHardwareBreakpointSetCommand(BreakpointWatchpointArguments* pArguments);
+static void handleBreakpointSetCommand(BreakpointWatchpointArguments* pArguments);
+static int  handleSoftwareBreakpointSetCommand(BreakpointWatchpointArguments* pArguments);
+static int  handleHardwareBreakpointSetCommand(BreakpointWatchpointArguments* pArguments);
 static void handleBreakpointWatchpointException(void);
 static void handleWatchpointSetCommand(PlatformWatchpointType type, BreakpointWatchpointArguments* pArguments);
-/* Handle the '"Z*" commands used by gdb to set hardware breakpoints/watchpoints.
+/* Handle the '"Z*" commands used by gdb to set breakpoints/watchpoints.
 
-    Command Format:     Z*,AAAAAAAA,K
+    Command Format:     Z*,AAAAAAAA,K[;XLL,BBBB...][;cmds:P,XLL,BBBB...]
     Response Format:    OK
-    Where * is 1 for hardware breakpoint.
+    Where * is 0 for software breakpoint.
+               1 for hardware breakpoint.
                2 for write watchpoint.
                3 for read watchpoint.
                4 for read/write watchpoint.
@@ -43,6 +50,12 @@ static void handleWatchpointSetCommand(PlatformWatchpointType type, BreakpointWa
                       3: 32-bit Thumb2 instruction.
                       4: 32-bit ARM insruction.
                       value: byte size for data watchpoint.
+          XLL,BBBB... is an optional list of conditions for software and hardware breakpoints.  Each condition is LL
+                      bytes of agent expression bytecode, BBBB..., sent as hexadecimal.  The program is only stopped
+                      at the breakpoint if one of the conditions evaluates to non-zero on the target.
+          cmds:P,XLL,BBBB... is an optional list of commands for software and hardware breakpoints, as sent for
+                      dprintf-style agent.  They are run on the target when the breakpoint is hit with a true
+                      condition and then the program is resumed without stopping.  P is the ignored persist flag.
 */
 uint32_t HandleBreakpointWatchpointSetCommand(void)
 {
@@ -60,8 +73,9 @@ uint32_t HandleBreakpointWatchpointSetCommand(void)
     
     switch(arguments.type)
     {
+    case '0':
     case '1':
-        handleHardwareBreakpointSetCommand(&arguments);
+        handleBreakpointSetCommand(&arguments);
         break;
     case '2':
         handleWatchpointSetCommand(MRI_PLATFORM_WRITE_WATCHPOINT, &arguments);
@@ -96,20 +110,66 @@ static void parseBreakpointWatchpointCommandArguments(BreakpointWatchpointArgume
     {
         __rethrow;
     }
+    pArguments->pAddress = ADDR32_TO_POINTER(pArguments->address);
 }
 
-static void handleHardwareBreakpointSetCommand(BreakpointWatchpointArguments* pArguments)
+static void handleBreakpointSetCommand(BreakpointWatchpointArguments* pArguments)
 {
+    int wasSet;
+
     __try
     {
-        Platform_SetHardwareBreakpoint(pArguments->address, pArguments->kind);
+        __throwing_func( SetBreakpointConditions(pArguments->type, pArguments->pAddress, pArguments->kind, GetBuffer()) );
+        __throwing_func( SetBreakpointCommands(pArguments->type, pArguments->pAddress, pArguments->kind, GetBuffer()) );
     }
     __catch
     {
+        ClearBreakpointConditions(pArguments->type, pArguments->pAddress);
+        ClearBreakpointCommands(pArguments->type, pArguments->pAddress);
         handleBreakpointWatchpointException();
         return;
     }
+
+    if (pArguments->type == '0')
+        wasSet = handleSoftwareBreakpointSetCommand(pArguments);
+    else
+        wasSet = handleHardwareBreakpointSetCommand(pArguments);
+    if (!wasSet)
+    {
+        ClearBreakpointConditions(pArguments->type, pArguments->pAddress);
+        ClearBreakpointCommands(pArguments->type, pArguments->pAddress);
+    }
+}
+
+static int handleSoftwareBreakpointSetCommand(BreakpointWatchpointArguments* pArguments)
+{
+    /* Breakpoints in flash, or beyond the capacity of the software breakpoint table, fall back to the hardware. */
+    __try
+    {
+        SetBreakpoint(pArguments->pAddress, pArguments->kind);
+    }
+    __catch
+    {
+        handleBreakpointWatchpointException();
+        return 0;
+    }
+    PrepareStringResponse("OK");
+    return 1;
+}
+
+static int handleHardwareBreakpointSetCommand(BreakpointWatchpointArguments* pArguments)
+{
+    __try
+    {
+        Platform_SetHardwareBreakpoint(pArguments->address, pArguments->kind);
+    }
+    __catch
+    {
+        handleBreakpointWatchpointException();
+        return 0;
+    }
     PrepareStringResponse("OK");
+    return 1;
 }
 
 static void handleBreakpointWatchpointException(void)
@@ -146,13 +206,15 @@ static void handleWatchpointSetCommand(PlatformWatchpointType type, BreakpointWa
 }
 
 
+static void handleSoftwareBreakpointRemoveCommand(BreakpointWatchpointArguments* pArguments);
 static void handleHardwareBreakpointRemoveCommand(BreakpointWatchpointArguments* pArguments);
 static void handleWatchpointRemoveCommand(PlatformWatchpointType type, BreakpointWatchpointArguments* pArguments);
-/* Handle the '"z*" commands used by gdb to remove hardware breakpoints/watchpoints.
+/* Handle the '"z*" commands used by gdb to remove breakpoints/watchpoints.
 
     Command Format:     z*,AAAAAAAA,K
     Response Format:    OK
-    Where * is 1 for hardware breakpoint.
+    Where * is 0 for software breakpoint.
+               1 for hardware breakpoint.
                2 for write watchpoint.
                3 for read watchpoint.
                4 for read/write watchpoint.
@@ -178,6 +240,9 @@ uint32_t HandleBreakpointWatchpointRemoveCommand(void)
     
     switch(arguments.type)
     {
+    case '0':
+        handleSoftwareBreakpointRemoveCommand(&arguments);
+        break;
     case '1':
         handleHardwareBreakpointRemoveCommand(&arguments);
         break;
@@ -198,8 +263,26 @@ uint32_t HandleBreakpointWatchpointRemoveCommand(void)
     return 0;
 }
 
+static void handleSoftwareBreakpointRemoveCommand(BreakpointWatchpointArguments* pArguments)
+{
+    ClearBreakpointConditions(pArguments->type, pArguments->pAddress);
+    ClearBreakpointCommands(pArguments->type, pArguments->pAddress);
+    __try
+    {
+        ClearBreakpoint(pArguments->pAddress, pArguments->kind);
+    }
+    __catch
+    {
+        handleBreakpointWatchpointException();
+        return;
+    }
+    PrepareStringResponse("OK");
+}
+
 static void handleHardwareBreakpointRemoveCommand(BreakpointWatchpointArguments* pArguments)
 {
+    ClearBreakpointConditions(pArguments->type, pArguments->pAddress);
+    ClearBreakpointCommands(pArguments->type, pArguments->pAddress);
     __try
     {
         Platform_ClearHardwareBreakpoint(pArguments->address, pArguments->kind);
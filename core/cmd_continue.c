@@ -17,10 +17,12 @@
 #include "core.h"
 #include "platforms.h"
 #include "mri.h"
+#include "gdb_console.h"
 #include "cmd_common.h"
 #include "cmd_continue.h"
 
 
+static uint32_t refuseToResume(void);
 static uint32_t skipHardcodedBreakpoint(void);
 static int shouldSkipHardcodedBreakpoint(void);
 static int isCurrentInstructionHardcodedBreakpoint(void);
@@ -31,6 +33,7 @@ static int isCurrentInstructionHardcodedBreakpoint(void);
     Response Format:    Blank until the next exception, at which time a 'T' stop response packet will be sent.
 
     Where AAAAAAAA is an optional value to be used for the Program Counter when restarting the program.
+    An E06 error is returned instead if the program can't be resumed from the current stop.
 */
 uint32_t HandleContinueCommand(void)
 {
@@ -38,6 +41,8 @@ uint32_t HandleContinueCommand(void)
     uint32_t    returnValue = 0;
     uint32_t    newPC;
 
+    if (!Platform_CanResume())
+        return refuseToResume();
     returnValue |= skipHardcodedBreakpoint();
     /* New program counter value is optional parameter. */
     __try
@@ -53,6 +58,13 @@ uint32_t HandleContinueCommand(void)
     return (returnValue | HANDLER_RETURN_RESUME_PROGRAM | HANDLER_RETURN_RETURN_IMMEDIATELY);
 }
 
+static uint32_t refuseToResume(void)
+{
+    WriteStringToGdbConsole("Can't resume from this stop, reset the target.\n");
+    PrepareStringResponse(MRI_ERROR_CANT_RESUME);
+    return 0;
+}
+
 static uint32_t skipHardcodedBreakpoint(void)
 {
     if (shouldSkipHardcodedBreakpoint())
@@ -83,6 +95,7 @@ static int isCurrentInstructionHardcodedBreakpoint(void)
 
     Where AA is the signal to be set, and
           BBBBBBBB is an optional value to be used for the Program Counter when restarting the program.
+    An E06 error is returned instead if the program can't be resumed from the current stop.
 */
 uint32_t HandleContinueWithSignalCommand(void)
 {
@@ -90,6 +103,8 @@ uint32_t HandleContinueWithSignalCommand(void)
     uint32_t    returnValue = 0;
     uint32_t    newPC;
 
+    if (!Platform_CanResume())
+        return refuseToResume();
     returnValue |= skipHardcodedBreakpoint();
     __try
     {
@@ -109,3 +124,37 @@ uint32_t HandleContinueWithSignalCommand(void)
 
     return (returnValue | HANDLER_RETURN_RESUME_PROGRAM | HANDLER_RETURN_RETURN_IMMEDIATELY);
 }
+
+
+/* Handle the 'D' command which is sent from gdb when it detaches from the program.  The program is left running.
+
+    Command Format:     D
+    Response Format:    OK, or E06 if the program can't be resumed from the current stop.
+*/
+uint32_t HandleDetachCommand(void)
+{
+    uint32_t returnValue;
+
+    if (!Platform_CanResume())
+        return refuseToResume();
+    returnValue = skipHardcodedBreakpoint();
+    PrepareStringResponse("OK");
+    return (returnValue | HANDLER_RETURN_RESUME_PROGRAM | HANDLER_RETURN_DETACHED);
+}
+
+
+/* Handle the 'k' command which is sent from gdb to kill the program.  A debug monitor can't kill the program that it
+   runs within so the program is left running as if gdb had detached.  It stays halted if it can't be resumed.
+
+    Command Format:     k
+    Response Format:    None since gdb doesn't wait for one.
+*/
+uint32_t HandleKillCommand(void)
+{
+    uint32_t returnValue;
+
+    if (!Platform_CanResume())
+        return HANDLER_RETURN_RETURN_IMMEDIATELY;
+    returnValue = skipHardcodedBreakpoint();
+    return (returnValue | HANDLER_RETURN_RESUME_PROGRAM | HANDLER_RETURN_RETURN_IMMEDIATELY | HANDLER_RETURN_DETACHED);
+}
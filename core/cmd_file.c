@@ -19,9 +19,10 @@
 #include "core.h"
 #include "cmd_common.h"
 #include "cmd_file.h"
+#include "stats.h"
 
 
-static int processGdbFileResponseCommands(void);
+static int processGdbFileResponseCommands(StatsFileOperation operation);
 /* Send file open request to gdb on behalf of mbed LocalFileSystem.
 
     Data Format: Fopen,ff/nn,gg,mm
@@ -46,7 +47,7 @@ int IssueGdbFileOpenRequest(const OpenParameters* pParameters)
     Buffer_WriteUIntegerAsHex(pBuffer, pParameters->mode);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_OPEN);
 }
 
 
@@ -71,7 +72,7 @@ int IssueGdbFileWriteRequest(const TransferParameters* pParameters)
     Buffer_WriteUIntegerAsHex(pBuffer, pParameters->bufferSize);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_WRITE);
 }
 
 
@@ -96,7 +97,7 @@ int IssueGdbFileReadRequest(const TransferParameters* pParameters)
     Buffer_WriteUIntegerAsHex(pBuffer, pParameters->bufferSize);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_READ);
 }
 
 
@@ -115,7 +116,7 @@ int IssueGdbFileCloseRequest(uint32_t fileDescriptor)
     Buffer_WriteUIntegerAsHex(pBuffer, fileDescriptor);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_CLOSE);
 }
 
 
@@ -140,7 +141,7 @@ int IssueGdbFileSeekRequest(const SeekParameters* pParameters)
     Buffer_WriteIntegerAsHex(pBuffer, pParameters->whence);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_LSEEK);
 }
 
 
@@ -162,7 +163,7 @@ int IssueGdbFileFStatRequest(uint32_t fileDescriptor, uint32_t fileStatBuffer)
     Buffer_WriteUIntegerAsHex(pBuffer, fileStatBuffer);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_FSTAT);
 }
 
 
@@ -184,7 +185,7 @@ int IssueGdbFileUnlinkRequest(const RemoveParameters* pParameters)
     Buffer_WriteUIntegerAsHex(pBuffer, pParameters->filenameLength);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_UNLINK);
 }
 
 
@@ -209,7 +210,7 @@ int IssueGdbFileStatRequest(const StatParameters* pParameters)
     Buffer_WriteUIntegerAsHex(pBuffer, pParameters->fileStatBuffer);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_STAT);
 }
 
 
@@ -237,7 +238,7 @@ int IssueGdbFileRenameRequest(const RenameParameters* pParameters)
     Buffer_WriteUIntegerAsHex(pBuffer, pParameters->newFilenameLength);
     
     SendPacketToGdb();
-    return processGdbFileResponseCommands();
+    return processGdbFileResponseCommands(STATS_FILE_RENAME);
 }
 
 
@@ -272,9 +273,10 @@ uint32_t HandleFileIOCommand(void)
     return (HANDLER_RETURN_RESUME_PROGRAM | HANDLER_RETURN_RETURN_IMMEDIATELY);
 }
 
-static int processGdbFileResponseCommands(void)
+static int processGdbFileResponseCommands(StatsFileOperation operation)
 {
     GdbCommandHandlingLoop();
+    RecordFileOperationStats(operation);
 
     if (WasControlCFlagSentFromGdb())
     {
@@ -18,6 +18,7 @@
 #include "mri.h"
 #include "memory.h"
 #include "cmd_common.h"
+#include "tracepoints.h"
 #include "cmd_memory.h"
 
 
@@ -30,6 +31,7 @@
           LLLLLLLL is the hexadecimal representation of the length (in bytes) of the read to be conducted.
           xx is the hexadecimal representation of the first byte read from the specified location.
           ... continue returning the rest of LLLLLLLL-1 bytes in hexadecimal format.
+    The memory comes from the trace frame instead when one has been selected with QTFrame.
 */
 uint32_t HandleMemoryReadCommand(void)
 {
@@ -48,7 +50,10 @@ uint32_t HandleMemoryReadCommand(void)
     }
 
     InitBuffer();
-    result = ReadMemoryIntoHexBuffer(pBuffer, ADDR32_TO_POINTER(addressLength.address), addressLength.length);
+    if (IsTraceFrameSelected())
+        result = ReadTraceFrameMemoryIntoHexBuffer(pBuffer, addressLength.address, addressLength.length);
+    else
+        result = ReadMemoryIntoHexBuffer(pBuffer, ADDR32_TO_POINTER(addressLength.address), addressLength.length);
     if (result == 0)
         PrepareStringResponse(MRI_ERROR_MEMORY_ACCESS_FAILURE);
 
@@ -0,0 +1,594 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Handler for gdb monitor commands which are sent to the stub via qRcmd packets. */
+#include <string.h>
+#include "buffer.h"
+#include "core.h"
+#include "mri.h"
+#include "memory.h"
+#include "gdb_console.h"
+#include "dump.h"
+#include "watchlog.h"
+#include "valuewatch.h"
+#include "expedite.h"
+#include "stats.h"
+#include "cmd_common.h"
+#include "cmd_monitor.h"
+
+
+#define ARRAY_SIZE(X) (sizeof(X)/sizeof(X[0]))
+
+static uint32_t handleMonitorCopyCommand(void);
+static uint32_t handleMonitorDumpCommand(void);
+static uint32_t handleMonitorExpediteCommand(void);
+static uint32_t handleMonitorFillCommand(void);
+#if MRI_ENABLE_STATS
+static uint32_t handleMonitorStatsCommand(void);
+#endif
+static uint32_t handleMonitorWatchlogCommand(void);
+static uint32_t handleMonitorWatchvalueCommand(void);
+/* Handle the "qRcmd" command used by gdb to forward the text of a "monitor" command to the stub.
+
+    Command Format: qRcmd,XX...
+    Response Format: OK
+
+    Where XX... is the hexadecimal representation of the monitor command text entered by the user.  Any output from
+    the command is sent to the gdb console in 'O' packets before the final response.
+*/
+uint32_t HandleMonitorCommand(void)
+{
+    static const struct
+    {
+        uint32_t     (*Handler)(void);
+        const char*  pName;
+    } monitorCommandTable[] =
+    {
+        {handleMonitorCopyCommand,        "copy"},
+        {handleMonitorDumpCommand,        "dump"},
+        {handleMonitorExpediteCommand,    "expedite"},
+        {handleMonitorFillCommand,        "fill"},
+#if MRI_ENABLE_STATS
+        {handleMonitorStatsCommand,       "stats"},
+#endif
+        {handleMonitorWatchlogCommand,    "watchlog"},
+        {handleMonitorWatchvalueCommand,  "watchvalue"}
+    };
+    Buffer* pBuffer = GetBuffer();
+    size_t  i;
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+        __throwing_func( Buffer_DecodeHexInPlace(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    for (i = 0 ; i < ARRAY_SIZE(monitorCommandTable) ; i++)
+    {
+        const char* pName = monitorCommandTable[i].pName;
+
+        if (Buffer_MatchesStringFollowedBy(pBuffer, pName, strlen(pName), ' '))
+            return monitorCommandTable[i].Handler();
+    }
+    clearExceptionCode();
+
+    PrepareEmptyResponseForUnknownCommand();
+    return 0;
+}
+
+
+/* Returns non-zero if the qRcmd packet in the buffer, positioned just after "qRcmd", holds a monitor command which
+   only reads state.  These are the only monitor commands that can be run while the program is running.  Anything
+   else, such as fill or copy which write target memory, waits for the program to stop. */
+int IsReadOnlyMonitorCommand(void)
+{
+    static const char* const readOnlyCommandTable[] =
+    {
+#if MRI_ENABLE_STATS
+        "stats",
+#endif
+        "watchlog dump"
+    };
+    Buffer* pBuffer = GetBuffer();
+    char    command[16];
+    size_t  length;
+    size_t  i;
+
+    if (!Buffer_BytesLeft(pBuffer) || !Buffer_IsNextCharEqualTo(pBuffer, ','))
+        return 0;
+    length = Buffer_BytesLeft(pBuffer) / 2;
+    if (Buffer_BytesLeft(pBuffer) % 2 != 0 || length >= sizeof(command))
+        return 0;
+    for (i = 0 ; i < length ; i++)
+    {
+        __try
+            command[i] = (char)Buffer_ReadByteAsHex(pBuffer);
+        __catch
+        {
+            clearExceptionCode();
+            return 0;
+        }
+    }
+    command[length] = '\0';
+
+    for (i = 0 ; i < ARRAY_SIZE(readOnlyCommandTable) ; i++)
+    {
+        if (strcmp(command, readOnlyCommandTable[i]) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+
+static uint32_t readMonitorArgument(Buffer* pBuffer);
+static void     skipSpaces(Buffer* pBuffer);
+static int      isNextCharAvailableAndEqualTo(Buffer* pBuffer, char thisChar);
+static void     throwIfNotAtEndOfArgument(Buffer* pBuffer);
+static void     throwIfMoreArguments(Buffer* pBuffer);
+static void     reportMemoryOperationResult(const char* pOperation, uint32_t bytesProcessed, uint32_t length);
+/* Handle the "monitor copy" command which copies a block of memory from one location to another on the target.
+
+    Command Format: copy DDDDDDDD SSSSSSSS LLLLLLLL
+
+    Where DDDDDDDD is the hexadecimal representation of the address to which the data should be copied.
+          SSSSSSSS is the hexadecimal representation of the address from which the data should be copied.
+          LLLLLLLL is the hexadecimal representation of the length (in bytes) of the block to be copied.
+    The source and destination blocks are allowed to overlap.  Each value can optionally be prefixed with 0x.
+*/
+static uint32_t handleMonitorCopyCommand(void)
+{
+    Buffer*  pBuffer = GetBuffer();
+    uint32_t destAddress;
+    uint32_t srcAddress;
+    uint32_t length;
+    uint32_t bytesCopied;
+
+    __try
+    {
+        __throwing_func( destAddress = readMonitorArgument(pBuffer) );
+        __throwing_func( srcAddress = readMonitorArgument(pBuffer) );
+        __throwing_func( length = readMonitorArgument(pBuffer) );
+        __throwing_func( throwIfMoreArguments(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    bytesCopied = CopyMemoryBlock(ADDR32_TO_POINTER(destAddress), ADDR32_TO_POINTER(srcAddress), length);
+    reportMemoryOperationResult("Copied ", bytesCopied, length);
+
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static uint32_t readMonitorArgument(Buffer* pBuffer)
+{
+    uint32_t value;
+
+    skipSpaces(pBuffer);
+    __try
+    {
+        __throwing_func( value = ReadUIntegerArgument(pBuffer) );
+        if (value == 0 && isNextCharAvailableAndEqualTo(pBuffer, 'x'))
+        {
+            __throwing_func( value = ReadUIntegerArgument(pBuffer) );
+        }
+        __throwing_func( throwIfNotAtEndOfArgument(pBuffer) );
+    }
+    __catch
+    {
+        __rethrow_and_return(0);
+    }
+
+    return value;
+}
+
+static void skipSpaces(Buffer* pBuffer)
+{
+    while (isNextCharAvailableAndEqualTo(pBuffer, ' '))
+    {
+    }
+}
+
+static int isNextCharAvailableAndEqualTo(Buffer* pBuffer, char thisChar)
+{
+    return Buffer_BytesLeft(pBuffer) > 0 && Buffer_IsNextCharEqualTo(pBuffer, thisChar);
+}
+
+static void throwIfNotAtEndOfArgument(Buffer* pBuffer)
+{
+    if (Buffer_BytesLeft(pBuffer) > 0 && !Buffer_IsNextCharEqualTo(pBuffer, ' '))
+        __throw(invalidArgumentException);
+}
+
+static void throwIfMoreArguments(Buffer* pBuffer)
+{
+    skipSpaces(pBuffer);
+    if (Buffer_BytesLeft(pBuffer) > 0)
+        __throw(invalidArgumentException);
+}
+
+static void reportMemoryOperationResult(const char* pOperation, uint32_t bytesProcessed, uint32_t length)
+{
+    if (bytesProcessed != length)
+        WriteStringToGdbConsole("Memory fault encountered. ");
+    WriteStringToGdbConsole(pOperation);
+    WriteHexValueToGdbConsole(bytesProcessed);
+    WriteStringToGdbConsole(" of ");
+    WriteHexValueToGdbConsole(length);
+    WriteStringToGdbConsole(" bytes.\n");
+}
+
+
+static uint32_t readMonitorStringArgument(Buffer* pBuffer, const char** ppString);
+/* Handle the "monitor dump" command which writes a compressed copy of a block of target memory to a file on the host.
+
+    Command Format: dump AAAAAAAA LLLLLLLL FILENAME
+
+    Where AAAAAAAA is the hexadecimal representation of the address of the first byte to be dumped.
+          LLLLLLLL is the hexadecimal representation of the length (in bytes) of the block to be dumped.
+          FILENAME is the name of the file to be created on the host.  It can't contain spaces.
+    The memory is compressed and written with gdb File-I/O requests once the program is next resumed since gdb can't
+    service such requests while it waits for the response to this command.  Each value can optionally be prefixed
+    with 0x.  The resulting file can be expanded on the host with "mrilz decompress".
+*/
+static uint32_t handleMonitorDumpCommand(void)
+{
+    Buffer*     pBuffer = GetBuffer();
+    uint32_t    address;
+    uint32_t    length;
+    const char* pFilename;
+    uint32_t    filenameLength;
+
+    __try
+    {
+        __throwing_func( address = readMonitorArgument(pBuffer) );
+        __throwing_func( length = readMonitorArgument(pBuffer) );
+        __throwing_func( filenameLength = readMonitorStringArgument(pBuffer, &pFilename) );
+        __throwing_func( throwIfMoreArguments(pBuffer) );
+        __throwing_func( QueueMemoryDump(ADDR32_TO_POINTER(address), length, pFilename, filenameLength) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    WriteStringToGdbConsole("Dump will be written to host when program is resumed.\n");
+
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static uint32_t readMonitorStringArgument(Buffer* pBuffer, const char** ppString)
+{
+    uint32_t length = 0;
+
+    skipSpaces(pBuffer);
+    *ppString = Buffer_GetArray(pBuffer) + Buffer_GetLength(pBuffer) - Buffer_BytesLeft(pBuffer);
+    while (Buffer_BytesLeft(pBuffer) > 0 && !Buffer_IsNextCharEqualTo(pBuffer, ' '))
+    {
+        Buffer_ReadChar(pBuffer);
+        length++;
+    }
+
+    if (length == 0)
+        __throw_and_return(invalidArgumentException, 0);
+    return length;
+}
+
+
+static int    matchesMonitorKeyword(Buffer* pBuffer, const char* pKeyword);
+static size_t readRegisterNumberArguments(Buffer* pBuffer, uint8_t* pRegisterNumbers, size_t maxCount);
+/* Handle the "monitor expedite" command which selects the registers to be sent along with the T stop response so
+   that gdb can display the stop location without first fetching all of the registers with a 'g' command.
+
+    Command Format: expedite [RR RR ...]
+                    expedite default
+
+    Where RR is the hexadecimal representation of a gdb register number.  Up to 16 registers can be listed.
+    Without any arguments the current selection is sent to the gdb console.  "default" restores the set which was
+    picked for the platform at build time.  Each value can optionally be prefixed with 0x.
+*/
+static uint32_t handleMonitorExpediteCommand(void)
+{
+    Buffer* pBuffer = GetBuffer();
+    uint8_t registerNumbers[EXPEDITE_MAX_REGISTERS];
+    size_t  count = 0;
+
+    skipSpaces(pBuffer);
+    if (Buffer_BytesLeft(pBuffer) == 0)
+    {
+        DisplayExpeditedRegisters();
+        PrepareStringResponse("OK");
+        return 0;
+    }
+
+    __try
+    {
+        if (matchesMonitorKeyword(pBuffer, "default"))
+        {
+            __throwing_func( throwIfMoreArguments(pBuffer) );
+        }
+        else
+        {
+            __throwing_func( count = readRegisterNumberArguments(pBuffer, registerNumbers, ARRAY_SIZE(registerNumbers)) );
+        }
+        __throwing_func( SetExpeditedRegisters(registerNumbers, count) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static size_t readRegisterNumberArguments(Buffer* pBuffer, uint8_t* pRegisterNumbers, size_t maxCount)
+{
+    size_t count = 0;
+
+    while (Buffer_BytesLeft(pBuffer) > 0)
+    {
+        uint32_t registerNumber;
+
+        __try
+            registerNumber = readMonitorArgument(pBuffer);
+        __catch
+            __rethrow_and_return(0);
+        if (count == maxCount || registerNumber > 0xFF)
+            __throw_and_return(invalidArgumentException, 0);
+        pRegisterNumbers[count++] = (uint8_t)registerNumber;
+        skipSpaces(pBuffer);
+    }
+
+    return count;
+}
+
+
+/* Handle the "monitor fill" command which fills a range of memory with a 32-bit pattern on the target.
+
+    Command Format: fill AAAAAAAA LLLLLLLL PPPPPPPP
+
+    Where AAAAAAAA is the hexadecimal representation of the address at which the fill should start.
+          LLLLLLLL is the hexadecimal representation of the length (in bytes) of the range to be filled.
+          PPPPPPPP is the hexadecimal representation of the 32-bit pattern to be written to each word in the range.
+    Bytes at the unaligned start or end of the range receive the pattern byte for their position within the word.
+    Each value can optionally be prefixed with 0x.
+*/
+static uint32_t handleMonitorFillCommand(void)
+{
+    Buffer*  pBuffer = GetBuffer();
+    uint32_t address;
+    uint32_t length;
+    uint32_t pattern;
+    uint32_t bytesFilled;
+
+    __try
+    {
+        __throwing_func( address = readMonitorArgument(pBuffer) );
+        __throwing_func( length = readMonitorArgument(pBuffer) );
+        __throwing_func( pattern = readMonitorArgument(pBuffer) );
+        __throwing_func( throwIfMoreArguments(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    bytesFilled = FillMemoryWithPattern(ADDR32_TO_POINTER(address), length, pattern);
+    reportMemoryOperationResult("Filled ", bytesFilled, length);
+
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+
+#if MRI_ENABLE_STATS
+/* Handle the "monitor stats" command which reports the cycles spent inside of the debug monitor.  Only available when
+   mri is built with MRI_ENABLE_STATS set to 1.
+
+    Command Format: stats
+                    stats clear
+
+    Each line sent to the gdb console holds the name of what was measured followed by the count, minimum, average,
+    and maximum number of cycles, all in hexadecimal.  "stop" covers each debug exception from entry to exit, "rx"
+    and "tx" each packet received and sent, "cmd:X" the handling of each gdb command character, and "file:NAME" each
+    File-I/O request made for a semihost call.  "clear" resets the stats.  The same text can be read with the
+    qXfer:mri-stats:read packet.
+*/
+static uint32_t handleMonitorStatsCommand(void)
+{
+    Buffer* pBuffer = GetBuffer();
+    int     isClear;
+
+    skipSpaces(pBuffer);
+    isClear = matchesMonitorKeyword(pBuffer, "clear");
+    __try
+        throwIfMoreArguments(pBuffer);
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    if (isClear)
+        ClearStats();
+    else
+        DisplayStats();
+
+    PrepareStringResponse("OK");
+    return 0;
+}
+#endif
+
+
+/* Handle the "monitor watchlog" command which manages a logging watchpoint.  Each write to the watched variable is
+   recorded on the target along with the PC, LR, and cycle count at the time of the write and then the program is
+   resumed without stopping in gdb.
+
+    Command Format: watchlog AAAAAAAA [SS]
+                    watchlog dump
+                    watchlog clear
+                    watchlog off
+
+    Where AAAAAAAA is the hexadecimal representation of the address of the variable to be watched.
+          SS is the hexadecimal representation of the size of the variable (1, 2, or 4 bytes).  Defaults to 4.
+    Arming a new logging watchpoint replaces the previous one.  "dump" sends the logged writes, oldest first, to the
+    gdb console.  "clear" empties the log and "off" removes the logging watchpoint while keeping the log.  Each
+    value can optionally be prefixed with 0x.
+*/
+static uint32_t handleMonitorWatchlogCommand(void)
+{
+    static const struct
+    {
+        void        (*Handler)(void);
+        const char*  pName;
+    } watchlogCommandTable[] =
+    {
+        {DumpWatchLog,      "dump"},
+        {ClearWatchLog,     "clear"},
+        {DisarmWatchLog,    "off"}
+    };
+    Buffer*  pBuffer = GetBuffer();
+    uint32_t address;
+    uint32_t size = 4;
+    size_t   i;
+
+    skipSpaces(pBuffer);
+    for (i = 0 ; i < ARRAY_SIZE(watchlogCommandTable) ; i++)
+    {
+        if (matchesMonitorKeyword(pBuffer, watchlogCommandTable[i].pName))
+        {
+            __try
+                throwIfMoreArguments(pBuffer);
+            __catch
+            {
+                PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+                return 0;
+            }
+            watchlogCommandTable[i].Handler();
+            PrepareStringResponse("OK");
+            return 0;
+        }
+    }
+
+    __try
+    {
+        __throwing_func( address = readMonitorArgument(pBuffer) );
+        skipSpaces(pBuffer);
+        if (Buffer_BytesLeft(pBuffer) > 0)
+        {
+            __throwing_func( size = readMonitorArgument(pBuffer) );
+        }
+        __throwing_func( throwIfMoreArguments(pBuffer) );
+        __throwing_func( ArmWatchLog(address, size) );
+    }
+    __catch
+    {
+        if (getExceptionCode() == exceededHardwareResourcesException)
+            PrepareStringResponse(MRI_ERROR_NO_FREE_BREAKPOINT);
+        else
+            PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    WriteStringToGdbConsole("Logging writes to ");
+    WriteHexValueToGdbConsole(address);
+    WriteStringToGdbConsole(".\n");
+
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static int matchesMonitorKeyword(Buffer* pBuffer, const char* pKeyword)
+{
+    int isMatch = Buffer_MatchesStringFollowedBy(pBuffer, pKeyword, strlen(pKeyword), ' ');
+
+    /* A failed match against text shorter than the keyword leaves a bufferOverrunException behind. */
+    clearExceptionCode();
+    return isMatch;
+}
+
+
+/* Handle the "monitor watchvalue" command which sets a watchpoint that only stops the program when a particular
+   value is written to a variable.
+
+    Command Format: watchvalue AAAAAAAA SS VVVVVVVV
+                    watchvalue off
+
+    Where AAAAAAAA is the hexadecimal representation of the address of the variable to be watched.
+          SS is the hexadecimal representation of the size of the variable (1, 2, or 4 bytes).
+          VVVVVVVV is the hexadecimal representation of the value to stop on.
+    The value is matched by the DWT when a comparator with data value matching is free.  Otherwise the program stops
+    on each write and mri silently resumes it when the value written doesn't match.  Setting a new value watchpoint
+    replaces the previous one.  Each value can optionally be prefixed with 0x.
+*/
+static uint32_t handleMonitorWatchvalueCommand(void)
+{
+    Buffer*  pBuffer = GetBuffer();
+    uint32_t address;
+    uint32_t size;
+    uint32_t value;
+
+    skipSpaces(pBuffer);
+    if (matchesMonitorKeyword(pBuffer, "off"))
+    {
+        __try
+            throwIfMoreArguments(pBuffer);
+        __catch
+        {
+            PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+            return 0;
+        }
+        DisarmValueWatchpoint();
+        PrepareStringResponse("OK");
+        return 0;
+    }
+
+    __try
+    {
+        __throwing_func( address = readMonitorArgument(pBuffer) );
+        __throwing_func( size = readMonitorArgument(pBuffer) );
+        __throwing_func( value = readMonitorArgument(pBuffer) );
+        __throwing_func( throwIfMoreArguments(pBuffer) );
+        __throwing_func( ArmValueWatchpoint(address, size, value) );
+    }
+    __catch
+    {
+        if (getExceptionCode() == exceededHardwareResourcesException)
+            PrepareStringResponse(MRI_ERROR_NO_FREE_BREAKPOINT);
+        else
+            PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    if (IsValueWatchpointMatchedInHardware())
+        WriteStringToGdbConsole("Value watchpoint set with hardware value matching.\n");
+    else
+        WriteStringToGdbConsole("Value watchpoint set with software value matching.\n");
+
+    PrepareStringResponse("OK");
+    return 0;
+}
@@ -18,7 +18,12 @@
 #include "core.h"
 #include "platforms.h"
 #include "mri.h"
+#include "memory.h"
+#include "compress.h"
+#include "stats.h"
 #include "cmd_common.h"
+#include "cmd_monitor.h"
+#include "cmd_trace.h"
 #include "cmd_query.h"
 
 
@@ -39,7 +44,12 @@ static void        readQueryTransferOffsetLengthArguments(Buffer* pBuffer, Annex
 static void        validateAnnexIsNull(const char* pAnnex);
 static void        handleQueryTransferReadCommand(AnnexOffsetLength* pArguments);
 static uint32_t    handleQueryTransferFeaturesCommand(void);
+#if MRI_ENABLE_STATS
+static uint32_t    handleQueryTransferStatsCommand(void);
+#endif
 static void        validateAnnexIs(const char* pAnnex, const char* pExpected);
+static uint32_t    handleQueryBlockHashCommand(void);
+static uint32_t    handleQueryInflateCommand(void);
 /* Handle the 'q' command used by gdb to communicate state to debug monitor and vice versa.
 
     Command Format: qSSS
@@ -50,6 +60,9 @@ uint32_t HandleQueryCommand(void)
     Buffer*             pBuffer = GetBuffer();
     static const char   qSupportedCommand[] = "Supported";
     static const char   qXferCommand[] = "Xfer";
+    static const char   qRcmdCommand[] = "Rcmd";
+    static const char   qMriBlockHashCommand[] = "MriBlockHash";
+    static const char   qMriInflateCommand[] = "MriInflate";
     
     if (Buffer_MatchesString(pBuffer, qSupportedCommand, sizeof(qSupportedCommand)-1))
     {
@@ -59,6 +72,22 @@ uint32_t HandleQueryCommand(void)
     {
         return handleQueryTransferCommand();
     }
+    else if (Buffer_MatchesStringFollowedBy(pBuffer, qRcmdCommand, sizeof(qRcmdCommand)-1, ','))
+    {
+        return HandleMonitorCommand();
+    }
+    else if (Buffer_MatchesString(pBuffer, qMriBlockHashCommand, sizeof(qMriBlockHashCommand)-1))
+    {
+        return handleQueryBlockHashCommand();
+    }
+    else if (Buffer_MatchesString(pBuffer, qMriInflateCommand, sizeof(qMriInflateCommand)-1))
+    {
+        return handleQueryInflateCommand();
+    }
+    else if (Buffer_IsNextCharEqualTo(pBuffer, 'T'))
+    {
+        return HandleTraceQueryCommand();
+    }
     else
     {
         PrepareEmptyResponseForUnknownCommand();
@@ -68,13 +97,13 @@ uint32_t HandleQueryCommand(void)
 
 /* Handle the "qSupported" command used by gdb to communicate state to debug monitor and vice versa.
 
-    Reponse Format: qXfer:memory-map:read+;PacketSize==SSSSSSSS
+    Reponse Format: ConditionalBreakpoints+;ConditionalTracepoints+;BreakpointCommands+;PacketSize=SSSSSSSS
     Where SSSSSSSS is the hexadecimal representation of the maximum packet size support by this stub.
 */
 static uint32_t handleQuerySupportedCommand(void)
 {
-  // static const char querySupportResponse[] = "qXfer:memory-map:read+;qXfer:features:read+;PacketSize=";
-  static const char querySupportResponse[] = "PacketSize=";  /* For RISC-V, temporarily not advertising that the stub supports qXfer
+  // static const char querySupportResponse[] = "qXfer:memory-map:read+;qXfer:features:read+;ConditionalBreakpoints+;ConditionalTracepoints+;BreakpointCommands+;PacketSize=";
+  static const char querySupportResponse[] = "ConditionalBreakpoints+;ConditionalTracepoints+;BreakpointCommands+;PacketSize=";  /* For RISC-V, temporarily not advertising that the stub supports qXfer
 								memory map reading or features reading.  Will try to reenable that
 								at some point */
     uint32_t          PacketSize = Platform_GetPacketBufferSize();
@@ -91,12 +120,17 @@ static uint32_t handleQuerySupportedCommand(void)
     Command Format: qXfer:object:read:annex:offset,length
     Where supported objects are currently:
         memory-map
+        features
+        mri-stats (when built with MRI_ENABLE_STATS)
 */
 static uint32_t handleQueryTransferCommand(void)
 {
     Buffer*             pBuffer =GetBuffer();
     static const char   memoryMapObject[] = "memory-map";
     static const char   featureObject[] = "features";
+#if MRI_ENABLE_STATS
+    static const char   statsObject[] = "mri-stats";
+#endif
     
     if (!Buffer_IsNextCharEqualTo(pBuffer, ':'))
     {
@@ -112,6 +146,12 @@ static uint32_t handleQueryTransferCommand(void)
     {
         return handleQueryTransferFeaturesCommand();
     }
+#if MRI_ENABLE_STATS
+    else if (Buffer_MatchesString(pBuffer, statsObject, sizeof(statsObject)-1))
+    {
+        return handleQueryTransferStatsCommand();
+    }
+#endif
     else
     {
         PrepareEmptyResponseForUnknownCommand();
@@ -271,3 +311,176 @@ static void validateAnnexIs(const char* pAnnex, const char* pExpected)
     if (pAnnex == NULL || 0 != strcmp(pAnnex, pExpected))
         __throw(invalidArgumentException);
 }
+
+
+#if MRI_ENABLE_STATS
+/* Handle the "qXfer:mri-stats" command used to read the debug monitor's cycle count stats in the same comma separated
+   format as "monitor stats".
+
+    Command Format: qXfer:mri-stats:read::offset,length
+*/
+static uint32_t handleQueryTransferStatsCommand(void)
+{
+    Buffer*             pBuffer = GetBuffer();
+    AnnexOffsetLength   arguments;
+    
+    __try
+    {
+        __throwing_func( readQueryTransferReadArguments(pBuffer, &arguments) );
+        __throwing_func( validateAnnexIsNull(arguments.pAnnex) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    WriteStatsTransferData(GetInitializedBuffer(), arguments.offset, arguments.length);
+    
+    return 0;
+}
+#endif
+
+
+static void writeBlockHashToBuffer(Buffer* pBuffer, uint32_t hash);
+/* Handle the "qMriBlockHash" command used by host tools to find which blocks of a memory range need to be reloaded.
+
+    Command Format: qMriBlockHash:AAAAAAAA,LLLLLLLL,BBBBBBBB
+    Response Format: HHHHHHHH...
+
+    Where AAAAAAAA is the hexadecimal representation of the address at which the range starts.
+          LLLLLLLL is the hexadecimal representation of the length (in bytes) of the range.
+          BBBBBBBB is the hexadecimal representation of the size (in bytes) of each block.  The last block is shorter
+                   if the length isn't a multiple of the block size.
+          HHHHHHHH is the 8 digit hexadecimal representation of the hash for each block, most significant digit first.
+    The hash is run over the little endian 32-bit words of each block, with the last partial word zero padded:
+        hash = 0x811C9DC5
+        for each word: hash = (rotate_left(hash, 5) ^ word) * 0x9E3779B1
+*/
+static uint32_t handleQueryBlockHashCommand(void)
+{
+    Buffer*       pBuffer = GetBuffer();
+    AddressLength arguments;
+    uint32_t      blockSize;
+    uint32_t      blockCount;
+    uint8_t*      p;
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( ReadAddressAndLengthArguments(pBuffer, &arguments) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+        __throwing_func( blockSize = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+    if (arguments.length == 0 || blockSize == 0)
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    blockCount = arguments.length / blockSize + (arguments.length % blockSize != 0);
+    InitBuffer();
+    if (blockCount > Buffer_BytesLeft(pBuffer) / 8)
+    {
+        PrepareStringResponse(MRI_ERROR_BUFFER_OVERRUN);
+        return 0;
+    }
+
+    p = ADDR32_TO_POINTER(arguments.address);
+    while (arguments.length > 0)
+    {
+        uint32_t length = arguments.length < blockSize ? arguments.length : blockSize;
+        uint32_t hash;
+
+        if (!HashMemoryBlock(p, length, &hash))
+        {
+            PrepareStringResponse(MRI_ERROR_MEMORY_ACCESS_FAILURE);
+            return 0;
+        }
+        writeBlockHashToBuffer(pBuffer, hash);
+        p += length;
+        arguments.length -= length;
+    }
+
+    return 0;
+}
+
+static void writeBlockHashToBuffer(Buffer* pBuffer, uint32_t hash)
+{
+    int shift;
+
+    for (shift = 24 ; shift >= 0 ; shift -= 8)
+        Buffer_WriteByteAsHex(pBuffer, (uint8_t)(hash >> shift));
+}
+
+
+/* Handle the "qMriInflate" command used by host tools to download compressed data into memory.
+
+    Command Format: qMriInflate:AAAAAAAA,LLLLLLLL[,HHHHHHHH]:xx...
+    Response Format: OK
+
+    Where AAAAAAAA is the hexadecimal representation of the address at which the decompressed data is to be written.
+          LLLLLLLL is the hexadecimal representation of the length (in bytes) of the decompressed data.
+          HHHHHHHH is the optional hexadecimal representation of the number of bytes just below AAAAAAAA which were
+                   written by earlier qMriInflate commands of the same download.  Defaults to 0.
+          xx... is a block of compressed data (as described in compress.h), escaped the same way as the data in an
+                'X' command.
+    Back-references in the compressed data can only reach the data written by this command and the HHHHHHHH bytes of
+    history before it.  That history must lie within mapped memory.
+*/
+static uint32_t handleQueryInflateCommand(void)
+{
+    Buffer*        pBuffer = GetBuffer();
+    AddressLength  arguments;
+    uint32_t       historyLength = 0;
+    const uint8_t* pCompressed;
+    uint32_t       compressedLength;
+    int            wasDecoded;
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( ReadAddressAndLengthArguments(pBuffer, &arguments) );
+        if (Buffer_BytesLeft(pBuffer) && Buffer_IsNextCharEqualTo(pBuffer, ','))
+        {
+            __throwing_func( historyLength = ReadUIntegerArgument(pBuffer) );
+        }
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( Buffer_UnescapeBinaryInPlace(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+    if (historyLength > arguments.address)
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+    if (historyLength > 0 &&
+        GetMemoryTypeOfRange(ADDR32_TO_POINTER(arguments.address - historyLength), historyLength) ==
+            MRI_PLATFORM_MEMORY_UNMAPPED)
+    {
+        PrepareStringResponse(MRI_ERROR_MEMORY_ACCESS_FAILURE);
+        return 0;
+    }
+
+    compressedLength = (uint32_t)Buffer_BytesLeft(pBuffer);
+    pCompressed = (const uint8_t*)Buffer_GetArray(pBuffer) + Buffer_GetLength(pBuffer) - compressedLength;
+    wasDecoded = DecompressToMemory(ADDR32_TO_POINTER(arguments.address), arguments.length, historyLength,
+                                    pCompressed, compressedLength);
+    if (Platform_WasMemoryFaultEncountered())
+        PrepareStringResponse(MRI_ERROR_MEMORY_ACCESS_FAILURE);
+    else if (!wasDecoded)
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+    else
+        PrepareStringResponse("OK");
+
+    return 0;
+}
@@ -18,6 +18,8 @@
 #include "buffer.h"
 #include "core.h"
 #include "mri.h"
+#include "tracepoints.h"
+#include "expedite.h"
 #include "cmd_registers.h"
 
 
@@ -30,6 +32,7 @@
              contents in the g response packet and the SContext structure.
           xxxxxxxx is the 32-bit value of the specified register in hex format.
           The above ii:xxxxxxxx; patterns can be repeated for whichever register values should be sent with T repsonse.
+    The platform picks the registers to be sent unless they have been overridden with "monitor expedite".
 */
 uint32_t Send_T_StopResponse(void)
 {
@@ -37,7 +40,7 @@ uint32_t Send_T_StopResponse(void)
     
     Buffer_WriteChar(pBuffer, 'T');
     Buffer_WriteByteAsHex(pBuffer, GetSignalValue());
-    Platform_WriteTResponseRegistersToBuffer(pBuffer);
+    WriteExpeditedRegistersToBuffer(pBuffer);
 
     SendPacketToGdb();
     return HANDLER_RETURN_RETURN_IMMEDIATELY;
@@ -52,10 +55,14 @@ uint32_t Send_T_StopResponse(void)
     Where xxxxxxxx is the hexadecimal representation of the 32-bit R0 register.
           yyyyyyyy is the hexadecimal representation of the 32-bit R1 register.
           ... and so on through the members of the SContext structure.
+    The registers come from the trace frame instead when one has been selected with QTFrame.
 */
 uint32_t HandleRegisterReadCommand(void)
 {
-    Platform_CopyContextToBuffer(GetInitializedBuffer());
+    if (IsTraceFrameSelected())
+        WriteTraceFrameRegisters(GetInitializedBuffer());
+    else
+        Platform_CopyContextToBuffer(GetInitializedBuffer());
 
     return 0;
 }
@@ -13,11 +13,15 @@
    limitations under the License.
 */
 /* Handler for single step gdb command. */
+#include "buffer.h"
+#include "core.h"
 #include "platforms.h"
+#include "mri.h"
 #include "cmd_common.h"
 #include "cmd_continue.h"
 #include "cmd_registers.h"
 #include "cmd_step.h"
+#include "rangestep.h"
 
 
 static uint32_t justAdvancedPastBreakpoint(uint32_t continueReturn);
@@ -75,3 +79,44 @@ uint32_t HandleSingleStepWithSignalCommand(void)
 
     return returnValue;
 }
+
+
+/* Handle the 'r' action of the 'vCont' command which is sent from gdb to tell the debugger to keep stepping the
+   currently halted program for as long as its program counter stays within an address range.
+   
+    Command Format:     rAAAAAAAA,BBBBBBBB
+    Response Format:    Blank until the next exception, at which time a 'T' stop response packet will be sent.
+
+    Where AAAAAAAA is the address of the first instruction in the range, and
+          BBBBBBBB is the address just past the end of the range.
+*/
+uint32_t HandleRangeStepCommand(void)
+{
+    Buffer*     pBuffer = GetBuffer();
+    uint32_t    start = 0;
+    uint32_t    end = 0;
+    uint32_t    returnValue;
+
+    __try
+    {
+        __throwing_func( start = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+        __throwing_func( end = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    returnValue = HandleContinueCommand();
+    if (justAdvancedPastBreakpoint(returnValue))
+    {
+        /* Treat the advance as the single step and don't resume execution. */
+        return Send_T_StopResponse();
+    }
+
+    if (returnValue)
+        StartRangeStep(start, end);
+    return returnValue;
+}
@@ -0,0 +1,464 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Handlers for the gdb commands which define, run, and inspect trace experiments. */
+#include <string.h>
+#include "core.h"
+#include "mri.h"
+#include "cmd_common.h"
+#include "tracepoints.h"
+#include "cmd_trace.h"
+
+
+#define ARRAY_SIZE(X) (sizeof(X)/sizeof(X[0]))
+
+typedef struct
+{
+    uint32_t     (*Handler)(void);
+    const char*  pName;
+} TraceCommand;
+
+static uint32_t dispatchTraceCommand(const TraceCommand* pCommands, size_t commandCount);
+static uint32_t handleTraceInitCommand(void);
+static uint32_t handleTraceDefineTracepointCommand(void);
+static uint32_t handleTraceDefineVariableCommand(void);
+static uint32_t handleTraceDefineCommand(void (*defineFunc)(Buffer*));
+static uint32_t handleTraceStartCommand(void);
+static uint32_t handleTraceStopCommand(void);
+static uint32_t handleTraceFrameCommand(void);
+static uint32_t handleTraceBufferCommand(void);
+static uint32_t handleTraceAcceptedCommand(void);
+static void     prepareTraceErrorResponse(void);
+/* Handle the 'Q' commands used by gdb to define and control trace experiments.
+
+    Command Format: QTSSS
+    Where SSS is the name of the trace command followed by its arguments.
+*/
+uint32_t HandleTraceSetCommand(void)
+{
+    static const TraceCommand traceSetCommandTable[] =
+    {
+        {handleTraceInitCommand,                "init"},
+        {handleTraceDefineTracepointCommand,    "DP"},
+        {handleTraceDefineVariableCommand,      "DV"},
+        {handleTraceStartCommand,               "Start"},
+        {handleTraceStopCommand,                "Stop"},
+        {handleTraceFrameCommand,               "Frame"},
+        {handleTraceBufferCommand,              "Buffer"},
+        {handleTraceAcceptedCommand,            "ro"},
+        {handleTraceAcceptedCommand,            "Disconnected"},
+        {handleTraceAcceptedCommand,            "Notes"}
+    };
+    Buffer* pBuffer = GetBuffer();
+
+    if (Buffer_BytesLeft(pBuffer) == 0 || !Buffer_IsNextCharEqualTo(pBuffer, 'T'))
+    {
+        PrepareEmptyResponseForUnknownCommand();
+        return 0;
+    }
+    return dispatchTraceCommand(traceSetCommandTable, ARRAY_SIZE(traceSetCommandTable));
+}
+
+static uint32_t dispatchTraceCommand(const TraceCommand* pCommands, size_t commandCount)
+{
+    Buffer* pBuffer = GetBuffer();
+    size_t  i;
+
+    for (i = 0 ; i < commandCount ; i++)
+    {
+        if (Buffer_MatchesString(pBuffer, pCommands[i].pName, strlen(pCommands[i].pName)))
+        {
+            /* Command names longer than the packet will have thrown while searching the table. */
+            clearExceptionCode();
+            return pCommands[i].Handler();
+        }
+    }
+    clearExceptionCode();
+
+    PrepareEmptyResponseForUnknownCommand();
+    return 0;
+}
+
+/* Handle the "QTinit" command used by gdb to discard all tracepoints and collected trace frames.
+
+    Command Format: QTinit
+    Response Format: OK
+*/
+static uint32_t handleTraceInitCommand(void)
+{
+    StopTracing();
+    InitTracepoints();
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static uint32_t handleTraceDefineTracepointCommand(void)
+{
+    return handleTraceDefineCommand(DefineTracepoint);
+}
+
+static uint32_t handleTraceDefineVariableCommand(void)
+{
+    return handleTraceDefineCommand(DefineTraceVariable);
+}
+
+/* Handle the "QTDP" and "QTDV" commands used by gdb to download tracepoints and trace state variables.
+
+    Command Format: QTDP:n:addr:E|D:step:pass[:Xlen,bytecode][-]
+                    QTDP:-n:addr:action[-]
+                    QTDV:n:value:builtin:name
+    Response Format: OK
+    Where action is one of
+            R mask: collect the registers.  All of the registers are collected in every frame no matter what.
+            M basereg,offset,length: collect length bytes of memory at the offset from basereg.
+            X len,bytecode: evaluate an agent expression which collects data with trace opcodes.
+*/
+static uint32_t handleTraceDefineCommand(void (*defineFunc)(Buffer*))
+{
+    Buffer* pBuffer = GetBuffer();
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( defineFunc(pBuffer) );
+    }
+    __catch
+    {
+        prepareTraceErrorResponse();
+        return 0;
+    }
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+/* Handle the "QTStart" command used by gdb to start a new trace experiment.
+
+    Command Format: QTStart
+    Response Format: OK
+*/
+static uint32_t handleTraceStartCommand(void)
+{
+    __try
+        StartTracing();
+    __catch
+    {
+        prepareTraceErrorResponse();
+        return 0;
+    }
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+/* Handle the "QTStop" command used by gdb to end the current trace experiment.
+
+    Command Format: QTStop
+    Response Format: OK
+*/
+static uint32_t handleTraceStopCommand(void)
+{
+    StopTracing();
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static int readTraceFindArguments(Buffer* pBuffer, TraceFindType* pType, uint32_t* pValue1, uint32_t* pValue2);
+/* Handle the "QTFrame" command used by gdb to select a frame from the trace buffer.
+
+    Command Format: QTFrame:n
+                    QTFrame:pc:addr
+                    QTFrame:tdp:t
+                    QTFrame:range:start:end
+                    QTFrame:outside:start:end
+    Response Format: FfffTttt
+                     F-1
+    Where n is the number of the frame to select or ffffffff to go back to the live program.
+          The other forms select the next frame after the current one which was collected at addr, by tracepoint
+          t, or at an address inside/outside the inclusive range from start to end.
+          ffff is the number of the frame selected and tttt is the number of the tracepoint which collected it.  F-1
+          is sent when no frame was selected.
+*/
+static uint32_t handleTraceFrameCommand(void)
+{
+    Buffer*       pBuffer = GetBuffer();
+    TraceFindType type;
+    uint32_t      value1;
+    uint32_t      value2 = 0;
+    int           frame;
+
+    if (!readTraceFindArguments(pBuffer, &type, &value1, &value2))
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    frame = FindTraceFrame(type, value1, value2);
+    pBuffer = GetInitializedBuffer();
+    if (frame < 0)
+    {
+        Buffer_WriteString(pBuffer, "F-1");
+        return 0;
+    }
+    Buffer_WriteChar(pBuffer, 'F');
+    Buffer_WriteUIntegerAsHex(pBuffer, (uint32_t)frame);
+    Buffer_WriteChar(pBuffer, 'T');
+    Buffer_WriteUIntegerAsHex(pBuffer, (uint32_t)GetSelectedTraceFrameTracepoint());
+    return 0;
+}
+
+static int readTraceFindArguments(Buffer* pBuffer, TraceFindType* pType, uint32_t* pValue1, uint32_t* pValue2)
+{
+    static const char   pcArgument[] = "pc";
+    static const char   tracepointArgument[] = "tdp";
+    static const char   rangeArgument[] = "range";
+    static const char   outsideArgument[] = "outside";
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        if (Buffer_MatchesString(pBuffer, pcArgument, sizeof(pcArgument)-1))
+            *pType = MRI_TRACE_FIND_PC;
+        else if (Buffer_MatchesString(pBuffer, tracepointArgument, sizeof(tracepointArgument)-1))
+            *pType = MRI_TRACE_FIND_TRACEPOINT;
+        else if (Buffer_MatchesString(pBuffer, rangeArgument, sizeof(rangeArgument)-1))
+            *pType = MRI_TRACE_FIND_INSIDE_RANGE;
+        else if (Buffer_MatchesString(pBuffer, outsideArgument, sizeof(outsideArgument)-1))
+            *pType = MRI_TRACE_FIND_OUTSIDE_RANGE;
+        else
+            *pType = MRI_TRACE_FIND_FRAME;
+        clearExceptionCode();
+
+        if (*pType != MRI_TRACE_FIND_FRAME)
+        {
+            __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        }
+        __throwing_func( *pValue1 = ReadUIntegerArgument(pBuffer) );
+        if (*pType == MRI_TRACE_FIND_INSIDE_RANGE || *pType == MRI_TRACE_FIND_OUTSIDE_RANGE)
+        {
+            __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+            __throwing_func( *pValue2 = ReadUIntegerArgument(pBuffer) );
+        }
+    }
+    __catch
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+/* Handle the "QTBuffer" command used by gdb to configure the trace buffer.
+
+    Command Format: QTBuffer:circular:n
+    Response Format: OK
+    Where n is 1 to discard the oldest frames when the buffer fills up or 0 to stop tracing instead.
+*/
+static uint32_t handleTraceBufferCommand(void)
+{
+    Buffer*             pBuffer = GetBuffer();
+    static const char   circularArgument[] = "circular";
+    uint32_t            isCircular;
+
+    if (!Buffer_IsNextCharEqualTo(pBuffer, ':') ||
+        !Buffer_MatchesString(pBuffer, circularArgument, sizeof(circularArgument)-1))
+    {
+        /* The size of the trace buffer is fixed at build time. */
+        PrepareEmptyResponseForUnknownCommand();
+        return 0;
+    }
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( isCircular = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+    SetTraceBufferCircular(isCircular != 0);
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+/* Handle the "QTro", "QTDisconnected", and "QTNotes" commands which are just accepted.  Flash is always read from
+   the device while looking at a trace frame, tracing doesn't continue past a disconnect, and notes aren't kept.
+
+    Command Format: QTro:start,end...
+                    QTDisconnected:n
+                    QTNotes:type:text...
+    Response Format: OK
+*/
+static uint32_t handleTraceAcceptedCommand(void)
+{
+    PrepareStringResponse("OK");
+    return 0;
+}
+
+static void prepareTraceErrorResponse(void)
+{
+    switch (getExceptionCode())
+    {
+    case exceededHardwareResourcesException:
+        PrepareStringResponse(MRI_ERROR_NO_FREE_BREAKPOINT);
+        break;
+    case invalidArgumentException:
+    default:
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        break;
+    }
+}
+
+
+static uint32_t handleTraceStatusCommand(void);
+static uint32_t handleFirstTracepointUploadCommand(void);
+static uint32_t handleNextTracepointUploadCommand(void);
+static uint32_t handleTracepointUploadCommand(int isFirst);
+static uint32_t handleTraceVariableUploadCommand(void);
+static uint32_t handleTracepointStatusCommand(void);
+static uint32_t handleTraceVariableValueCommand(void);
+/* Handle the 'qT' commands used by gdb to query the state of trace experiments.
+
+    Command Format: qTSSS
+    Where SSS is the name of the trace query followed by its arguments.
+*/
+uint32_t HandleTraceQueryCommand(void)
+{
+    static const TraceCommand traceQueryCommandTable[] =
+    {
+        {handleTraceStatusCommand,              "Status"},
+        {handleFirstTracepointUploadCommand,    "fP"},
+        {handleNextTracepointUploadCommand,     "sP"},
+        {handleTraceVariableUploadCommand,      "fV"},
+        {handleTraceVariableUploadCommand,      "sV"},
+        {handleTracepointStatusCommand,         "P"},
+        {handleTraceVariableValueCommand,       "V"}
+    };
+
+    return dispatchTraceCommand(traceQueryCommandTable, ARRAY_SIZE(traceQueryCommandTable));
+}
+
+/* Handle the "qTStatus" command used by gdb to query the state of the current trace experiment.
+
+    Command Format: qTStatus
+    Response Format: T0|T1;tnotrun:0|tstop:0|tfull:0|tpasscount:n;tframes:n;tcreated:n;tfree:n;tsize:n;...
+*/
+static uint32_t handleTraceStatusCommand(void)
+{
+    WriteTraceStatus(GetInitializedBuffer());
+    return 0;
+}
+
+static uint32_t handleFirstTracepointUploadCommand(void)
+{
+    return handleTracepointUploadCommand(1);
+}
+
+static uint32_t handleNextTracepointUploadCommand(void)
+{
+    return handleTracepointUploadCommand(0);
+}
+
+/* Handle the "qTfP" and "qTsP" commands used by gdb to upload the tracepoints defined on the target.
+
+    Command Format: qTfP
+                    qTsP
+    Response Format: Tn:addr:E|D:step:pass
+                     l
+    Where l indicates that there are no more tracepoints.
+*/
+static uint32_t handleTracepointUploadCommand(int isFirst)
+{
+    static uint32_t nextIndex;
+    Buffer*         pBuffer = GetInitializedBuffer();
+
+    if (isFirst)
+        nextIndex = 0;
+    if (!WriteTracepointDefinition(pBuffer, nextIndex))
+    {
+        Buffer_WriteChar(pBuffer, 'l');
+        return 0;
+    }
+    nextIndex++;
+    return 0;
+}
+
+/* Handle the "qTfV" and "qTsV" commands used by gdb to upload the trace state variables defined on the target.
+   Their names aren't kept on the target so there is never anything to upload.
+
+    Command Format: qTfV
+                    qTsV
+    Response Format: l
+*/
+static uint32_t handleTraceVariableUploadCommand(void)
+{
+    PrepareStringResponse("l");
+    return 0;
+}
+
+/* Handle the "qTP" command used by gdb to fetch the hit count of a tracepoint location.
+
+    Command Format: qTP:n:addr
+    Response Format: Vhits:usage
+*/
+static uint32_t handleTracepointStatusCommand(void)
+{
+    Buffer*  pBuffer = GetBuffer();
+    uint32_t number;
+    uint32_t address;
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( number = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( address = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    if (!WriteTracepointHitCount(GetInitializedBuffer(), number, address))
+        PrepareEmptyResponseForUnknownCommand();
+    return 0;
+}
+
+/* Handle the "qTV" command used by gdb to fetch the value of a trace state variable.
+
+    Command Format: qTV:n
+    Response Format: Vvalue
+                     U
+    Where U indicates that the value is unknown.
+*/
+static uint32_t handleTraceVariableValueCommand(void)
+{
+    Buffer*  pBuffer = GetBuffer();
+    uint32_t number;
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( number = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+
+    WriteTraceVariableValue(GetInitializedBuffer(), number);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Handler for gdb's vCont packets. */
+#include "buffer.h"
+#include "core.h"
+#include "mri.h"
+#include "cmd_common.h"
+#include "cmd_continue.h"
+#include "cmd_step.h"
+#include "cmd_vcont.h"
+
+
+static uint32_t handleVContQueryCommand(void);
+static uint32_t handleVContCommand(void);
+/* Handle the 'v' command which gdb uses for its packets with multi-letter names.  Only vCont? and vCont are
+   supported.  The others get an empty response which tells gdb that they aren't supported.
+
+    Command Format: vSSS
+    Where SSS is the rest of the packet's name followed by its arguments.
+*/
+uint32_t HandleVCommand(void)
+{
+    Buffer*             pBuffer = GetBuffer();
+    static const char   vContQueryCommand[] = "Cont?";
+    static const char   vContCommand[] = "Cont";
+
+    if (Buffer_MatchesString(pBuffer, vContQueryCommand, sizeof(vContQueryCommand)-1))
+    {
+        return handleVContQueryCommand();
+    }
+    else if (Buffer_MatchesStringFollowedBy(pBuffer, vContCommand, sizeof(vContCommand)-1, ';'))
+    {
+        return handleVContCommand();
+    }
+    else
+    {
+        clearExceptionCode();
+        PrepareEmptyResponseForUnknownCommand();
+        return 0;
+    }
+}
+
+/* Handle the 'vCont?' command which is sent from gdb to find out which vCont actions are supported.
+
+    Command Format: vCont?
+    Response Format: vCont;c;C;s;S;r
+*/
+static uint32_t handleVContQueryCommand(void)
+{
+    PrepareStringResponse("vCont;c;C;s;S;r");
+    return 0;
+}
+
+static void ignoreThreadIdAndLaterActions(Buffer* pBuffer);
+/* Handle the 'vCont' command which is sent from gdb to resume the program with a separate action for each thread.
+   MRI only has the one thread so the first action is used and the rest of the packet is ignored.
+
+    Command Format: vCont;A[:TT][;A[:TT]]...
+    Response Format: Blank until the next exception, at which time a 'T' stop response packet will be sent.
+
+    Where A is one of the following actions along with any arguments it takes:
+            c               Continue.
+            CSS             Continue with signal SS, which MRI ignores.
+            s               Single step.
+            SSS             Single step with signal SS, which MRI ignores.
+            rAAAA,BBBB      Keep stepping while the program counter is within the range AAAA up to BBBB.
+          TT is the optional id of the thread to which the action applies.
+*/
+static uint32_t handleVContCommand(void)
+{
+    Buffer* pBuffer = GetBuffer();
+    char    action = '\0';
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ';') );
+        __throwing_func( action = Buffer_ReadChar(pBuffer) );
+    }
+    __catch
+    {
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+    ignoreThreadIdAndLaterActions(pBuffer);
+
+    switch (action)
+    {
+    case 'c':
+        return HandleContinueCommand();
+    case 'C':
+        return HandleContinueWithSignalCommand();
+    case 's':
+        return HandleSingleStepCommand();
+    case 'S':
+        return HandleSingleStepWithSignalCommand();
+    case 'r':
+        return HandleRangeStepCommand();
+    default:
+        PrepareStringResponse(MRI_ERROR_INVALID_ARGUMENT);
+        return 0;
+    }
+}
+
+static void ignoreThreadIdAndLaterActions(Buffer* pBuffer)
+{
+    /* Truncate the packet at the end of the first action so that its handler doesn't try to parse the rest. */
+    char* pActionEnd = pBuffer->pCurrent;
+
+    while (pActionEnd < pBuffer->pEnd && *pActionEnd != ':' && *pActionEnd != ';')
+        pActionEnd++;
+    pBuffer->pEnd = pActionEnd;
+}
@@ -0,0 +1,268 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* LZ4 style compression routines used to move large blocks of memory between gdb and the target more quickly. */
+#include "platforms.h"
+#include "compress.h"
+
+
+#define MIN_MATCH_LENGTH    4
+#define LENGTH_NIBBLE_MAX   15
+#define HASH_MULTIPLIER     2654435761U
+
+void Compress_Init(CompressState* pState, const void* pvSrc, uint32_t srcLength, uint32_t* pHashTable, uint32_t hashBits)
+{
+    uint32_t i;
+
+    pState->pSrc = (const uint8_t*)pvSrc;
+    pState->pHashTable = pHashTable;
+    pState->hashBits = hashBits;
+    pState->srcLength = srcLength;
+    pState->srcOffset = 0;
+    for (i = 0 ; i < (1U << hashBits) ; i++)
+        pHashTable[i] = 0;
+}
+
+
+static uint32_t readSourceWord(const CompressState* pState, uint32_t offset);
+static uint32_t hashWord(const CompressState* pState, uint32_t word);
+static uint32_t findMatchLength(const CompressState* pState, uint32_t matchOffset, uint32_t offset);
+static uint32_t sequenceSize(uint32_t literalCount, uint32_t matchLength);
+static uint32_t extendedLengthSize(uint32_t length);
+static uint32_t literalsWhichFit(uint32_t destSize);
+static uint8_t* writeSequence(const CompressState* pState, uint8_t* pDest, uint32_t anchor, uint32_t literalCount,
+                              uint32_t offset, uint32_t matchLength);
+static uint8_t* writeExtendedLength(uint8_t* pDest, uint32_t length);
+/* Compresses as much of the remaining source data as will fit in destSize bytes (which must be at least 2) and
+   returns the number of compressed bytes written to pDest.  pState->srcOffset is advanced past the source bytes which
+   were consumed. */
+uint32_t Compress_NextBlock(CompressState* pState, uint8_t* pDest, uint32_t destSize)
+{
+    uint8_t* pOutput = pDest;
+    uint32_t anchor = pState->srcOffset;
+    uint32_t offset = anchor;
+    uint32_t literalCount;
+
+    /* Greedy LZ4 style parse which looks up the last position with the same 4 byte prefix in a hash table. */
+    while (offset + MIN_MATCH_LENGTH <= pState->srcLength)
+    {
+        uint32_t word = readSourceWord(pState, offset);
+        uint32_t hash = hashWord(pState, word);
+        uint32_t candidate = pState->pHashTable[hash];
+
+        /* Table entries are offset + 1 so that 0 can mark an empty slot.  A block which ran out of room can leave an
+           entry for the current offset itself so only accept candidates which come earlier in the source. */
+        pState->pHashTable[hash] = offset + 1;
+        if (candidate != 0 && candidate <= offset && offset - (candidate - 1) <= COMPRESS_MAX_OFFSET &&
+            readSourceWord(pState, candidate - 1) == word)
+        {
+            uint32_t matchLength = findMatchLength(pState, candidate - 1, offset);
+
+            if (sequenceSize(offset - anchor, matchLength) > destSize - (uint32_t)(pOutput - pDest))
+                break;
+            pOutput = writeSequence(pState, pOutput, anchor, offset - anchor, offset - (candidate - 1), matchLength);
+            offset += matchLength;
+            anchor = offset;
+        }
+        else
+        {
+            offset++;
+        }
+    }
+
+    /* Finish the block with a literal only sequence, containing as much of the unmatched input as will fit. */
+    literalCount = literalsWhichFit(destSize - (uint32_t)(pOutput - pDest));
+    if (literalCount > pState->srcLength - anchor)
+        literalCount = pState->srcLength - anchor;
+    if (literalCount > 0)
+        pOutput = writeSequence(pState, pOutput, anchor, literalCount, 0, 0);
+    pState->srcOffset = anchor + literalCount;
+
+    return (uint32_t)(pOutput - pDest);
+}
+
+static uint32_t readSourceWord(const CompressState* pState, uint32_t offset)
+{
+    const uint8_t* p = pState->pSrc + offset;
+
+    return (uint32_t)Platform_MemRead8(p) |
+           (uint32_t)Platform_MemRead8(p + 1) << 8 |
+           (uint32_t)Platform_MemRead8(p + 2) << 16 |
+           (uint32_t)Platform_MemRead8(p + 3) << 24;
+}
+
+static uint32_t hashWord(const CompressState* pState, uint32_t word)
+{
+    return (uint32_t)(word * HASH_MULTIPLIER) >> (32 - pState->hashBits);
+}
+
+static uint32_t findMatchLength(const CompressState* pState, uint32_t matchOffset, uint32_t offset)
+{
+    uint32_t length = MIN_MATCH_LENGTH;
+
+    while (offset + length < pState->srcLength &&
+           Platform_MemRead8(pState->pSrc + matchOffset + length) == Platform_MemRead8(pState->pSrc + offset + length))
+    {
+        length++;
+    }
+
+    return length;
+}
+
+static uint32_t sequenceSize(uint32_t literalCount, uint32_t matchLength)
+{
+    uint32_t size = 1 + extendedLengthSize(literalCount) + literalCount;
+
+    if (matchLength > 0)
+        size += 2 + extendedLengthSize(matchLength - MIN_MATCH_LENGTH);
+
+    return size;
+}
+
+static uint32_t extendedLengthSize(uint32_t length)
+{
+    if (length < LENGTH_NIBBLE_MAX)
+        return 0;
+    return (length - LENGTH_NIBBLE_MAX) / 255 + 1;
+}
+
+static uint32_t literalsWhichFit(uint32_t destSize)
+{
+    uint32_t literalCount;
+
+    if (destSize <= 1)
+        return 0;
+    literalCount = destSize - 1 - extendedLengthSize(destSize - 1);
+    while (sequenceSize(literalCount, 0) > destSize)
+        literalCount--;
+
+    return literalCount;
+}
+
+static uint8_t* writeSequence(const CompressState* pState, uint8_t* pDest, uint32_t anchor, uint32_t literalCount,
+                              uint32_t offset, uint32_t matchLength)
+{
+    uint8_t  token;
+    uint32_t i;
+
+    token = (uint8_t)((literalCount < LENGTH_NIBBLE_MAX ? literalCount : LENGTH_NIBBLE_MAX) << 4);
+    if (matchLength > 0)
+    {
+        uint32_t extraMatchLength = matchLength - MIN_MATCH_LENGTH;
+
+        token |= (uint8_t)(extraMatchLength < LENGTH_NIBBLE_MAX ? extraMatchLength : LENGTH_NIBBLE_MAX);
+    }
+    *pDest++ = token;
+    if (literalCount >= LENGTH_NIBBLE_MAX)
+        pDest = writeExtendedLength(pDest, literalCount - LENGTH_NIBBLE_MAX);
+    for (i = 0 ; i < literalCount ; i++)
+        *pDest++ = Platform_MemRead8(pState->pSrc + anchor + i);
+    if (matchLength == 0)
+        return pDest;
+
+    *pDest++ = (uint8_t)offset;
+    *pDest++ = (uint8_t)(offset >> 8);
+    if (matchLength - MIN_MATCH_LENGTH >= LENGTH_NIBBLE_MAX)
+        pDest = writeExtendedLength(pDest, matchLength - MIN_MATCH_LENGTH - LENGTH_NIBBLE_MAX);
+
+    return pDest;
+}
+
+static uint8_t* writeExtendedLength(uint8_t* pDest, uint32_t length)
+{
+    while (length >= 255)
+    {
+        *pDest++ = 255;
+        length -= 255;
+    }
+    *pDest++ = (uint8_t)length;
+
+    return pDest;
+}
+
+
+static int readExtendedLength(const uint8_t** ppSrc, const uint8_t* pSrcEnd, uint32_t* pLength);
+static int isOffsetWithinHistory(uint32_t offset, uint32_t bytesWritten, uint32_t historyLength);
+/* Decompresses a block into memory, returning non-zero if it decoded cleanly into exactly destLength bytes.
+   Back-references can reach up to historyLength bytes before pvDest.  The caller is responsible for checking
+   Platform_WasMemoryFaultEncountered() afterwards. */
+int DecompressToMemory(void* pvDest, uint32_t destLength, uint32_t historyLength, const uint8_t* pSrc, uint32_t srcLength)
+{
+    uint8_t*       pDest = (uint8_t*)pvDest;
+    uint32_t       bytesLeft = destLength;
+    const uint8_t* pSrcEnd = pSrc + srcLength;
+
+    while (pSrc < pSrcEnd)
+    {
+        uint8_t        token = *pSrc++;
+        uint32_t       literalCount = token >> 4;
+        uint32_t       matchLength = token & LENGTH_NIBBLE_MAX;
+        uint32_t       offset;
+        const uint8_t* pMatch;
+
+        if (literalCount == LENGTH_NIBBLE_MAX && !readExtendedLength(&pSrc, pSrcEnd, &literalCount))
+            return 0;
+        if (literalCount > (uint32_t)(pSrcEnd - pSrc) || literalCount > bytesLeft)
+            return 0;
+        bytesLeft -= literalCount;
+        while (literalCount-- > 0)
+            Platform_MemWrite8(pDest++, *pSrc++);
+
+        /* The last sequence of a block only contains literals. */
+        if (pSrc == pSrcEnd)
+            break;
+        if (pSrcEnd - pSrc < 2)
+            return 0;
+        offset = (uint32_t)pSrc[0] | (uint32_t)pSrc[1] << 8;
+        pSrc += 2;
+        if (matchLength == LENGTH_NIBBLE_MAX && !readExtendedLength(&pSrc, pSrcEnd, &matchLength))
+            return 0;
+        matchLength += MIN_MATCH_LENGTH;
+        if (offset == 0 || !isOffsetWithinHistory(offset, destLength - bytesLeft, historyLength) ||
+            matchLength > bytesLeft)
+        {
+            return 0;
+        }
+        bytesLeft -= matchLength;
+
+        /* Copy a byte at a time since the match is allowed to overlap the data it is producing. */
+        pMatch = pDest - offset;
+        while (matchLength-- > 0)
+            Platform_MemWrite8(pDest++, Platform_MemRead8(pMatch++));
+    }
+
+    return bytesLeft == 0;
+}
+
+static int readExtendedLength(const uint8_t** ppSrc, const uint8_t* pSrcEnd, uint32_t* pLength)
+{
+    const uint8_t* pSrc = *ppSrc;
+    uint8_t        byte;
+
+    do
+    {
+        if (pSrc == pSrcEnd)
+            return 0;
+        byte = *pSrc++;
+        *pLength += byte;
+    } while (byte == 255);
+    *ppSrc = pSrc;
+
+    return 1;
+}
+
+static int isOffsetWithinHistory(uint32_t offset, uint32_t bytesWritten, uint32_t historyLength)
+{
+    return offset <= bytesWritten || offset - bytesWritten <= historyLength;
+}
@@ -0,0 +1,218 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Conditions which gdb attaches to breakpoints so that they can be evaluated on the target without a round trip.
+   When all of the conditions for a breakpoint evaluate to false, the monitor single steps over the breakpoint itself
+   and lets the program continue without ever notifying gdb. */
+#include <string.h>
+#include "platforms.h"
+#include "cmd_common.h"
+#include "agent.h"
+#include "breakpoints.h"
+#include "conditions.h"
+
+
+typedef struct
+{
+    void*    pAddress;
+    uint32_t kind;
+    /* The type of Z packet, '0' or '1', which set the breakpoint since gdb can place both at the same address. */
+    char     type;
+    /* Each condition is stored as a length byte followed by that many bytes of agent expression bytecode.  An entry
+       with no conditions is free. */
+    uint32_t conditionsLength;
+    uint8_t  conditions[MRI_BREAKPOINT_CONDITIONS_SIZE];
+} ConditionalBreakpoint;
+
+static ConditionalBreakpoint g_conditions[MRI_CONDITIONAL_BREAKPOINT_COUNT];
+
+
+void InitBreakpointConditions(void)
+{
+    memset(g_conditions, 0, sizeof(g_conditions));
+}
+
+
+static ConditionalBreakpoint* findEntry(char type, void* pvAddress)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_CONDITIONAL_BREAKPOINT_COUNT ; i++)
+    {
+        ConditionalBreakpoint* pEntry = &g_conditions[i];
+
+        if (pEntry->conditionsLength && pEntry->type == type && pEntry->pAddress == pvAddress)
+            return pEntry;
+    }
+
+    return NULL;
+}
+
+
+static ConditionalBreakpoint* findFreeEntry(void);
+static void                   parseConditions(ConditionalBreakpoint* pEntry, Buffer* pBuffer);
+static void                   parseCondition(ConditionalBreakpoint* pEntry, Buffer* pBuffer);
+/* Parses the optional cond_list which follows the kind field of a Z0/Z1 packet and attaches it to the breakpoint of
+   that type at pvAddress, replacing any conditions from an earlier Z packet.  The list is a series of ";Xlen,bytecode" items,
+   possibly with the ';' omitted between items.  A breakpoint sent without conditions is left unconditional.  Parsing
+   stops at the first item which isn't a condition so that the caller can handle anything which follows.  Throws
+   invalidArgumentException for a malformed list and exceededHardwareResourcesException if the conditions don't fit
+   in the table. */
+void SetBreakpointConditions(char type, void* pvAddress, uint32_t kind, Buffer* pBuffer)
+{
+    ConditionalBreakpoint* pEntry;
+
+    ClearBreakpointConditions(type, pvAddress);
+    if (Buffer_BytesLeft(pBuffer) == 0)
+        return;
+
+    pEntry = findFreeEntry();
+    if (!pEntry)
+        __throw(exceededHardwareResourcesException);
+    pEntry->pAddress = pvAddress;
+    pEntry->kind = kind;
+    pEntry->type = type;
+
+    __try
+        parseConditions(pEntry, pBuffer);
+    __catch
+    {
+        pEntry->conditionsLength = 0;
+        __rethrow;
+    }
+}
+
+static ConditionalBreakpoint* findFreeEntry(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_CONDITIONAL_BREAKPOINT_COUNT ; i++)
+    {
+        if (g_conditions[i].conditionsLength == 0)
+            return &g_conditions[i];
+    }
+
+    return NULL;
+}
+
+static void parseConditions(ConditionalBreakpoint* pEntry, Buffer* pBuffer)
+{
+    while (Buffer_BytesLeft(pBuffer) > 0)
+    {
+        if (Buffer_IsNextCharEqualTo(pBuffer, ';'))
+            continue;
+        if (!Buffer_IsNextCharEqualTo(pBuffer, 'X'))
+            break;
+
+        __try
+            parseCondition(pEntry, pBuffer);
+        __catch
+            __rethrow;
+    }
+}
+
+static void parseCondition(ConditionalBreakpoint* pEntry, Buffer* pBuffer)
+{
+    uint32_t length;
+    uint8_t* pDest;
+
+    __try
+    {
+        __throwing_func( length = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+
+    if (length == 0 || length > 255)
+        __throw(invalidArgumentException);
+    if (length + 1 > MRI_BREAKPOINT_CONDITIONS_SIZE - pEntry->conditionsLength)
+        __throw(exceededHardwareResourcesException);
+
+    pDest = &pEntry->conditions[pEntry->conditionsLength];
+    *pDest++ = (uint8_t)length;
+    while (length-- > 0)
+    {
+        __try
+            *pDest++ = Buffer_ReadByteAsHex(pBuffer);
+        __catch
+            __throw(invalidArgumentException);
+    }
+    pEntry->conditionsLength = pDest - pEntry->conditions;
+}
+
+
+/* Removes any conditions attached to the breakpoint of the given type at pvAddress. */
+void ClearBreakpointConditions(char type, void* pvAddress)
+{
+    ConditionalBreakpoint* pEntry = findEntry(type, pvAddress);
+
+    if (pEntry)
+        pEntry->conditionsLength = 0;
+}
+
+
+static int  areAllConditionsFalse(ConditionalBreakpoint* pEntry);
+/* Called when the program stops on a breakpoint.  If the breakpoints at the current PC have conditions attached and
+   they all evaluate to false then a single step over the breakpoint is started and 1 is returned so that the caller
+   can resume the program without notifying gdb.  A condition which can't be evaluated, because of a memory fault for
+   example, is treated as true so that gdb gets to see the stop. */
+int SkipConditionalBreakpointIfFalse(void)
+{
+    uint32_t               pc = Platform_GetProgramCounter();
+    ConditionalBreakpoint* pHit = NULL;
+    size_t                 i;
+
+    for (i = 0 ; i < MRI_CONDITIONAL_BREAKPOINT_COUNT ; i++)
+    {
+        ConditionalBreakpoint* pEntry = &g_conditions[i];
+
+        if (!pEntry->conditionsLength || (uint32_t)(size_t)pEntry->pAddress != pc)
+            continue;
+        if (!areAllConditionsFalse(pEntry))
+            return 0;
+        pHit = pEntry;
+    }
+
+    if (!pHit)
+        return 0;
+    return StartSteppingOverBreakpoint(pHit->pAddress, pHit->kind);
+}
+
+static int areAllConditionsFalse(ConditionalBreakpoint* pEntry)
+{
+    uint8_t* pCurr = pEntry->conditions;
+    uint8_t* pEnd = pEntry->conditions + pEntry->conditionsLength;
+
+    while (pCurr < pEnd)
+    {
+        uint32_t length = *pCurr++;
+        uint64_t result;
+
+        __try
+            result = EvaluateAgentExpression(pCurr, length);
+        __catch
+        {
+            clearExceptionCode();
+            return 0;
+        }
+        if (result)
+            return 0;
+        pCurr += length;
+    }
+
+    return 1;
+}
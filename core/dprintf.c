@@ -0,0 +1,550 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Commands which gdb attaches to breakpoints so that they can be run on the target.  gdb sends these for
+   dprintf-style agent where each command is an agent expression which ends with the printf opcode.  The formatted
+   text is collected in a buffer on the target so that a dprintf in a busy loop doesn't cost a round trip to gdb each
+   time that it is hit. */
+#include <string.h>
+#include "platforms.h"
+#include "core.h"
+#include "memory.h"
+#include "cmd_common.h"
+#include "agent.h"
+#include "breakpoints.h"
+#include "gdb_console.h"
+#include "dprintf.h"
+
+
+typedef struct
+{
+    void*    pAddress;
+    uint32_t kind;
+    /* The type of Z packet, '0' or '1', which set the breakpoint since gdb can place both at the same address. */
+    char     type;
+    /* Each command is stored as a length byte followed by that many bytes of agent expression bytecode.  An entry
+       with no commands is free. */
+    uint32_t commandsLength;
+    uint8_t  commands[MRI_BREAKPOINT_COMMANDS_SIZE];
+} BreakpointCommands;
+
+typedef struct
+{
+    BreakpointCommands breakpoints[MRI_BREAKPOINT_COMMANDS_COUNT];
+    uint32_t           outputLength;
+    char               output[MRI_DPRINTF_BUFFER_SIZE];
+} Dprintf;
+
+typedef struct
+{
+    const char* pStart;
+    uint32_t    width;
+    int32_t     precision;
+    uint32_t    bitWidth;
+    char        conversion;
+    char        signChar;
+    int         isLeftJustified;
+    int         isZeroPadded;
+    int         isAlternateForm;
+} FormatSpec;
+
+static Dprintf g_dprintf;
+
+
+void InitBreakpointCommands(void)
+{
+    memset(&g_dprintf, 0, sizeof(g_dprintf));
+}
+
+
+static BreakpointCommands* findEntry(char type, void* pvAddress)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_BREAKPOINT_COMMANDS_COUNT ; i++)
+    {
+        BreakpointCommands* pEntry = &g_dprintf.breakpoints[i];
+
+        if (pEntry->commandsLength && pEntry->type == type && pEntry->pAddress == pvAddress)
+            return pEntry;
+    }
+
+    return NULL;
+}
+
+
+static void                parseCommandListHeader(Buffer* pBuffer);
+static BreakpointCommands* findFreeEntry(void);
+static void                parseCommands(BreakpointCommands* pEntry, Buffer* pBuffer);
+static void                parseCommand(BreakpointCommands* pEntry, Buffer* pBuffer);
+/* Parses the optional cmd_list which follows any conditions in a Z0/Z1 packet and attaches it to the breakpoint of
+   that type at pvAddress, replacing any commands from an earlier Z packet.  The list has the form "cmds:persist,Xlen,bytecode..."
+   with the ';' between items being optional.  The persist flag is ignored since the commands stay on the target until
+   gdb removes the breakpoint anyway.  Throws invalidArgumentException for a malformed list and
+   exceededHardwareResourcesException if the commands don't fit in the table. */
+void SetBreakpointCommands(char type, void* pvAddress, uint32_t kind, Buffer* pBuffer)
+{
+    BreakpointCommands* pEntry;
+
+    ClearBreakpointCommands(type, pvAddress);
+    if (Buffer_BytesLeft(pBuffer) == 0)
+        return;
+
+    __try
+        parseCommandListHeader(pBuffer);
+    __catch
+        __rethrow;
+
+    pEntry = findFreeEntry();
+    if (!pEntry)
+        __throw(exceededHardwareResourcesException);
+    pEntry->pAddress = pvAddress;
+    pEntry->kind = kind;
+    pEntry->type = type;
+
+    __try
+        parseCommands(pEntry, pBuffer);
+    __catch
+    {
+        pEntry->commandsLength = 0;
+        __rethrow;
+    }
+}
+
+static void parseCommandListHeader(Buffer* pBuffer)
+{
+    static const char commandListPrefix[] = "cmds";
+    int               isCommandList;
+
+    __try
+        isCommandList = Buffer_MatchesString(pBuffer, commandListPrefix, sizeof(commandListPrefix)-1);
+    __catch
+        __throw(invalidArgumentException);
+    if (!isCommandList)
+        __throw(invalidArgumentException);
+
+    __try
+    {
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+}
+
+static BreakpointCommands* findFreeEntry(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_BREAKPOINT_COMMANDS_COUNT ; i++)
+    {
+        if (g_dprintf.breakpoints[i].commandsLength == 0)
+            return &g_dprintf.breakpoints[i];
+    }
+
+    return NULL;
+}
+
+static void parseCommands(BreakpointCommands* pEntry, Buffer* pBuffer)
+{
+    while (Buffer_BytesLeft(pBuffer) > 0)
+    {
+        if (Buffer_IsNextCharEqualTo(pBuffer, ';'))
+            continue;
+        if (!Buffer_IsNextCharEqualTo(pBuffer, 'X'))
+            __throw(invalidArgumentException);
+
+        __try
+            parseCommand(pEntry, pBuffer);
+        __catch
+            __rethrow;
+    }
+    if (pEntry->commandsLength == 0)
+        __throw(invalidArgumentException);
+}
+
+static void parseCommand(BreakpointCommands* pEntry, Buffer* pBuffer)
+{
+    uint32_t length;
+    uint8_t* pDest;
+
+    __try
+    {
+        __throwing_func( length = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+
+    if (length == 0 || length > 255)
+        __throw(invalidArgumentException);
+    if (length + 1 > MRI_BREAKPOINT_COMMANDS_SIZE - pEntry->commandsLength)
+        __throw(exceededHardwareResourcesException);
+
+    pDest = &pEntry->commands[pEntry->commandsLength];
+    *pDest++ = (uint8_t)length;
+    while (length-- > 0)
+    {
+        __try
+            *pDest++ = Buffer_ReadByteAsHex(pBuffer);
+        __catch
+            __throw(invalidArgumentException);
+    }
+    pEntry->commandsLength = pDest - pEntry->commands;
+}
+
+
+/* Removes any commands attached to the breakpoint of the given type at pvAddress. */
+void ClearBreakpointCommands(char type, void* pvAddress)
+{
+    BreakpointCommands* pEntry = findEntry(type, pvAddress);
+
+    if (pEntry)
+        pEntry->commandsLength = 0;
+}
+
+
+static void runCommands(BreakpointCommands* pEntry);
+static void appendFormattedOutput(const char* pFormat, const uint64_t* pArgs, uint32_t argCount);
+static const AgentHooks g_dprintfHooks = { NULL, NULL, NULL, NULL, appendFormattedOutput };
+/* Called when the program stops on a breakpoint whose conditions, if any, are true.  If the breakpoints at the current
+   PC have commands attached then they are run, a single step over the breakpoint is started, and 1 is returned so that
+   the caller can resume the program without notifying gdb.  A command which fails, because of a memory fault for
+   example, is skipped. */
+int RunBreakpointCommandsIfPresent(void)
+{
+    uint32_t            pc = Platform_GetProgramCounter();
+    BreakpointCommands* pHit = NULL;
+    size_t              i;
+
+    for (i = 0 ; i < MRI_BREAKPOINT_COMMANDS_COUNT ; i++)
+    {
+        BreakpointCommands* pEntry = &g_dprintf.breakpoints[i];
+
+        if (!pEntry->commandsLength || (uint32_t)(size_t)pEntry->pAddress != pc)
+            continue;
+        runCommands(pEntry);
+        pHit = pEntry;
+    }
+
+    if (!pHit)
+        return 0;
+    return StartSteppingOverBreakpoint(pHit->pAddress, pHit->kind);
+}
+
+static void runCommands(BreakpointCommands* pEntry)
+{
+    uint8_t* pCurr = pEntry->commands;
+    uint8_t* pEnd = pEntry->commands + pEntry->commandsLength;
+
+    while (pCurr < pEnd)
+    {
+        uint32_t length = *pCurr++;
+
+        __try
+            ExecuteAgentCommand(pCurr, length, &g_dprintfHooks);
+        __catch
+            clearExceptionCode();
+        pCurr += length;
+    }
+}
+
+static const char* parseFormatSpec(const char* pFormat, FormatSpec* pSpec);
+static void        appendChar(char c);
+static void        appendFormatSpecText(const FormatSpec* pSpec, const char* pEnd);
+static void        appendInteger(const FormatSpec* pSpec, uint64_t value);
+static void        appendString(const FormatSpec* pSpec, uint32_t address);
+static void appendFormattedOutput(const char* pFormat, const uint64_t* pArgs, uint32_t argCount)
+{
+    uint32_t argIndex = 0;
+
+    while (*pFormat)
+    {
+        FormatSpec  spec;
+        const char* pNext;
+
+        if (*pFormat != '%')
+        {
+            appendChar(*pFormat++);
+            continue;
+        }
+
+        pNext = parseFormatSpec(pFormat, &spec);
+        if (spec.conversion == '%')
+        {
+            appendChar('%');
+        }
+        else if (argIndex >= argCount)
+        {
+            appendFormatSpecText(&spec, pNext);
+        }
+        else
+        {
+            uint64_t arg = pArgs[argIndex++];
+
+            switch (spec.conversion)
+            {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'p':
+                appendInteger(&spec, arg);
+                break;
+            case 'c':
+            case 's':
+                appendString(&spec, (uint32_t)arg);
+                break;
+            default:
+                /* Floating point conversions aren't supported so they are output as is. */
+                appendFormatSpecText(&spec, pNext);
+                break;
+            }
+        }
+        pFormat = pNext;
+    }
+}
+
+static const char* parseFormatSpec(const char* pFormat, FormatSpec* pSpec)
+{
+    memset(pSpec, 0, sizeof(*pSpec));
+    pSpec->pStart = pFormat++;
+    pSpec->precision = -1;
+    pSpec->bitWidth = 32;
+
+    for (;;)
+    {
+        if (*pFormat == '-')
+            pSpec->isLeftJustified = 1;
+        else if (*pFormat == '0')
+            pSpec->isZeroPadded = 1;
+        else if (*pFormat == '#')
+            pSpec->isAlternateForm = 1;
+        else if (*pFormat == '+' || (*pFormat == ' ' && pSpec->signChar != '+'))
+            pSpec->signChar = *pFormat;
+        else
+            break;
+        pFormat++;
+    }
+    while (*pFormat >= '0' && *pFormat <= '9')
+        pSpec->width = pSpec->width * 10 + (*pFormat++ - '0');
+    if (*pFormat == '.')
+    {
+        pFormat++;
+        pSpec->precision = 0;
+        while (*pFormat >= '0' && *pFormat <= '9')
+            pSpec->precision = pSpec->precision * 10 + (*pFormat++ - '0');
+    }
+
+    /* int and long are both 32 bits on the devices supported by mri. */
+    for (;;)
+    {
+        if (*pFormat == 'h')
+            pSpec->bitWidth /= 2;
+        else if (*pFormat == 'j' || *pFormat == 'q' || (*pFormat == 'l' && pFormat[1] == 'l'))
+            pSpec->bitWidth = 64;
+        else if (*pFormat != 'l' && *pFormat != 'z' && *pFormat != 't' && *pFormat != 'L')
+            break;
+        if (*pFormat == 'l' && pFormat[1] == 'l')
+            pFormat++;
+        pFormat++;
+    }
+
+    if (*pFormat)
+        pSpec->conversion = *pFormat++;
+    return pFormat;
+}
+
+static void appendChar(char c)
+{
+    if (g_dprintf.outputLength >= sizeof(g_dprintf.output))
+        FlushDprintfOutput();
+    g_dprintf.output[g_dprintf.outputLength++] = c;
+}
+
+static void appendFormatSpecText(const FormatSpec* pSpec, const char* pEnd)
+{
+    const char* pCurr;
+
+    for (pCurr = pSpec->pStart ; pCurr < pEnd ; pCurr++)
+        appendChar(*pCurr);
+}
+
+static void appendPadding(char padChar, uint32_t count);
+static void appendInteger(const FormatSpec* pSpec, uint64_t value)
+{
+    static const char lowerDigits[] = "0123456789abcdef";
+    static const char upperDigits[] = "0123456789ABCDEF";
+    const char*       pDigits = pSpec->conversion == 'X' ? upperDigits : lowerDigits;
+    const char*       pPrefix = "";
+    char              digits[22];
+    uint32_t          digitCount = 0;
+    uint32_t          base = 10;
+    uint32_t          zeroCount = 0;
+    uint32_t          length;
+    char              signChar = 0;
+
+    if (pSpec->conversion == 'p')
+    {
+        value = (uint32_t)value;
+        pPrefix = "0x";
+        base = 16;
+    }
+    else
+    {
+        uint32_t unusedBits = 64 - pSpec->bitWidth;
+
+        value = (value << unusedBits) >> unusedBits;
+        if (pSpec->conversion == 'd' || pSpec->conversion == 'i')
+        {
+            int64_t signedValue = (int64_t)(value << unusedBits) >> unusedBits;
+
+            signChar = pSpec->signChar;
+            if (signedValue < 0)
+            {
+                signChar = '-';
+                value = -(uint64_t)signedValue;
+            }
+        }
+        else if (pSpec->conversion == 'o')
+        {
+            base = 8;
+            if (pSpec->isAlternateForm && value)
+                pPrefix = "0";
+        }
+        else if (pSpec->conversion != 'u')
+        {
+            base = 16;
+            if (pSpec->isAlternateForm && value)
+                pPrefix = pSpec->conversion == 'X' ? "0X" : "0x";
+        }
+    }
+
+    /* As with the C library, a precision of 0 prints nothing at all for a value of 0. */
+    while (value || (digitCount == 0 && pSpec->precision != 0))
+    {
+        digits[digitCount++] = pDigits[value % base];
+        value /= base;
+    }
+    if (pSpec->precision > 0 && (uint32_t)pSpec->precision > digitCount)
+        zeroCount = pSpec->precision - digitCount;
+    length = (signChar ? 1 : 0) + strlen(pPrefix) + zeroCount + digitCount;
+    if (pSpec->isZeroPadded && !pSpec->isLeftJustified && pSpec->precision < 0 && pSpec->width > length)
+    {
+        zeroCount += pSpec->width - length;
+        length = pSpec->width;
+    }
+
+    if (!pSpec->isLeftJustified && pSpec->width > length)
+        appendPadding(' ', pSpec->width - length);
+    if (signChar)
+        appendChar(signChar);
+    while (*pPrefix)
+        appendChar(*pPrefix++);
+    appendPadding('0', zeroCount);
+    while (digitCount > 0)
+        appendChar(digits[--digitCount]);
+    if (pSpec->isLeftJustified && pSpec->width > length)
+        appendPadding(' ', pSpec->width - length);
+}
+
+static void appendPadding(char padChar, uint32_t count)
+{
+    while (count-- > 0)
+        appendChar(padChar);
+}
+
+static uint32_t measureString(const FormatSpec* pSpec, uint32_t address, int* pWasFaulted);
+static int      readTargetChar(uint32_t address, char* pChar);
+static void appendString(const FormatSpec* pSpec, uint32_t address)
+{
+    static const char faultText[] = "<error>";
+    uint32_t          length;
+    uint32_t          i;
+    int               wasFaulted = 0;
+
+    /* %c is handled here too with the character itself standing in for the string contents. */
+    if (pSpec->conversion == 'c')
+        length = 1;
+    else
+        length = measureString(pSpec, address, &wasFaulted);
+    if (wasFaulted)
+        length = sizeof(faultText) - 1;
+
+    if (!pSpec->isLeftJustified && pSpec->width > length)
+        appendPadding(' ', pSpec->width - length);
+    for (i = 0 ; i < length ; i++)
+    {
+        char c;
+
+        if (pSpec->conversion == 'c')
+            c = (char)address;
+        else if (wasFaulted)
+            c = faultText[i];
+        else if (!readTargetChar(address + i, &c))
+            break;
+        appendChar(c);
+    }
+    if (pSpec->isLeftJustified && pSpec->width > length)
+        appendPadding(' ', pSpec->width - length);
+}
+
+static uint32_t measureString(const FormatSpec* pSpec, uint32_t address, int* pWasFaulted)
+{
+    uint32_t maxLength = pSpec->precision >= 0 ? (uint32_t)pSpec->precision : MRI_DPRINTF_BUFFER_SIZE;
+    uint32_t length;
+
+    for (length = 0 ; length < maxLength ; length++)
+    {
+        char c;
+
+        if (!readTargetChar(address + length, &c))
+        {
+            *pWasFaulted = 1;
+            return 0;
+        }
+        if (c == '\0')
+            break;
+    }
+
+    return length;
+}
+
+static int readTargetChar(uint32_t address, char* pChar)
+{
+    const uint8_t* p = PointerFromTargetAddress(address);
+
+    if (GetMemoryTypeOfRange(p, 1) == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+    *pChar = (char)Platform_MemRead8(p);
+    return !Platform_WasMemoryFaultEncountered();
+}
+
+
+/* Sends any dprintf output buffered on the target to gdb.  Called when the buffer fills up and before the program is
+   reported as stopped so that gdb sees the output in the correct order. */
+void FlushDprintfOutput(void)
+{
+    if (g_dprintf.outputLength == 0)
+        return;
+    WriteSizedStringToGdbConsole(g_dprintf.output, g_dprintf.outputLength);
+    g_dprintf.outputLength = 0;
+}
@@ -0,0 +1,179 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Routines to compress a block of target memory and write it to a file on the gdb host. */
+#include <string.h>
+#include "platforms.h"
+#include "try_catch.h"
+#include "core.h"
+#include "fileio.h"
+#include "cmd_file.h"
+#include "compress.h"
+#include "gdb_console.h"
+#include "dump.h"
+
+
+/* Compressed bytes sent to gdb in each Fwrite request and the size of the compressor's hash table.  Both are kept
+   small since the buffers are permanently allocated in target RAM. */
+#define DUMP_BLOCK_SIZE     256
+#define DUMP_HASH_BITS      7
+
+typedef struct
+{
+    CompressState  compressState;
+    const uint8_t* pMemory;
+    const char*    pError;
+    uint32_t       length;
+    uint32_t       bytesDumped;
+    int            isQueued;
+    char           filename[DUMP_MAX_FILENAME_SIZE];
+} DumpState;
+
+static DumpState g_dump;
+static uint8_t   g_dumpBlock[DUMP_FRAME_HEADER_SIZE + DUMP_BLOCK_SIZE];
+static uint32_t  g_dumpHashTable[1 << DUMP_HASH_BITS];
+
+
+/* Remembers the memory range and host filename for a dump to be performed by RunQueuedMemoryDump().  gdb doesn't
+   accept File-I/O requests while it waits for the response to a monitor command so the dump has to be deferred until
+   the program is next resumed.  Throws invalidArgumentException if the filename is too long to be stored. */
+void QueueMemoryDump(const void* pvMemory, uint32_t length, const char* pFilename, uint32_t filenameLength)
+{
+    if (filenameLength == 0 || filenameLength >= sizeof(g_dump.filename))
+        __throw(invalidArgumentException);
+
+    memcpy(g_dump.filename, pFilename, filenameLength);
+    g_dump.filename[filenameLength] = '\0';
+    g_dump.pMemory = (const uint8_t*)pvMemory;
+    g_dump.length = length;
+    g_dump.isQueued = 1;
+}
+
+
+int IsMemoryDumpQueued(void)
+{
+    return g_dump.isQueued;
+}
+
+
+/* Drops the dump queued by QueueMemoryDump() without writing anything, as is needed once gdb has detached. */
+void CancelMemoryDump(void)
+{
+    g_dump.isQueued = 0;
+}
+
+
+static int  dumpToHostFile(void);
+static int  writeCompressedBlocks(int fileDescriptor);
+static void writeUInt32(uint8_t* p, uint32_t value);
+static void reportDumpResult(void);
+/* Compresses the memory range queued by QueueMemoryDump() and writes it to the host file using gdb's File-I/O
+   requests.  The outcome is reported on the gdb console.  Returns 0 if the user pressed CTRL+C while gdb was
+   processing one of the requests, in which case the dump is abandoned and the caller should report the SIGINT to gdb.
+   Returns 1 otherwise. */
+int RunQueuedMemoryDump(void)
+{
+    int wasCompleted;
+
+    g_dump.isQueued = 0;
+    g_dump.pError = NULL;
+    g_dump.bytesDumped = 0;
+
+    RecordInternalFileIORequest(1);
+    wasCompleted = dumpToHostFile();
+    RecordInternalFileIORequest(0);
+    if (!wasCompleted)
+        return 0;
+
+    reportDumpResult();
+    return 1;
+}
+
+static int dumpToHostFile(void)
+{
+    OpenParameters openParameters;
+    int            fileDescriptor;
+
+    openParameters.filenameAddress = (uint32_t)(size_t)g_dump.filename;
+    openParameters.filenameLength = strlen(g_dump.filename) + 1;
+    openParameters.flags = O_WRONLY | O_CREAT | O_TRUNC;
+    openParameters.mode = S_IRUSR | S_IWUSR;
+    if (!IssueGdbFileOpenRequest(&openParameters))
+        return 0;
+    fileDescriptor = GetSemihostReturnCode();
+    if (fileDescriptor < 0)
+    {
+        g_dump.pError = "Failed to open host file. ";
+        return 1;
+    }
+
+    if (!writeCompressedBlocks(fileDescriptor))
+        return 0;
+    return IssueGdbFileCloseRequest(fileDescriptor);
+}
+
+static int writeCompressedBlocks(int fileDescriptor)
+{
+    CompressState*     pState = &g_dump.compressState;
+    TransferParameters transferParameters;
+
+    transferParameters.fileDescriptor = fileDescriptor;
+    transferParameters.bufferAddress = (uint32_t)(size_t)g_dumpBlock;
+    Compress_Init(pState, g_dump.pMemory, g_dump.length, g_dumpHashTable, DUMP_HASH_BITS);
+    while (pState->srcOffset < g_dump.length)
+    {
+        uint32_t srcOffset = pState->srcOffset;
+        uint32_t compressedLength;
+
+        compressedLength = Compress_NextBlock(pState, g_dumpBlock + DUMP_FRAME_HEADER_SIZE, DUMP_BLOCK_SIZE);
+        if (Platform_WasMemoryFaultEncountered())
+        {
+            g_dump.pError = "Memory fault encountered. ";
+            return 1;
+        }
+        writeUInt32(g_dumpBlock, pState->srcOffset - srcOffset);
+        writeUInt32(g_dumpBlock + 4, compressedLength);
+
+        transferParameters.bufferSize = (int32_t)(DUMP_FRAME_HEADER_SIZE + compressedLength);
+        if (!IssueGdbFileWriteRequest(&transferParameters))
+            return 0;
+        if (GetSemihostReturnCode() != transferParameters.bufferSize)
+        {
+            g_dump.pError = "Failed to write host file. ";
+            return 1;
+        }
+        g_dump.bytesDumped = pState->srcOffset;
+    }
+
+    return 1;
+}
+
+static void writeUInt32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static void reportDumpResult(void)
+{
+    if (g_dump.pError)
+        WriteStringToGdbConsole(g_dump.pError);
+    WriteStringToGdbConsole("Dumped ");
+    WriteHexValueToGdbConsole(g_dump.bytesDumped);
+    WriteStringToGdbConsole(" of ");
+    WriteHexValueToGdbConsole(g_dump.length);
+    WriteStringToGdbConsole(" bytes.\n");
+}
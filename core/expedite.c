@@ -0,0 +1,119 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Selection of the registers which are expedited to gdb in T stop responses.  Each platform sends its own build time
+   default set until the "monitor expedite" command replaces it with a list of gdb register numbers. */
+#include <string.h>
+#include "platforms.h"
+#include "gdb_console.h"
+#include "expedite.h"
+
+
+typedef struct
+{
+    uint8_t registerNumbers[EXPEDITE_MAX_REGISTERS];
+    size_t  count;
+} ExpeditedRegisters;
+
+static ExpeditedRegisters g_expedite;
+
+
+void __mriExpedite_Init(void)
+{
+    memset(&g_expedite, 0, sizeof(g_expedite));
+}
+
+
+/* An empty list restores the platform's default set.  Throws invalidIndexException, leaving the current set in
+   place, if any of the registers can't be read by Platform_ReadRegister(). */
+void __mriExpedite_SetRegisters(const uint8_t* pRegisterNumbers, size_t count)
+{
+    size_t i;
+
+    if (count > EXPEDITE_MAX_REGISTERS)
+        __throw(invalidArgumentException);
+    for (i = 0 ; i < count ; i++)
+    {
+        __try
+            Platform_ReadRegister(pRegisterNumbers[i]);
+        __catch
+            __rethrow;
+    }
+
+    memcpy(g_expedite.registerNumbers, pRegisterNumbers, count);
+    g_expedite.count = count;
+}
+
+
+void __mriExpedite_DisplayRegisters(void)
+{
+    size_t i;
+
+    WriteStringToGdbConsole("Expedited registers:");
+    if (g_expedite.count == 0)
+        WriteStringToGdbConsole(" platform default");
+    for (i = 0 ; i < g_expedite.count ; i++)
+    {
+        WriteStringToGdbConsole(" ");
+        WriteHexValueToGdbConsole(g_expedite.registerNumbers[i]);
+    }
+    WriteStringToGdbConsole("\n");
+}
+
+
+void __mriExpedite_WriteTResponseRegisters(Buffer* pBuffer)
+{
+    if (g_expedite.count == 0)
+        Platform_WriteTResponseRegistersToBuffer(pBuffer);
+    else
+        WriteRegistersForTResponse(pBuffer, g_expedite.registerNumbers, g_expedite.count);
+}
+
+
+static void writeRegisterForTResponse(Buffer* pBuffer, uint8_t registerNumber, uint32_t registerValue);
+/* Writes the ii:xxxxxxxx; pair for each of the listed registers.  Registers which can't be read on this device are
+   skipped so that a build time list can be shared across devices with and without optional registers. */
+void __mriExpedite_WriteRegisters(Buffer* pBuffer, const uint8_t* pRegisterNumbers, size_t count)
+{
+    size_t i;
+
+    for (i = 0 ; i < count ; i++)
+    {
+        uint32_t value;
+
+        __try
+            value = Platform_ReadRegister(pRegisterNumbers[i]);
+        __catch
+        {
+            clearExceptionCode();
+            continue;
+        }
+        writeRegisterForTResponse(pBuffer, pRegisterNumbers[i], value);
+    }
+}
+
+static void writeRegisterForTResponse(Buffer* pBuffer, uint8_t registerNumber, uint32_t registerValue)
+{
+    size_t i;
+
+    Buffer_WriteByteAsHex(pBuffer, registerNumber);
+    Buffer_WriteChar(pBuffer, ':');
+    /* gdb expects the register contents in target (little endian) byte order. */
+    for (i = 0 ; i < sizeof(registerValue) ; i++)
+    {
+        Buffer_WriteByteAsHex(pBuffer, (uint8_t)registerValue);
+        registerValue >>= 8;
+    }
+    Buffer_WriteChar(pBuffer, ';');
+}
@@ -54,6 +54,32 @@ static void writeStringToExclusiveGdbCommChannel(const char* pString)
 }
 
 
+/* Writes length characters from pString, which doesn't need to be NUL terminated, to the gdb console.  Text too long
+   to fit in a single 'O' packet is split across as many packets as needed. */
+void WriteSizedStringToGdbConsole(const char* pString, uint32_t length)
+{
+    if (Platform_CommSharingWithApplication() && IsFirstException())
+    {
+        while (length-- > 0)
+            Platform_CommSendChar(*pString++);
+        return;
+    }
+
+    while (length > 0)
+    {
+        Buffer* pBuffer = GetInitializedBuffer();
+
+        Buffer_WriteChar(pBuffer, 'O');
+        while (length > 0 && Buffer_BytesLeft(pBuffer) >= 2)
+        {
+            Buffer_WriteByteAsHex(pBuffer, *pString++);
+            length--;
+        }
+        SendPacketToGdb();
+    }
+}
+
+
 void WriteHexValueToGdbConsole(uint32_t Value)
 {
     Buffer BufferObject;
@@ -17,6 +17,9 @@
 #include "memory.h"
 
 
+static PlatformMemoryType determineMemoryTypeOfRange(const void* pvMemory, uint32_t length);
+static int isRamOrFlash(PlatformMemoryType memoryType);
+static uint32_t readRamIntoHexBuffer(Buffer* pBuffer, const void* pvMemory, uint32_t readByteCount);
 static uint32_t readMemoryBytesIntoHexBuffer(Buffer* pBuffer, const void*  pvMemory, uint32_t readByteCount);
 static uint32_t readMemoryHalfWordIntoHexBuffer(Buffer* pBuffer, const void*  pvMemory);
 static int isNotHalfWordAligned(const void* pvMemory);
@@ -25,6 +28,13 @@ static uint32_t readMemoryWordIntoHexBuffer(Buffer* pBuffer, const void* pvMemor
 static int isNotWordAligned(const void* pvMemory);
 uint32_t ReadMemoryIntoHexBuffer(Buffer* pBuffer, const void* pvMemory, uint32_t readByteCount)
 {
+    PlatformMemoryType memoryType = determineMemoryTypeOfRange(pvMemory, readByteCount);
+
+    if (memoryType == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+    if (isRamOrFlash(memoryType))
+        return readRamIntoHexBuffer(pBuffer, pvMemory, readByteCount);
+
     switch (readByteCount)
     {
     case 2:
@@ -36,6 +46,65 @@ uint32_t ReadMemoryIntoHexBuffer(Buffer* pBuffer, const void* pvMemory, uint32_t
     }
 }
 
+static PlatformMemoryType determineMemoryTypeOfRange(const void* pvMemory, uint32_t length)
+{
+    const PlatformMemoryRegion* pRegion = Platform_GetDeviceMemoryRegions();
+    uint32_t                    regionCount = Platform_GetDeviceMemoryRegionCount();
+    uint32_t                    address = (uint32_t)(size_t)pvMemory;
+
+    /* Platforms which don't describe their memory get the cautious peripheral treatment everywhere. */
+    if (regionCount == 0)
+        return MRI_PLATFORM_MEMORY_PERIPHERAL;
+
+    while (regionCount-- > 0)
+    {
+        uint32_t offset = address - pRegion->start;
+
+        if (offset < pRegion->length)
+        {
+            /* Ranges which run off the end of a region are left to the cautious peripheral path as well. */
+            if (length > pRegion->length - offset)
+                return MRI_PLATFORM_MEMORY_PERIPHERAL;
+            return pRegion->type;
+        }
+        pRegion++;
+    }
+
+    return MRI_PLATFORM_MEMORY_UNMAPPED;
+}
+
+static int isRamOrFlash(PlatformMemoryType memoryType)
+{
+    return memoryType == MRI_PLATFORM_MEMORY_RAM || memoryType == MRI_PLATFORM_MEMORY_FLASH;
+}
+
+static uint32_t readRamIntoHexBuffer(Buffer* pBuffer, const void* pvMemory, uint32_t readByteCount)
+{
+    const uint8_t* p = (const uint8_t*)pvMemory;
+    uint32_t       bytesLeft = readByteCount;
+
+    /* RAM and FLASH don't care about access width so read a word at a time and only check for a fault at the end. */
+    while (bytesLeft > 0)
+    {
+        if (bytesLeft >= sizeof(uint32_t) && !isNotWordAligned(p))
+        {
+            uint32_t value = Platform_MemRead32(p);
+            writeBytesToBufferAsHex(pBuffer, &value, sizeof(value));
+            p += sizeof(value);
+            bytesLeft -= sizeof(value);
+        }
+        else
+        {
+            Buffer_WriteByteAsHex(pBuffer, Platform_MemRead8(p++));
+            bytesLeft--;
+        }
+    }
+    if (Platform_WasMemoryFaultEncountered())
+        return 0;
+
+    return readByteCount;
+}
+
 static uint32_t readMemoryBytesIntoHexBuffer(Buffer* pBuffer, const void*  pvMemory, uint32_t readByteCount)
 {
     uint32_t byteCount = 0;
@@ -104,12 +173,22 @@ static int isNotWordAligned(const void* pvMemory)
 }
 
 
+typedef int (*ReadBytesFromBufferFunc)(Buffer* pBuffer, void* pv, uint32_t length);
+
+static int writeBufferToRam(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount, ReadBytesFromBufferFunc readBytes);
 static int writeHexBufferToByteMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount);
 static int writeHexBufferToHalfWordMemory(Buffer* pBuffer, void* pvMemory);
-static int readBytesFromHexBuffer(Buffer* pBuffer, void* pv, size_t length);
+static int readBytesFromHexBuffer(Buffer* pBuffer, void* pv, uint32_t length);
 static int writeHexBufferToWordMemory(Buffer* pBuffer, void* pvMemory);
 int WriteHexBufferToMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount)
 {
+    PlatformMemoryType memoryType = determineMemoryTypeOfRange(pvMemory, writeByteCount);
+
+    if (memoryType == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+    if (isRamOrFlash(memoryType))
+        return writeBufferToRam(pBuffer, pvMemory, writeByteCount, readBytesFromHexBuffer);
+
     switch (writeByteCount)
     {
     case 2:
@@ -121,6 +200,38 @@ int WriteHexBufferToMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCo
     }
 }
 
+static int writeBufferToRam(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount, ReadBytesFromBufferFunc readBytes)
+{
+    uint8_t* p = (uint8_t*)pvMemory;
+    int      result = 1;
+
+    while (writeByteCount > 0)
+    {
+        uint32_t value;
+        uint32_t chunkSize = sizeof(value);
+
+        if (writeByteCount < chunkSize || isNotWordAligned(p))
+            chunkSize = 1;
+        if (!readBytes(pBuffer, &value, chunkSize))
+        {
+            result = 0;
+            break;
+        }
+
+        if (chunkSize == sizeof(value))
+            Platform_MemWrite32(p, value);
+        else
+            Platform_MemWrite8(p, *(uint8_t*)&value);
+        p += chunkSize;
+        writeByteCount -= chunkSize;
+    }
+    /* Query even on parse failure so that a fault from the earlier writes doesn't linger into the next request. */
+    if (Platform_WasMemoryFaultEncountered())
+        return 0;
+
+    return result;
+}
+
 static int writeHexBufferToByteMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount)
 {
     uint8_t* p = (uint8_t*) pvMemory;
@@ -159,7 +270,7 @@ static int writeHexBufferToHalfWordMemory(Buffer* pBuffer, void* pvMemory)
     return 1;
 }
 
-static int readBytesFromHexBuffer(Buffer* pBuffer, void* pv, size_t length)
+static int readBytesFromHexBuffer(Buffer* pBuffer, void* pv, uint32_t length)
 {
     uint8_t* pBytes = (uint8_t*)pv;
     while (length--)
@@ -200,6 +311,13 @@ static int readBytesFromBinaryBuffer(Buffer*  pBuffer, void* pvMemory, uint32_t
 static int  writeBinaryBufferToWordMemory(Buffer* pBuffer, void* pvMemory);
 int WriteBinaryBufferToMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount)
 {
+    PlatformMemoryType memoryType = determineMemoryTypeOfRange(pvMemory, writeByteCount);
+
+    if (memoryType == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+    if (isRamOrFlash(memoryType))
+        return writeBufferToRam(pBuffer, pvMemory, writeByteCount, readBytesFromBinaryBuffer);
+
     switch (writeByteCount)
     {
     case 2:
@@ -322,3 +440,232 @@ static int writeBinaryBufferToWordMemory(Buffer* pBuffer, void* pvMemory)
 
     return 1;
 }
+
+
+static uint32_t fillMemoryWithPattern(uint8_t* p, uint32_t length, uint32_t pattern, int checkEachAccess);
+static uint8_t  patternByteForAddress(uint32_t pattern, const void* pv);
+uint32_t FillMemoryWithPattern(void* pvMemory, uint32_t length, uint32_t pattern)
+{
+    PlatformMemoryType memoryType = determineMemoryTypeOfRange(pvMemory, length);
+    uint32_t           bytesFilled;
+
+    if (memoryType == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+    if (!isRamOrFlash(memoryType))
+        return fillMemoryWithPattern(pvMemory, length, pattern, 1);
+
+    bytesFilled = fillMemoryWithPattern(pvMemory, length, pattern, 0);
+    if (Platform_WasMemoryFaultEncountered())
+        return 0;
+    return bytesFilled;
+}
+
+static uint32_t fillMemoryWithPattern(uint8_t* p, uint32_t length, uint32_t pattern, int checkEachAccess)
+{
+    uint32_t bytesLeft = length;
+
+    while (bytesLeft > 0)
+    {
+        uint32_t accessSize = sizeof(uint32_t);
+
+        if (bytesLeft < accessSize || isNotWordAligned(p))
+            accessSize = 1;
+        if (accessSize == sizeof(uint32_t))
+            Platform_MemWrite32(p, pattern);
+        else
+            Platform_MemWrite8(p, patternByteForAddress(pattern, p));
+        if (checkEachAccess && Platform_WasMemoryFaultEncountered())
+            break;
+        p += accessSize;
+        bytesLeft -= accessSize;
+    }
+
+    return length - bytesLeft;
+}
+
+static uint8_t patternByteForAddress(uint32_t pattern, const void* pv)
+{
+    /* Keep the pattern word aligned in memory even when the fill starts or ends part way through a word. */
+    return (uint8_t)(pattern >> (8 * ((size_t)pv & 3)));
+}
+
+
+static int      isBackwardCopyRequired(const uint8_t* pDest, const uint8_t* pSrc, uint32_t length);
+static uint32_t copyMemoryForward(uint8_t* pDest, const uint8_t* pSrc, uint32_t length, int checkEachAccess);
+static uint32_t copyMemoryBackward(uint8_t* pDest, const uint8_t* pSrc, uint32_t length, int checkEachAccess);
+static int      copyMemoryUnit(uint8_t* pDest, const uint8_t* pSrc, uint32_t size, int checkEachAccess);
+static int      areMutuallyWordAligned(const void* pv1, const void* pv2);
+uint32_t CopyMemoryBlock(void* pvDest, const void* pvSrc, uint32_t length)
+{
+    PlatformMemoryType destType = determineMemoryTypeOfRange(pvDest, length);
+    PlatformMemoryType srcType = determineMemoryTypeOfRange(pvSrc, length);
+    int                checkEachAccess = !isRamOrFlash(destType) || !isRamOrFlash(srcType);
+    uint32_t           bytesCopied;
+
+    if (destType == MRI_PLATFORM_MEMORY_UNMAPPED || srcType == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+
+    if (isBackwardCopyRequired(pvDest, pvSrc, length))
+        bytesCopied = copyMemoryBackward(pvDest, pvSrc, length, checkEachAccess);
+    else
+        bytesCopied = copyMemoryForward(pvDest, pvSrc, length, checkEachAccess);
+    if (!checkEachAccess && Platform_WasMemoryFaultEncountered())
+        return 0;
+
+    return bytesCopied;
+}
+
+static int isBackwardCopyRequired(const uint8_t* pDest, const uint8_t* pSrc, uint32_t length)
+{
+    /* Copying front to back would overwrite source bytes before they are read if the destination overlaps the end. */
+    return pDest > pSrc && pDest < pSrc + length;
+}
+
+static uint32_t copyMemoryForward(uint8_t* pDest, const uint8_t* pSrc, uint32_t length, int checkEachAccess)
+{
+    int      isWordCopyPossible = areMutuallyWordAligned(pDest, pSrc);
+    uint32_t bytesLeft = length;
+
+    while (bytesLeft > 0)
+    {
+        uint32_t accessSize = sizeof(uint32_t);
+
+        if (!isWordCopyPossible || bytesLeft < accessSize || isNotWordAligned(pDest))
+            accessSize = 1;
+        if (!copyMemoryUnit(pDest, pSrc, accessSize, checkEachAccess))
+            break;
+        pDest += accessSize;
+        pSrc += accessSize;
+        bytesLeft -= accessSize;
+    }
+
+    return length - bytesLeft;
+}
+
+static uint32_t copyMemoryBackward(uint8_t* pDest, const uint8_t* pSrc, uint32_t length, int checkEachAccess)
+{
+    int      isWordCopyPossible = areMutuallyWordAligned(pDest, pSrc);
+    uint32_t bytesLeft = length;
+
+    pDest += length;
+    pSrc += length;
+    while (bytesLeft > 0)
+    {
+        uint32_t accessSize = sizeof(uint32_t);
+
+        if (!isWordCopyPossible || bytesLeft < accessSize || isNotWordAligned(pDest))
+            accessSize = 1;
+        pDest -= accessSize;
+        pSrc -= accessSize;
+        if (!copyMemoryUnit(pDest, pSrc, accessSize, checkEachAccess))
+            break;
+        bytesLeft -= accessSize;
+    }
+
+    return length - bytesLeft;
+}
+
+static int copyMemoryUnit(uint8_t* pDest, const uint8_t* pSrc, uint32_t size, int checkEachAccess)
+{
+    uint32_t value;
+
+    if (size == sizeof(value))
+        value = Platform_MemRead32(pSrc);
+    else
+        value = Platform_MemRead8(pSrc);
+    if (checkEachAccess && Platform_WasMemoryFaultEncountered())
+        return 0;
+
+    if (size == sizeof(value))
+        Platform_MemWrite32(pDest, value);
+    else
+        Platform_MemWrite8(pDest, (uint8_t)value);
+    if (checkEachAccess && Platform_WasMemoryFaultEncountered())
+        return 0;
+
+    return 1;
+}
+
+static int areMutuallyWordAligned(const void* pv1, const void* pv2)
+{
+    return (((size_t)pv1 ^ (size_t)pv2) & 3) == 0;
+}
+
+
+/* Constants used by the block hash.  Host tools must use the same values to compute matching hashes. */
+#define BLOCK_HASH_SEED         0x811C9DC5
+#define BLOCK_HASH_MULTIPLIER   0x9E3779B1
+
+static uint32_t readLittleEndianWord(const uint8_t* p, uint32_t byteCount);
+static uint32_t mixWordIntoHash(uint32_t hash, uint32_t word);
+int HashMemoryBlock(const void* pvMemory, uint32_t length, uint32_t* pHash)
+{
+    PlatformMemoryType memoryType = determineMemoryTypeOfRange(pvMemory, length);
+    const uint8_t*     p = (const uint8_t*)pvMemory;
+    uint32_t           hash = BLOCK_HASH_SEED;
+    int                checkEachAccess;
+
+    if (memoryType == MRI_PLATFORM_MEMORY_UNMAPPED)
+        return 0;
+    checkEachAccess = !isRamOrFlash(memoryType);
+
+    /* The hash is defined over little endian 32-bit words with the final partial word padded with zeroes. */
+    while (length > 0)
+    {
+        uint32_t byteCount = length < sizeof(uint32_t) ? length : sizeof(uint32_t);
+        uint32_t word;
+
+        if (byteCount == sizeof(uint32_t) && !isNotWordAligned(p))
+            word = Platform_MemRead32(p);
+        else
+            word = readLittleEndianWord(p, byteCount);
+        if (checkEachAccess && Platform_WasMemoryFaultEncountered())
+            return 0;
+        hash = mixWordIntoHash(hash, word);
+        p += byteCount;
+        length -= byteCount;
+    }
+    if (Platform_WasMemoryFaultEncountered())
+        return 0;
+
+    *pHash = hash;
+    return 1;
+}
+
+static uint32_t readLittleEndianWord(const uint8_t* p, uint32_t byteCount)
+{
+    uint32_t word = 0;
+    uint32_t i;
+
+    for (i = 0 ; i < byteCount ; i++)
+        word |= (uint32_t)Platform_MemRead8(p + i) << (8 * i);
+
+    return word;
+}
+
+static uint32_t mixWordIntoHash(uint32_t hash, uint32_t word)
+{
+    hash = (hash << 5) | (hash >> 27);
+    return (hash ^ word) * BLOCK_HASH_MULTIPLIER;
+}
+
+
+/* Returns the type of memory (RAM, FLASH, etc) which contains the whole of the specified range.  Ranges which span
+   regions are reported as MRI_PLATFORM_MEMORY_PERIPHERAL. */
+PlatformMemoryType GetMemoryTypeOfRange(const void* pvMemory, uint32_t length)
+{
+    return determineMemoryTypeOfRange(pvMemory, length);
+}
+
+
+/* Converts a 32-bit target address, such as one recorded by an earlier command, into a pointer.  Code which has no
+   Buffer at hand for ADDR32_TO_POINTER() uses this instead. */
+void* PointerFromTargetAddress(uint32_t address)
+{
+#if _LP64
+    /* When unit testing on 64-bit, the address will be from the stack so grab the upper 32 bits from a stack address. */
+    return (void*)((size_t)address | ((size_t)&address & 0xFFFFFFFF00000000ULL));
+#else
+    return (void*)(size_t)address;
+#endif /* _LP64 */
+}
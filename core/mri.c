@@ -35,7 +35,20 @@
 #include "cmd_query.h"
 #include "cmd_break_watch.h"
 #include "cmd_step.h"
+#include "cmd_trace.h"
+#include "cmd_vcont.h"
+#include "cmd_monitor.h"
 #include "memory.h"
+#include "dump.h"
+#include "breakpoints.h"
+#include "conditions.h"
+#include "dprintf.h"
+#include "tracepoints.h"
+#include "watchlog.h"
+#include "valuewatch.h"
+#include "rangestep.h"
+#include "expedite.h"
+#include "stats.h"
 
 
 typedef struct
@@ -54,6 +67,9 @@ static MriCore g_mri;
 #define MRI_FLAGS_SUCCESSFUL_INIT   1
 #define MRI_FLAGS_FIRST_EXCEPTION   2
 #define MRI_FLAGS_SEMIHOST_CTRL_C   4
+#define MRI_FLAGS_INTERNAL_FILE_IO  8
+#define MRI_FLAGS_PACKET_PENDING    16
+#define MRI_FLAGS_DETACHED          32
 
 /* Calculates the number of items in a static array at compile time. */
 #define ARRAY_SIZE(X) (sizeof(X)/sizeof(X[0]))
@@ -85,6 +101,15 @@ void __mriInit(const char* pDebuggerParameters)
 static void clearCoreStructure(void)
 {
     memset(&g_mri, 0, sizeof(g_mri));
+    InitSoftwareBreakpoints();
+    InitBreakpointConditions();
+    InitBreakpointCommands();
+    InitTracepoints();
+    InitWatchLog();
+    InitValueWatchpoint();
+    InitRangeStep();
+    InitExpeditedRegisters();
+    InitStats();
 }
 
 static void initializePlatformSpecificModulesWithDebuggerParameters(const char* pDebuggerParameters)
@@ -112,12 +137,19 @@ static void setSuccessfulInitFlag(void)
 }
 
 
+static int  handleLiveAccessCommandIfPresent(void);
+static int  isLiveAccessCommand(void);
+static int  dispatchGDBCommand(void);
+static void setPacketPendingFlag(void);
+static int  isPacketPending(void);
 static void blockIfGdbHasNotConnected(void);
 static void waitForGdbToConnect(void);
 static void waitForFirstCharFromHost(void);
 static int  didHostSendGdbAckChar(void);
 static void determineSignalValue(void);
 static int  isDebugTrap(void);
+static int  wasStopHandledWithoutGdb(int justSingleStepped);
+static void runQueuedMemoryDumps(void);
 static void prepareForDebuggerExit(void);
 static void clearFirstExceptionFlag(void);
 void __mriDebugException(void)
@@ -125,37 +157,148 @@ void __mriDebugException(void)
     int wasWaitingForGdbToConnect = IsWaitingForGdbToConnect();
     int justSingleStepped = Platform_IsSingleStepping();
     
+    StartStatsTimer(STATS_TIMER_STOP);
     if (Platform_CommCausedInterrupt() && !Platform_CommHasReceiveData())
     {
         Platform_CommClearInterrupt();
         return;
     }
+    if (Platform_CommCausedInterrupt() && !IsFirstException() && handleLiveAccessCommandIfPresent())
+    {
+        Platform_CommClearInterrupt();
+        return;
+    }
 
     Platform_EnteringDebuggerHook();
     blockIfGdbHasNotConnected();
     Platform_EnteringDebugger();
+    RemoveSoftwareBreakpoints();
     determineSignalValue();
     
-    if (isDebugTrap() && 
-        Semihost_IsDebuggeeMakingSemihostCall() && 
-        Semihost_HandleSemihostRequest() &&
-        !justSingleStepped )
+    /* A stop which can't be resumed is always reported to gdb. */
+    if (Platform_CanResume() && wasStopHandledWithoutGdb(justSingleStepped))
     {
         prepareForDebuggerExit();
         return;
     }
     
+    StopRangeStep();
     if (!wasWaitingForGdbToConnect)
     {
+        FlushDprintfOutput();
+        ReportFailedBreakpoints();
         Platform_DisplayFaultCauseToGdbConsole();
-        Send_T_StopResponse();
+        /* A packet received while running which couldn't be serviced live is answered instead of the stop response. */
+        if (!isPacketPending())
+            Send_T_StopResponse();
     }
     
     GdbCommandHandlingLoop();
+    runQueuedMemoryDumps();
 
     prepareForDebuggerExit();
 }
 
+static int wasStopHandledWithoutGdb(int justSingleStepped)
+{
+    /* Stops for semihosting, conditional breakpoints, dprintf, tracepoints, and the like are serviced by MRI itself
+       and the program is then resumed without telling gdb. */
+    if (IsSteppingOverBreakpoint())
+    {
+        FinishSteppingOverBreakpoint();
+        if (isDebugTrap() && justSingleStepped && !IsRangeStepping())
+            return 1;
+    }
+    
+    if (isDebugTrap() && justSingleStepped && ContinueRangeStepIfInRange())
+        return 1;
+    
+    if (isDebugTrap() && 
+        Semihost_IsDebuggeeMakingSemihostCall() && 
+        Semihost_HandleSemihostRequest() &&
+        !justSingleStepped )
+    {
+        return 1;
+    }
+    
+    if (isDebugTrap() && !justSingleStepped && SkipConditionalBreakpointIfFalse())
+        return 1;
+    
+    if (isDebugTrap() && !justSingleStepped && RunBreakpointCommandsIfPresent())
+        return 1;
+    
+    if (isDebugTrap() && !justSingleStepped && CollectTraceFrameIfTracepointHit())
+        return 1;
+    
+    if (isDebugTrap() && !justSingleStepped && SkipValueWatchpointIfNoMatch())
+        return 1;
+    
+    if (isDebugTrap() && !justSingleStepped && RecordWatchLogEntryIfHit())
+        return 1;
+
+    return 0;
+}
+
+static int handleLiveAccessCommandIfPresent(void)
+{
+    /* Memory accesses and read-only monitor commands sent while the program is running are serviced from the UART
+       interrupt without halting the program.  Anything else, including CTRL+C, stops the program as before. */
+    if (Platform_CommReceiveChar() != '$')
+        return 0;
+
+    InitBuffer();
+    Packet_GetFromGDBAfterStartChar(&g_mri.packet, &g_mri.buffer);
+    if (!isLiveAccessCommand())
+    {
+        setPacketPendingFlag();
+        return 0;
+    }
+
+    /* The patches placed by a single step can't be told apart from the program's own code so refuse until it's done. */
+    if (Platform_IsSingleStepping())
+    {
+        PrepareStringResponse(MRI_ERROR_MEMORY_ACCESS_FAILURE);
+        SendPacketToGdb();
+        return 1;
+    }
+
+    /* Take the software breakpoints out while the command runs so that reads and hashes see the original code.  Code
+       written by the command is then saved as the original to be restored at the next stop. */
+    RemoveSoftwareBreakpoints();
+    dispatchGDBCommand();
+    InsertSoftwareBreakpoints();
+    return 1;
+}
+
+static int isLiveAccessCommand(void)
+{
+    static const char qRcmdCommand[] = "qRcmd";
+    static const char qMriBlockHashCommand[] = "qMriBlockHash";
+    Buffer*           pBuffer = GetBuffer();
+    int               isLiveCommand;
+
+    isLiveCommand = Buffer_IsNextCharEqualTo(pBuffer, 'm') ||
+                    Buffer_IsNextCharEqualTo(pBuffer, 'M') ||
+                    (Buffer_MatchesStringFollowedBy(pBuffer, qRcmdCommand, sizeof(qRcmdCommand)-1, ',') &&
+                     IsReadOnlyMonitorCommand()) ||
+                    Buffer_MatchesString(pBuffer, qMriBlockHashCommand, sizeof(qMriBlockHashCommand)-1);
+    /* Packets too short to match throw bufferOverrunException which isn't an error here. */
+    clearExceptionCode();
+    Buffer_Reset(pBuffer);
+
+    return isLiveCommand;
+}
+
+static void setPacketPendingFlag(void)
+{
+    g_mri.flags |= MRI_FLAGS_PACKET_PENDING;
+}
+
+static int isPacketPending(void)
+{
+    return (int)(g_mri.flags & MRI_FLAGS_PACKET_PENDING);
+}
+
 static void blockIfGdbHasNotConnected(void)
 {
     if (IsWaitingForGdbToConnect())
@@ -197,11 +340,42 @@ static int isDebugTrap(void)
     return g_mri.signalValue == SIGTRAP;
 }
 
+static int  hasGdbDetached(void);
+static void runQueuedMemoryDumps(void)
+{
+    /* A dump which was interrupted with CTRL+C stops the program again and gives gdb the chance to queue up more. */
+    while (IsMemoryDumpQueued())
+    {
+        /* gdb no longer answers File-I/O requests once it has detached from or killed the program. */
+        if (hasGdbDetached())
+        {
+            CancelMemoryDump();
+            break;
+        }
+        if (!RunQueuedMemoryDump())
+        {
+            Send_T_StopResponse();
+            GdbCommandHandlingLoop();
+        }
+    }
+}
+
+static int hasGdbDetached(void)
+{
+    return g_mri.flags & MRI_FLAGS_DETACHED;
+}
+
+static void clearDetachedFlag(void);
 static void prepareForDebuggerExit(void)
 {
+    /* A single step only executes one instruction so there is no need to pay for inserting the breakpoints. */
+    if (!Platform_IsSingleStepping())
+        InsertSoftwareBreakpoints();
     Platform_LeavingDebugger();
     Platform_LeavingDebuggerHook();
     clearFirstExceptionFlag();
+    clearDetachedFlag();
+    RecordStopStats();
 }
 
 static void clearFirstExceptionFlag(void)
@@ -209,12 +383,18 @@ static void clearFirstExceptionFlag(void)
     g_mri.flags &= ~MRI_FLAGS_FIRST_EXCEPTION;
 }
 
+static void clearDetachedFlag(void)
+{
+    g_mri.flags &= ~MRI_FLAGS_DETACHED;
+}
+
 
 /*********************************************/
 /* Routines to manipulate MRI state objects. */
 /*********************************************/
 static int handleGDBCommand(void);
 static void getPacketFromGDB(void);
+static void clearPacketPendingFlag(void);
 void GdbCommandHandlingLoop(void)
 {
     int startDebuggeeUpAgain;
@@ -226,6 +406,12 @@ void GdbCommandHandlingLoop(void)
 }
 
 static int handleGDBCommand(void)
+{
+    getPacketFromGDB();
+    return dispatchGDBCommand();
+}
+
+static int dispatchGDBCommand(void)
 {
     Buffer*         pBuffer = GetBuffer();
     uint32_t        handlerResult = 0;
@@ -240,50 +426,62 @@ static int handleGDBCommand(void)
         {Send_T_StopResponse,                       '?'},
         {HandleContinueCommand,                     'c'},
         {HandleContinueWithSignalCommand,           'C'},
+        {HandleDetachCommand,                       'D'},
         {HandleFileIOCommand,                       'F'},
         {HandleRegisterReadCommand,                 'g'},
         {HandleRegisterWriteCommand,                'G'},
+        {HandleKillCommand,                         'k'},
         {HandleMemoryReadCommand,                   'm'},
         {HandleMemoryWriteCommand,                  'M'},
         {HandleQueryCommand,                        'q'},
+        {HandleTraceSetCommand,                     'Q'},
         {HandleSingleStepCommand,                   's'},
         {HandleSingleStepWithSignalCommand,         'S'},
+        {HandleVCommand,                            'v'},
         {HandleBinaryMemoryWriteCommand,            'X'},
         {HandleBreakpointWatchpointRemoveCommand,   'z'},
         {HandleBreakpointWatchpointSetCommand,      'Z'}
     };
     
-    getPacketFromGDB();
-    
+    StartStatsTimer(STATS_TIMER_COMMAND);
     commandChar = Buffer_ReadChar(pBuffer);
     for (i = 0 ; i < ARRAY_SIZE(commandTable) ; i++)
     {
         if (commandTable[i].commandChar == commandChar)
         {
             handlerResult = commandTable[i].Handler();
-            if (handlerResult & HANDLER_RETURN_RETURN_IMMEDIATELY)
-            {
-                return handlerResult & HANDLER_RETURN_RESUME_PROGRAM;
-            }
-            else
-            {
-                break;
-            }
+            break;
         }
     }
     if (ARRAY_SIZE(commandTable) == i)
         PrepareEmptyResponseForUnknownCommand();
 
-    SendPacketToGdb();
+    if (!(handlerResult & HANDLER_RETURN_RETURN_IMMEDIATELY))
+        SendPacketToGdb();
+    if (ARRAY_SIZE(commandTable) != i)
+        RecordCommandStats(commandChar);
+    if (handlerResult & HANDLER_RETURN_DETACHED)
+        g_mri.flags |= MRI_FLAGS_DETACHED;
+
     return (handlerResult & HANDLER_RETURN_RESUME_PROGRAM);
 }
 
 static void getPacketFromGDB(void)
 {
+    if (isPacketPending())
+    {
+        clearPacketPendingFlag();
+        return;
+    }
     InitBuffer();
     Packet_GetFromGDB(&g_mri.packet, &g_mri.buffer);
 }
 
+static void clearPacketPendingFlag(void)
+{
+    g_mri.flags &= ~MRI_FLAGS_PACKET_PENDING;
+}
+
 
 void InitBuffer(void)
 {
@@ -334,11 +532,23 @@ int WasSemihostCallCancelledByGdb(void)
 
 void FlagSemihostCallAsHandled(void)
 {
+    /* File-I/O requests issued by mri itself, such as memory dumps, have no semihost call to complete. */
+    if (g_mri.flags & MRI_FLAGS_INTERNAL_FILE_IO)
+        return;
     Platform_AdvanceProgramCounterToNextInstruction();
     Platform_SetSemihostCallReturnAndErrnoValues(g_mri.semihostReturnCode, g_mri.semihostErrno);
 }
 
 
+void RecordInternalFileIORequest(int internalRequest)
+{
+    if (internalRequest)
+        g_mri.flags |= MRI_FLAGS_INTERNAL_FILE_IO;
+    else
+        g_mri.flags &= ~MRI_FLAGS_INTERNAL_FILE_IO;
+}
+
+
 int IsFirstException(void)
 {
     return (int)(g_mri.flags & MRI_FLAGS_FIRST_EXCEPTION);
@@ -398,5 +608,7 @@ void SendPacketToGdb(void)
     }
 
     Buffer_SetEndOfBuffer(&g_mri.buffer);
+    StartStatsTimer(STATS_TIMER_SEND);
     Packet_SendToGDB(&g_mri.packet, &g_mri.buffer);
+    RecordPacketSendStats();
 }
@@ -18,9 +18,11 @@
 #include "hex_convert.h"
 #include "platforms.h"
 #include "packet.h"
+#include "stats.h"
 
 
 static void initPacketStructure(Packet* pPacket, Buffer* pBuffer);
+static void getValidPacket(Packet* pPacket);
 static void getMostRecentPacket(Packet* pPacket);
 static void getPacketDataAndExpectedChecksum(Packet* pPacket);
 static void waitForStartOfNextPacket(Packet* pPacket);
@@ -36,18 +38,33 @@ static void resetBufferToEnableFutureReadingOfValidPacketData(Packet* pPacket);
 void Packet_GetFromGDB(Packet* pPacket, Buffer* pBuffer)
 {
     initPacketStructure(pPacket, pBuffer);
+    getValidPacket(pPacket);
+}
+
+static void initPacketStructure(Packet* pPacket, Buffer* pBuffer)
+{
+    memset(pPacket, 0, sizeof(*pPacket));
+    pPacket->pBuffer = pBuffer;
+}
+
+static void getValidPacket(Packet* pPacket)
+{
     do
     {
         getMostRecentPacket(pPacket);
     } while(!isChecksumValid(pPacket));
     
     resetBufferToEnableFutureReadingOfValidPacketData(pPacket);
+    RecordPacketReceiveStats();
 }
 
-static void initPacketStructure(Packet* pPacket, Buffer* pBuffer)
+
+void Packet_GetFromGDBAfterStartChar(Packet* pPacket, Buffer* pBuffer)
 {
-    memset(pPacket, 0, sizeof(*pPacket));
-    pPacket->pBuffer = pBuffer;
+    /* The caller has already received the '$' which starts the packet. */
+    initPacketStructure(pPacket, pBuffer);
+    pPacket->lastChar = '$';
+    getValidPacket(pPacket);
 }
 
 static void getMostRecentPacket(Packet* pPacket)
@@ -86,6 +103,8 @@ static void waitForStartOfNextPacket(Packet* pPacket)
     /* Wait for the packet start character, '$', and ignore all other characters. */
     while (nextChar != '$')
         nextChar = getNextCharFromGdb(pPacket);
+    /* Packet receive time is measured from its start character so that time spent waiting on gdb isn't counted. */
+    StartStatsTimer(STATS_TIMER_RECEIVE);
 }
 
 static char getNextCharFromGdb(Packet* pPacket)
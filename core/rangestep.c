@@ -0,0 +1,97 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Range stepping which keeps stepping the program without involving gdb for as long as its program counter stays
+   within an address range.  gdb starts it with the vCont;r action when stepping over a source line so that only
+   the final stop is sent over the serial link.  The platform can run whole basic blocks of the range at once. */
+#include <string.h>
+#include "platforms.h"
+#include "breakpoints.h"
+#include "rangestep.h"
+
+
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;
+    uint32_t resumeAddress;
+    int      isActive;
+} RangeStep;
+
+static RangeStep g_rangeStep;
+
+
+void __mriRangeStep_Init(void)
+{
+    memset(&g_rangeStep, 0, sizeof(g_rangeStep));
+}
+
+
+static void resumeRangeStep(void);
+/* Starts stepping the program until its program counter leaves the range from start up to, but not including, end.
+   The first step is always taken, even when the program counter starts outside of the range. */
+void __mriRangeStep_Start(uint32_t start, uint32_t end)
+{
+    g_rangeStep.start = start;
+    g_rangeStep.end = end;
+    g_rangeStep.isActive = 1;
+    resumeRangeStep();
+}
+
+static void resumeRangeStep(void)
+{
+    g_rangeStep.resumeAddress = Platform_GetProgramCounter();
+    Platform_EnableBlockStep(g_rangeStep.end);
+}
+
+
+/* Called when the program stops to be reported to gdb. */
+void __mriRangeStep_Stop(void)
+{
+    g_rangeStep.isActive = 0;
+}
+
+
+int __mriRangeStep_IsActive(void)
+{
+    return g_rangeStep.isActive;
+}
+
+
+static int isInRange(uint32_t address);
+static int wasStoppedByBreakpoint(uint32_t address);
+/* Called when a step has completed.  Returns non-zero if the program counter is still within the range, in which
+   case the next step has already been started and the program should just be resumed. */
+int __mriRangeStep_ContinueIfInRange(void)
+{
+    uint32_t pc = Platform_GetProgramCounter();
+
+    if (!g_rangeStep.isActive || !isInRange(pc) || wasStoppedByBreakpoint(pc))
+        return 0;
+
+    resumeRangeStep();
+    return 1;
+}
+
+static int isInRange(uint32_t address)
+{
+    return address >= g_rangeStep.start && address < g_rangeStep.end;
+}
+
+static int wasStoppedByBreakpoint(uint32_t address)
+{
+    /* A step which made no progress was stopped by a hardware breakpoint on the instruction it was about to execute.
+       Software breakpoints aren't written to memory for a single step so they have to be looked up instead. */
+    return address == g_rangeStep.resumeAddress || IsSoftwareBreakpointSet((const void*)(size_t)address);
+}
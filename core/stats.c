@@ -0,0 +1,246 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Optional cycle count instrumentation which keeps the count, minimum, average, and maximum number of cycles spent in
+   each stop, each gdb command, each packet sent and received, and each File-I/O request made for a semihost call.
+   All of the intervals are measured with Platform_GetCycleCount() (DWT CYCCNT on Cortex-M and mcycle on RISC-V). */
+#include <string.h>
+#include "platforms.h"
+#include "gdb_console.h"
+#include "stats.h"
+
+#if MRI_ENABLE_STATS
+
+typedef struct
+{
+    uint64_t total;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+} StatsEntry;
+
+typedef struct
+{
+    StatsEntry stop;
+    StatsEntry receive;
+    StatsEntry send;
+    StatsEntry commands[MRI_STATS_COMMAND_COUNT];
+    StatsEntry fileOperations[STATS_FILE_COUNT];
+    char       commandChars[MRI_STATS_COMMAND_COUNT];
+} Stats;
+
+static Stats    g_stats;
+static uint32_t g_timerStarts[STATS_TIMER_COUNT];
+
+
+void __mriStats_Init(void)
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+    memset(g_timerStarts, 0, sizeof(g_timerStarts));
+}
+
+
+void __mriStats_StartTimer(StatsTimer timer)
+{
+    g_timerStarts[timer] = Platform_GetCycleCount();
+}
+
+
+static void     recordSample(StatsEntry* pEntry, StatsTimer timer);
+static uint32_t elapsedCycles(StatsTimer timer);
+/* Called on the way out of the debugger to record the cycles spent since the debug exception was entered. */
+void __mriStats_RecordStop(void)
+{
+    recordSample(&g_stats.stop, STATS_TIMER_STOP);
+}
+
+static void recordSample(StatsEntry* pEntry, StatsTimer timer)
+{
+    uint32_t cycles = elapsedCycles(timer);
+
+    if (pEntry->count == 0 || cycles < pEntry->min)
+        pEntry->min = cycles;
+    if (cycles > pEntry->max)
+        pEntry->max = cycles;
+    pEntry->total += cycles;
+    pEntry->count++;
+}
+
+static uint32_t elapsedCycles(StatsTimer timer)
+{
+    /* Unsigned subtraction still gives the right answer after the cycle counter wraps around once. */
+    return Platform_GetCycleCount() - g_timerStarts[timer];
+}
+
+
+static StatsEntry* findCommandEntry(char commandChar);
+/* Commands seen after MRI_STATS_COMMAND_COUNT different command characters have been tracked are dropped. */
+void __mriStats_RecordCommand(char commandChar)
+{
+    StatsEntry* pEntry = findCommandEntry(commandChar);
+
+    if (pEntry)
+        recordSample(pEntry, STATS_TIMER_COMMAND);
+}
+
+static StatsEntry* findCommandEntry(char commandChar)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_STATS_COMMAND_COUNT ; i++)
+    {
+        if (g_stats.commandChars[i] == '\0')
+            g_stats.commandChars[i] = commandChar;
+        if (g_stats.commandChars[i] == commandChar)
+            return &g_stats.commands[i];
+    }
+    return NULL;
+}
+
+
+void __mriStats_RecordPacketReceive(void)
+{
+    recordSample(&g_stats.receive, STATS_TIMER_RECEIVE);
+}
+
+
+void __mriStats_RecordPacketSend(void)
+{
+    recordSample(&g_stats.send, STATS_TIMER_SEND);
+}
+
+
+/* The File-I/O request is timed from the debug exception raised by the semihost call up to gdb's reply. */
+void __mriStats_RecordFileOperation(StatsFileOperation operation)
+{
+    recordSample(&g_stats.fileOperations[operation], STATS_TIMER_STOP);
+}
+
+
+typedef void (*StatsLineWriter)(const char* pLine, void* pContext);
+
+static void writeStatsLines(StatsLineWriter writeLine, void* pContext);
+static void writeEntryLine(StatsLineWriter writeLine, void* pContext, const char* pPrefix, const char* pName,
+                           const StatsEntry* pEntry);
+static void writeLineToGdbConsole(const char* pLine, void* pContext);
+/* Sends the stats to the gdb console as comma separated lines of hexadecimal cycle counts. */
+void __mriStats_Display(void)
+{
+    writeStatsLines(writeLineToGdbConsole, NULL);
+}
+
+static void writeStatsLines(StatsLineWriter writeLine, void* pContext)
+{
+    static const char* const fileOperationNames[STATS_FILE_COUNT] =
+    {
+        "open", "write", "read", "close", "lseek", "fstat", "unlink", "stat", "rename"
+    };
+    char   name[] = "cmd:?";
+    size_t i;
+
+    writeLine("name,count,min,avg,max\n", pContext);
+    writeEntryLine(writeLine, pContext, "stop", "", &g_stats.stop);
+    writeEntryLine(writeLine, pContext, "rx", "", &g_stats.receive);
+    writeEntryLine(writeLine, pContext, "tx", "", &g_stats.send);
+    for (i = 0 ; i < MRI_STATS_COMMAND_COUNT && g_stats.commandChars[i] ; i++)
+    {
+        name[sizeof(name) - 2] = g_stats.commandChars[i];
+        writeEntryLine(writeLine, pContext, name, "", &g_stats.commands[i]);
+    }
+    for (i = 0 ; i < STATS_FILE_COUNT ; i++)
+    {
+        if (g_stats.fileOperations[i].count)
+            writeEntryLine(writeLine, pContext, "file:", fileOperationNames[i], &g_stats.fileOperations[i]);
+    }
+}
+
+static void writeEntryLine(StatsLineWriter writeLine, void* pContext, const char* pPrefix, const char* pName,
+                           const StatsEntry* pEntry)
+{
+    Buffer lineBuffer;
+    char   line[48];
+
+    Buffer_Init(&lineBuffer, line, sizeof(line));
+    Buffer_WriteString(&lineBuffer, pPrefix);
+    Buffer_WriteString(&lineBuffer, pName);
+    Buffer_WriteChar(&lineBuffer, ',');
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->count);
+    Buffer_WriteChar(&lineBuffer, ',');
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->min);
+    Buffer_WriteChar(&lineBuffer, ',');
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->count ? (uint32_t)(pEntry->total / pEntry->count) : 0);
+    Buffer_WriteChar(&lineBuffer, ',');
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->max);
+    Buffer_WriteChar(&lineBuffer, '\n');
+    Buffer_WriteChar(&lineBuffer, '\0');
+
+    writeLine(line, pContext);
+}
+
+static void writeLineToGdbConsole(const char* pLine, void* pContext)
+{
+    WriteStringToGdbConsole(pLine);
+}
+
+
+void __mriStats_Clear(void)
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+
+
+typedef struct
+{
+    Buffer*  pBuffer;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t position;
+    uint32_t written;
+} TransferWindow;
+
+static void writeLineToTransferWindow(const char* pLine, void* pContext);
+/* Writes the qXfer reply for the part of the text sent by "monitor stats" which starts at offset.  The reply starts
+   with 'l' when it contains the end of the text and 'm' when there is more to be read. */
+void __mriStats_WriteTransferData(Buffer* pBuffer, uint32_t offset, uint32_t length)
+{
+    char*          pPrefix = Buffer_GetArray(pBuffer) + Buffer_GetLength(pBuffer) - Buffer_BytesLeft(pBuffer);
+    TransferWindow window;
+
+    Buffer_WriteChar(pBuffer, 'l');
+    window.pBuffer = pBuffer;
+    window.offset = offset;
+    window.length = length < Buffer_BytesLeft(pBuffer) ? length : Buffer_BytesLeft(pBuffer);
+    window.position = 0;
+    window.written = 0;
+    writeStatsLines(writeLineToTransferWindow, &window);
+
+    if (window.position > window.offset + window.written)
+        *pPrefix = 'm';
+}
+
+static void writeLineToTransferWindow(const char* pLine, void* pContext)
+{
+    TransferWindow* pWindow = (TransferWindow*)pContext;
+
+    for ( ; *pLine ; pLine++, pWindow->position++)
+    {
+        if (pWindow->position >= pWindow->offset && pWindow->written < pWindow->length)
+        {
+            Buffer_WriteChar(pWindow->pBuffer, *pLine);
+            pWindow->written++;
+        }
+    }
+}
+
+#endif /* MRI_ENABLE_STATS */
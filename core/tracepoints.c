@@ -0,0 +1,1196 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Tracepoints which collect registers and memory into a trace buffer on the target and let the program continue
+   without stopping in gdb.  Each tracepoint location is a breakpoint which the monitor handles itself: a hit appends a
+   frame to the trace buffer and then single steps over the breakpoint before resuming the program.  gdb can later
+   select frames from the buffer and read back the registers and memory which were collected in them. */
+#include <string.h>
+#include "platforms.h"
+#include "core.h"
+#include "memory.h"
+#include "cmd_common.h"
+#include "agent.h"
+#include "breakpoints.h"
+#include "tracepoints.h"
+
+
+/* A 16-bit breakpoint works for both Thumb and compressed RISC-V code, even when it only covers the first half of a
+   32-bit instruction. */
+#define TRACEPOINT_BREAKPOINT_KIND  2
+
+/* The basereg which gdb sends for memory ranges which are at an absolute address. */
+#define TRACE_ABSOLUTE_ADDRESS      0xFFFFFFFF
+
+/* Actions stored in Tracepoint::actions.  Each starts with one of these type bytes. */
+#define ACTION_CONDITION            'C' /* 16-bit length followed by agent expression bytecode. */
+#define ACTION_MEMORY               'M' /* 32-bit basereg, offset, and length. */
+#define ACTION_EXPRESSION           'X' /* 16-bit length followed by agent expression bytecode. */
+#define ACTION_MEMORY_SIZE          (1 + 3 * sizeof(uint32_t))
+#define ACTION_BYTECODE_HEADER_SIZE (1 + sizeof(uint16_t))
+
+/* Blocks stored in a trace frame after its TraceFrameHeader.  Each starts with one of these type bytes and the 16-bit
+   length of the data which follows. */
+#define BLOCK_REGISTERS             'R' /* Registers in the same format as the response to the 'g' command. */
+#define BLOCK_MEMORY                'M' /* 32-bit address followed by the contents of memory. */
+#define BLOCK_VARIABLE              'V' /* 32-bit trace state variable number followed by its 64-bit value. */
+#define BLOCK_HEADER_SIZE           (1 + sizeof(uint16_t))
+#define BLOCK_MAX_LENGTH            0xFFFF
+
+typedef struct
+{
+    uint32_t number;
+    uint32_t address;
+    uint32_t length;
+} TraceFrameHeader;
+
+typedef struct
+{
+    uint32_t number;
+    uint32_t address;
+    uint32_t passCount;
+    uint32_t hitCount;
+    uint32_t actionsLength;
+    int      isDefined;
+    int      isEnabled;
+    int      isInserted;
+    uint8_t  actions[MRI_TRACEPOINT_ACTIONS_SIZE];
+} Tracepoint;
+
+typedef struct
+{
+    uint64_t value;
+    uint64_t initialValue;
+    uint32_t number;
+    int      isDefined;
+} TraceVariable;
+
+typedef enum
+{
+    TRACE_NOT_RUN,
+    TRACE_RUNNING,
+    TRACE_STOPPED,
+    TRACE_BUFFER_FULL,
+    TRACE_PASS_COUNT
+} TraceState;
+
+typedef struct
+{
+    Tracepoint    tracepoints[MRI_TRACEPOINT_COUNT];
+    TraceVariable variables[MRI_TRACE_VARIABLE_COUNT];
+    /* Frames are stored oldest first starting at head.  Once a circular buffer has wrapped, the older frames run from
+       head up to wrapEnd and the newer ones from the start of the buffer up to frameStart. */
+    uint32_t      head;
+    uint32_t      wrapEnd;
+    uint32_t      frameStart;
+    uint32_t      writeOffset;
+    uint32_t      frameCount;
+    uint32_t      framesCreated;
+    uint32_t      stopTracepoint;
+    int           selectedFrame;
+    int           isWrapped;
+    int           isCircular;
+    int           isCollecting;
+    TraceState    state;
+} Tracing;
+
+static Tracing g_tracing;
+static uint8_t g_traceBuffer[MRI_TRACE_BUFFER_SIZE] MRI_TRACE_BUFFER_ATTRIBUTES;
+
+
+static void clearTraceBuffer(void);
+void InitTracepoints(void)
+{
+    memset(&g_tracing, 0, sizeof(g_tracing));
+    clearTraceBuffer();
+}
+
+static void clearTraceBuffer(void)
+{
+    g_tracing.head = 0;
+    g_tracing.wrapEnd = 0;
+    g_tracing.frameStart = 0;
+    g_tracing.writeOffset = 0;
+    g_tracing.frameCount = 0;
+    g_tracing.framesCreated = 0;
+    g_tracing.isWrapped = 0;
+    g_tracing.selectedFrame = -1;
+}
+
+
+static Tracepoint* findTracepoint(uint32_t number, uint32_t address);
+static Tracepoint* findFreeTracepoint(void);
+static void        parseTracepointDefinition(Tracepoint* pTracepoint, Buffer* pBuffer);
+static void        parseTracepointAction(Tracepoint* pTracepoint, Buffer* pBuffer);
+static void        parseMemoryAction(Tracepoint* pTracepoint, Buffer* pBuffer);
+static void        parseBytecodeAction(Tracepoint* pTracepoint, uint8_t type, Buffer* pBuffer);
+static uint8_t*    allocateAction(Tracepoint* pTracepoint, uint32_t size);
+/* Parses the body of a QTDP command.  The first command for a tracepoint location creates it:
+       n:addr:E|D:step:pass[:Xlen,bytecode][-]
+   and each of the commands which follow adds one action to it:
+       -n:addr:action[-]
+   Throws invalidArgumentException for malformed or unsupported definitions, such as while-stepping or fast
+   tracepoints, and exceededHardwareResourcesException when there is no room left for the tracepoint or its actions. */
+void DefineTracepoint(Buffer* pBuffer)
+{
+    int         isAction = Buffer_BytesLeft(pBuffer) > 0 && Buffer_IsNextCharEqualTo(pBuffer, '-');
+    Tracepoint* pTracepoint;
+    uint32_t    number;
+    uint32_t    address;
+
+    __try
+    {
+        __throwing_func( number = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( address = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+
+    pTracepoint = findTracepoint(number, address);
+    if (isAction)
+    {
+        if (!pTracepoint)
+            __throw(invalidArgumentException);
+        __try
+            parseTracepointAction(pTracepoint, pBuffer);
+        __catch
+            __rethrow;
+        return;
+    }
+
+    if (!pTracepoint)
+        pTracepoint = findFreeTracepoint();
+    if (!pTracepoint)
+        __throw(exceededHardwareResourcesException);
+    memset(pTracepoint, 0, sizeof(*pTracepoint));
+    pTracepoint->number = number;
+    pTracepoint->address = address;
+
+    __try
+        parseTracepointDefinition(pTracepoint, pBuffer);
+    __catch
+        __rethrow;
+    pTracepoint->isDefined = 1;
+}
+
+static Tracepoint* findTracepoint(uint32_t number, uint32_t address)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        Tracepoint* pTracepoint = &g_tracing.tracepoints[i];
+
+        if (pTracepoint->isDefined && pTracepoint->number == number && pTracepoint->address == address)
+            return pTracepoint;
+    }
+
+    return NULL;
+}
+
+static Tracepoint* findFreeTracepoint(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        if (!g_tracing.tracepoints[i].isDefined)
+            return &g_tracing.tracepoints[i];
+    }
+
+    return NULL;
+}
+
+static void parseTracepointDefinition(Tracepoint* pTracepoint, Buffer* pBuffer)
+{
+    char     enabled;
+    uint32_t stepCount;
+
+    __try
+    {
+        __throwing_func( enabled = Buffer_ReadChar(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( stepCount = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( pTracepoint->passCount = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+
+    /* Collecting while single stepping after the tracepoint is hit isn't supported. */
+    if ((enabled != 'E' && enabled != 'D') || stepCount != 0)
+        __throw(invalidArgumentException);
+    pTracepoint->isEnabled = (enabled == 'E');
+
+    while (Buffer_BytesLeft(pBuffer) > 0 && Buffer_IsNextCharEqualTo(pBuffer, ':'))
+    {
+        /* Fast tracepoints (F) need an in-process agent so a condition (X) is the only option accepted. */
+        if (!Buffer_IsNextCharEqualTo(pBuffer, 'X'))
+            __throw(invalidArgumentException);
+        __try
+            parseBytecodeAction(pTracepoint, ACTION_CONDITION, pBuffer);
+        __catch
+            __rethrow;
+    }
+}
+
+static void parseTracepointAction(Tracepoint* pTracepoint, Buffer* pBuffer)
+{
+    char actionType;
+
+    __try
+        actionType = Buffer_ReadChar(pBuffer);
+    __catch
+        __throw(invalidArgumentException);
+
+    switch (actionType)
+    {
+    case 'R':
+        /* Every frame holds all of the registers anyway. */
+        break;
+    case 'M':
+        parseMemoryAction(pTracepoint, pBuffer);
+        break;
+    case 'X':
+        parseBytecodeAction(pTracepoint, ACTION_EXPRESSION, pBuffer);
+        break;
+    default:
+        /* While-stepping actions (S) aren't supported. */
+        __throw(invalidArgumentException);
+    }
+}
+
+static void parseMemoryAction(Tracepoint* pTracepoint, Buffer* pBuffer)
+{
+    uint32_t fields[3];
+    uint8_t* pAction;
+
+    /* M basereg,offset,length where basereg is TRACE_ABSOLUTE_ADDRESS when the offset is the actual address. */
+    __try
+    {
+        __throwing_func( fields[0] = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+        __throwing_func( fields[1] = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+        __throwing_func( fields[2] = ReadUIntegerArgument(pBuffer) );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+    if (fields[2] == 0 || fields[2] > BLOCK_MAX_LENGTH - sizeof(uint32_t))
+        __throw(invalidArgumentException);
+
+    pAction = allocateAction(pTracepoint, ACTION_MEMORY_SIZE);
+    if (!pAction)
+        __throw(exceededHardwareResourcesException);
+    pAction[0] = ACTION_MEMORY;
+    memcpy(&pAction[1], fields, sizeof(fields));
+}
+
+static void parseBytecodeAction(Tracepoint* pTracepoint, uint8_t type, Buffer* pBuffer)
+{
+    uint32_t length;
+    uint16_t length16;
+    uint8_t* pAction;
+    uint32_t i;
+
+    __try
+    {
+        __throwing_func( length = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ',') );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+    if (length == 0 || length > BLOCK_MAX_LENGTH)
+        __throw(invalidArgumentException);
+
+    pAction = allocateAction(pTracepoint, ACTION_BYTECODE_HEADER_SIZE + length);
+    if (!pAction)
+        __throw(exceededHardwareResourcesException);
+    pAction[0] = type;
+    length16 = (uint16_t)length;
+    memcpy(&pAction[1], &length16, sizeof(length16));
+    for (i = 0 ; i < length ; i++)
+    {
+        __try
+            pAction[ACTION_BYTECODE_HEADER_SIZE + i] = Buffer_ReadByteAsHex(pBuffer);
+        __catch
+        {
+            pTracepoint->actionsLength -= ACTION_BYTECODE_HEADER_SIZE + length;
+            __throw(invalidArgumentException);
+        }
+    }
+}
+
+static uint8_t* allocateAction(Tracepoint* pTracepoint, uint32_t size)
+{
+    uint8_t* pAction;
+
+    if (size > MRI_TRACEPOINT_ACTIONS_SIZE - pTracepoint->actionsLength)
+        return NULL;
+    pAction = &pTracepoint->actions[pTracepoint->actionsLength];
+    pTracepoint->actionsLength += size;
+
+    return pAction;
+}
+
+
+static TraceVariable* findVariable(uint32_t number);
+static TraceVariable* findFreeVariable(void);
+/* Parses the body of a QTDV command which defines a trace state variable and its initial value:
+       n:value:builtin:name
+   Throws invalidArgumentException if the definition is malformed and exceededHardwareResourcesException if there are
+   no free variables left. */
+void DefineTraceVariable(Buffer* pBuffer)
+{
+    TraceVariable* pVariable;
+    uint32_t       number;
+    uint64_t       value;
+
+    __try
+    {
+        __throwing_func( number = ReadUIntegerArgument(pBuffer) );
+        __throwing_func( ThrowIfNextCharIsNotEqualTo(pBuffer, ':') );
+        __throwing_func( value = Buffer_ReadUInteger64AsHex(pBuffer) );
+    }
+    __catch
+    {
+        __throw(invalidArgumentException);
+    }
+
+    pVariable = findVariable(number);
+    if (!pVariable)
+        pVariable = findFreeVariable();
+    if (!pVariable)
+        __throw(exceededHardwareResourcesException);
+    pVariable->number = number;
+    pVariable->initialValue = value;
+    pVariable->value = value;
+    pVariable->isDefined = 1;
+}
+
+static TraceVariable* findVariable(uint32_t number)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACE_VARIABLE_COUNT ; i++)
+    {
+        TraceVariable* pVariable = &g_tracing.variables[i];
+
+        if (pVariable->isDefined && pVariable->number == number)
+            return pVariable;
+    }
+
+    return NULL;
+}
+
+static TraceVariable* findFreeVariable(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACE_VARIABLE_COUNT ; i++)
+    {
+        if (!g_tracing.variables[i].isDefined)
+            return &g_tracing.variables[i];
+    }
+
+    return NULL;
+}
+
+
+/* Selects whether the oldest frames are discarded to make room for new ones once the trace buffer fills up, rather
+   than stopping the trace experiment. */
+void SetTraceBufferCircular(int isCircular)
+{
+    g_tracing.isCircular = isCircular;
+}
+
+
+static void insertTracepointBreakpoints(void);
+static int  isBreakpointInsertedAt(uint32_t address);
+static void removeTracepointBreakpoints(void);
+static const void* addressToPointer(uint32_t address);
+/* Starts a new trace experiment with an empty trace buffer by setting breakpoints on all of the enabled tracepoints.
+   Throws exceededHardwareResourcesException if there aren't enough breakpoints for all of them. */
+void StartTracing(void)
+{
+    size_t i;
+
+    removeTracepointBreakpoints();
+    clearTraceBuffer();
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+        g_tracing.tracepoints[i].hitCount = 0;
+    for (i = 0 ; i < MRI_TRACE_VARIABLE_COUNT ; i++)
+        g_tracing.variables[i].value = g_tracing.variables[i].initialValue;
+
+    __try
+        insertTracepointBreakpoints();
+    __catch
+    {
+        removeTracepointBreakpoints();
+        __rethrow;
+    }
+    g_tracing.state = TRACE_RUNNING;
+}
+
+static void insertTracepointBreakpoints(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        Tracepoint* pTracepoint = &g_tracing.tracepoints[i];
+
+        /* gdb sends a separate tracepoint for each location so they can share an address. */
+        if (!pTracepoint->isDefined || !pTracepoint->isEnabled || isBreakpointInsertedAt(pTracepoint->address))
+            continue;
+        __try
+            SetBreakpoint((void*)addressToPointer(pTracepoint->address), TRACEPOINT_BREAKPOINT_KIND);
+        __catch
+            __rethrow;
+        pTracepoint->isInserted = 1;
+    }
+}
+
+static int isBreakpointInsertedAt(uint32_t address)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        if (g_tracing.tracepoints[i].isInserted && g_tracing.tracepoints[i].address == address)
+            return 1;
+    }
+
+    return 0;
+}
+
+static void removeTracepointBreakpoints(void)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        Tracepoint* pTracepoint = &g_tracing.tracepoints[i];
+
+        if (!pTracepoint->isInserted)
+            continue;
+        __try
+            ClearBreakpoint((void*)addressToPointer(pTracepoint->address), TRACEPOINT_BREAKPOINT_KIND);
+        __catch
+            clearExceptionCode();
+        pTracepoint->isInserted = 0;
+    }
+}
+
+static const void* addressToPointer(uint32_t address)
+{
+    return PointerFromTargetAddress(address);
+}
+
+
+static void stopTracing(TraceState state, uint32_t tracepointNumber);
+/* Stops the current trace experiment, leaving the frames which were collected in the trace buffer. */
+void StopTracing(void)
+{
+    if (g_tracing.state == TRACE_RUNNING)
+        stopTracing(TRACE_STOPPED, 0);
+}
+
+static void stopTracing(TraceState state, uint32_t tracepointNumber)
+{
+    removeTracepointBreakpoints();
+    g_tracing.state = state;
+    g_tracing.stopTracepoint = tracepointNumber;
+}
+
+
+static void     collectTraceFrame(Tracepoint* pTracepoint);
+static void     beginFrame(Tracepoint* pTracepoint);
+static int      isConditionTrue(Tracepoint* pTracepoint);
+static void     collectRegisters(void);
+static void     runActions(Tracepoint* pTracepoint);
+static void     runMemoryAction(const uint8_t* pAction);
+static void     runExpressionAction(const uint8_t* pAction);
+static uint32_t actionSize(const uint8_t* pAction);
+static void     endFrame(void);
+static void     abortFrame(void);
+static uint8_t* reserveBlock(uint8_t type, uint32_t length);
+static void     removeLastBlock(uint8_t* pData);
+static uint8_t* reserveTraceBufferSpace(uint32_t size);
+static void     wrapFrameToStartOfBuffer(uint32_t spaceNeeded);
+static void     discardFramesBefore(uint32_t end);
+static uint32_t frameLengthAt(uint32_t offset);
+static void     collectMemory(uint32_t address, uint32_t size);
+static void     collectVariable(uint32_t number);
+static uint64_t getVariable(uint32_t number);
+static void     setVariable(uint32_t number, uint64_t value);
+static const AgentHooks g_traceHooks = { collectMemory, collectVariable, getVariable, setVariable, NULL };
+/* Called when the program stops on a breakpoint while a trace experiment is running.  If the PC is at a tracepoint
+   then a frame is collected for each tracepoint at that address whose condition is true and 1 is returned so that the
+   caller can resume the program without notifying gdb. */
+int CollectTraceFrameIfTracepointHit(void)
+{
+    uint32_t pc = Platform_GetProgramCounter();
+    int      wasHit = 0;
+    size_t   i;
+
+    if (g_tracing.state != TRACE_RUNNING)
+        return 0;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        Tracepoint* pTracepoint = &g_tracing.tracepoints[i];
+
+        if (!pTracepoint->isDefined || !pTracepoint->isEnabled || pTracepoint->address != pc)
+            continue;
+        wasHit = 1;
+        if (g_tracing.state == TRACE_RUNNING && isConditionTrue(pTracepoint))
+            collectTraceFrame(pTracepoint);
+    }
+    if (!wasHit)
+        return 0;
+
+    /* The breakpoints have already been removed if this hit brought the trace experiment to an end. */
+    if (g_tracing.state != TRACE_RUNNING)
+        return 1;
+    return StartSteppingOverBreakpoint((void*)addressToPointer(pc), TRACEPOINT_BREAKPOINT_KIND);
+}
+
+static void collectTraceFrame(Tracepoint* pTracepoint)
+{
+    __try
+    {
+        __throwing_func( beginFrame(pTracepoint) );
+        __throwing_func( collectRegisters() );
+        __throwing_func( runActions(pTracepoint) );
+    }
+    __catch
+    {
+        /* Running out of room in the trace buffer is the only failure which makes it this far. */
+        clearExceptionCode();
+        abortFrame();
+        stopTracing(TRACE_BUFFER_FULL, 0);
+        return;
+    }
+    endFrame();
+
+    pTracepoint->hitCount++;
+    if (pTracepoint->passCount && pTracepoint->hitCount >= pTracepoint->passCount)
+        stopTracing(TRACE_PASS_COUNT, pTracepoint->number);
+}
+
+static void beginFrame(Tracepoint* pTracepoint)
+{
+    TraceFrameHeader header;
+    uint8_t*         pHeader;
+
+    g_tracing.writeOffset = g_tracing.frameStart;
+    g_tracing.isCollecting = 1;
+    pHeader = reserveTraceBufferSpace(sizeof(header));
+    if (!pHeader)
+        __throw(bufferOverrunException);
+
+    header.number = pTracepoint->number;
+    header.address = pTracepoint->address;
+    header.length = 0;
+    memcpy(pHeader, &header, sizeof(header));
+}
+
+static int isConditionTrue(Tracepoint* pTracepoint)
+{
+    const uint8_t* pCurr = pTracepoint->actions;
+    const uint8_t* pEnd = pTracepoint->actions + pTracepoint->actionsLength;
+
+    for ( ; pCurr < pEnd ; pCurr += actionSize(pCurr))
+    {
+        uint16_t length;
+        uint64_t result;
+
+        if (*pCurr != ACTION_CONDITION)
+            continue;
+        memcpy(&length, &pCurr[1], sizeof(length));
+        __try
+            result = EvaluateAgentExpressionWithHooks(&pCurr[ACTION_BYTECODE_HEADER_SIZE], length, &g_traceHooks);
+        __catch
+        {
+            /* Just as for breakpoint conditions, a condition which can't be evaluated is treated as true. */
+            clearExceptionCode();
+            return 1;
+        }
+        return result != 0;
+    }
+
+    return 1;
+}
+
+static void collectRegisters(void)
+{
+    Buffer*  pBuffer = GetInitializedBuffer();
+    uint32_t length;
+    uint8_t* pDest;
+
+    /* The registers are stored in the same format as sent to gdb, so just without the hex encoding, so that the 'g'
+       command can return them without any knowledge of the platform's context layout. */
+    Platform_CopyContextToBuffer(pBuffer);
+    Buffer_SetEndOfBuffer(pBuffer);
+    Buffer_Reset(pBuffer);
+    length = Buffer_GetLength(pBuffer) / 2;
+
+    pDest = reserveBlock(BLOCK_REGISTERS, length);
+    if (!pDest)
+        __throw(bufferOverrunException);
+    while (length-- > 0)
+        *pDest++ = Buffer_ReadByteAsHex(pBuffer);
+}
+
+static void runActions(Tracepoint* pTracepoint)
+{
+    const uint8_t* pCurr = pTracepoint->actions;
+    const uint8_t* pEnd = pTracepoint->actions + pTracepoint->actionsLength;
+
+    for ( ; pCurr < pEnd ; pCurr += actionSize(pCurr))
+    {
+        __try
+        {
+            if (*pCurr == ACTION_MEMORY)
+            {
+                __throwing_func( runMemoryAction(pCurr) );
+            }
+            else if (*pCurr == ACTION_EXPRESSION)
+            {
+                __throwing_func( runExpressionAction(pCurr) );
+            }
+        }
+        __catch
+        {
+            __rethrow;
+        }
+    }
+}
+
+static void runMemoryAction(const uint8_t* pAction)
+{
+    uint32_t fields[3];
+    uint32_t address;
+
+    memcpy(fields, &pAction[1], sizeof(fields));
+    address = fields[1];
+    if (fields[0] != TRACE_ABSOLUTE_ADDRESS)
+    {
+        __try
+            address += Platform_ReadRegister(fields[0]);
+        __catch
+        {
+            clearExceptionCode();
+            return;
+        }
+    }
+
+    __try
+        collectMemory(address, fields[2]);
+    __catch
+        __rethrow;
+}
+
+static void runExpressionAction(const uint8_t* pAction)
+{
+    uint16_t length;
+
+    memcpy(&length, &pAction[1], sizeof(length));
+    __try
+        EvaluateAgentExpressionWithHooks(&pAction[ACTION_BYTECODE_HEADER_SIZE], length, &g_traceHooks);
+    __catch
+    {
+        /* An expression which can't be evaluated just collects less but a full trace buffer ends the frame. */
+        if (getExceptionCode() == bufferOverrunException)
+            __rethrow;
+        clearExceptionCode();
+    }
+}
+
+static uint32_t actionSize(const uint8_t* pAction)
+{
+    uint16_t length;
+
+    if (*pAction == ACTION_MEMORY)
+        return ACTION_MEMORY_SIZE;
+    memcpy(&length, &pAction[1], sizeof(length));
+    return ACTION_BYTECODE_HEADER_SIZE + length;
+}
+
+static void endFrame(void)
+{
+    TraceFrameHeader header;
+
+    memcpy(&header, &g_traceBuffer[g_tracing.frameStart], sizeof(header));
+    header.length = g_tracing.writeOffset - g_tracing.frameStart;
+    memcpy(&g_traceBuffer[g_tracing.frameStart], &header, sizeof(header));
+
+    g_tracing.frameStart = g_tracing.writeOffset;
+    g_tracing.frameCount++;
+    g_tracing.framesCreated++;
+    g_tracing.isCollecting = 0;
+}
+
+static void abortFrame(void)
+{
+    g_tracing.writeOffset = g_tracing.frameStart;
+    g_tracing.isCollecting = 0;
+}
+
+static uint8_t* reserveBlock(uint8_t type, uint32_t length)
+{
+    uint16_t length16 = (uint16_t)length;
+    uint8_t* pBlock;
+
+    pBlock = reserveTraceBufferSpace(BLOCK_HEADER_SIZE + length);
+    if (!pBlock)
+        return NULL;
+    pBlock[0] = type;
+    memcpy(&pBlock[1], &length16, sizeof(length16));
+
+    return &pBlock[BLOCK_HEADER_SIZE];
+}
+
+static void removeLastBlock(uint8_t* pData)
+{
+    g_tracing.writeOffset = (pData - g_traceBuffer) - BLOCK_HEADER_SIZE;
+}
+
+static uint8_t* reserveTraceBufferSpace(uint32_t size)
+{
+    uint32_t frameSize = g_tracing.writeOffset - g_tracing.frameStart;
+    uint8_t* pSpace;
+
+    /* Frames are never split across the end of the buffer so one which wouldn't fit is moved to the start. */
+    if (size > sizeof(g_traceBuffer) - frameSize)
+        return NULL;
+    if (size > sizeof(g_traceBuffer) - g_tracing.writeOffset)
+    {
+        if (!g_tracing.isCircular)
+            return NULL;
+        wrapFrameToStartOfBuffer(frameSize + size);
+    }
+    discardFramesBefore(g_tracing.writeOffset + size);
+
+    pSpace = &g_traceBuffer[g_tracing.writeOffset];
+    g_tracing.writeOffset += size;
+    return pSpace;
+}
+
+static void wrapFrameToStartOfBuffer(uint32_t spaceNeeded)
+{
+    uint32_t frameSize = g_tracing.writeOffset - g_tracing.frameStart;
+
+    /* Older frames between here and the end of the buffer can't survive this frame wrapping around past them.  The
+       rest stay where they are and become the older half of the wrapped buffer. */
+    discardFramesBefore(sizeof(g_traceBuffer));
+    if (g_tracing.frameCount > 0)
+    {
+        g_tracing.wrapEnd = g_tracing.frameStart;
+        g_tracing.isWrapped = 1;
+    }
+    discardFramesBefore(spaceNeeded);
+
+    memmove(g_traceBuffer, &g_traceBuffer[g_tracing.frameStart], frameSize);
+    g_tracing.frameStart = 0;
+    g_tracing.writeOffset = frameSize;
+}
+
+static void discardFramesBefore(uint32_t end)
+{
+    /* Only the frames of a wrapped buffer can be in the way of the frame being written. */
+    while (g_tracing.isWrapped && g_tracing.head < end)
+    {
+        g_tracing.head += frameLengthAt(g_tracing.head);
+        g_tracing.frameCount--;
+        if (g_tracing.head >= g_tracing.wrapEnd)
+        {
+            g_tracing.head = 0;
+            g_tracing.isWrapped = 0;
+        }
+    }
+}
+
+static uint32_t frameLengthAt(uint32_t offset)
+{
+    TraceFrameHeader header;
+
+    memcpy(&header, &g_traceBuffer[offset], sizeof(header));
+    return header.length;
+}
+
+static void collectMemory(uint32_t address, uint32_t size)
+{
+    const uint8_t* pSrc = addressToPointer(address);
+    uint8_t*       pDest;
+    uint32_t       i;
+
+    /* The trace opcodes are only allowed in actions, not in conditions. */
+    if (!g_tracing.isCollecting || size > BLOCK_MAX_LENGTH - sizeof(address))
+        __throw(invalidArgumentException);
+
+    pDest = reserveBlock(BLOCK_MEMORY, sizeof(address) + size);
+    if (!pDest)
+        __throw(bufferOverrunException);
+    memcpy(pDest, &address, sizeof(address));
+    pDest += sizeof(address);
+
+    /* Memory which can't be read is left out of the frame so that gdb reports it as unavailable. */
+    if (GetMemoryTypeOfRange(pSrc, size) == MRI_PLATFORM_MEMORY_UNMAPPED)
+    {
+        removeLastBlock(pDest - sizeof(address));
+        return;
+    }
+    for (i = 0 ; i < size ; i++)
+        pDest[i] = Platform_MemRead8(pSrc + i);
+    if (Platform_WasMemoryFaultEncountered())
+        removeLastBlock(pDest - sizeof(address));
+}
+
+static void collectVariable(uint32_t number)
+{
+    TraceVariable* pVariable = findVariable(number);
+    uint8_t*       pDest;
+
+    if (!g_tracing.isCollecting || !pVariable)
+        __throw(invalidArgumentException);
+
+    pDest = reserveBlock(BLOCK_VARIABLE, sizeof(number) + sizeof(pVariable->value));
+    if (!pDest)
+        __throw(bufferOverrunException);
+    memcpy(pDest, &number, sizeof(number));
+    memcpy(pDest + sizeof(number), &pVariable->value, sizeof(pVariable->value));
+}
+
+static uint64_t getVariable(uint32_t number)
+{
+    TraceVariable* pVariable = findVariable(number);
+
+    if (!pVariable)
+        __throw_and_return(invalidArgumentException, 0);
+    return pVariable->value;
+}
+
+static void setVariable(uint32_t number, uint64_t value)
+{
+    TraceVariable* pVariable = findVariable(number);
+
+    if (!pVariable)
+        __throw(invalidArgumentException);
+    pVariable->value = value;
+}
+
+
+/* Writes the response to the qTStatus command:
+       T1|T0[;stop reason];tframes:x;tcreated:x;tfree:x;tsize:x;circular:0|1;disconn:0
+*/
+void WriteTraceStatus(Buffer* pBuffer)
+{
+    uint32_t freeSpace;
+
+    Buffer_WriteString(pBuffer, g_tracing.state == TRACE_RUNNING ? "T1" : "T0");
+    switch (g_tracing.state)
+    {
+    case TRACE_NOT_RUN:
+        Buffer_WriteString(pBuffer, ";tnotrun:0");
+        break;
+    case TRACE_STOPPED:
+        Buffer_WriteString(pBuffer, ";tstop:0");
+        break;
+    case TRACE_BUFFER_FULL:
+        Buffer_WriteString(pBuffer, ";tfull:0");
+        break;
+    case TRACE_PASS_COUNT:
+        Buffer_WriteString(pBuffer, ";tpasscount:");
+        Buffer_WriteUIntegerAsHex(pBuffer, g_tracing.stopTracepoint);
+        break;
+    default:
+        break;
+    }
+
+    if (g_tracing.isWrapped)
+        freeSpace = g_tracing.head - g_tracing.frameStart;
+    else
+        freeSpace = sizeof(g_traceBuffer) - g_tracing.frameStart;
+    Buffer_WriteString(pBuffer, ";tframes:");
+    Buffer_WriteUIntegerAsHex(pBuffer, g_tracing.frameCount);
+    Buffer_WriteString(pBuffer, ";tcreated:");
+    Buffer_WriteUIntegerAsHex(pBuffer, g_tracing.framesCreated);
+    Buffer_WriteString(pBuffer, ";tfree:");
+    Buffer_WriteUIntegerAsHex(pBuffer, freeSpace);
+    Buffer_WriteString(pBuffer, ";tsize:");
+    Buffer_WriteUIntegerAsHex(pBuffer, sizeof(g_traceBuffer));
+    Buffer_WriteString(pBuffer, g_tracing.isCircular ? ";circular:1" : ";circular:0");
+    Buffer_WriteString(pBuffer, ";disconn:0");
+}
+
+
+/* Writes the definition of the index'th tracepoint for the qTfP/qTsP commands which gdb uses to upload tracepoints:
+       Tn:addr:E|D:0:pass
+   The actions aren't uploaded.  Returns 0 once there are no more tracepoints. */
+int WriteTracepointDefinition(Buffer* pBuffer, uint32_t index)
+{
+    size_t i;
+
+    for (i = 0 ; i < MRI_TRACEPOINT_COUNT ; i++)
+    {
+        Tracepoint* pTracepoint = &g_tracing.tracepoints[i];
+
+        if (!pTracepoint->isDefined || index-- > 0)
+            continue;
+        Buffer_WriteChar(pBuffer, 'T');
+        Buffer_WriteUIntegerAsHex(pBuffer, pTracepoint->number);
+        Buffer_WriteChar(pBuffer, ':');
+        Buffer_WriteUIntegerAsHex(pBuffer, pTracepoint->address);
+        Buffer_WriteString(pBuffer, pTracepoint->isEnabled ? ":E:0:" : ":D:0:");
+        Buffer_WriteUIntegerAsHex(pBuffer, pTracepoint->passCount);
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/* Writes the response to the qTP command, Vhits:usage, for the specified tracepoint location.  Returns 0 if there is
+   no such tracepoint. */
+int WriteTracepointHitCount(Buffer* pBuffer, uint32_t number, uint32_t address)
+{
+    Tracepoint* pTracepoint = findTracepoint(number, address);
+
+    if (!pTracepoint)
+        return 0;
+    Buffer_WriteChar(pBuffer, 'V');
+    Buffer_WriteUIntegerAsHex(pBuffer, pTracepoint->hitCount);
+    Buffer_WriteString(pBuffer, ":0");
+    return 1;
+}
+
+
+static const uint8_t* findSelectedFrameBlock(uint8_t type, const uint8_t* pPrevData, uint16_t* pLength);
+static uint32_t       frameOffset(uint32_t index);
+static void           writeUInteger64AsHex(Buffer* pBuffer, uint64_t value);
+/* Writes the response to the qTV command, Vvalue or U when unknown, for the specified trace state variable.  The
+   value comes from the selected trace frame when there is one. */
+void WriteTraceVariableValue(Buffer* pBuffer, uint32_t number)
+{
+    TraceVariable* pVariable = findVariable(number);
+    const uint8_t* pData = NULL;
+    uint16_t       length = 0;
+
+    if (IsTraceFrameSelected())
+    {
+        while ((pData = findSelectedFrameBlock(BLOCK_VARIABLE, pData, &length)) != NULL)
+        {
+            uint32_t blockNumber;
+            uint64_t value;
+
+            memcpy(&blockNumber, pData, sizeof(blockNumber));
+            if (blockNumber != number)
+                continue;
+            memcpy(&value, pData + sizeof(blockNumber), sizeof(value));
+            Buffer_WriteChar(pBuffer, 'V');
+            writeUInteger64AsHex(pBuffer, value);
+            return;
+        }
+    }
+    else if (pVariable)
+    {
+        Buffer_WriteChar(pBuffer, 'V');
+        writeUInteger64AsHex(pBuffer, pVariable->value);
+        return;
+    }
+
+    Buffer_WriteChar(pBuffer, 'U');
+}
+
+static const uint8_t* findSelectedFrameBlock(uint8_t type, const uint8_t* pPrevData, uint16_t* pLength)
+{
+    uint32_t       offset = frameOffset(g_tracing.selectedFrame);
+    const uint8_t* pEnd = &g_traceBuffer[offset + frameLengthAt(offset)];
+    const uint8_t* pCurr;
+
+    if (pPrevData)
+        pCurr = pPrevData + *pLength;
+    else
+        pCurr = &g_traceBuffer[offset + sizeof(TraceFrameHeader)];
+
+    while (pCurr < pEnd)
+    {
+        uint16_t length;
+
+        memcpy(&length, &pCurr[1], sizeof(length));
+        if (*pCurr == type)
+        {
+            *pLength = length;
+            return &pCurr[BLOCK_HEADER_SIZE];
+        }
+        pCurr += BLOCK_HEADER_SIZE + length;
+    }
+
+    return NULL;
+}
+
+static uint32_t frameOffset(uint32_t index)
+{
+    uint32_t offset = g_tracing.head;
+
+    while (index-- > 0)
+    {
+        offset += frameLengthAt(offset);
+        if (g_tracing.isWrapped && offset >= g_tracing.wrapEnd)
+            offset = 0;
+    }
+
+    return offset;
+}
+
+static void writeUInteger64AsHex(Buffer* pBuffer, uint64_t value)
+{
+    uint32_t upper = (uint32_t)(value >> 32);
+    uint32_t lower = (uint32_t)value;
+    int      shift;
+
+    if (upper == 0)
+    {
+        Buffer_WriteUIntegerAsHex(pBuffer, lower);
+        return;
+    }
+    Buffer_WriteUIntegerAsHex(pBuffer, upper);
+    for (shift = 24 ; shift >= 0 ; shift -= 8)
+        Buffer_WriteByteAsHex(pBuffer, (uint8_t)(lower >> shift));
+}
+
+
+static int doesFrameMatch(TraceFindType type, const TraceFrameHeader* pHeader, uint32_t value1, uint32_t value2);
+/* Selects a frame in the trace buffer for the QTFrame command.  MRI_TRACE_FIND_FRAME selects frame number value1
+   directly while the other types search forward from the currently selected frame for the next one which matches.
+   Returns the number of the frame selected or -1 if there wasn't one, in which case the live program state is used
+   again by commands such as 'g' and 'm'. */
+int FindTraceFrame(TraceFindType type, uint32_t value1, uint32_t value2)
+{
+    uint32_t index;
+
+    if (type == MRI_TRACE_FIND_FRAME)
+    {
+        g_tracing.selectedFrame = value1 < g_tracing.frameCount ? (int)value1 : -1;
+        return g_tracing.selectedFrame;
+    }
+
+    for (index = (uint32_t)(g_tracing.selectedFrame + 1) ; index < g_tracing.frameCount ; index++)
+    {
+        TraceFrameHeader header;
+
+        memcpy(&header, &g_traceBuffer[frameOffset(index)], sizeof(header));
+        if (doesFrameMatch(type, &header, value1, value2))
+        {
+            g_tracing.selectedFrame = (int)index;
+            return g_tracing.selectedFrame;
+        }
+    }
+
+    g_tracing.selectedFrame = -1;
+    return -1;
+}
+
+static int doesFrameMatch(TraceFindType type, const TraceFrameHeader* pHeader, uint32_t value1, uint32_t value2)
+{
+    switch (type)
+    {
+    case MRI_TRACE_FIND_PC:
+        return pHeader->address == value1;
+    case MRI_TRACE_FIND_TRACEPOINT:
+        return pHeader->number == value1;
+    case MRI_TRACE_FIND_INSIDE_RANGE:
+        return pHeader->address >= value1 && pHeader->address <= value2;
+    case MRI_TRACE_FIND_OUTSIDE_RANGE:
+        return pHeader->address < value1 || pHeader->address > value2;
+    default:
+        return 0;
+    }
+}
+
+
+/* Returns the number of the tracepoint which collected the selected trace frame. */
+int GetSelectedTraceFrameTracepoint(void)
+{
+    TraceFrameHeader header;
+
+    memcpy(&header, &g_traceBuffer[frameOffset(g_tracing.selectedFrame)], sizeof(header));
+    return (int)header.number;
+}
+
+
+/* Returns non-zero when gdb has selected a trace frame with QTFrame. */
+int IsTraceFrameSelected(void)
+{
+    return g_tracing.selectedFrame >= 0;
+}
+
+
+/* Writes the registers collected in the selected trace frame in the format of the response to the 'g' command. */
+void WriteTraceFrameRegisters(Buffer* pBuffer)
+{
+    uint16_t       length = 0;
+    const uint8_t* pData = findSelectedFrameBlock(BLOCK_REGISTERS, NULL, &length);
+
+    while (pData && length-- > 0)
+        Buffer_WriteByteAsHex(pBuffer, *pData++);
+}
+
+
+/* Reads memory from the selected trace frame into pBuffer as hex for the 'm' command.  Returns the number of bytes
+   which could be read starting at address, which is 0 if that address wasn't collected in the frame. */
+uint32_t ReadTraceFrameMemoryIntoHexBuffer(Buffer* pBuffer, uint32_t address, uint32_t length)
+{
+    const uint8_t* pData = NULL;
+    uint16_t       blockLength = 0;
+    const void*    pMemory = addressToPointer(address);
+
+    while ((pData = findSelectedFrameBlock(BLOCK_MEMORY, pData, &blockLength)) != NULL)
+    {
+        uint32_t blockAddress;
+        uint32_t offset;
+        uint32_t available;
+        uint32_t i;
+
+        memcpy(&blockAddress, pData, sizeof(blockAddress));
+        offset = address - blockAddress;
+        if (offset >= blockLength - sizeof(blockAddress))
+            continue;
+
+        available = blockLength - sizeof(blockAddress) - offset;
+        if (length > available)
+            length = available;
+        for (i = 0 ; i < length ; i++)
+            Buffer_WriteByteAsHex(pBuffer, pData[sizeof(blockAddress) + offset + i]);
+        return length;
+    }
+
+    /* Code and constants in flash can't have changed since the frame was collected so they are read from the device,
+       which is what gdb needs to disassemble and unwind the stack while looking at a frame. */
+    if (GetMemoryTypeOfRange(pMemory, length) == MRI_PLATFORM_MEMORY_FLASH)
+        return ReadMemoryIntoHexBuffer(pBuffer, pMemory, length);
+    return 0;
+}
@@ -0,0 +1,182 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Value watchpoints which only stop the program when a particular value is written to a variable.  The DWT can match
+   data values itself on some comparators.  When none of those is free, or the device can't match values at all, a
+   plain write watchpoint is used instead and the program is silently resumed after writes of any other value. */
+#include <string.h>
+#include "platforms.h"
+#include "core.h"
+#include "buffer.h"
+#include "cmd_common.h"
+#include "gdb_console.h"
+#include "memory.h"
+#include "valuewatch.h"
+
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    uint32_t value;
+    int      isArmed;
+    int      isMatchedInHardware;
+} ValueWatchpoint;
+
+static ValueWatchpoint g_valueWatch;
+
+
+void __mriValueWatch_Init(void)
+{
+    memset(&g_valueWatch, 0, sizeof(g_valueWatch));
+}
+
+
+static int      isValidSize(uint32_t size);
+static void     setHardwareWatchpoint(uint32_t address, uint32_t size, uint32_t value);
+static uint32_t truncateValue(uint32_t value, uint32_t size);
+/* Sets a watchpoint which stops when value is written to the size bytes at address.  Only one value watchpoint can be
+   armed at a time so any earlier one is removed first. */
+void __mriValueWatch_Arm(uint32_t address, uint32_t size, uint32_t value)
+{
+    if (!isValidSize(size))
+        __throw(invalidArgumentException);
+
+    __mriValueWatch_Disarm();
+    __try
+        setHardwareWatchpoint(address, size, value);
+    __catch
+        __rethrow;
+
+    g_valueWatch.address = address;
+    g_valueWatch.size = size;
+    g_valueWatch.value = truncateValue(value, size);
+    g_valueWatch.isArmed = 1;
+}
+
+static int isValidSize(uint32_t size)
+{
+    return size == 1 || size == 2 || size == 4;
+}
+
+static uint32_t truncateValue(uint32_t value, uint32_t size)
+{
+    if (size >= sizeof(uint32_t))
+        return value;
+    return value & ((1U << (size * 8)) - 1);
+}
+
+static void setHardwareWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    __try
+        Platform_SetHardwareValueWatchpoint(address, size, value);
+    __catch
+    {
+        if (getExceptionCode() != exceededHardwareResourcesException)
+            __rethrow;
+
+        /* Fall back to stopping on every write and checking the value in software. */
+        __try
+            Platform_SetHardwareWatchpoint(address, size, MRI_PLATFORM_WRITE_WATCHPOINT);
+        __catch
+            __rethrow;
+        g_valueWatch.isMatchedInHardware = 0;
+        return;
+    }
+    g_valueWatch.isMatchedInHardware = 1;
+}
+
+
+void __mriValueWatch_Disarm(void)
+{
+    if (!g_valueWatch.isArmed)
+        return;
+
+    __try
+    {
+        if (g_valueWatch.isMatchedInHardware)
+            Platform_ClearHardwareValueWatchpoint(g_valueWatch.address, g_valueWatch.size, g_valueWatch.value);
+        else
+            Platform_ClearHardwareWatchpoint(g_valueWatch.address, g_valueWatch.size, MRI_PLATFORM_WRITE_WATCHPOINT);
+    }
+    __catch
+    {
+        clearExceptionCode();
+    }
+    g_valueWatch.isArmed = 0;
+}
+
+
+int __mriValueWatch_IsMatchedInHardware(void)
+{
+    return g_valueWatch.isMatchedInHardware;
+}
+
+
+static uint32_t readWatchedValue(void);
+static void     reportMatchToGdbConsole(void);
+/* Called on each debug trap.  Returns non-zero if the value watchpoint caused it but the value written doesn't match
+   so that the program can be resumed without stopping in gdb.  Writes a note to the gdb console when it does match
+   since gdb doesn't know about the watchpoint and would otherwise show the stop as a plain SIGTRAP. */
+int __mriValueWatch_SkipIfNoMatch(void)
+{
+    if (!g_valueWatch.isArmed || !Platform_WasWatchpointHit(g_valueWatch.address))
+        return 0;
+
+    if (!g_valueWatch.isMatchedInHardware && readWatchedValue() != g_valueWatch.value)
+        return 1;
+
+    reportMatchToGdbConsole();
+    return 0;
+}
+
+static uint32_t readWatchedValue(void)
+{
+    void*    pValue = PointerFromTargetAddress(g_valueWatch.address);
+    uint32_t value;
+
+    switch (g_valueWatch.size)
+    {
+    case 1:
+        value = Platform_MemRead8(pValue);
+        break;
+    case 2:
+        value = Platform_MemRead16(pValue);
+        break;
+    default:
+        value = Platform_MemRead32(pValue);
+        break;
+    }
+
+    /* Stop on a fault rather than risk silently skipping the write being watched for. */
+    if (Platform_WasMemoryFaultEncountered())
+        return g_valueWatch.value;
+    return value;
+}
+
+static void reportMatchToGdbConsole(void)
+{
+    Buffer lineBuffer;
+    char   line[64];
+
+    Buffer_Init(&lineBuffer, line, sizeof(line));
+    Buffer_WriteString(&lineBuffer, "Value watchpoint: 0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, g_valueWatch.value);
+    Buffer_WriteString(&lineBuffer, " written to 0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, g_valueWatch.address);
+    Buffer_WriteString(&lineBuffer, "\n");
+    Buffer_WriteChar(&lineBuffer, '\0');
+
+    WriteStringToGdbConsole(line);
+}
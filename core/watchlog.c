@@ -0,0 +1,221 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Logging watchpoints which record each write to a variable in a ring buffer on the target and then resume the
+   program.  Finding the code which clobbers a variable with a normal watchpoint costs a stop and a manual continue
+   for every write.  The log is dumped to the gdb console on request with "monitor watchlog dump". */
+#include <string.h>
+#include "platforms.h"
+#include "core.h"
+#include "buffer.h"
+#include "cmd_common.h"
+#include "gdb_console.h"
+#include "memory.h"
+#include "watchlog.h"
+
+
+typedef struct
+{
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t value;
+    uint32_t cycles;
+} WatchLogEntry;
+
+typedef struct
+{
+    WatchLogEntry entries[MRI_WATCHLOG_ENTRIES];
+    uint32_t      address;
+    uint32_t      size;
+    uint32_t      start;
+    uint32_t      count;
+    uint32_t      overwritten;
+    int           isArmed;
+} WatchLog;
+
+static WatchLog g_watchLog;
+
+
+void __mriWatchLog_Init(void)
+{
+    memset(&g_watchLog, 0, sizeof(g_watchLog));
+}
+
+
+static int isValidSize(uint32_t size);
+/* Sets a write watchpoint on the size bytes at address and logs each write to it.  Only one logging watchpoint can
+   be armed at a time so any earlier one is removed and its log discarded first. */
+void __mriWatchLog_Arm(uint32_t address, uint32_t size)
+{
+    if (!isValidSize(size))
+        __throw(invalidArgumentException);
+
+    __mriWatchLog_Disarm();
+    __mriWatchLog_Clear();
+    __try
+        Platform_SetHardwareWatchpoint(address, size, MRI_PLATFORM_WRITE_WATCHPOINT);
+    __catch
+        __rethrow;
+
+    g_watchLog.address = address;
+    g_watchLog.size = size;
+    g_watchLog.isArmed = 1;
+}
+
+static int isValidSize(uint32_t size)
+{
+    /* The value written is logged so the variable must fit in a single access. */
+    return size == 1 || size == 2 || size == 4;
+}
+
+
+/* Removes the logging watchpoint but keeps the entries already logged so that they can still be dumped. */
+void __mriWatchLog_Disarm(void)
+{
+    if (!g_watchLog.isArmed)
+        return;
+
+    __try
+        Platform_ClearHardwareWatchpoint(g_watchLog.address, g_watchLog.size, MRI_PLATFORM_WRITE_WATCHPOINT);
+    __catch
+        clearExceptionCode();
+    g_watchLog.isArmed = 0;
+}
+
+
+void __mriWatchLog_Clear(void)
+{
+    g_watchLog.start = 0;
+    g_watchLog.count = 0;
+    g_watchLog.overwritten = 0;
+}
+
+
+static void writeHeaderToGdbConsole(void);
+static void writeEntryToGdbConsole(const WatchLogEntry* pEntry);
+void __mriWatchLog_Dump(void)
+{
+    uint32_t i;
+
+    if (g_watchLog.count == 0)
+    {
+        WriteStringToGdbConsole("Watch log is empty.\n");
+        return;
+    }
+
+    writeHeaderToGdbConsole();
+    for (i = 0 ; i < g_watchLog.count ; i++)
+        writeEntryToGdbConsole(&g_watchLog.entries[(g_watchLog.start + i) % MRI_WATCHLOG_ENTRIES]);
+}
+
+/* Each line is formatted into a local buffer first so that it is sent to gdb in a single 'O' packet. */
+static void writeHeaderToGdbConsole(void)
+{
+    Buffer lineBuffer;
+    char   line[80];
+
+    Buffer_Init(&lineBuffer, line, sizeof(line));
+    Buffer_WriteString(&lineBuffer, "Watch log for 0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, g_watchLog.address);
+    Buffer_WriteString(&lineBuffer, ": 0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, g_watchLog.count);
+    Buffer_WriteString(&lineBuffer, " entries, 0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, g_watchLog.overwritten);
+    Buffer_WriteString(&lineBuffer, " overwritten\n");
+    Buffer_WriteChar(&lineBuffer, '\0');
+
+    WriteStringToGdbConsole(line);
+}
+
+static void writeEntryToGdbConsole(const WatchLogEntry* pEntry)
+{
+    Buffer lineBuffer;
+    char   line[80];
+
+    Buffer_Init(&lineBuffer, line, sizeof(line));
+    Buffer_WriteString(&lineBuffer, "pc=0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->pc);
+    Buffer_WriteString(&lineBuffer, " lr=0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->lr);
+    Buffer_WriteString(&lineBuffer, " value=0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->value);
+    Buffer_WriteString(&lineBuffer, " cycles=0x");
+    Buffer_WriteUIntegerAsHex(&lineBuffer, pEntry->cycles);
+    Buffer_WriteString(&lineBuffer, "\n");
+    Buffer_WriteChar(&lineBuffer, '\0');
+
+    WriteStringToGdbConsole(line);
+}
+
+
+static WatchLogEntry* allocateEntry(void);
+static uint32_t       readWatchedValue(void);
+/* Called on each debug trap.  Returns non-zero if the logging watchpoint caused it, after adding an entry to the log,
+   so that the program can be resumed without stopping in gdb.  The DWT reports data watchpoints after the write has
+   completed so the value read back is the one just written. */
+int __mriWatchLog_RecordIfHit(void)
+{
+    WatchLogEntry* pEntry;
+
+    if (!g_watchLog.isArmed || !Platform_WasWatchpointHit(g_watchLog.address))
+        return 0;
+
+    pEntry = allocateEntry();
+    pEntry->pc = Platform_GetProgramCounter();
+    pEntry->lr = Platform_GetLinkRegister();
+    pEntry->value = readWatchedValue();
+    pEntry->cycles = Platform_GetCycleCount();
+
+    return 1;
+}
+
+static WatchLogEntry* allocateEntry(void)
+{
+    uint32_t index = (g_watchLog.start + g_watchLog.count) % MRI_WATCHLOG_ENTRIES;
+
+    if (g_watchLog.count < MRI_WATCHLOG_ENTRIES)
+    {
+        g_watchLog.count++;
+    }
+    else
+    {
+        g_watchLog.start = (g_watchLog.start + 1) % MRI_WATCHLOG_ENTRIES;
+        g_watchLog.overwritten++;
+    }
+
+    return &g_watchLog.entries[index];
+}
+
+static uint32_t readWatchedValue(void)
+{
+    void*    pValue = PointerFromTargetAddress(g_watchLog.address);
+    uint32_t value;
+
+    switch (g_watchLog.size)
+    {
+    case 1:
+        value = Platform_MemRead8(pValue);
+        break;
+    case 2:
+        value = Platform_MemRead16(pValue);
+        break;
+    default:
+        value = Platform_MemRead32(pValue);
+        break;
+    }
+
+    /* A fault here just leaves a bogus value in the log. */
+    Platform_WasMemoryFaultEncountered();
+    return value;
+}
@@ -20,37 +20,42 @@
 #include "../../architectures/armv7-m/debug_cm3.h"
 
 
-static const char g_memoryMapXml[] = "<?xml version=\"1.0\"?>"
-                                     "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">"
-                                     "<memory-map>"
-                                       "<memory type=\"flash\" start=\"0x0\" length=\"0x10000\"> <property name=\"blocksize\">0x1000</property></memory>"    
-                                       "<memory type=\"flash\" start=\"0x10000\" length=\"0x70000\"> <property name=\"blocksize\">0x8000</property></memory>"
-                                       "<memory type=\"ram\" start=\"0x10000000\" length=\"0x8000\"> </memory>"    
-                                       "<memory type=\"rom\" start=\"0x1FFF0000\" length=\"0x2000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x2007C000\" length=\"0x8000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x2009C000\" length=\"0x4000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x22000000\" length=\"0x2000000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x40000000\" length=\"0x14000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x40018000\" length=\"0x34000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x4005C000\" length=\"0x4000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x40088000\" length=\"0x1C000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x400A8000\" length=\"0x4000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x400B0000\" length=\"0x4000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x400B8000\" length=\"0x8000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x400FC000\" length=\"0x4000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x42000000\" length=\"0x2000000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x50000000\" length=\"0x8000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0x5000C000\" length=\"0x4000\"> </memory>"
-                                       "<memory type=\"ram\" start=\"0xE0000000\" length=\"0x100000\"> </memory>"
-                                     "</memory-map>";
+#define LPC176X_MEMORY(FLASH, ROM, RAM, PERIPHERAL) \
+    FLASH(0x0, 0x10000, 0x1000) \
+    FLASH(0x10000, 0x70000, 0x8000) \
+    RAM(0x10000000, 0x8000) \
+    ROM(0x1FFF0000, 0x2000) \
+    RAM(0x2007C000, 0x8000) \
+    RAM(0x2009C000, 0x4000) \
+    RAM(0x22000000, 0x2000000) \
+    PERIPHERAL(0x40000000, 0x14000) \
+    PERIPHERAL(0x40018000, 0x34000) \
+    PERIPHERAL(0x4005C000, 0x4000) \
+    PERIPHERAL(0x40088000, 0x1C000) \
+    PERIPHERAL(0x400A8000, 0x4000) \
+    PERIPHERAL(0x400B0000, 0x4000) \
+    PERIPHERAL(0x400B8000, 0x8000) \
+    PERIPHERAL(0x400FC000, 0x4000) \
+    PERIPHERAL(0x42000000, 0x2000000) \
+    PERIPHERAL(0x50000000, 0x8000) \
+    PERIPHERAL(0x5000C000, 0x4000) \
+    PERIPHERAL(0xE0000000, 0x100000)
+
+static const char g_memoryMapXml[] = MRI_MEMORY_MAP_XML(LPC176X_MEMORY);
+static const PlatformMemoryRegion g_memoryRegions[] = MRI_MEMORY_REGIONS(LPC176X_MEMORY);
 Lpc176xState __mriLpc176xState;
 
+/* The FPB can only remap to SRAM in the 0x20000000 - 0x3FFFFFFF region but .bss is linked into the local SRAM at
+   0x10000000 on the LPC176x.  The mbed linker scripts place the AHBSRAM0 section in the AHB SRAM at 0x2007C000. */
+static uint32_t g_fpbRemapTable[FPB_REMAP_TABLE_ENTRIES] __attribute__((section("AHBSRAM0"),
+                                                                        aligned(FPB_REMAP_TABLE_ALIGNMENT)));
+
 
 /* Reference this handler in the ASM module to make sure that it gets linked in. */
 void UART0_IRQHandler(void);
 
 
-static void defaultExternalInterruptsToPriority1(void);
+static void defaultExternalInterruptsBelowHaltPriority(void);
 void __mriLpc176x_Init(Token* pParameterTokens)
 {
     /* Reference handler in ASM module to make sure that is gets linked in. */
@@ -58,21 +63,21 @@ void __mriLpc176x_Init(Token* pParameterTokens)
     (void)dummyReference;
 
     __try
-        __mriCortexMInit(pParameterTokens);
+        __mriCortexMInit(pParameterTokens, g_fpbRemapTable);
     __catch
         __rethrow;
         
-    defaultExternalInterruptsToPriority1();    
+    defaultExternalInterruptsBelowHaltPriority();    
     __mriLpc176xUart_Init(pParameterTokens);
 }
 
-static void defaultExternalInterruptsToPriority1(void)
+static void defaultExternalInterruptsBelowHaltPriority(void)
 {
     static const int CAN_IRQn = 34;
     int              irq;
     
     for (irq = WDT_IRQn ; irq <= CAN_IRQn ; irq++)
-        NVIC_SetPriority((IRQn_Type)irq, 1);
+        NVIC_SetPriority((IRQn_Type)irq, __mriCortexMGetHaltPriority() + 1);
 }
 
 
@@ -86,3 +91,15 @@ const char* Platform_GetDeviceMemoryMapXml(void)
 {
     return g_memoryMapXml;
 }
+
+
+uint32_t Platform_GetDeviceMemoryRegionCount(void)
+{
+    return sizeof(g_memoryRegions) / sizeof(g_memoryRegions[0]);
+}
+
+
+const PlatformMemoryRegion* Platform_GetDeviceMemoryRegions(void)
+{
+    return g_memoryRegions;
+}
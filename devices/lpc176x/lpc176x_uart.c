@@ -16,6 +16,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "platforms.h"
+#include "../../architectures/armv7-m/armv7-m.h"
 #include "../../architectures/armv7-m/debug_cm3.h"
 #include "lpc176x_init.h"
 
@@ -95,6 +96,7 @@ typedef struct
 
 static void     parseUartParameters(Token* pParameterTokens, UartParameters* pParameters);
 static void     saveUartToBeUsedByDebugger(uint32_t mriCommSetting);
+static void     registerCommInterrupt(void);
 static void     setUartSharedFlag(void);
 static uint32_t uint32FromString(const char* pString);
 static uint32_t getDecimalDigit(char currChar);
@@ -129,6 +131,7 @@ void __mriLpc176xUart_Init(Token* pParameterTokens)
 
     parseUartParameters(pParameterTokens, &parameters);
     saveUartToBeUsedByDebugger(parameters.uartIndex);
+    registerCommInterrupt();
     if (parameters.share)
         setUartSharedFlag();
     else
@@ -171,6 +174,16 @@ static void saveUartToBeUsedByDebugger(uint32_t mriUart)
     __mriLpc176xState.pCurrentUart = &g_uartConfigurations[mriUart];
 }
 
+static void registerCommInterrupt(void)
+{
+    static const uint32_t receiverDataReadyBit = 1 << 0;
+    const uint32_t        uart0BaseExceptionId = 21;
+    LPC_UART_TypeDef*     pUart = __mriLpc176xState.pCurrentUart->pUartRegisters;
+
+    __mriCortexMSetCommInterrupt(uart0BaseExceptionId + Platform_CommUartIndex(),
+                                 (const volatile uint32_t*)&pUart->LSR, receiverDataReadyBit, &pUart->IIR);
+}
+
 static void setUartSharedFlag(void)
 {
     __mriLpc176xState.flags |= LPC176X_UART_FLAGS_SHARE;
@@ -433,7 +446,7 @@ static void configureNVICForUartInterrupt(void)
     IRQn_Type currentUartIRQ;
     
     currentUartIRQ = (IRQn_Type)((int)uart0BaseIRQ + Platform_CommUartIndex());
-    NVIC_SetPriority(currentUartIRQ, 0);
+    NVIC_SetPriority(currentUartIRQ, __mriCortexMGetHaltPriority());
     NVIC_EnableIRQ(currentUartIRQ);
 }
 
@@ -20,34 +20,41 @@
 #include "../../architectures/armv7-m/debug_cm3.h"
 
 
-static const char g_memoryMapXml4330[] = "<?xml version=\"1.0\"?>"
-                                         "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">"
-                                         "<memory-map>"
-                                         "<memory type=\"flash\" start=\"0x14000000\" length=\"0x4000000\"> <property name=\"blocksize\">0x400</property></memory>"
-                                         "<memory type=\"ram\" start=\"0x10000000\" length=\"0x20000\"> </memory>"
-                                         "<memory type=\"ram\" start=\"0x10080000\" length=\"0x12000\"> </memory>"
-                                         "<memory type=\"ram\" start=\"0x20000000\" length=\"0x8000\"> </memory>"
-                                         "<memory type=\"ram\" start=\"0x20008000\" length=\"0x8000\"> </memory>"
-                                         "</memory-map>";
-static const char g_memoryMapXml4337[] = "<?xml version=\"1.0\"?>"
-                                         "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">"
-                                         "<memory-map>"
-                                         "<memory type=\"flash\" start=\"0x1A000000\" length=\"0x80000\"> <property name=\"blocksize\">0x400</property></memory>"
-                                         "<memory type=\"flash\" start=\"0x1B000000\" length=\"0x80000\"> <property name=\"blocksize\">0x400</property></memory>"
-                                         "<memory type=\"ram\" start=\"0x10000000\" length=\"0x8000\"> </memory>"
-                                         "<memory type=\"ram\" start=\"0x10080000\" length=\"0xA000\"> </memory>"
-                                         "<memory type=\"ram\" start=\"0x20000000\" length=\"0x8000\"> </memory>"
-                                         "<memory type=\"ram\" start=\"0x20008000\" length=\"0x8000\"> </memory>"
-                                         "</memory-map>";
+#define LPC4330_MEMORY(FLASH, ROM, RAM, PERIPHERAL) \
+    FLASH(0x14000000, 0x4000000, 0x400) \
+    RAM(0x10000000, 0x20000) \
+    RAM(0x10080000, 0x12000) \
+    RAM(0x20000000, 0x8000) \
+    RAM(0x20008000, 0x8000) \
+    PERIPHERAL(0x40000000, 0x20000000) \
+    PERIPHERAL(0xE0000000, 0x100000)
+#define LPC4337_MEMORY(FLASH, ROM, RAM, PERIPHERAL) \
+    FLASH(0x1A000000, 0x80000, 0x400) \
+    FLASH(0x1B000000, 0x80000, 0x400) \
+    RAM(0x10000000, 0x8000) \
+    RAM(0x10080000, 0xA000) \
+    RAM(0x20000000, 0x8000) \
+    RAM(0x20008000, 0x8000) \
+    PERIPHERAL(0x40000000, 0x20000000) \
+    PERIPHERAL(0xE0000000, 0x100000)
+
+static const char g_memoryMapXml4330[] = MRI_MEMORY_MAP_XML(LPC4330_MEMORY);
+static const char g_memoryMapXml4337[] = MRI_MEMORY_MAP_XML(LPC4337_MEMORY);
+static const PlatformMemoryRegion g_memoryRegions4330[] = MRI_MEMORY_REGIONS(LPC4330_MEMORY);
+static const PlatformMemoryRegion g_memoryRegions4337[] = MRI_MEMORY_REGIONS(LPC4337_MEMORY);
 Lpc43xxState __mriLpc43xxState;
 
+/* Remap table used by the FPB to patch BKPT instructions into code fetched from FLASH.  It must be linked into the AHB
+   SRAM at 0x20000000 rather than the local SRAM at 0x10000000 for the FPB to be able to use it. */
+static uint32_t g_fpbRemapTable[FPB_REMAP_TABLE_ENTRIES] __attribute__((aligned(FPB_REMAP_TABLE_ALIGNMENT)));
+
 
 
 /* Reference this handler in the ASM module to make sure that it gets linked in. */
 void USART0_IRQHandler(void);
 
 
-static void defaultExternalInterruptsToPriority1(void);
+static void defaultExternalInterruptsBelowHaltPriority(void);
 void __mriLpc43xx_Init(Token* pParameterTokens)
 {
     /* Reference handler in ASM module to make sure that is gets linked in. */
@@ -55,20 +62,20 @@ void __mriLpc43xx_Init(Token* pParameterTokens)
     (void)dummyReference;
 
     __try
-        __mriCortexMInit(pParameterTokens);
+        __mriCortexMInit(pParameterTokens, g_fpbRemapTable);
     __catch
         __rethrow;
 
-    defaultExternalInterruptsToPriority1();    
+    defaultExternalInterruptsBelowHaltPriority();    
     __mriLpc43xxUart_Init(pParameterTokens);
 }
 
-static void defaultExternalInterruptsToPriority1(void)
+static void defaultExternalInterruptsBelowHaltPriority(void)
 {
     int              irq;
     
     for (irq = DAC_IRQn ; irq <= QEI_IRQn ; irq++)
-        NVIC_SetPriority((IRQn_Type)irq, 1);
+        NVIC_SetPriority((IRQn_Type)irq, __mriCortexMGetHaltPriority() + 1);
 }
 
 
@@ -95,3 +102,21 @@ const char* Platform_GetDeviceMemoryMapXml(void)
     else
         return g_memoryMapXml4330;
 }
+
+
+uint32_t Platform_GetDeviceMemoryRegionCount(void)
+{
+    if (isLpc4337())
+        return sizeof(g_memoryRegions4337) / sizeof(g_memoryRegions4337[0]);
+    else
+        return sizeof(g_memoryRegions4330) / sizeof(g_memoryRegions4330[0]);
+}
+
+
+const PlatformMemoryRegion* Platform_GetDeviceMemoryRegions(void)
+{
+    if (isLpc4337())
+        return g_memoryRegions4337;
+    else
+        return g_memoryRegions4330;
+}
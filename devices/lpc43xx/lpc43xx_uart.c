@@ -16,6 +16,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "platforms.h"
+#include "../../architectures/armv7-m/armv7-m.h"
 #include "../../architectures/armv7-m/debug_cm3.h"
 #include "lpc43xx_init.h"
 
@@ -94,6 +95,7 @@ typedef struct
 
 static void     parseUartParameters(Token* pParameterTokens, UartConfiguration* pUart, UartParameters* pParameters);
 static void     saveUartToBeUsedByDebugger(const UartConfiguration* pUart);
+static void     registerCommInterrupt(void);
 static void     setUartSharedFlag(void);
 static uint32_t uint32FromString(const char* pString);
 static uint32_t getDecimalDigit(char currChar);
@@ -125,6 +127,7 @@ void __mriLpc43xxUart_Init(Token* pParameterTokens)
 
     parseUartParameters(pParameterTokens, &g_customUart, &parameters);
     saveUartToBeUsedByDebugger(parameters.pUart);
+    registerCommInterrupt();
     if (parameters.share)
         setUartSharedFlag();
     else
@@ -412,6 +415,16 @@ static void saveUartToBeUsedByDebugger(const UartConfiguration* pUart)
     __mriLpc43xxState.pCurrentUart = pUart;
 }
 
+static void registerCommInterrupt(void)
+{
+    static const uint32_t receiverDataReadyBit = 1 << 0;
+    const uint32_t        uart0BaseExceptionId = USART0_IRQn + 16;
+    LPC_USART_T*          pUart = __mriLpc43xxState.pCurrentUart->pUartRegisters;
+
+    __mriCortexMSetCommInterrupt(uart0BaseExceptionId + Platform_CommUartIndex(),
+                                 &pUart->LSR, receiverDataReadyBit, &pUart->IIR);
+}
+
 static void setUartSharedFlag(void)
 {
     __mriLpc43xxState.flags |= LPC43XX_UART_FLAGS_SHARE;
@@ -658,7 +671,7 @@ static void configureNVICForUartInterrupt(void)
     IRQn_Type currentUartIRQ;
 
     currentUartIRQ = (IRQn_Type)((int)uart0BaseIRQ + Platform_CommUartIndex());
-    NVIC_SetPriority(currentUartIRQ, 0);
+    NVIC_SetPriority(currentUartIRQ, __mriCortexMGetHaltPriority());
     NVIC_EnableIRQ(currentUartIRQ);
 }
 
@@ -21,27 +21,43 @@
 #include "../../architectures/armv7-m/debug_cm3.h"
 
 
-static const char g_memoryMapXml[] = "<?xml version=\"1.0\"?>"
-                                     "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">"
-                                     "<memory-map>"
-                                     "<memory type=\"flash\" start=\"0x08000000\" length=\"0x10000\"> <property name=\"blocksize\">0x4000</property></memory>"
-                                     "<memory type=\"flash\" start=\"0x08010000\" length=\"0x10000\"> <property name=\"blocksize\">0x10000</property></memory>"
-                                     "<memory type=\"flash\" start=\"0x08020000\" length=\"0xE0000\"> <property name=\"blocksize\">0x20000</property></memory>"
-                                     "<memory type=\"flash\" start=\"0x08100000\" length=\"0x10000\"> <property name=\"blocksize\">0x4000</property></memory>"
-                                     "<memory type=\"flash\" start=\"0x08110000\" length=\"0x10000\"> <property name=\"blocksize\">0x10000</property></memory>"
-                                     "<memory type=\"flash\" start=\"0x08120000\" length=\"0xE0000\"> <property name=\"blocksize\">0x20000</property></memory>"
-                                     "<memory type=\"ram\" start=\"0x20000000\" length=\"0x1C000\"> </memory>"
-                                     "<memory type=\"ram\" start=\"0x2001C000\" length=\"0x4000\"> </memory>"
-                                     "<memory type=\"ram\" start=\"0x20020000\" length=\"0x10000\"> </memory>"
-                                     "</memory-map>";
+/* The FMC banks for external NOR/PSRAM/NAND memories are treated as peripherals so that the width of each access
+   is kept while the SDRAM banks (at 0xD0000000 on the STM32F429I-DISCO board) are treated as RAM. */
+#define STM32F429XX_MEMORY(FLASH, ROM, RAM, PERIPHERAL) \
+    FLASH(0x08000000, 0x10000, 0x4000) \
+    FLASH(0x08010000, 0x10000, 0x10000) \
+    FLASH(0x08020000, 0xE0000, 0x20000) \
+    FLASH(0x08100000, 0x10000, 0x4000) \
+    FLASH(0x08110000, 0x10000, 0x10000) \
+    FLASH(0x08120000, 0xE0000, 0x20000) \
+    RAM(0x10000000, 0x10000) \
+    ROM(0x1FFEC000, 0x10) \
+    ROM(0x1FFF0000, 0x7A10) \
+    ROM(0x1FFFC000, 0x10) \
+    RAM(0x20000000, 0x1C000) \
+    RAM(0x2001C000, 0x4000) \
+    RAM(0x20020000, 0x10000) \
+    RAM(0x22000000, 0x2000000) \
+    PERIPHERAL(0x40000000, 0x20000000) \
+    PERIPHERAL(0x60000000, 0x40000000) \
+    PERIPHERAL(0xA0000000, 0x1000) \
+    RAM(0xC0000000, 0x20000000) \
+    PERIPHERAL(0xE0000000, 0x100000)
+
+static const char g_memoryMapXml[] = MRI_MEMORY_MAP_XML(STM32F429XX_MEMORY);
+static const PlatformMemoryRegion g_memoryRegions[] = MRI_MEMORY_REGIONS(STM32F429XX_MEMORY);
 Stm32f429xxState __mriStm32f429xxState;
 
+/* Remap table used by the FPB to patch BKPT instructions into code fetched from FLASH.  It must be linked into the
+   SRAM at 0x20000000 rather than the CCM RAM at 0x10000000 for the FPB to be able to use it. */
+static uint32_t g_fpbRemapTable[FPB_REMAP_TABLE_ENTRIES] __attribute__((aligned(FPB_REMAP_TABLE_ALIGNMENT)));
+
 
 /* Reference this handler in the ASM module to make sure that it gets linked in. */
 void USART1_IRQHandler(void);
 
 
-static void defaultExternalInterruptsToPriority1(void);
+static void defaultExternalInterruptsBelowHaltPriority(void);
 void __mriStm32f429xx_Init(Token* pParameterTokens)
 {
     /* Reference handler in ASM module to make sure that is gets linked in. */
@@ -49,21 +65,24 @@ void __mriStm32f429xx_Init(Token* pParameterTokens)
     (void)dummyReference;
 
     __try
-        __mriCortexMInit(pParameterTokens);
+        __mriCortexMInit(pParameterTokens, g_fpbRemapTable);
     __catch
         __rethrow;
 
-    defaultExternalInterruptsToPriority1();
-    __mriStm32f429xxUart_Init(pParameterTokens);
+    defaultExternalInterruptsBelowHaltPriority();
+    __try
+        __mriStm32f429xxUart_Init(pParameterTokens);
+    __catch
+        __rethrow;
 }
 
-static void defaultExternalInterruptsToPriority1(void)
+static void defaultExternalInterruptsBelowHaltPriority(void)
 {
     int irq;
-    /* Set all priority to a lower non-zero priority. */
+    /* Set all priority to a level below the debug monitor. */
     for (irq = WWDG_IRQn ; irq <= DMA2D_IRQn ; irq++)
     {
-        NVIC_SetPriority((IRQn_Type)irq, 1);
+        NVIC_SetPriority((IRQn_Type)irq, __mriCortexMGetHaltPriority() + 1);
     }
 }
 
@@ -78,3 +97,15 @@ const char* Platform_GetDeviceMemoryMapXml(void)
 {
     return g_memoryMapXml;
 }
+
+
+uint32_t Platform_GetDeviceMemoryRegionCount(void)
+{
+    return sizeof(g_memoryRegions) / sizeof(g_memoryRegions[0]);
+}
+
+
+const PlatformMemoryRegion* Platform_GetDeviceMemoryRegions(void)
+{
+    return g_memoryRegions;
+}
@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "platforms.h"
+#include "../../architectures/armv7-m/armv7-m.h"
 #include "../../architectures/armv7-m/debug_cm3.h"
 #include "stm32f429xx_init.h"
 #include "stm32f429xx_usart.h"
@@ -31,7 +32,8 @@ static const UartConfiguration g_uartConfigurations[] =
          */
         USART1,
         7, /* AF7 */
-        7  /* AF7 */
+        7, /* AF7 */
+        USART1_IRQn
     },
     {
         /* 
@@ -40,7 +42,8 @@ static const UartConfiguration g_uartConfigurations[] =
          */
         USART2,
         7, /* AF7 */
-        7  /* AF7 */
+        7, /* AF7 */
+        USART2_IRQn
     },
     {
         /*
@@ -49,7 +52,8 @@ static const UartConfiguration g_uartConfigurations[] =
          */
         USART3,
         7, /* AF7 */
-        7  /* AF7 */
+        7, /* AF7 */
+        USART3_IRQn
     }
 };
 
@@ -64,7 +68,9 @@ typedef struct
 
 static void     configureNVICForUartInterrupt(uint32_t index);
 static void     parseUartParameters(Token* pParameterTokens, UartParameters* pParameters);
+static void     throwIfUartIsNotSupported(uint32_t uartIndex);
 static void     setManualBaudFlag(void);
+static void     registerCommInterrupt(void);
 static void     setUartSharedFlag(void);
 static void     saveUartToBeUsedByDebugger(uint32_t mriUart);
 static void     configureUartForExclusiveUseOfDebugger(UartParameters* pParameters);
@@ -110,7 +116,12 @@ void __mriStm32f429xxUart_Init(Token *pParameterTokens)
     setManualBaudFlag();
 
     parseUartParameters(pParameterTokens, &parameters);
+    __try
+        throwIfUartIsNotSupported(parameters.uartIndex);
+    __catch
+        __rethrow;
     saveUartToBeUsedByDebugger(parameters.uartIndex);
+    registerCommInterrupt();
     if (parameters.share)
         setUartSharedFlag();
     else 
@@ -146,6 +157,14 @@ static void parseUartParameters(Token* pParameterTokens, UartParameters* pParame
         pParameters->share = 1;
 }
 
+static void throwIfUartIsNotSupported(uint32_t uartIndex)
+{
+    /* Only USART1-3 have pins, clocks, and handlers set up for the debugger.  Leave mri disabled rather than have it
+       drive the wrong UART, or miss its interrupts, when none of them was selected. */
+    if (uartIndex < 1 || uartIndex > sizeof(g_uartConfigurations) / sizeof(g_uartConfigurations[0]))
+        __throw(invalidArgumentException);
+}
+
 
 
 static void saveUartToBeUsedByDebugger(uint32_t mriUart)
@@ -156,6 +175,14 @@ static void saveUartToBeUsedByDebugger(uint32_t mriUart)
 
 
 
+static void registerCommInterrupt(void)
+{
+    const UartConfiguration* pUart = __mriStm32f429xxState.pCurrentUart;
+
+    /* RXNE is cleared by reading DR so there is no separate register to read when dismissing the interrupt. */
+    __mriCortexMSetCommInterrupt(pUart->irq + 16, &pUart->pUartRegisters->SR, USART_SR_RXNE, NULL);
+}
+
 static void setUartSharedFlag(void)
 {
     __mriStm32f429xxState.flags |= STM32F429XX_UART_FLAGS_SHARE;
@@ -548,10 +575,7 @@ int Platform_CommCausedInterrupt(void)
 {
     int interruptSource = (int)getCurrentlyExecutingExceptionNumber()-16;
 
-    /* For USART1~3,the IRQn are continuous,others need check! */
-    int irq_num_base = USART1_IRQn;
-    int currentUartIRQ = irq_num_base + Platform_CommUartIndex();
-    return currentUartIRQ==interruptSource;
+    return __mriStm32f429xxState.pCurrentUart->irq == interruptSource;
 }
 
 void Platform_CommClearInterrupt(void)
@@ -598,13 +622,9 @@ void Platform_CommWaitForReceiveDataToStop(void)
 
 static void configureNVICForUartInterrupt(uint32_t index)
 {
-    IRQn_Type irq_num_base = USART1_IRQn;
-    /*
-     * For USART1~3,the IRQn are continuous,others need check!
-     */
-    IRQn_Type currentUartIRQ;
-    currentUartIRQ = (IRQn_Type)((int)irq_num_base + Platform_CommUartIndex()) ;
-    NVIC_SetPriority(currentUartIRQ, 0);
+    IRQn_Type currentUartIRQ = __mriStm32f429xxState.pCurrentUart->irq;
+
+    NVIC_SetPriority(currentUartIRQ, __mriCortexMGetHaltPriority());
     NVIC_EnableIRQ(currentUartIRQ);
 }
 
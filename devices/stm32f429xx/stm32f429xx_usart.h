@@ -26,6 +26,7 @@ typedef struct
     USART_TypeDef*     pUartRegisters;
     uint32_t    txFunction;
     uint32_t    rxFunction;
+    IRQn_Type   irq;
 } UartConfiguration;
 
 
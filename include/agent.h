@@ -0,0 +1,54 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Interpreter for the agent expression bytecode which gdb sends down to have conditions evaluated on the target. */
+#ifndef _AGENT_H_
+#define _AGENT_H_
+
+#include <stdint.h>
+#include "try_catch.h"
+
+/* Maximum number of 64-bit entries on the evaluation stack.  Each one takes 8 bytes of RAM. */
+#ifndef MRI_AGENT_STACK_SIZE
+#define MRI_AGENT_STACK_SIZE 16
+#endif
+
+/* Maximum number of opcodes executed for a single expression so that a backwards goto can't hang the program. */
+#ifndef MRI_AGENT_MAX_OPCODES
+#define MRI_AGENT_MAX_OPCODES 1024
+#endif
+
+/* Callbacks which give the trace collection, trace state variable, and printf opcodes somewhere to put their
+   results.  Opcodes whose callbacks are NULL are rejected.  The callbacks are free to throw exceptions which will abort
+   the evaluation.  Printf is passed the NUL terminated format string and its arguments, first argument first. */
+typedef struct
+{
+    void     (*CollectMemory)(uint32_t address, uint32_t size);
+    void     (*CollectVariable)(uint32_t index);
+    uint64_t (*GetVariable)(uint32_t index);
+    void     (*SetVariable)(uint32_t index, uint64_t value);
+    void     (*Printf)(const char* pFormat, const uint64_t* pArgs, uint32_t argCount);
+} AgentHooks;
+
+/* Real name of functions are in __mri namespace. */
+__throws uint64_t __mriAgent_Evaluate(const uint8_t* pBytecode, uint32_t length);
+__throws uint64_t __mriAgent_EvaluateWithHooks(const uint8_t* pBytecode, uint32_t length, const AgentHooks* pHooks);
+__throws void     __mriAgent_ExecuteCommand(const uint8_t* pBytecode, uint32_t length, const AgentHooks* pHooks);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define EvaluateAgentExpression             __mriAgent_Evaluate
+#define EvaluateAgentExpressionWithHooks    __mriAgent_EvaluateWithHooks
+#define ExecuteAgentCommand                 __mriAgent_ExecuteCommand
+
+#endif /* _AGENT_H_ */
@@ -0,0 +1,56 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Software breakpoints which are placed in RAM by temporarily replacing the instruction with a breakpoint.  Also
+   handles single stepping over a breakpoint which the monitor has dealt with itself. */
+#ifndef _BREAKPOINTS_H_
+#define _BREAKPOINTS_H_
+
+#include <stdint.h>
+#include "try_catch.h"
+
+/* Maximum number of software breakpoints which can be set at once.  Each one takes 16 bytes of RAM. */
+#ifndef MRI_SOFTWARE_BREAKPOINT_COUNT
+#define MRI_SOFTWARE_BREAKPOINT_COUNT 32
+#endif
+
+/* Real name of functions are in __mri namespace. */
+void          __mriBreakpoints_Init(void);
+__throws int  __mriBreakpoints_SetSoftware(void* pvAddress, uint32_t kind);
+int           __mriBreakpoints_ClearSoftware(void* pvAddress);
+int           __mriBreakpoints_IsSoftwareSet(const void* pvAddress);
+__throws void __mriBreakpoints_Set(void* pvAddress, uint32_t kind);
+__throws void __mriBreakpoints_Clear(void* pvAddress, uint32_t kind);
+void          __mriBreakpoints_InsertSoftware(void);
+void          __mriBreakpoints_RemoveSoftware(void);
+void          __mriBreakpoints_ReportInsertFailures(void);
+int           __mriBreakpoints_StartSteppingOver(void* pvAddress, uint32_t kind);
+int           __mriBreakpoints_IsSteppingOver(void);
+void          __mriBreakpoints_FinishSteppingOver(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitSoftwareBreakpoints      __mriBreakpoints_Init
+#define SetSoftwareBreakpoint        __mriBreakpoints_SetSoftware
+#define ClearSoftwareBreakpoint      __mriBreakpoints_ClearSoftware
+#define IsSoftwareBreakpointSet      __mriBreakpoints_IsSoftwareSet
+#define SetBreakpoint                __mriBreakpoints_Set
+#define ClearBreakpoint              __mriBreakpoints_Clear
+#define InsertSoftwareBreakpoints    __mriBreakpoints_InsertSoftware
+#define RemoveSoftwareBreakpoints    __mriBreakpoints_RemoveSoftware
+#define ReportFailedBreakpoints      __mriBreakpoints_ReportInsertFailures
+#define StartSteppingOverBreakpoint  __mriBreakpoints_StartSteppingOver
+#define IsSteppingOverBreakpoint     __mriBreakpoints_IsSteppingOver
+#define FinishSteppingOverBreakpoint __mriBreakpoints_FinishSteppingOver
+
+#endif /* _BREAKPOINTS_H_ */
@@ -42,11 +42,15 @@ uint8_t  __mriBuffer_ReadByteAsHex(Buffer* pBuffer);
 void     __mriBuffer_WriteString(Buffer* pBuffer, const char* pString);
 void     __mriBuffer_WriteSizedString(Buffer* pBuffer, const char* pString, size_t length);
 uint32_t __mriBuffer_ReadUIntegerAsHex(Buffer* pBuffer);
+uint64_t __mriBuffer_ReadUInteger64AsHex(Buffer* pBuffer);
 void     __mriBuffer_WriteUIntegerAsHex(Buffer* pBuffer, uint32_t value);
 int32_t  __mriBuffer_ReadIntegerAsHex(Buffer* pBuffer);
 void     __mriBuffer_WriteIntegerAsHex(Buffer* pBuffer, int32_t value);
 int      __mriBuffer_IsNextCharEqualTo(Buffer* pBuffer, char thisChar);
 int      __mriBuffer_MatchesString(Buffer* pBuffer, const char* pString, size_t stringLength);
+int      __mriBuffer_MatchesStringFollowedBy(Buffer* pBuffer, const char* pString, size_t stringLength, char separator);
+void     __mriBuffer_DecodeHexInPlace(Buffer* pBuffer);
+void     __mriBuffer_UnescapeBinaryInPlace(Buffer* pBuffer);
 
 /* Macroes which allow code to drop the __mri namespace prefix. */
 #define Buffer_Init                 __mriBuffer_Init
@@ -63,10 +67,14 @@ int      __mriBuffer_MatchesString(Buffer* pBuffer, const char* pString, size_t
 #define Buffer_WriteString          __mriBuffer_WriteString
 #define Buffer_WriteSizedString     __mriBuffer_WriteSizedString
 #define Buffer_ReadUIntegerAsHex    __mriBuffer_ReadUIntegerAsHex
+#define Buffer_ReadUInteger64AsHex  __mriBuffer_ReadUInteger64AsHex
 #define Buffer_WriteUIntegerAsHex   __mriBuffer_WriteUIntegerAsHex
 #define Buffer_ReadIntegerAsHex     __mriBuffer_ReadIntegerAsHex
 #define Buffer_WriteIntegerAsHex    __mriBuffer_WriteIntegerAsHex
 #define Buffer_IsNextCharEqualTo    __mriBuffer_IsNextCharEqualTo
 #define Buffer_MatchesString        __mriBuffer_MatchesString
+#define Buffer_MatchesStringFollowedBy __mriBuffer_MatchesStringFollowedBy
+#define Buffer_DecodeHexInPlace     __mriBuffer_DecodeHexInPlace
+#define Buffer_UnescapeBinaryInPlace __mriBuffer_UnescapeBinaryInPlace
 
 #endif /* _BUFFER_H_ */
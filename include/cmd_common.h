@@ -22,10 +22,12 @@
 
 /* The bits that can be set in the return value from a command handler to indicate if the caller should return
    immediately or send the prepared response back to gdb.  It also indicates whether program execution should be
-   resumed for commands like continue and single step. */
+   resumed for commands like continue and single step and whether gdb has stopped listening, as it does after a
+   detach or kill. */
 #define HANDLER_RETURN_RESUME_PROGRAM       1
 #define HANDLER_RETURN_RETURN_IMMEDIATELY   2
 #define HANDLER_RETURN_SKIPPED_OVER_BREAK   4
+#define HANDLER_RETURN_DETACHED             8
 
 typedef struct
 {
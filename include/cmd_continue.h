@@ -21,9 +21,13 @@
 /* Real name of functions are in __mri namespace. */
 uint32_t __mriCmd_HandleContinueCommand(void);
 uint32_t __mriCmd_HandleContinueWithSignalCommand(void);
+uint32_t __mriCmd_HandleDetachCommand(void);
+uint32_t __mriCmd_HandleKillCommand(void);
 
 /* Macroes which allow code to drop the __mri namespace prefix. */
 #define HandleContinueCommand           __mriCmd_HandleContinueCommand
 #define HandleContinueWithSignalCommand __mriCmd_HandleContinueWithSignalCommand
+#define HandleDetachCommand             __mriCmd_HandleDetachCommand
+#define HandleKillCommand               __mriCmd_HandleKillCommand
 
 #endif /* _CMD_CONTINUE_H_ */
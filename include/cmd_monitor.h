@@ -0,0 +1,29 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Handler for gdb monitor commands which are sent to the stub via qRcmd packets. */
+#ifndef _CMD_MONITOR_H_
+#define _CMD_MONITOR_H_
+
+#include <stdint.h>
+
+/* Real name of functions are in __mri namespace. */
+uint32_t __mriCmd_HandleMonitorCommand(void);
+int      __mriCmd_IsReadOnlyMonitorCommand(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define HandleMonitorCommand        __mriCmd_HandleMonitorCommand
+#define IsReadOnlyMonitorCommand    __mriCmd_IsReadOnlyMonitorCommand
+
+#endif /* _CMD_MONITOR_H_ */
@@ -21,9 +21,11 @@
 /* Real name of functions are in __mri namespace. */
 uint32_t __mriCmd_HandleSingleStepCommand(void);
 uint32_t __mriCmd_HandleSingleStepWithSignalCommand(void);
+uint32_t __mriCmd_HandleRangeStepCommand(void);
 
 /* Macroes which allow code to drop the __mri namespace prefix. */
 #define HandleSingleStepCommand           __mriCmd_HandleSingleStepCommand
 #define HandleSingleStepWithSignalCommand __mriCmd_HandleSingleStepWithSignalCommand
+#define HandleRangeStepCommand            __mriCmd_HandleRangeStepCommand
 
 #endif /* _CMD_STEP_H_ */
@@ -0,0 +1,27 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Handler for gdb's vCont packets. */
+#ifndef _CMD_VCONT_H_
+#define _CMD_VCONT_H_
+
+#include <stdint.h>
+
+/* Real name of functions are in __mri namespace. */
+uint32_t __mriCmd_HandleVCommand(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define HandleVCommand  __mriCmd_HandleVCommand
+
+#endif /* _CMD_VCONT_H_ */
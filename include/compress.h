@@ -0,0 +1,47 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* LZ4 style compression routines used to move large blocks of memory between gdb and the target more quickly. */
+#ifndef _COMPRESS_H_
+#define _COMPRESS_H_
+
+#include <stdint.h>
+
+/* The compressed data is a series of LZ4 block format sequences.  Back-references in a sequence can reach up to
+   COMPRESS_MAX_OFFSET bytes before the current output position, including data which was output by earlier blocks of
+   the same stream.  The already decompressed memory acts as the window so the decoder needs no extra RAM. */
+#define COMPRESS_MAX_OFFSET     0xFFFF
+
+typedef struct
+{
+    const uint8_t* pSrc;
+    uint32_t*      pHashTable;
+    uint32_t       hashBits;
+    uint32_t       srcLength;
+    uint32_t       srcOffset;
+} CompressState;
+
+/* Real name of functions are in __mri namespace. */
+void     __mriCompress_Init(CompressState* pState, const void* pvSrc, uint32_t srcLength,
+                            uint32_t* pHashTable, uint32_t hashBits);
+uint32_t __mriCompress_NextBlock(CompressState* pState, uint8_t* pDest, uint32_t destSize);
+int      __mriCompress_DecompressToMemory(void* pvDest, uint32_t destLength, uint32_t historyLength,
+                                          const uint8_t* pSrc, uint32_t srcLength);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define Compress_Init               __mriCompress_Init
+#define Compress_NextBlock          __mriCompress_NextBlock
+#define DecompressToMemory          __mriCompress_DecompressToMemory
+
+#endif /* _COMPRESS_H_ */
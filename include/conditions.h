@@ -0,0 +1,46 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Conditions which gdb attaches to breakpoints so that they can be evaluated on the target without a round trip. */
+#ifndef _CONDITIONS_H_
+#define _CONDITIONS_H_
+
+#include <stdint.h>
+#include "buffer.h"
+#include "try_catch.h"
+
+/* Maximum number of breakpoints which can have conditions attached at once. */
+#ifndef MRI_CONDITIONAL_BREAKPOINT_COUNT
+#define MRI_CONDITIONAL_BREAKPOINT_COUNT 8
+#endif
+
+/* Bytes of agent expression bytecode which can be attached to each breakpoint, including a length byte per
+   expression. */
+#ifndef MRI_BREAKPOINT_CONDITIONS_SIZE
+#define MRI_BREAKPOINT_CONDITIONS_SIZE 64
+#endif
+
+/* Real name of functions are in __mri namespace. */
+void          __mriConditions_Init(void);
+__throws void __mriConditions_Set(char type, void* pvAddress, uint32_t kind, Buffer* pBuffer);
+void          __mriConditions_Clear(char type, void* pvAddress);
+int           __mriConditions_SkipBreakpointIfFalse(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitBreakpointConditions                __mriConditions_Init
+#define SetBreakpointConditions                 __mriConditions_Set
+#define ClearBreakpointConditions               __mriConditions_Clear
+#define SkipConditionalBreakpointIfFalse        __mriConditions_SkipBreakpointIfFalse
+
+#endif /* _CONDITIONS_H_ */
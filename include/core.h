@@ -31,6 +31,7 @@ int     __mriCore_WasControlCFlagSentFromGdb(void);
 void    __mriCore_RecordControlCFlagSentFromGdb(int controlCFlag);
 int     __mriCore_WasSemihostCallCancelledByGdb(void);
 void    __mriCore_FlagSemihostCallAsHandled(void);
+void    __mriCore_RecordInternalFileIORequest(int internalRequest);
 int     __mriCore_IsFirstException(void);
 int     __mriCore_WasSuccessfullyInit(void);
 int     __mriCore_IsWaitingForGdbToConnect(void);
@@ -53,6 +54,7 @@ void    __mriCore_GdbCommandHandlingLoop(void);
 #define RecordControlCFlagSentFromGdb   __mriCore_RecordControlCFlagSentFromGdb
 #define WasSemihostCallCancelledByGdb   __mriCore_WasSemihostCallCancelledByGdb
 #define FlagSemihostCallAsHandled       __mriCore_FlagSemihostCallAsHandled
+#define RecordInternalFileIORequest     __mriCore_RecordInternalFileIORequest
 #define IsFirstException                __mriCore_IsFirstException
 #define WasSuccessfullyInit             __mriCore_WasSuccessfullyInit
 #define IsWaitingForGdbToConnect        __mriCore_IsWaitingForGdbToConnect
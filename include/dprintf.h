@@ -0,0 +1,55 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Commands which gdb attaches to breakpoints, such as the ones it generates for dprintf-style agent, so that they
+   can be run on the target without a round trip. */
+#ifndef _DPRINTF_H_
+#define _DPRINTF_H_
+
+#include <stdint.h>
+#include "buffer.h"
+#include "try_catch.h"
+
+/* Maximum number of breakpoints which can have commands attached at once. */
+#ifndef MRI_BREAKPOINT_COMMANDS_COUNT
+#define MRI_BREAKPOINT_COMMANDS_COUNT 8
+#endif
+
+/* Bytes of agent expression bytecode which can be attached to each breakpoint as commands, including a length byte
+   per command.  dprintf format strings are stored in the bytecode itself. */
+#ifndef MRI_BREAKPOINT_COMMANDS_SIZE
+#define MRI_BREAKPOINT_COMMANDS_SIZE 128
+#endif
+
+/* Bytes of dprintf output which are buffered on the target until they are sent to gdb in 'O' packets, either because
+   the buffer has filled up or the program has stopped for real. */
+#ifndef MRI_DPRINTF_BUFFER_SIZE
+#define MRI_DPRINTF_BUFFER_SIZE 256
+#endif
+
+/* Real name of functions are in __mri namespace. */
+void          __mriDprintf_Init(void);
+__throws void __mriDprintf_SetCommands(char type, void* pvAddress, uint32_t kind, Buffer* pBuffer);
+void          __mriDprintf_ClearCommands(char type, void* pvAddress);
+int           __mriDprintf_RunCommandsIfPresent(void);
+void          __mriDprintf_FlushOutput(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitBreakpointCommands          __mriDprintf_Init
+#define SetBreakpointCommands           __mriDprintf_SetCommands
+#define ClearBreakpointCommands         __mriDprintf_ClearCommands
+#define RunBreakpointCommandsIfPresent  __mriDprintf_RunCommandsIfPresent
+#define FlushDprintfOutput              __mriDprintf_FlushOutput
+
+#endif /* _DPRINTF_H_ */
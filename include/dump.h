@@ -0,0 +1,39 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Routines to compress a block of target memory and write it to a file on the gdb host. */
+#ifndef _DUMP_H_
+#define _DUMP_H_
+
+#include <stdint.h>
+
+/* The file written to the host is a series of blocks, each containing its 32-bit little endian decompressed and
+   compressed lengths followed by the compressed data.  This is the same format produced by "mrilz compress" so
+   "mrilz decompress" can be used to expand a dump back out on the host. */
+#define DUMP_FRAME_HEADER_SIZE  8
+#define DUMP_MAX_FILENAME_SIZE  64
+
+/* Real name of functions are in __mri namespace. */
+void __mriDump_Queue(const void* pvMemory, uint32_t length, const char* pFilename, uint32_t filenameLength);
+int  __mriDump_IsQueued(void);
+int  __mriDump_RunQueued(void);
+void __mriDump_Cancel(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define QueueMemoryDump         __mriDump_Queue
+#define IsMemoryDumpQueued      __mriDump_IsQueued
+#define RunQueuedMemoryDump     __mriDump_RunQueued
+#define CancelMemoryDump        __mriDump_Cancel
+
+#endif /* _DUMP_H_ */
@@ -0,0 +1,41 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Selection of the registers which are expedited to gdb in T stop responses so that it doesn't need to fetch the
+   whole register context with a 'g' command before it can display the stop location. */
+#ifndef _EXPEDITE_H_
+#define _EXPEDITE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "buffer.h"
+#include "try_catch.h"
+
+#define EXPEDITE_MAX_REGISTERS 16
+
+/* Real name of functions are in __mri namespace. */
+void          __mriExpedite_Init(void);
+__throws void __mriExpedite_SetRegisters(const uint8_t* pRegisterNumbers, size_t count);
+void          __mriExpedite_DisplayRegisters(void);
+void          __mriExpedite_WriteTResponseRegisters(Buffer* pBuffer);
+void          __mriExpedite_WriteRegisters(Buffer* pBuffer, const uint8_t* pRegisterNumbers, size_t count);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitExpeditedRegisters                  __mriExpedite_Init
+#define SetExpeditedRegisters                   __mriExpedite_SetRegisters
+#define DisplayExpeditedRegisters               __mriExpedite_DisplayRegisters
+#define WriteExpeditedRegistersToBuffer         __mriExpedite_WriteTResponseRegisters
+#define WriteRegistersForTResponse              __mriExpedite_WriteRegisters
+
+#endif /* _EXPEDITE_H_ */
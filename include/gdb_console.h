@@ -20,10 +20,12 @@
 
 /* Real name of functions are in __mri namespace. */
 void __mriGdbConsole_WriteString(const char* pString);
+void __mriGdbConsole_WriteSizedString(const char* pString, uint32_t length);
 void __mriGdbConsole_WriteHexValue(uint32_t value);
 
 /* Macroes which allow code to drop the __mri namespace prefix. */
-#define WriteStringToGdbConsole     __mriGdbConsole_WriteString
-#define WriteHexValueToGdbConsole   __mriGdbConsole_WriteHexValue
+#define WriteStringToGdbConsole         __mriGdbConsole_WriteString
+#define WriteSizedStringToGdbConsole    __mriGdbConsole_WriteSizedString
+#define WriteHexValueToGdbConsole       __mriGdbConsole_WriteHexValue
 
 #endif /* _GDB_CONSOLE_H_ */
@@ -18,15 +18,26 @@
 
 #include <stdint.h>
 #include "buffer.h"
+#include "platforms.h"
 
 /* Real name of functions are in __mri namespace. */
 uint32_t __mriMem_ReadMemoryIntoHexBuffer(Buffer* pBuffer, const void* pvMemory, uint32_t readByteCount);
 int      __mriMem_WriteHexBufferToMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount);
 int      __mriMem_WriteBinaryBufferToMemory(Buffer* pBuffer, void* pvMemory, uint32_t writeByteCount);
+uint32_t __mriMem_FillMemoryWithPattern(void* pvMemory, uint32_t length, uint32_t pattern);
+uint32_t __mriMem_CopyMemoryBlock(void* pvDest, const void* pvSrc, uint32_t length);
+int      __mriMem_HashMemoryBlock(const void* pvMemory, uint32_t length, uint32_t* pHash);
+PlatformMemoryType __mriMem_GetMemoryTypeOfRange(const void* pvMemory, uint32_t length);
+void*    __mriMem_PointerFromTargetAddress(uint32_t address);
 
 /* Macroes which allow code to drop the __mri namespace prefix. */
 #define ReadMemoryIntoHexBuffer     __mriMem_ReadMemoryIntoHexBuffer
 #define WriteHexBufferToMemory      __mriMem_WriteHexBufferToMemory
 #define WriteBinaryBufferToMemory   __mriMem_WriteBinaryBufferToMemory
+#define FillMemoryWithPattern       __mriMem_FillMemoryWithPattern
+#define CopyMemoryBlock             __mriMem_CopyMemoryBlock
+#define HashMemoryBlock             __mriMem_HashMemoryBlock
+#define GetMemoryTypeOfRange        __mriMem_GetMemoryTypeOfRange
+#define PointerFromTargetAddress    __mriMem_PointerFromTargetAddress
 
 #endif /* _MEMORY_H_ */
@@ -28,6 +28,7 @@
 #define     MRI_ERROR_MEMORY_ACCESS_FAILURE "E03"   /* Couldn't access requested memory. */
 #define     MRI_ERROR_BUFFER_OVERRUN        "E04"   /* Overflowed internal input/output buffer. */
 #define     MRI_ERROR_NO_FREE_BREAKPOINT    "E05"   /* No free FPB breakpoint comparator slots. */
+#define     MRI_ERROR_CANT_RESUME           "E06"   /* Program can't be resumed from the current stop. */
 
 
 #ifdef __cplusplus
@@ -29,12 +29,14 @@ typedef struct
 
 /* Real name of functions are in __mri namespace. */
 void    __mriPacket_GetFromGDB(Packet* pPacket, Buffer* pBuffer);
+void    __mriPacket_GetFromGDBAfterStartChar(Packet* pPacket, Buffer* pBuffer);
 void    __mriPacket_SendToGDB(Packet* pPacket, Buffer* pBuffer);
 
 /* Macroes which allow code to drop the __mri namespace prefix. */
-#define Packet_Init         __mriPacket_Init
-#define Packet_GetFromGDB   __mriPacket_GetFromGDB
-#define Packet_SendToGDB    __mriPacket_SendToGDB
+#define Packet_Init                     __mriPacket_Init
+#define Packet_GetFromGDB               __mriPacket_GetFromGDB
+#define Packet_GetFromGDBAfterStartChar __mriPacket_GetFromGDBAfterStartChar
+#define Packet_SendToGDB                __mriPacket_SendToGDB
 
 
 #endif /* _PACKET_H_ */
@@ -50,13 +50,18 @@ int       __mriPlatform_CommUartIndex(void);
 uint8_t   __mriPlatform_DetermineCauseOfException(void);
 void      __mriPlatform_DisplayFaultCauseToGdbConsole(void);
 void      __mriPlatform_EnableSingleStep(void);
+void      __mriPlatform_EnableBlockStep(uint32_t endAddress);
 void      __mriPlatform_DisableSingleStep(void);
 int       __mriPlatform_IsSingleStepping(void);
 uint32_t  __mriPlatform_GetProgramCounter(void);
 void      __mriPlatform_SetProgramCounter(uint32_t newPC);
 void      __mriPlatform_AdvanceProgramCounterToNextInstruction(void);
 int       __mriPlatform_WasProgramCounterModifiedByUser(void);
+int       __mriPlatform_CanResume(void);
+__throws uint32_t __mriPlatform_ReadRegister(uint32_t registerNumber);
+uint32_t  __mriPlatform_GetLinkRegister(void);
 int       __mriPlatform_WasMemoryFaultEncountered(void);
+uint32_t  __mriPlatform_GetCycleCount(void);
 
 void      __mriPlatform_WriteTResponseRegistersToBuffer(Buffer* pBuffer);
 void      __mriPlatform_CopyContextToBuffer(Buffer* pBuffer);
@@ -67,6 +72,52 @@ const char*  __mriPlatform_GetDeviceMemoryMapXml(void);
 uint32_t     __mriPlatform_GetTargetXmlSize(void);
 const char*  __mriPlatform_GetTargetXml(void);
 
+typedef enum
+{
+    MRI_PLATFORM_MEMORY_UNMAPPED = 0,
+    MRI_PLATFORM_MEMORY_RAM,
+    MRI_PLATFORM_MEMORY_FLASH,
+    MRI_PLATFORM_MEMORY_PERIPHERAL
+}  PlatformMemoryType;
+
+typedef struct
+{
+    uint32_t            start;
+    uint32_t            length;
+    PlatformMemoryType  type;
+}  PlatformMemoryRegion;
+
+uint32_t                     __mriPlatform_GetDeviceMemoryRegionCount(void);
+const PlatformMemoryRegion*  __mriPlatform_GetDeviceMemoryRegions(void);
+
+/* Devices describe their memory once in a list macro such as:
+        #define DEVICE_MEMORY(FLASH, ROM, RAM, PERIPHERAL) \
+            FLASH(0x08000000, 0x10000, 0x4000) \
+            RAM(0x20000000, 0x20000) \
+            PERIPHERAL(0x40000000, 0x20000000)
+   and build both the memory-map XML sent to gdb and the PlatformMemoryRegion table from it so that the two always
+   match.  gdb has no peripheral memory type so those windows are sent to it as "ram". */
+#define MRI_MEMORY_MAP_XML(LIST) \
+    "<?xml version=\"1.0\"?>" \
+    "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">" \
+    "<memory-map>" \
+    LIST(MRI_MEMORY_MAP_XML_FLASH, MRI_MEMORY_MAP_XML_ROM, MRI_MEMORY_MAP_XML_RAM, MRI_MEMORY_MAP_XML_RAM) \
+    "</memory-map>"
+#define MRI_MEMORY_MAP_XML_FLASH(START, LENGTH, BLOCKSIZE) \
+    "<memory type=\"flash\" start=\"" #START "\" length=\"" #LENGTH "\"> " \
+    "<property name=\"blocksize\">" #BLOCKSIZE "</property></memory>"
+#define MRI_MEMORY_MAP_XML_ROM(START, LENGTH) \
+    "<memory type=\"rom\" start=\"" #START "\" length=\"" #LENGTH "\"> </memory>"
+#define MRI_MEMORY_MAP_XML_RAM(START, LENGTH) \
+    "<memory type=\"ram\" start=\"" #START "\" length=\"" #LENGTH "\"> </memory>"
+
+#define MRI_MEMORY_REGIONS(LIST) \
+    { LIST(MRI_MEMORY_REGION_FLASH, MRI_MEMORY_REGION_ROM, MRI_MEMORY_REGION_RAM, MRI_MEMORY_REGION_PERIPHERAL) }
+#define MRI_MEMORY_REGION_FLASH(START, LENGTH, BLOCKSIZE)   { START, LENGTH, MRI_PLATFORM_MEMORY_FLASH },
+#define MRI_MEMORY_REGION_ROM(START, LENGTH)                { START, LENGTH, MRI_PLATFORM_MEMORY_FLASH },
+#define MRI_MEMORY_REGION_RAM(START, LENGTH)                { START, LENGTH, MRI_PLATFORM_MEMORY_RAM },
+#define MRI_MEMORY_REGION_PERIPHERAL(START, LENGTH)         { START, LENGTH, MRI_PLATFORM_MEMORY_PERIPHERAL },
+
 typedef enum
 {
     MRI_PLATFORM_WRITE_WATCHPOINT = 0,
@@ -78,6 +129,11 @@ __throws void  __mriPlatform_SetHardwareBreakpoint(uint32_t address, uint32_t ki
 __throws void  __mriPlatform_ClearHardwareBreakpoint(uint32_t address, uint32_t kind);
 __throws void  __mriPlatform_SetHardwareWatchpoint(uint32_t address, uint32_t size,  PlatformWatchpointType type);
 __throws void  __mriPlatform_ClearHardwareWatchpoint(uint32_t address, uint32_t size,  PlatformWatchpointType type);
+__throws void  __mriPlatform_SetHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value);
+__throws void  __mriPlatform_ClearHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value);
+int            __mriPlatform_WasWatchpointHit(uint32_t address);
+__throws uint32_t __mriPlatform_GetSoftwareBreakpointMachineCode(uint32_t kind);
+void           __mriPlatform_SyncInstructionCache(void);
 
 typedef enum
 {
@@ -129,13 +185,18 @@ uint32_t       __mriPlatform_GetUidSize(void);
 #define Platform_DetermineCauseOfException                  __mriPlatform_DetermineCauseOfException
 #define Platform_DisplayFaultCauseToGdbConsole              __mriPlatform_DisplayFaultCauseToGdbConsole
 #define Platform_EnableSingleStep                           __mriPlatform_EnableSingleStep
+#define Platform_EnableBlockStep                            __mriPlatform_EnableBlockStep
 #define Platform_DisableSingleStep                          __mriPlatform_DisableSingleStep
 #define Platform_IsSingleStepping                           __mriPlatform_IsSingleStepping
 #define Platform_GetProgramCounter                          __mriPlatform_GetProgramCounter
 #define Platform_SetProgramCounter                          __mriPlatform_SetProgramCounter
 #define Platform_AdvanceProgramCounterToNextInstruction     __mriPlatform_AdvanceProgramCounterToNextInstruction
 #define Platform_WasProgramCounterModifiedByUser            __mriPlatform_WasProgramCounterModifiedByUser
+#define Platform_CanResume                                  __mriPlatform_CanResume
+#define Platform_ReadRegister                               __mriPlatform_ReadRegister
+#define Platform_GetLinkRegister                            __mriPlatform_GetLinkRegister
 #define Platform_WasMemoryFaultEncountered                  __mriPlatform_WasMemoryFaultEncountered
+#define Platform_GetCycleCount                              __mriPlatform_GetCycleCount
 #define Platform_WriteTResponseRegistersToBuffer            __mriPlatform_WriteTResponseRegistersToBuffer
 #define Platform_CopyContextToBuffer                        __mriPlatform_CopyContextToBuffer
 #define Platform_CopyContextFromBuffer                      __mriPlatform_CopyContextFromBuffer
@@ -143,10 +204,17 @@ uint32_t       __mriPlatform_GetUidSize(void);
 #define Platform_GetTargetXmlSize                           __mriPlatform_GetTargetXmlSize
 #define Platform_GetTargetXml                               __mriPlatform_GetTargetXml
 #define Platform_GetDeviceMemoryMapXml                      __mriPlatform_GetDeviceMemoryMapXml
+#define Platform_GetDeviceMemoryRegionCount                 __mriPlatform_GetDeviceMemoryRegionCount
+#define Platform_GetDeviceMemoryRegions                     __mriPlatform_GetDeviceMemoryRegions
 #define Platform_SetHardwareBreakpoint                      __mriPlatform_SetHardwareBreakpoint
 #define Platform_ClearHardwareBreakpoint                    __mriPlatform_ClearHardwareBreakpoint
 #define Platform_SetHardwareWatchpoint                      __mriPlatform_SetHardwareWatchpoint
 #define Platform_ClearHardwareWatchpoint                    __mriPlatform_ClearHardwareWatchpoint
+#define Platform_SetHardwareValueWatchpoint                 __mriPlatform_SetHardwareValueWatchpoint
+#define Platform_ClearHardwareValueWatchpoint               __mriPlatform_ClearHardwareValueWatchpoint
+#define Platform_WasWatchpointHit                           __mriPlatform_WasWatchpointHit
+#define Platform_GetSoftwareBreakpointMachineCode           __mriPlatform_GetSoftwareBreakpointMachineCode
+#define Platform_SyncInstructionCache                       __mriPlatform_SyncInstructionCache
 #define Platform_TypeOfCurrentInstruction                   __mriPlatform_TypeOfCurrentInstruction
 #define Platform_GetSemihostCallParameters                  __mriPlatform_GetSemihostCallParameters
 #define Platform_SetSemihostCallReturnAndErrnoValues        __mriPlatform_SetSemihostCallReturnAndErrnoValues
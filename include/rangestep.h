@@ -0,0 +1,36 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Range stepping which keeps stepping the program without involving gdb for as long as its program counter stays
+   within an address range, typically the instructions generated for a single source line. */
+#ifndef _RANGESTEP_H_
+#define _RANGESTEP_H_
+
+#include <stdint.h>
+
+/* Real name of functions are in __mri namespace. */
+void __mriRangeStep_Init(void);
+void __mriRangeStep_Start(uint32_t start, uint32_t end);
+void __mriRangeStep_Stop(void);
+int  __mriRangeStep_IsActive(void);
+int  __mriRangeStep_ContinueIfInRange(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitRangeStep               __mriRangeStep_Init
+#define StartRangeStep              __mriRangeStep_Start
+#define StopRangeStep               __mriRangeStep_Stop
+#define IsRangeStepping             __mriRangeStep_IsActive
+#define ContinueRangeStepIfInRange  __mriRangeStep_ContinueIfInRange
+
+#endif /* _RANGESTEP_H_ */
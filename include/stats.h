@@ -0,0 +1,96 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Optional cycle count instrumentation which measures the time spent inside of the debug monitor itself. */
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#include <stdint.h>
+#include "buffer.h"
+
+/* Set to 1 to build in the instrumentation along with the "monitor stats" command and qXfer:mri-stats object. */
+#ifndef MRI_ENABLE_STATS
+#define MRI_ENABLE_STATS 0
+#endif
+
+/* Number of different gdb command characters which can be tracked. */
+#ifndef MRI_STATS_COMMAND_COUNT
+#define MRI_STATS_COMMAND_COUNT 16
+#endif
+
+/* Intervals which are timed with the platform's cycle counter. */
+typedef enum
+{
+    STATS_TIMER_STOP = 0,
+    STATS_TIMER_COMMAND,
+    STATS_TIMER_RECEIVE,
+    STATS_TIMER_SEND,
+    STATS_TIMER_COUNT
+} StatsTimer;
+
+/* gdb File-I/O requests issued on behalf of semihost calls. */
+typedef enum
+{
+    STATS_FILE_OPEN = 0,
+    STATS_FILE_WRITE,
+    STATS_FILE_READ,
+    STATS_FILE_CLOSE,
+    STATS_FILE_LSEEK,
+    STATS_FILE_FSTAT,
+    STATS_FILE_UNLINK,
+    STATS_FILE_STAT,
+    STATS_FILE_RENAME,
+    STATS_FILE_COUNT
+} StatsFileOperation;
+
+#if MRI_ENABLE_STATS
+
+/* Real name of functions are in __mri namespace. */
+void __mriStats_Init(void);
+void __mriStats_StartTimer(StatsTimer timer);
+void __mriStats_RecordStop(void);
+void __mriStats_RecordCommand(char commandChar);
+void __mriStats_RecordPacketReceive(void);
+void __mriStats_RecordPacketSend(void);
+void __mriStats_RecordFileOperation(StatsFileOperation operation);
+void __mriStats_Display(void);
+void __mriStats_Clear(void);
+void __mriStats_WriteTransferData(Buffer* pBuffer, uint32_t offset, uint32_t length);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitStats                   __mriStats_Init
+#define StartStatsTimer             __mriStats_StartTimer
+#define RecordStopStats             __mriStats_RecordStop
+#define RecordCommandStats          __mriStats_RecordCommand
+#define RecordPacketReceiveStats    __mriStats_RecordPacketReceive
+#define RecordPacketSendStats       __mriStats_RecordPacketSend
+#define RecordFileOperationStats    __mriStats_RecordFileOperation
+#define DisplayStats                __mriStats_Display
+#define ClearStats                  __mriStats_Clear
+#define WriteStatsTransferData      __mriStats_WriteTransferData
+
+#else
+
+/* The instrumentation points compile away when the stats aren't built in. */
+#define InitStats()                         ((void)0)
+#define StartStatsTimer(TIMER)              ((void)0)
+#define RecordStopStats()                   ((void)0)
+#define RecordCommandStats(CHAR)            ((void)0)
+#define RecordPacketReceiveStats()          ((void)0)
+#define RecordPacketSendStats()             ((void)0)
+#define RecordFileOperationStats(OPERATION) ((void)0)
+
+#endif /* MRI_ENABLE_STATS */
+
+#endif /* _STATS_H_ */
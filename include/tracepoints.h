@@ -0,0 +1,99 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Tracepoints which collect registers and memory into a trace buffer on the target and let the program continue
+   without stopping in gdb. */
+#ifndef _TRACEPOINTS_H_
+#define _TRACEPOINTS_H_
+
+#include <stdint.h>
+#include "buffer.h"
+#include "try_catch.h"
+
+/* Maximum number of tracepoint locations which can be defined at once. */
+#ifndef MRI_TRACEPOINT_COUNT
+#define MRI_TRACEPOINT_COUNT 8
+#endif
+
+/* Bytes of collection actions and condition bytecode which can be attached to each tracepoint location. */
+#ifndef MRI_TRACEPOINT_ACTIONS_SIZE
+#define MRI_TRACEPOINT_ACTIONS_SIZE 64
+#endif
+
+/* Maximum number of trace state variables. */
+#ifndef MRI_TRACE_VARIABLE_COUNT
+#define MRI_TRACE_VARIABLE_COUNT 8
+#endif
+
+/* Size of the trace frame buffer in bytes.  Every frame holds a copy of the registers, as they would be returned for
+   a 'g' command, plus any memory and trace state variables collected by the tracepoint's actions. */
+#ifndef MRI_TRACE_BUFFER_SIZE
+#define MRI_TRACE_BUFFER_SIZE 2048
+#endif
+
+/* The trace buffer can be placed in a RAM section reserved for it by the linker script, which keeps it out of the
+   way of the program's own data, by defining MRI_TRACE_BUFFER_SECTION to the name of that section. */
+#ifdef MRI_TRACE_BUFFER_SECTION
+#define MRI_TRACE_BUFFER_ATTRIBUTES __attribute__((section(MRI_TRACE_BUFFER_SECTION)))
+#else
+#define MRI_TRACE_BUFFER_ATTRIBUTES
+#endif
+
+/* Ways in which QTFrame can search the trace buffer for a frame. */
+typedef enum
+{
+    MRI_TRACE_FIND_FRAME,
+    MRI_TRACE_FIND_PC,
+    MRI_TRACE_FIND_TRACEPOINT,
+    MRI_TRACE_FIND_INSIDE_RANGE,
+    MRI_TRACE_FIND_OUTSIDE_RANGE
+} TraceFindType;
+
+/* Real name of functions are in __mri namespace. */
+void          __mriTracepoints_Init(void);
+__throws void __mriTracepoints_Define(Buffer* pBuffer);
+__throws void __mriTracepoints_DefineVariable(Buffer* pBuffer);
+void          __mriTracepoints_SetCircular(int isCircular);
+__throws void __mriTracepoints_Start(void);
+void          __mriTracepoints_Stop(void);
+int           __mriTracepoints_CollectIfHit(void);
+void          __mriTracepoints_WriteStatus(Buffer* pBuffer);
+int           __mriTracepoints_WriteDefinition(Buffer* pBuffer, uint32_t index);
+int           __mriTracepoints_WriteHitCount(Buffer* pBuffer, uint32_t number, uint32_t address);
+void          __mriTracepoints_WriteVariableValue(Buffer* pBuffer, uint32_t number);
+int           __mriTracepoints_FindFrame(TraceFindType type, uint32_t value1, uint32_t value2);
+int           __mriTracepoints_GetSelectedFrameTracepoint(void);
+int           __mriTracepoints_IsFrameSelected(void);
+void          __mriTracepoints_WriteFrameRegisters(Buffer* pBuffer);
+uint32_t      __mriTracepoints_ReadFrameMemoryIntoHexBuffer(Buffer* pBuffer, uint32_t address, uint32_t length);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitTracepoints                         __mriTracepoints_Init
+#define DefineTracepoint                        __mriTracepoints_Define
+#define DefineTraceVariable                     __mriTracepoints_DefineVariable
+#define SetTraceBufferCircular                  __mriTracepoints_SetCircular
+#define StartTracing                            __mriTracepoints_Start
+#define StopTracing                             __mriTracepoints_Stop
+#define CollectTraceFrameIfTracepointHit        __mriTracepoints_CollectIfHit
+#define WriteTraceStatus                        __mriTracepoints_WriteStatus
+#define WriteTracepointDefinition               __mriTracepoints_WriteDefinition
+#define WriteTracepointHitCount                 __mriTracepoints_WriteHitCount
+#define WriteTraceVariableValue                 __mriTracepoints_WriteVariableValue
+#define FindTraceFrame                          __mriTracepoints_FindFrame
+#define GetSelectedTraceFrameTracepoint         __mriTracepoints_GetSelectedFrameTracepoint
+#define IsTraceFrameSelected                    __mriTracepoints_IsFrameSelected
+#define WriteTraceFrameRegisters                __mriTracepoints_WriteFrameRegisters
+#define ReadTraceFrameMemoryIntoHexBuffer       __mriTracepoints_ReadFrameMemoryIntoHexBuffer
+
+#endif /* _TRACEPOINTS_H_ */
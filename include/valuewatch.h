@@ -0,0 +1,36 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Value watchpoints which only stop the program when a particular value is written to a variable. */
+#ifndef _VALUEWATCH_H_
+#define _VALUEWATCH_H_
+
+#include <stdint.h>
+#include "try_catch.h"
+
+/* Real name of functions are in __mri namespace. */
+void          __mriValueWatch_Init(void);
+__throws void __mriValueWatch_Arm(uint32_t address, uint32_t size, uint32_t value);
+void          __mriValueWatch_Disarm(void);
+int           __mriValueWatch_IsMatchedInHardware(void);
+int           __mriValueWatch_SkipIfNoMatch(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitValueWatchpoint                 __mriValueWatch_Init
+#define ArmValueWatchpoint                  __mriValueWatch_Arm
+#define DisarmValueWatchpoint               __mriValueWatch_Disarm
+#define IsValueWatchpointMatchedInHardware  __mriValueWatch_IsMatchedInHardware
+#define SkipValueWatchpointIfNoMatch        __mriValueWatch_SkipIfNoMatch
+
+#endif /* _VALUEWATCH_H_ */
@@ -0,0 +1,44 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Logging watchpoints which record each write to a variable in a ring buffer on the target and then resume the
+   program without stopping in gdb. */
+#ifndef _WATCHLOG_H_
+#define _WATCHLOG_H_
+
+#include <stdint.h>
+#include "try_catch.h"
+
+/* Number of writes which are kept in the watch log ring buffer.  The oldest entry is overwritten once it fills. */
+#ifndef MRI_WATCHLOG_ENTRIES
+#define MRI_WATCHLOG_ENTRIES 32
+#endif
+
+/* Real name of functions are in __mri namespace. */
+void          __mriWatchLog_Init(void);
+__throws void __mriWatchLog_Arm(uint32_t address, uint32_t size);
+void          __mriWatchLog_Disarm(void);
+void          __mriWatchLog_Clear(void);
+void          __mriWatchLog_Dump(void);
+int           __mriWatchLog_RecordIfHit(void);
+
+/* Macroes which allow code to drop the __mri namespace prefix. */
+#define InitWatchLog                __mriWatchLog_Init
+#define ArmWatchLog                 __mriWatchLog_Arm
+#define DisarmWatchLog              __mriWatchLog_Disarm
+#define ClearWatchLog               __mriWatchLog_Clear
+#define DumpWatchLog                __mriWatchLog_Dump
+#define RecordWatchLogEntryIfHit    __mriWatchLog_RecordIfHit
+
+#endif /* _WATCHLOG_H_ */
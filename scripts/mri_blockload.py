@@ -0,0 +1,110 @@
+# Copyright 2026 The MRI contributors
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# gdb command which reloads only the blocks of an ELF image which differ from what is already in target memory.
+#
+# Usage from within gdb:
+#   (gdb) source scripts/mri_blockload.py
+#   (gdb) mri-blockload [FILE [BLOCKSIZE]]
+#
+# The loadable segments of the ELF file are split into blocks (256 bytes by default) and mri is asked for the hash of
+# each block with the qMriBlockHash packet.  Only blocks whose hash doesn't match the one computed here are written
+# to the target.  gdb sends those writes with 'X' packets.
+import os
+import struct
+import sys
+
+import gdb
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from mri_elf import read_load_segments
+
+
+DEFAULT_BLOCK_SIZE = 0x100
+MAX_BLOCKS_PER_QUERY = 64
+
+
+def block_hash(data):
+    """Must match HashMemoryBlock() in core/memory.c."""
+    hash = 0x811C9DC5
+    for offset in range(0, len(data), 4):
+        word = struct.unpack("<I", data[offset:offset + 4].ljust(4, b"\0"))[0]
+        hash = ((hash << 5) | (hash >> 27)) & 0xFFFFFFFF
+        hash = ((hash ^ word) * 0x9E3779B1) & 0xFFFFFFFF
+    return hash
+
+
+def query_block_hashes(address, length, block_size):
+    output = gdb.execute("maint packet qMriBlockHash:%x,%x,%x" % (address, length, block_size), to_string=True)
+    response = output.split("received: ")[-1].strip().strip('"')
+    if len(response) == 0:
+        raise gdb.GdbError("Target doesn't support the qMriBlockHash packet.")
+    if response[0] == "E" and len(response) == 3:
+        return None
+    return [int(response[i:i + 8], 16) for i in range(0, len(response), 8)]
+
+
+def fetch_target_hashes(address, length, block_size):
+    """Fetch the hashes for a range of blocks, shrinking the request if the response doesn't fit in a packet."""
+    blocks_per_query = MAX_BLOCKS_PER_QUERY
+    hashes = []
+    offset = 0
+    while offset < length:
+        chunk_length = min(blocks_per_query * block_size, length - offset)
+        chunk_hashes = query_block_hashes(address + offset, chunk_length, block_size)
+        if chunk_hashes is None:
+            if blocks_per_query == 1:
+                raise gdb.GdbError("Failed to fetch block hashes at 0x%08x." % (address + offset))
+            blocks_per_query //= 2
+            continue
+        hashes.extend(chunk_hashes)
+        offset += chunk_length
+    return hashes
+
+
+class MriBlockLoadCommand(gdb.Command):
+    """Load only the blocks of an ELF image which differ from the contents of target memory.
+Usage: mri-blockload [FILE [BLOCKSIZE]]
+FILE defaults to the program being debugged and BLOCKSIZE defaults to 256 bytes."""
+
+    def __init__(self):
+        super(MriBlockLoadCommand, self).__init__("mri-blockload", gdb.COMMAND_FILES, gdb.COMPLETE_FILENAME)
+
+    def invoke(self, argument, from_tty):
+        arguments = gdb.string_to_argv(argument)
+        filename = arguments[0] if len(arguments) > 0 else gdb.current_progspace().filename
+        block_size = int(arguments[1], 0) if len(arguments) > 1 else DEFAULT_BLOCK_SIZE
+        if filename is None:
+            raise gdb.GdbError("No file specified and no program loaded.")
+
+        entry, segments = read_load_segments(filename)
+        inferior = gdb.selected_inferior()
+        total_blocks = 0
+        changed_blocks = 0
+        changed_bytes = 0
+        for address, data in segments:
+            hashes = fetch_target_hashes(address, len(data), block_size)
+            for index, target_hash in enumerate(hashes):
+                block = data[index * block_size:(index + 1) * block_size]
+                total_blocks += 1
+                if block_hash(block) != target_hash:
+                    inferior.write_memory(address + index * block_size, block)
+                    changed_blocks += 1
+                    changed_bytes += len(block)
+
+        gdb.execute("set $pc = 0x%x" % entry)
+        print("Loaded %d of %d blocks (%d bytes)." % (changed_blocks, total_blocks, changed_bytes))
+
+
+MriBlockLoadCommand()
@@ -0,0 +1,39 @@
+# Copyright 2026 The MRI contributors
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# Helpers shared by the mri gdb scripts for reading ELF files.
+import struct
+
+import gdb
+
+
+PT_LOAD = 1
+
+
+def read_load_segments(filename):
+    """Return the entry point and a list of (load address, bytes) tuples for each loadable segment of an ELF32 file."""
+    with open(filename, "rb") as file:
+        image = file.read()
+    if image[:4] != b"\x7fELF" or image[4] != 1:
+        raise gdb.GdbError("%s isn't a 32-bit ELF file." % filename)
+    endian = "<" if image[5] == 1 else ">"
+    entry, phoff = struct.unpack_from(endian + "II", image, 24)
+    phentsize, phnum = struct.unpack_from(endian + "HH", image, 42)
+
+    segments = []
+    for index in range(phnum):
+        p_type, offset, vaddr, paddr, filesz = struct.unpack_from(endian + "IIIII", image, phoff + index * phentsize)
+        if p_type == PT_LOAD and filesz > 0:
+            segments.append((paddr, image[offset:offset + filesz]))
+    return entry, segments
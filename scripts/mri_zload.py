@@ -0,0 +1,125 @@
+# Copyright 2026 The MRI contributors
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# gdb command which downloads an ELF image to mri in compressed form with the qMriInflate packet.
+#
+# Usage from within gdb (requires gdb 13 or newer so that connection.send_packet() accepts and returns bytes):
+#   (gdb) source scripts/mri_zload.py
+#   (gdb) mri-zload [FILE]
+#
+# Each loadable segment of the ELF file is compressed with the mrilz host tool (built by "make host") and the
+# resulting blocks are sent to mri, which decompresses them straight into target memory.  Set the MRILZ environment
+# variable if mrilz isn't in the root of the mri tree.
+import os
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+import gdb
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from mri_elf import read_load_segments
+
+
+# Room left in each packet for the command name and arguments.
+PACKET_OVERHEAD = 48
+ESCAPED_BYTES = b"#$}*"
+# Furthest that a back-reference can reach behind the current output position (COMPRESS_MAX_OFFSET in compress.h).
+MAX_HISTORY = 0xFFFF
+
+
+def mrilz_path():
+    default_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "mrilz")
+    return os.environ.get("MRILZ", default_path)
+
+
+def compress_segment(data, max_block_size):
+    """Return a list of (decompressed length, compressed bytes) tuples produced by mrilz for data."""
+    with tempfile.TemporaryDirectory() as directory:
+        input_filename = os.path.join(directory, "segment.bin")
+        output_filename = os.path.join(directory, "segment.lz")
+        with open(input_filename, "wb") as file:
+            file.write(data)
+        subprocess.check_call([mrilz_path(), "compress", input_filename, output_filename, str(max_block_size)])
+        with open(output_filename, "rb") as file:
+            compressed = file.read()
+
+    blocks = []
+    offset = 0
+    while offset < len(compressed):
+        decompressed_length, compressed_length = struct.unpack_from("<II", compressed, offset)
+        offset += 8
+        blocks.append((decompressed_length, compressed[offset:offset + compressed_length]))
+        offset += compressed_length
+    return blocks
+
+
+def escape_binary(data):
+    escaped = bytearray()
+    for byte in bytearray(data):
+        if byte in bytearray(ESCAPED_BYTES):
+            escaped.append(ord("}"))
+            byte ^= 0x20
+        escaped.append(byte)
+    return bytes(escaped)
+
+
+def max_packet_size(connection):
+    response = connection.send_packet("qSupported")
+    match = re.search(rb"PacketSize=([0-9a-fA-F]+)", response)
+    if match is None:
+        raise gdb.GdbError("Target didn't report its packet size.")
+    return int(match.group(1), 16)
+
+
+class MriZLoadCommand(gdb.Command):
+    """Download an ELF image to the target in compressed form.
+Usage: mri-zload [FILE]
+FILE defaults to the program being debugged."""
+
+    def __init__(self):
+        super(MriZLoadCommand, self).__init__("mri-zload", gdb.COMMAND_FILES, gdb.COMPLETE_FILENAME)
+
+    def invoke(self, argument, from_tty):
+        arguments = gdb.string_to_argv(argument)
+        filename = arguments[0] if len(arguments) > 0 else gdb.current_progspace().filename
+        if filename is None:
+            raise gdb.GdbError("No file specified and no program loaded.")
+
+        entry, segments = read_load_segments(filename)
+        connection = gdb.selected_inferior().connection
+        # Escaping can double the size of the compressed data in the worst case.
+        max_block_size = (max_packet_size(connection) - PACKET_OVERHEAD) // 2
+        total_bytes = 0
+        sent_bytes = 0
+        for address, data in segments:
+            # Blocks can refer back to the data already sent for the same segment so tell mri how much of it to allow.
+            history = 0
+            for decompressed_length, block in compress_segment(data, max_block_size):
+                header = b"qMriInflate:%x,%x,%x:" % (address, decompressed_length, min(history, MAX_HISTORY))
+                response = connection.send_packet(header + escape_binary(block))
+                if response != b"OK":
+                    raise gdb.GdbError("Download failed at 0x%08x with %s." % (address, response.decode()))
+                address += decompressed_length
+                history += decompressed_length
+                total_bytes += decompressed_length
+                sent_bytes += len(block)
+
+        gdb.execute("set $pc = 0x%x" % entry)
+        print("Loaded %d bytes as %d compressed bytes." % (total_bytes, sent_bytes))
+
+
+MriZLoadCommand()
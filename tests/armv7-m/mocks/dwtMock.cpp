@@ -0,0 +1,124 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+#include "dwtMock.h"
+
+
+// Forward Function Declarations.
+static int findMatch(uint32_t address, uint32_t function1, uint32_t function2);
+static int isComparatorMatch(DWT_COMP_Type* pComparator, uint32_t address);
+
+
+
+// DWT register file which is handed to the DWT module in place of the memory mapped registers.
+static volatile uint32_t g_control;
+static DWT_COMP_Type     g_comparators[DWTMOCK_MAX_COMPARATORS];
+
+void dwtMock_Init(uint32_t comparatorCount)
+{
+    g_control = comparatorCount << DWT_CTRL_NUMCOMP_SHIFT;
+
+    // Start with every comparator configured to catch code which doesn't clear them.
+    for (size_t i = 0 ; i < DWTMOCK_MAX_COMPARATORS ; i++)
+    {
+        g_comparators[i].COMP = 0xFFFFFFFF;
+        g_comparators[i].MASK = 0x1F;
+        g_comparators[i].FUNCTION = DWT_COMP_FUNCTION_EMITRANGE | DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE;
+    }
+}
+
+volatile uint32_t* dwtMock_GetControl(void)
+{
+    return &g_control;
+}
+
+DWT_COMP_Type* dwtMock_GetComparators(void)
+{
+    return g_comparators;
+}
+
+
+
+// Emulates how the DWT hardware would match instruction fetches and data accesses against its comparators.
+int dwtMock_FindInstructionMatch(uint32_t pc)
+{
+    return findMatch(pc, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION);
+}
+
+int dwtMock_FindDataMatch(uint32_t address, int isWrite)
+{
+    uint32_t function = isWrite ? DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE : DWT_COMP_FUNCTION_FUNCTION_DATA_READ;
+    return findMatch(address, function, DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE);
+}
+
+static int findMatch(uint32_t address, uint32_t function1, uint32_t function2)
+{
+    uint32_t comparatorCount = g_control >> DWT_CTRL_NUMCOMP_SHIFT;
+
+    for (uint32_t i = 0 ; i < comparatorCount ; i++)
+    {
+        uint32_t function = g_comparators[i].FUNCTION & DWT_COMP_FUNCTION_FUNCTION_MASK;
+
+        if (g_comparators[i].FUNCTION & DWT_COMP_FUNCTION_DATAVMATCH)
+            continue;
+        if ((function == function1 || function == function2) && isComparatorMatch(&g_comparators[i], address))
+            return (int)i;
+    }
+    return DWTMOCK_NO_MATCH;
+}
+
+int dwtMock_FindDataValueMatch(uint32_t address, uint32_t value, int isWrite)
+{
+    uint32_t comparatorCount = g_control >> DWT_CTRL_NUMCOMP_SHIFT;
+    uint32_t function1 = isWrite ? DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE : DWT_COMP_FUNCTION_FUNCTION_DATA_READ;
+
+    for (uint32_t i = 0 ; i < comparatorCount ; i++)
+    {
+        uint32_t functionBits = g_comparators[i].FUNCTION;
+        uint32_t function = functionBits & DWT_COMP_FUNCTION_FUNCTION_MASK;
+        uint32_t linkedIndex = (functionBits & DWT_COMP_FUNCTION_DATAVADDR0) >> DWT_COMP_FUNCTION_DATAVADDR0_SHIFT;
+        uint32_t valueMask;
+
+        if (!(functionBits & DWT_COMP_FUNCTION_DATAVMATCH) || linkedIndex >= comparatorCount)
+            continue;
+        if (function != function1 && function != DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE)
+            continue;
+        switch (functionBits & DWT_COMP_FUNCTION_DATAVSIZE_MASK)
+        {
+        case DWT_COMP_FUNCTION_DATAVSIZE_BYTE:
+            valueMask = 0xFF;
+            break;
+        case DWT_COMP_FUNCTION_DATAVSIZE_HALFWORD:
+            valueMask = 0xFFFF;
+            break;
+        default:
+            valueMask = 0xFFFFFFFF;
+            break;
+        }
+        if (isComparatorMatch(&g_comparators[linkedIndex], address) &&
+            (value & valueMask) == (g_comparators[i].COMP & valueMask))
+        {
+            return (int)i;
+        }
+    }
+    return DWTMOCK_NO_MATCH;
+}
+
+static int isComparatorMatch(DWT_COMP_Type* pComparator, uint32_t address)
+{
+    uint32_t ignoreMask = (1U << pComparator->MASK) - 1;
+
+    return (address & ~ignoreMask) == (pComparator->COMP & ~ignoreMask);
+}
@@ -0,0 +1,35 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#ifndef _DWT_MOCK_H_
+#define _DWT_MOCK_H_
+
+extern "C"
+{
+#include "dwt.h"
+}
+
+#define DWTMOCK_MAX_COMPARATORS     16
+/* Value returned by the dwtMock_Find*Match() routines when no comparator matches the access. */
+#define DWTMOCK_NO_MATCH            -1
+
+void               dwtMock_Init(uint32_t comparatorCount);
+volatile uint32_t* dwtMock_GetControl(void);
+DWT_COMP_Type*     dwtMock_GetComparators(void);
+
+int                dwtMock_FindInstructionMatch(uint32_t pc);
+int                dwtMock_FindDataMatch(uint32_t address, int isWrite);
+int                dwtMock_FindDataValueMatch(uint32_t address, uint32_t value, int isWrite);
+
+#endif /* _DWT_MOCK_H_ */
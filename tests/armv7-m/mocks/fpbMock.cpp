@@ -0,0 +1,142 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+#include "fpbMock.h"
+
+#define ARRAY_SIZE(X) (sizeof(X)/sizeof(X[0]))
+
+
+// Forward Function Declarations.
+static uint32_t readCodeWord(uint32_t address);
+static int      isComparatorMatch(uint32_t comparator, uint32_t address);
+static uint32_t fetchFromComparator(uint32_t comparatorIndex, uint32_t address, const uint32_t* pRemapTable);
+static uint32_t extractHalfword(uint32_t word, uint32_t address);
+
+
+
+// Code memory read by the FPB module when building remap table entries.  Each halfword of code memory contains the
+// lower 16-bits of its own address.
+static int      g_readCodeWordCalls;
+static uint32_t g_lastReadCodeWordAddress;
+
+uint32_t fpbMock_GetOriginalHalfword(uint32_t address)
+{
+    return address & 0xFFFE;
+}
+
+int fpbMock_GetReadCodeWordCalls(void)
+{
+    return g_readCodeWordCalls;
+}
+
+uint32_t fpbMock_GetLastReadCodeWordAddress(void)
+{
+    return g_lastReadCodeWordAddress;
+}
+
+static uint32_t readCodeWord(uint32_t address)
+{
+    uint32_t wordAddress = address & ~3U;
+    return (fpbMock_GetOriginalHalfword(wordAddress + 2) << 16) | fpbMock_GetOriginalHalfword(wordAddress);
+}
+
+// __mriFPB_ReadCodeWord stub called by the FPB module.
+uint32_t __mriFPB_ReadCodeWord(uint32_t address)
+{
+    g_readCodeWordCalls++;
+    g_lastReadCodeWordAddress = address;
+    return readCodeWord(address);
+}
+
+
+
+// FPB register file which is handed to the FPB module in place of the memory mapped registers.
+static FPB_Type g_fpb;
+static uint32_t g_comparators[FPBMOCK_MAX_COMPARATORS];
+
+void fpbMock_Init(uint32_t codeComparatorCount, uint32_t literalComparatorCount, int isRemapSupported)
+{
+    uint32_t codeCountLsb = codeComparatorCount & 0xF;
+    uint32_t codeCountMsb = (codeComparatorCount >> 4) & 0x7;
+
+    g_fpb.CTRL = (codeCountMsb << FP_CTRL_NUM_CODE_MSB_SHIFT) |
+                 (literalComparatorCount << FP_CTRL_NUM_LIT_SHIFT) |
+                 (codeCountLsb << FP_CTRL_NUM_CODE_LSB_SHIFT);
+    g_fpb.REMAP = isRemapSupported ? FP_REMAP_RMPSPT : 0;
+
+    // Start with every comparator enabled to catch code which doesn't clear them.
+    for (size_t i = 0 ; i < ARRAY_SIZE(g_comparators) ; i++)
+        g_comparators[i] = 0xFFFFFFFF;
+    g_readCodeWordCalls = 0;
+    g_lastReadCodeWordAddress = 0;
+}
+
+FPB_Type* fpbMock_GetFPB(void)
+{
+    return &g_fpb;
+}
+
+uint32_t* fpbMock_GetComparators(void)
+{
+    return g_comparators;
+}
+
+
+
+// Emulates how the FPB hardware would handle an instruction fetch from the specified halfword.  Only the code
+// comparators take part in instruction fetches.
+uint32_t fpbMock_FetchHalfword(uint32_t address, const uint32_t* pRemapTable)
+{
+    uint32_t codeComparatorCount = ((g_fpb.CTRL & FP_CTRL_NUM_CODE_MSB_MASK) >> 8) |
+                                   ((g_fpb.CTRL & FP_CTRL_NUM_CODE_LSB_MASK) >> 4);
+
+    if (g_fpb.CTRL & FP_CTRL_ENABLE)
+    {
+        for (uint32_t i = 0 ; i < codeComparatorCount ; i++)
+        {
+            if (isComparatorMatch(g_comparators[i], address))
+                return fetchFromComparator(i, address, pRemapTable);
+        }
+    }
+    return extractHalfword(readCodeWord(address), address);
+}
+
+static int isComparatorMatch(uint32_t comparator, uint32_t address)
+{
+    return (comparator & FP_COMP_ENABLE) && (comparator & FP_COMP_COMP_MASK) == (address & FP_COMP_COMP_MASK);
+}
+
+static uint32_t fetchFromComparator(uint32_t comparatorIndex, uint32_t address, const uint32_t* pRemapTable)
+{
+    uint32_t replace = g_comparators[comparatorIndex] & FP_COMP_REPLACE_MASK;
+    int      isUpperHalfword = address & 2;
+
+    switch (replace)
+    {
+    case FP_COMP_REPLACE_REMAP:
+        return extractHalfword(pRemapTable[comparatorIndex], address);
+    case FP_COMP_REPLACE_BREAK_LOWER:
+        return isUpperHalfword ? extractHalfword(readCodeWord(address), address) : FPBMOCK_BREAKPOINT;
+    case FP_COMP_REPLACE_BREAK_UPPER:
+        return isUpperHalfword ? FPBMOCK_BREAKPOINT : extractHalfword(readCodeWord(address), address);
+    default:
+        return FPBMOCK_BREAKPOINT;
+    }
+}
+
+static uint32_t extractHalfword(uint32_t word, uint32_t address)
+{
+    return (address & 2) ? word >> 16 : word & 0xFFFF;
+}
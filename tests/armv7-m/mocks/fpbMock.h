@@ -0,0 +1,37 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#ifndef _FPB_MOCK_H_
+#define _FPB_MOCK_H_
+
+extern "C"
+{
+#include "fpb.h"
+}
+
+/* Value returned by fpbMock_FetchHalfword() when a comparator in breakpoint mode matches the fetch. */
+#define FPBMOCK_BREAKPOINT          0x10000
+#define FPBMOCK_MAX_COMPARATORS     16
+
+void      fpbMock_Init(uint32_t codeComparatorCount, uint32_t literalComparatorCount, int isRemapSupported);
+FPB_Type* fpbMock_GetFPB(void);
+uint32_t* fpbMock_GetComparators(void);
+
+uint32_t  fpbMock_GetOriginalHalfword(uint32_t address);
+int       fpbMock_GetReadCodeWordCalls(void);
+uint32_t  fpbMock_GetLastReadCodeWordAddress(void);
+
+uint32_t  fpbMock_FetchHalfword(uint32_t address, const uint32_t* pRemapTable);
+
+#endif /* _FPB_MOCK_H_ */
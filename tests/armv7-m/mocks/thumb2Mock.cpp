@@ -0,0 +1,52 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+#include "thumb2Mock.h"
+
+
+// Code memory read by the Thumb-2 decoder.  Halfwords outside of the code set by the test read as 0x0000 (MOVS r0, r0)
+// which never ends a basic block.
+static uint16_t g_code[THUMB2MOCK_MAX_HALFWORDS];
+static uint32_t g_baseAddress;
+static size_t   g_halfWordCount;
+static uint32_t g_highestReadAddress;
+
+void thumb2Mock_SetCode(uint32_t baseAddress, const uint16_t* pHalfWords, size_t halfWordCount)
+{
+    if (halfWordCount > THUMB2MOCK_MAX_HALFWORDS)
+        halfWordCount = THUMB2MOCK_MAX_HALFWORDS;
+    memset(g_code, 0, sizeof(g_code));
+    memcpy(g_code, pHalfWords, halfWordCount * sizeof(*pHalfWords));
+    g_baseAddress = baseAddress;
+    g_halfWordCount = halfWordCount;
+    g_highestReadAddress = 0;
+}
+
+uint32_t thumb2Mock_GetHighestReadAddress(void)
+{
+    return g_highestReadAddress;
+}
+
+// __mriThumb2_ReadCodeHalfWord stub called by the Thumb-2 decoder.
+uint16_t __mriThumb2_ReadCodeHalfWord(uint32_t address)
+{
+    uint32_t index = (address - g_baseAddress) / sizeof(uint16_t);
+
+    if (address > g_highestReadAddress)
+        g_highestReadAddress = address;
+    if (address < g_baseAddress || index >= g_halfWordCount)
+        return 0x0000;
+    return g_code[index];
+}
@@ -0,0 +1,30 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#ifndef _THUMB2_MOCK_H_
+#define _THUMB2_MOCK_H_
+
+#include <stddef.h>
+
+extern "C"
+{
+#include "thumb2.h"
+}
+
+#define THUMB2MOCK_MAX_HALFWORDS    32
+
+void     thumb2Mock_SetCode(uint32_t baseAddress, const uint16_t* pHalfWords, size_t halfWordCount);
+uint32_t thumb2Mock_GetHighestReadAddress(void);
+
+#endif /* _THUMB2_MOCK_H_ */
@@ -0,0 +1,447 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+extern "C"
+{
+#include "dwt.h"
+}
+#include "dwtMock.h"
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+static const uint32_t WRITE = DWT_COMP_FUNCTION_FUNCTION_DATA_WRITE;
+static const uint32_t READ = DWT_COMP_FUNCTION_FUNCTION_DATA_READ;
+static const uint32_t READWRITE = DWT_COMP_FUNCTION_FUNCTION_DATA_READWRITE;
+
+TEST_GROUP(DWT)
+{
+    void setup()
+    {
+        initDWT(4);
+    }
+
+    void teardown()
+    {
+    }
+
+    void initDWT(uint32_t comparatorCount)
+    {
+        dwtMock_Init(comparatorCount);
+        DWT_Init(dwtMock_GetControl(), dwtMock_GetComparators());
+    }
+
+    DWT_COMP_Type* comparator(uint32_t index)
+    {
+        return &dwtMock_GetComparators()[index];
+    }
+};
+
+TEST(DWT, Init_ShouldClearImplementedComparatorsOnly)
+{
+    for (int i = 0 ; i < 4 ; i++)
+    {
+        CHECK_EQUAL(0, comparator(i)->COMP);
+        CHECK_EQUAL(0, comparator(i)->MASK);
+        CHECK_EQUAL(0, comparator(i)->FUNCTION);
+    }
+    CHECK_EQUAL(0xFFFFFFFF, comparator(4)->COMP);
+    CHECK_EQUAL(4, DWT_GetComparatorCount());
+}
+
+TEST(DWT, IsValidWatchpoint_ShouldRequireNaturallyAlignedPowerOf2SizeAndDataType)
+{
+    CHECK_TRUE(DWT_IsValidWatchpoint(0x10000000, 4, WRITE));
+    CHECK_TRUE(DWT_IsValidWatchpoint(0x10000000, 256, READWRITE));
+    CHECK_FALSE(DWT_IsValidWatchpoint(0x10000000, 3, WRITE));
+    CHECK_FALSE(DWT_IsValidWatchpoint(0x10000002, 4, WRITE));
+    CHECK_FALSE(DWT_IsValidWatchpoint(0x10000000, 4, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION));
+}
+
+TEST(DWT, SetWatchpoint_ShouldProgramAddressMaskAndFunction)
+{
+    POINTERS_EQUAL(comparator(0), DWT_SetWatchpoint(0x10000010, 16, READ));
+    CHECK_EQUAL(0x10000010, comparator(0)->COMP);
+    CHECK_EQUAL(4, comparator(0)->MASK);
+    CHECK_EQUAL(READ, comparator(0)->FUNCTION);
+    CHECK_EQUAL(0, dwtMock_FindDataMatch(0x1000001F, 0));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x10000020, 0));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x10000010, 1));
+}
+
+TEST(DWT, SetWatchpoint_Invalid_ShouldReturnNullAndLeaveComparatorsFree)
+{
+    POINTERS_EQUAL(NULL, DWT_SetWatchpoint(0x10000001, 2, WRITE));
+    CHECK_EQUAL(0, comparator(0)->FUNCTION);
+}
+
+TEST(DWT, SetSameWatchpointTwice_ShouldReuseComparator)
+{
+    DWT_SetWatchpoint(0x10000000, 4, WRITE);
+    POINTERS_EQUAL(comparator(0), DWT_SetWatchpoint(0x10000000, 4, WRITE));
+    CHECK_EQUAL(0, comparator(1)->FUNCTION);
+}
+
+TEST(DWT, SetWatchpointsOfDifferentTypeOnSameAddress_ShouldUseSeparateComparators)
+{
+    DWT_SetWatchpoint(0x10000000, 4, WRITE);
+    POINTERS_EQUAL(comparator(1), DWT_SetWatchpoint(0x10000000, 4, READ));
+}
+
+TEST(DWT, ClearWatchpoint_ShouldFreeComparator)
+{
+    DWT_SetWatchpoint(0x10000000, 4, WRITE);
+    POINTERS_EQUAL(comparator(0), DWT_ClearWatchpoint(0x10000000, 4, WRITE));
+    CHECK_EQUAL(0, comparator(0)->FUNCTION);
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x10000000, 1));
+}
+
+TEST(DWT, ClearWatchpointNotSet_ShouldReturnNull)
+{
+    DWT_SetWatchpoint(0x10000000, 4, WRITE);
+    POINTERS_EQUAL(NULL, DWT_ClearWatchpoint(0x10000000, 8, WRITE));
+    POINTERS_EQUAL(NULL, DWT_ClearWatchpoint(0x10000000, 4, READ));
+    CHECK_EQUAL(WRITE, comparator(0)->FUNCTION);
+}
+
+TEST(DWT, SetBreakpoint_ShouldUsePCMatchComparator)
+{
+    POINTERS_EQUAL(comparator(0), DWT_SetBreakpoint(0x00001002));
+    CHECK_EQUAL(0x00001002, comparator(0)->COMP);
+    CHECK_EQUAL(0, comparator(0)->MASK);
+    CHECK_EQUAL(DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION, comparator(0)->FUNCTION);
+    CHECK_EQUAL(0, dwtMock_FindInstructionMatch(0x00001002));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindInstructionMatch(0x00001000));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x00001002, 0));
+}
+
+TEST(DWT, SetBreakpoint_OnOddAddress_ShouldFail)
+{
+    POINTERS_EQUAL(NULL, DWT_SetBreakpoint(0x00001001));
+    POINTERS_EQUAL(NULL, DWT_FindBreakpoint(0x00001001));
+    POINTERS_EQUAL(NULL, DWT_ClearBreakpoint(0x00001001));
+    CHECK_EQUAL(0, comparator(0)->FUNCTION);
+}
+
+TEST(DWT, SetBreakpoint_InRAM_ShouldSucceed)
+{
+    POINTERS_EQUAL(comparator(0), DWT_SetBreakpoint(0x20000000));
+}
+
+TEST(DWT, FindBreakpoint_ShouldOnlyFindPCMatchComparators)
+{
+    DWT_SetWatchpoint(0x00001000, 2, READ);
+    POINTERS_EQUAL(NULL, DWT_FindBreakpoint(0x00001000));
+    DWT_SetBreakpoint(0x00001000);
+    POINTERS_EQUAL(comparator(1), DWT_FindBreakpoint(0x00001000));
+}
+
+TEST(DWT, BreakpointsAndWatchpoints_ShouldShareComparatorPool)
+{
+    POINTERS_EQUAL(comparator(0), DWT_SetBreakpoint(0x00001000));
+    POINTERS_EQUAL(comparator(1), DWT_SetWatchpoint(0x10000000, 4, WRITE));
+    POINTERS_EQUAL(comparator(2), DWT_SetBreakpoint(0x00002000));
+    POINTERS_EQUAL(comparator(3), DWT_SetWatchpoint(0x10000004, 4, READ));
+    POINTERS_EQUAL(NULL, DWT_SetBreakpoint(0x00003000));
+    POINTERS_EQUAL(NULL, DWT_SetWatchpoint(0x10000008, 4, READ));
+}
+
+TEST(DWT, ClearBreakpoint_ShouldMakeComparatorAvailableForWatchpoint)
+{
+    DWT_SetBreakpoint(0x00001000);
+    DWT_SetBreakpoint(0x00002000);
+    DWT_SetBreakpoint(0x00003000);
+    DWT_SetBreakpoint(0x00004000);
+    POINTERS_EQUAL(comparator(1), DWT_ClearBreakpoint(0x00002000));
+    POINTERS_EQUAL(NULL, DWT_ClearBreakpoint(0x00002000));
+    POINTERS_EQUAL(comparator(1), DWT_SetWatchpoint(0x10000000, 4, WRITE));
+    CHECK_EQUAL(2, dwtMock_FindInstructionMatch(0x00003000));
+}
+
+TEST(DWT, ClearWatchpoint_ShouldNotClearBreakpointOnSameAddress)
+{
+    DWT_SetBreakpoint(0x00001000);
+    POINTERS_EQUAL(NULL, DWT_ClearWatchpoint(0x00001000, 2, READ));
+    CHECK_EQUAL(0, dwtMock_FindInstructionMatch(0x00001000));
+}
+
+TEST(DWT, NoComparators_ShouldFailAllocations)
+{
+    initDWT(0);
+    POINTERS_EQUAL(NULL, DWT_SetBreakpoint(0x00001000));
+    POINTERS_EQUAL(NULL, DWT_SetWatchpoint(0x10000000, 4, WRITE));
+}
+
+TEST(DWT, WasWatchpointMatched_ShouldOnlyReportComparatorsMatchedWhenLatched)
+{
+    DWT_SetWatchpoint(0x10000000, 4, WRITE);
+    DWT_SetWatchpoint(0x10000010, 4, WRITE);
+    comparator(1)->FUNCTION |= DWT_COMP_FUNCTION_MATCHED;
+    CHECK_FALSE(DWT_WasWatchpointMatched(0x10000010));
+
+    DWT_LatchMatchedComparators();
+    CHECK_TRUE(DWT_WasWatchpointMatched(0x10000010));
+    CHECK_FALSE(DWT_WasWatchpointMatched(0x10000000));
+    CHECK_FALSE(DWT_WasWatchpointMatched(0x10000020));
+
+    comparator(1)->FUNCTION &= ~DWT_COMP_FUNCTION_MATCHED;
+    DWT_LatchMatchedComparators();
+    CHECK_FALSE(DWT_WasWatchpointMatched(0x10000010));
+}
+
+TEST(DWT, WasWatchpointMatched_ShouldIgnoreBreakpointComparators)
+{
+    DWT_SetBreakpoint(0x00001000);
+    comparator(0)->FUNCTION |= DWT_COMP_FUNCTION_MATCHED;
+    DWT_LatchMatchedComparators();
+    CHECK_FALSE(DWT_WasWatchpointMatched(0x00001000));
+}
+
+TEST(DWT, SetValueWatchpoint_ShouldLinkValueComparatorToAddressComparator)
+{
+    POINTERS_EQUAL(comparator(0), DWT_SetValueWatchpoint(0x10000004, 4, 7, WRITE));
+    CHECK_EQUAL(7, comparator(0)->COMP);
+    CHECK_EQUAL(DWT_COMP_FUNCTION_DATAVMATCH | DWT_COMP_FUNCTION_DATAVSIZE_WORD |
+                (1 << DWT_COMP_FUNCTION_DATAVADDR1_SHIFT) | (1 << DWT_COMP_FUNCTION_DATAVADDR0_SHIFT) | WRITE,
+                comparator(0)->FUNCTION);
+    CHECK_EQUAL(0x10000004, comparator(1)->COMP);
+    CHECK_EQUAL(0, comparator(1)->MASK);
+    CHECK_EQUAL(0, comparator(1)->FUNCTION);
+
+    CHECK_EQUAL(0, dwtMock_FindDataValueMatch(0x10000004, 7, 1));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataValueMatch(0x10000004, 6, 1));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataValueMatch(0x10000008, 7, 1));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x10000004, 1));
+}
+
+TEST(DWT, SetValueWatchpoint_ShouldReplicateByteAndHalfwordValues)
+{
+    DWT_SetValueWatchpoint(0x10000001, 1, 0x1234, WRITE);
+    CHECK_EQUAL(0x34343434, comparator(0)->COMP);
+    CHECK_EQUAL(DWT_COMP_FUNCTION_DATAVSIZE_BYTE, comparator(0)->FUNCTION & DWT_COMP_FUNCTION_DATAVSIZE_MASK);
+    DWT_SetValueWatchpoint(0x10000002, 2, 0x12345678, WRITE);
+    CHECK_EQUAL(0x56785678, comparator(2)->COMP);
+    CHECK_EQUAL(DWT_COMP_FUNCTION_DATAVSIZE_HALFWORD, comparator(2)->FUNCTION & DWT_COMP_FUNCTION_DATAVSIZE_MASK);
+}
+
+TEST(DWT, SetValueWatchpoint_Invalid_ShouldReturnNull)
+{
+    POINTERS_EQUAL(NULL, DWT_SetValueWatchpoint(0x10000000, 8, 7, WRITE));
+    POINTERS_EQUAL(NULL, DWT_SetValueWatchpoint(0x10000002, 4, 7, WRITE));
+    POINTERS_EQUAL(NULL, DWT_SetValueWatchpoint(0x10000000, 4, 7, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION));
+}
+
+TEST(DWT, SetValueWatchpoint_ShouldNeedTwoFreeComparators)
+{
+    DWT_SetWatchpoint(0x20000000, 4, WRITE);
+    DWT_SetWatchpoint(0x20000010, 4, WRITE);
+    DWT_SetWatchpoint(0x20000020, 4, WRITE);
+    POINTERS_EQUAL(NULL, DWT_SetValueWatchpoint(0x10000000, 4, 7, WRITE));
+    CHECK_EQUAL(0, comparator(3)->FUNCTION);
+}
+
+TEST(DWT, LinkedAddressComparator_ShouldNotBeAllocatedAgain)
+{
+    DWT_SetValueWatchpoint(0x10000000, 4, 7, WRITE);
+    POINTERS_EQUAL(comparator(2), DWT_SetWatchpoint(0x20000000, 4, WRITE));
+    POINTERS_EQUAL(comparator(3), DWT_SetBreakpoint(0x00001000));
+    POINTERS_EQUAL(NULL, DWT_SetWatchpoint(0x20000010, 4, WRITE));
+}
+
+TEST(DWT, SetSameValueWatchpointTwice_ShouldReuseComparators)
+{
+    DWT_SetValueWatchpoint(0x10000000, 4, 7, WRITE);
+    POINTERS_EQUAL(comparator(0), DWT_SetValueWatchpoint(0x10000000, 4, 7, WRITE));
+    CHECK_EQUAL(0, comparator(2)->FUNCTION);
+    POINTERS_EQUAL(comparator(2), DWT_SetValueWatchpoint(0x10000000, 4, 8, WRITE));
+}
+
+TEST(DWT, ClearValueWatchpoint_ShouldFreeBothComparators)
+{
+    DWT_SetValueWatchpoint(0x10000000, 4, 7, WRITE);
+    POINTERS_EQUAL(NULL, DWT_ClearValueWatchpoint(0x10000000, 4, 8, WRITE));
+    POINTERS_EQUAL(comparator(0), DWT_ClearValueWatchpoint(0x10000000, 4, 7, WRITE));
+    CHECK_EQUAL(0, comparator(0)->FUNCTION);
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataValueMatch(0x10000000, 7, 1));
+    POINTERS_EQUAL(comparator(0), DWT_SetWatchpoint(0x20000000, 4, WRITE));
+    POINTERS_EQUAL(comparator(1), DWT_SetWatchpoint(0x20000010, 4, WRITE));
+}
+
+TEST(DWT, WasWatchpointMatched_ShouldReportValueWatchpointByItsAddress)
+{
+    DWT_SetValueWatchpoint(0x10000000, 4, 7, WRITE);
+    comparator(0)->FUNCTION |= DWT_COMP_FUNCTION_MATCHED;
+    DWT_LatchMatchedComparators();
+    CHECK_TRUE(DWT_WasWatchpointMatched(0x10000000));
+    CHECK_FALSE(DWT_WasWatchpointMatched(7));
+}
+
+TEST(DWT, DecomposeRange_AlignedPowerOf2_ShouldUseOneBlock)
+{
+    DWT_Block blocks[4];
+
+    CHECK_EQUAL(1, DWT_DecomposeRange(0x10000010, 16, blocks, 4));
+    CHECK_EQUAL(0x10000010, blocks[0].address);
+    CHECK_EQUAL(16, blocks[0].size);
+}
+
+TEST(DWT, DecomposeRange_TwelveByteStruct_ShouldUseTwoBlocks)
+{
+    DWT_Block blocks[4];
+
+    CHECK_EQUAL(2, DWT_DecomposeRange(0x10000000, 12, blocks, 4));
+    CHECK_EQUAL(0x10000000, blocks[0].address);
+    CHECK_EQUAL(8, blocks[0].size);
+    CHECK_EQUAL(0x10000008, blocks[1].address);
+    CHECK_EQUAL(4, blocks[1].size);
+
+    CHECK_EQUAL(2, DWT_DecomposeRange(0x10000004, 12, blocks, 4));
+    CHECK_EQUAL(0x10000004, blocks[0].address);
+    CHECK_EQUAL(4, blocks[0].size);
+    CHECK_EQUAL(0x10000008, blocks[1].address);
+    CHECK_EQUAL(8, blocks[1].size);
+}
+
+TEST(DWT, DecomposeRange_UnalignedBuffer_ShouldUseLargestAlignedBlockAtEachStep)
+{
+    DWT_Block blocks[4];
+
+    CHECK_EQUAL(4, DWT_DecomposeRange(0x10000001, 6, blocks, 4));
+    CHECK_EQUAL(0x10000001, blocks[0].address);
+    CHECK_EQUAL(1, blocks[0].size);
+    CHECK_EQUAL(0x10000002, blocks[1].address);
+    CHECK_EQUAL(2, blocks[1].size);
+    CHECK_EQUAL(0x10000004, blocks[2].address);
+    CHECK_EQUAL(2, blocks[2].size);
+    CHECK_EQUAL(0x10000006, blocks[3].address);
+    CHECK_EQUAL(1, blocks[3].size);
+}
+
+TEST(DWT, DecomposeRange_NeedingMoreThanMaxBlocks_ShouldReturnZero)
+{
+    DWT_Block blocks[4];
+
+    CHECK_EQUAL(0, DWT_DecomposeRange(0x10000001, 6, blocks, 3));
+    CHECK_EQUAL(0, DWT_DecomposeRange(0x10000000, 4, blocks, 0));
+}
+
+TEST(DWT, CoverRange_AcrossLargeBoundary_ShouldSplitAtBoundary)
+{
+    DWT_Block blocks[2];
+
+    CHECK_EQUAL(2, DWT_CoverRange(0x10000FFD, 6, blocks, 2));
+    CHECK_EQUAL(0x10000FFC, blocks[0].address);
+    CHECK_EQUAL(4, blocks[0].size);
+    CHECK_EQUAL(0x10001000, blocks[1].address);
+    CHECK_EQUAL(4, blocks[1].size);
+}
+
+TEST(DWT, CoverRange_WhenEnclosingBlockIsNoLarger_ShouldUseOneBlock)
+{
+    DWT_Block blocks[2];
+
+    CHECK_EQUAL(1, DWT_CoverRange(0x10000001, 6, blocks, 2));
+    CHECK_EQUAL(0x10000000, blocks[0].address);
+    CHECK_EQUAL(8, blocks[0].size);
+}
+
+TEST(DWT, CoverRange_WithOneBlock_ShouldUseEnclosingBlock)
+{
+    DWT_Block blocks[1];
+
+    CHECK_EQUAL(1, DWT_CoverRange(0x10000FFE, 6, blocks, 1));
+    CHECK_EQUAL(0x10000000, blocks[0].address);
+    CHECK_EQUAL(0x2000, blocks[0].size);
+    CHECK_EQUAL(0, DWT_CoverRange(0x10000FFE, 6, blocks, 0));
+}
+
+TEST(DWT, IsValidRangeWatchpoint_ShouldAcceptAnySizeAndAlignmentWhichDoesNotWrap)
+{
+    CHECK_TRUE(DWT_IsValidRangeWatchpoint(0x10000001, 3, WRITE));
+    CHECK_TRUE(DWT_IsValidRangeWatchpoint(0xFFFFFFFC, 4, READ));
+    CHECK_FALSE(DWT_IsValidRangeWatchpoint(0x10000000, 0, WRITE));
+    CHECK_FALSE(DWT_IsValidRangeWatchpoint(0xFFFFFFFC, 5, WRITE));
+    CHECK_FALSE(DWT_IsValidRangeWatchpoint(0x10000000, 4, DWT_COMP_FUNCTION_FUNCTION_INSTRUCTION));
+}
+
+TEST(DWT, SetRangeWatchpoint_ShouldProgramComparatorForEachBlock)
+{
+    POINTERS_EQUAL(comparator(0), DWT_SetRangeWatchpoint(0x10000004, 12, READ));
+    CHECK_EQUAL(0x10000004, comparator(0)->COMP);
+    CHECK_EQUAL(2, comparator(0)->MASK);
+    CHECK_EQUAL(0x10000008, comparator(1)->COMP);
+    CHECK_EQUAL(3, comparator(1)->MASK);
+    CHECK_EQUAL(READ, comparator(1)->FUNCTION);
+    CHECK_EQUAL(0, comparator(2)->FUNCTION);
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x10000003, 0));
+    CHECK_EQUAL(0, dwtMock_FindDataMatch(0x10000004, 0));
+    CHECK_EQUAL(1, dwtMock_FindDataMatch(0x1000000F, 0));
+    CHECK_EQUAL(DWTMOCK_NO_MATCH, dwtMock_FindDataMatch(0x10000010, 0));
+}
+
+TEST(DWT, SetRangeWatchpoint_ReadNeedingTooManyComparators_ShouldFailAndLeaveComparatorsFree)
+{
+    DWT_SetBreakpoint(0x00001000);
+    POINTERS_EQUAL(NULL, DWT_SetRangeWatchpoint(0x10000001, 6, READ));
+    CHECK_EQUAL(0, comparator(1)->FUNCTION);
+    CHECK_EQUAL(0, comparator(2)->FUNCTION);
+    CHECK_EQUAL(0, comparator(3)->FUNCTION);
+}
+
+TEST(DWT, SetRangeWatchpoint_WriteNeedingTooManyComparators_ShouldCoverWithLargerBlock)
+{
+    DWT_SetBreakpoint(0x00001000);
+    POINTERS_EQUAL(comparator(1), DWT_SetRangeWatchpoint(0x10000001, 6, WRITE));
+    CHECK_EQUAL(0x10000000, comparator(1)->COMP);
+    CHECK_EQUAL(3, comparator(1)->MASK);
+    CHECK_EQUAL(0, comparator(2)->FUNCTION);
+    CHECK_EQUAL(1, dwtMock_FindDataMatch(0x10000006, 1));
+}
+
+TEST(DWT, SetSameRangeWatchpointTwice_ShouldReuseComparators)
+{
+    DWT_SetRangeWatchpoint(0x10000004, 12, WRITE);
+    POINTERS_EQUAL(comparator(0), DWT_SetRangeWatchpoint(0x10000004, 12, WRITE));
+    CHECK_EQUAL(0, comparator(2)->FUNCTION);
+}
+
+TEST(DWT, ClearRangeWatchpoint_ShouldFreeAllOfItsComparators)
+{
+    DWT_SetRangeWatchpoint(0x10000004, 12, WRITE);
+    POINTERS_EQUAL(NULL, DWT_ClearRangeWatchpoint(0x10000004, 12, READ));
+    POINTERS_EQUAL(comparator(0), DWT_ClearRangeWatchpoint(0x10000004, 12, WRITE));
+    CHECK_EQUAL(0, comparator(0)->FUNCTION);
+    CHECK_EQUAL(0, comparator(1)->FUNCTION);
+    POINTERS_EQUAL(NULL, DWT_ClearRangeWatchpoint(0x10000004, 12, WRITE));
+}
+
+TEST(DWT, RangeComparators_ShouldNotBeSharedWithOtherWatchpoints)
+{
+    DWT_SetRangeWatchpoint(0x10000004, 12, WRITE);
+    POINTERS_EQUAL(comparator(2), DWT_SetWatchpoint(0x10000004, 4, WRITE));
+    POINTERS_EQUAL(comparator(2), DWT_ClearWatchpoint(0x10000004, 4, WRITE));
+    POINTERS_EQUAL(NULL, DWT_ClearWatchpoint(0x10000008, 8, WRITE));
+    CHECK_EQUAL(WRITE, comparator(0)->FUNCTION);
+    CHECK_EQUAL(WRITE, comparator(1)->FUNCTION);
+}
+
+TEST(DWT, WasWatchpointMatched_ShouldReportRangeWatchpointByItsAddress)
+{
+    DWT_SetRangeWatchpoint(0x10000004, 12, WRITE);
+    comparator(1)->FUNCTION |= DWT_COMP_FUNCTION_MATCHED;
+    DWT_LatchMatchedComparators();
+    CHECK_TRUE(DWT_WasWatchpointMatched(0x10000004));
+    CHECK_FALSE(DWT_WasWatchpointMatched(0x10000008));
+}
@@ -0,0 +1,335 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+
+extern "C"
+{
+#include "fpb.h"
+}
+#include "fpbMock.h"
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+static const uint32_t BKPT = 0xbe00;
+
+TEST_GROUP(FPB)
+{
+    uint32_t m_remapTable[FPB_REMAP_TABLE_ENTRIES];
+
+    void setup()
+    {
+        memset(m_remapTable, 0xFF, sizeof(m_remapTable));
+    }
+
+    void teardown()
+    {
+    }
+
+    void initFPB(uint32_t codeComparatorCount, uint32_t literalComparatorCount, int isRemapSupported)
+    {
+        fpbMock_Init(codeComparatorCount, literalComparatorCount, isRemapSupported);
+        FPB_Init(fpbMock_GetFPB(), fpbMock_GetComparators(), m_remapTable);
+    }
+
+    void initCortexM3FPB(int isRemapSupported)
+    {
+        initFPB(6, 2, isRemapSupported);
+    }
+
+    uint32_t comparator(uint32_t index)
+    {
+        return fpbMock_GetComparators()[index];
+    }
+
+    uint32_t fetch(uint32_t address)
+    {
+        return fpbMock_FetchHalfword(address, m_remapTable);
+    }
+
+    uint32_t original(uint32_t address)
+    {
+        return fpbMock_GetOriginalHalfword(address);
+    }
+};
+
+TEST(FPB, Init_ShouldClearCodeAndLiteralComparatorsOnly)
+{
+    initCortexM3FPB(0);
+    for (int i = 0 ; i < 8 ; i++)
+        CHECK_EQUAL(0, comparator(i));
+    CHECK_EQUAL(0xFFFFFFFF, comparator(8));
+}
+
+TEST(FPB, Init_ShouldEnableFPBWithKey)
+{
+    initCortexM3FPB(0);
+    CHECK_EQUAL(FP_CTRL_KEY | FP_CTRL_ENABLE, fpbMock_GetFPB()->CTRL & (FP_CTRL_KEY | FP_CTRL_ENABLE));
+}
+
+TEST(FPB, Init_WithRemapSupport_ShouldPointRemapRegisterAtClearedTable)
+{
+    initCortexM3FPB(1);
+    CHECK_TRUE(FPB_IsRemapEnabled());
+    CHECK_EQUAL((uint32_t)(size_t)m_remapTable & FP_REMAP_REMAP_MASK, fpbMock_GetFPB()->REMAP & FP_REMAP_REMAP_MASK);
+    for (int i = 0 ; i < FPB_REMAP_TABLE_ENTRIES ; i++)
+        CHECK_EQUAL(0, m_remapTable[i]);
+}
+
+TEST(FPB, Init_WithoutRemapSupport_ShouldLeaveTableUntouchedAndUseBreakMode)
+{
+    initCortexM3FPB(0);
+    CHECK_FALSE(FPB_IsRemapEnabled());
+    CHECK_EQUAL(0xFFFFFFFF, m_remapTable[0]);
+}
+
+TEST(FPB, Init_WithNullRemapTable_ShouldUseBreakMode)
+{
+    fpbMock_Init(6, 2, 1);
+    FPB_Init(fpbMock_GetFPB(), fpbMock_GetComparators(), NULL);
+    CHECK_FALSE(FPB_IsRemapEnabled());
+    CHECK_EQUAL(0, fpbMock_GetFPB()->REMAP & FP_REMAP_REMAP_MASK);
+}
+
+TEST(FPB, Init_WithMoreComparatorsThanRemapTableEntries_ShouldUseBreakMode)
+{
+    initFPB(8, 2, 1);
+    CHECK_FALSE(FPB_IsRemapEnabled());
+}
+
+TEST(FPB, Init_WithMoreThan15CodeComparators_ShouldClearThemAll)
+{
+    initFPB(FPBMOCK_MAX_COMPARATORS, 0, 0);
+    CHECK_EQUAL(0, comparator(FPBMOCK_MAX_COMPARATORS - 1));
+}
+
+TEST(FPB, BreakMode_SetBreakpointOnLowerHalfword)
+{
+    initCortexM3FPB(0);
+    POINTERS_EQUAL(&fpbMock_GetComparators()[0], FPB_SetBreakpoint(0x1000, 0));
+    CHECK_EQUAL(0x1000 | FP_COMP_REPLACE_BREAK_LOWER | FP_COMP_ENABLE, comparator(0));
+    CHECK_EQUAL(FPBMOCK_BREAKPOINT, fetch(0x1000));
+    CHECK_EQUAL(original(0x1002), fetch(0x1002));
+}
+
+TEST(FPB, BreakMode_SetBreakpointOnUpperHalfword)
+{
+    initCortexM3FPB(0);
+    FPB_SetBreakpoint(0x1002, 0);
+    CHECK_EQUAL(0x1000 | FP_COMP_REPLACE_BREAK_UPPER | FP_COMP_ENABLE, comparator(0));
+    CHECK_EQUAL(original(0x1000), fetch(0x1000));
+    CHECK_EQUAL(FPBMOCK_BREAKPOINT, fetch(0x1002));
+}
+
+TEST(FPB, BreakMode_Set32BitBreakpoint_ShouldBreakOnWholeWord)
+{
+    initCortexM3FPB(0);
+    FPB_SetBreakpoint(0x1000, 1);
+    CHECK_EQUAL(0x1000 | FP_COMP_REPLACE_BREAK | FP_COMP_ENABLE, comparator(0));
+}
+
+TEST(FPB, BreakMode_SetSameBreakpointTwice_ShouldReuseComparator)
+{
+    initCortexM3FPB(0);
+    uint32_t* pFirst = FPB_SetBreakpoint(0x1000, 0);
+    POINTERS_EQUAL(pFirst, FPB_SetBreakpoint(0x1000, 0));
+    CHECK_EQUAL(0, comparator(1));
+}
+
+TEST(FPB, BreakMode_SetMoreBreakpointsThanCodeComparators_ShouldFail)
+{
+    initCortexM3FPB(0);
+    for (uint32_t i = 0 ; i < 6 ; i++)
+        CHECK_TRUE(FPB_SetBreakpoint(0x1000 + i * 4, 0) != NULL);
+    POINTERS_EQUAL(NULL, FPB_SetBreakpoint(0x2000, 0));
+    CHECK_EQUAL(0, comparator(6));
+}
+
+TEST(FPB, BreakMode_ClearBreakpoint_ShouldFreeComparatorForReuse)
+{
+    initCortexM3FPB(0);
+    FPB_SetBreakpoint(0x1000, 0);
+    FPB_SetBreakpoint(0x2000, 0);
+    POINTERS_EQUAL(&fpbMock_GetComparators()[0], FPB_ClearBreakpoint(0x1000, 0));
+    CHECK_EQUAL(0, comparator(0));
+    POINTERS_EQUAL(&fpbMock_GetComparators()[0], FPB_SetBreakpoint(0x3000, 0));
+}
+
+TEST(FPB, BreakMode_ClearBreakpointNotSet_ShouldReturnNull)
+{
+    initCortexM3FPB(0);
+    FPB_SetBreakpoint(0x1000, 0);
+    POINTERS_EQUAL(NULL, FPB_ClearBreakpoint(0x1002, 0));
+    CHECK_EQUAL(FPBMOCK_BREAKPOINT, fetch(0x1000));
+}
+
+TEST(FPB, SetBreakpoint_OnInvalidAddresses_ShouldFailInBothModes)
+{
+    for (int isRemapSupported = 0 ; isRemapSupported <= 1 ; isRemapSupported++)
+    {
+        initCortexM3FPB(isRemapSupported);
+        POINTERS_EQUAL(NULL, FPB_SetBreakpoint(0x1001, 0));
+        POINTERS_EQUAL(NULL, FPB_SetBreakpoint(0x20000000, 0));
+        POINTERS_EQUAL(NULL, FPB_ClearBreakpoint(0x1001, 0));
+        CHECK_EQUAL(0, comparator(0));
+    }
+}
+
+TEST(FPB, RemapMode_SetBreakpointOnLowerHalfword_ShouldPatchBkptIntoTableEntry)
+{
+    initCortexM3FPB(1);
+    POINTERS_EQUAL(&fpbMock_GetComparators()[0], FPB_SetBreakpoint(0x1000, 0));
+    CHECK_EQUAL(0x1000 | FP_COMP_REPLACE_REMAP | FP_COMP_ENABLE, comparator(0));
+    CHECK_EQUAL((original(0x1002) << 16) | BKPT, m_remapTable[0]);
+    CHECK_EQUAL(BKPT, fetch(0x1000));
+    CHECK_EQUAL(original(0x1002), fetch(0x1002));
+}
+
+TEST(FPB, RemapMode_SetBreakpointOnUpperHalfword_ShouldPatchBkptIntoTableEntry)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1006, 0);
+    CHECK_EQUAL(0x1004 | FP_COMP_REPLACE_REMAP | FP_COMP_ENABLE, comparator(0));
+    CHECK_EQUAL((BKPT << 16) | original(0x1004), m_remapTable[0]);
+    CHECK_EQUAL(original(0x1004), fetch(0x1004));
+    CHECK_EQUAL(BKPT, fetch(0x1006));
+}
+
+TEST(FPB, RemapMode_Set32BitBreakpoint_ShouldOnlyPatchFirstHalfword)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1000, 1);
+    CHECK_EQUAL(BKPT, fetch(0x1000));
+    CHECK_EQUAL(original(0x1002), fetch(0x1002));
+}
+
+TEST(FPB, RemapMode_SetBreakpoint_ShouldReadOriginalWordOnlyWhenAllocatingComparator)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1002, 0);
+    CHECK_EQUAL(1, fpbMock_GetReadCodeWordCalls());
+    CHECK_EQUAL(0x1000, fpbMock_GetLastReadCodeWordAddress());
+    FPB_SetBreakpoint(0x1000, 0);
+    FPB_SetBreakpoint(0x1002, 0);
+    CHECK_EQUAL(1, fpbMock_GetReadCodeWordCalls());
+}
+
+TEST(FPB, RemapMode_TwoBreakpointsInSameWord_ShouldShareComparator)
+{
+    initCortexM3FPB(1);
+    uint32_t* pLower = FPB_SetBreakpoint(0x1000, 0);
+    uint32_t* pUpper = FPB_SetBreakpoint(0x1002, 0);
+    POINTERS_EQUAL(pLower, pUpper);
+    CHECK_EQUAL(0, comparator(1));
+    CHECK_EQUAL((BKPT << 16) | BKPT, m_remapTable[0]);
+    CHECK_EQUAL(BKPT, fetch(0x1000));
+    CHECK_EQUAL(BKPT, fetch(0x1002));
+}
+
+TEST(FPB, RemapMode_ShouldFitTwoBreakpointsPerComparator)
+{
+    initCortexM3FPB(1);
+    for (uint32_t address = 0x1000 ; address < 0x1000 + 6 * 4 ; address += 2)
+        CHECK_TRUE(FPB_SetBreakpoint(address, 0) != NULL);
+    POINTERS_EQUAL(NULL, FPB_SetBreakpoint(0x2000, 0));
+    for (uint32_t address = 0x1000 ; address < 0x1000 + 6 * 4 ; address += 2)
+        CHECK_EQUAL(BKPT, fetch(address));
+}
+
+TEST(FPB, RemapMode_ClearOneOfTwoSharedBreakpoints_ShouldRestoreOnlyThatHalfword)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1000, 0);
+    FPB_SetBreakpoint(0x1002, 0);
+    POINTERS_EQUAL(&fpbMock_GetComparators()[0], FPB_ClearBreakpoint(0x1000, 0));
+    CHECK_EQUAL(0x1000 | FP_COMP_REPLACE_REMAP | FP_COMP_ENABLE, comparator(0));
+    CHECK_EQUAL(original(0x1000), fetch(0x1000));
+    CHECK_EQUAL(BKPT, fetch(0x1002));
+}
+
+TEST(FPB, RemapMode_ClearLastBreakpointInWord_ShouldDisableComparatorAndRestoreTableEntry)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1002, 0);
+    FPB_ClearBreakpoint(0x1002, 0);
+    CHECK_EQUAL(0, comparator(0));
+    CHECK_EQUAL((original(0x1002) << 16) | original(0x1000), m_remapTable[0]);
+    CHECK_EQUAL(original(0x1002), fetch(0x1002));
+}
+
+TEST(FPB, RemapMode_ClearBreakpointNotSet_ShouldReturnNull)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1000, 0);
+    POINTERS_EQUAL(NULL, FPB_ClearBreakpoint(0x2000, 0));
+    CHECK_EQUAL(BKPT, fetch(0x1000));
+}
+
+TEST(FPB, RemapMode_ReusedComparator_ShouldUseTableEntryWithSameIndex)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1000, 0);
+    FPB_SetBreakpoint(0x2000, 0);
+    FPB_SetBreakpoint(0x3000, 0);
+    FPB_ClearBreakpoint(0x2000, 0);
+    POINTERS_EQUAL(&fpbMock_GetComparators()[1], FPB_SetBreakpoint(0x4002, 0));
+    CHECK_EQUAL((BKPT << 16) | original(0x4000), m_remapTable[1]);
+    CHECK_EQUAL(original(0x2000), fetch(0x2000));
+    CHECK_EQUAL(original(0x4000), fetch(0x4000));
+    CHECK_EQUAL(BKPT, fetch(0x4002));
+    CHECK_EQUAL(BKPT, fetch(0x1000));
+    CHECK_EQUAL(BKPT, fetch(0x3000));
+}
+
+TEST(FPB, RemapMode_ShouldLeaveLiteralComparatorsAndTheirTableEntriesUnused)
+{
+    initCortexM3FPB(1);
+    for (uint32_t i = 0 ; i < 7 ; i++)
+        FPB_SetBreakpoint(0x1000 + i * 4, 0);
+    CHECK_EQUAL(0, comparator(6));
+    CHECK_EQUAL(0, comparator(7));
+    CHECK_EQUAL(0, m_remapTable[6]);
+    CHECK_EQUAL(0, m_remapTable[7]);
+}
+
+TEST(FPB, IsBreakpointSet_ShouldFindBreakModeBreakpointsOfEitherSize)
+{
+    initCortexM3FPB(0);
+    FPB_SetBreakpoint(0x1000, 0);
+    FPB_SetBreakpoint(0x2000, 1);
+    CHECK_TRUE(FPB_IsBreakpointSet(0x1000));
+    CHECK_TRUE(FPB_IsBreakpointSet(0x2000));
+    CHECK_FALSE(FPB_IsBreakpointSet(0x1002));
+    CHECK_FALSE(FPB_IsBreakpointSet(0x3000));
+    FPB_ClearBreakpoint(0x1000, 0);
+    CHECK_FALSE(FPB_IsBreakpointSet(0x1000));
+}
+
+TEST(FPB, IsBreakpointSet_ShouldOnlyFindRemappedHalfwordWithBreakpoint)
+{
+    initCortexM3FPB(1);
+    FPB_SetBreakpoint(0x1002, 0);
+    CHECK_TRUE(FPB_IsBreakpointSet(0x1002));
+    CHECK_FALSE(FPB_IsBreakpointSet(0x1000));
+    CHECK_FALSE(FPB_IsBreakpointSet(0x2002));
+}
+
+TEST(FPB, IsBreakpointSet_ShouldReturnFalseForInvalidAddress)
+{
+    initCortexM3FPB(0);
+    CHECK_FALSE(FPB_IsBreakpointSet(0x1001));
+    CHECK_FALSE(FPB_IsBreakpointSet(0xE0000000));
+}
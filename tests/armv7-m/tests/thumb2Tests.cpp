@@ -0,0 +1,216 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+extern "C"
+{
+#include "thumb2.h"
+}
+#include "thumb2Mock.h"
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+#define ARRAY_SIZE(X) (sizeof(X)/sizeof(X[0]))
+
+
+struct InstructionEntry
+{
+    const char* pDisassembly;
+    uint16_t    halfWord0;
+    uint16_t    halfWord1;
+    uint32_t    size;
+    int         isBlockEnd;
+};
+
+static const InstructionEntry g_instructions[] =
+{
+    // 16-bit instructions which fall through to the next instruction.
+    {"movs r0, #0",                 0x2000, 0x0000, 2, 0},
+    {"lsls r0, r0, #1",             0x0040, 0x0000, 2, 0},
+    {"adds r0, r0, r1",             0x1840, 0x0000, 2, 0},
+    {"mov r0, r1",                  0x4608, 0x0000, 2, 0},
+    {"mov r7, sp",                  0x466F, 0x0000, 2, 0},
+    {"add sp, r0",                  0x4485, 0x0000, 2, 0},
+    {"cmp r0, lr",                  0x4570, 0x0000, 2, 0},
+    {"ldr r0, [r0]",                0x6800, 0x0000, 2, 0},
+    {"ldr r0, [sp, #4]",            0x9801, 0x0000, 2, 0},
+    {"ldr r0, [pc, #4]",            0x4801, 0x0000, 2, 0},
+    {"ldmia r0!, {r0, r1}",         0xC803, 0x0000, 2, 0},
+    {"adr r0, label",               0xA001, 0x0000, 2, 0},
+    {"push {lr}",                   0xB500, 0x0000, 2, 0},
+    {"pop {r0}",                    0xBC01, 0x0000, 2, 0},
+    {"sub sp, #8",                  0xB082, 0x0000, 2, 0},
+    {"uxtb r0, r0",                 0xB2C0, 0x0000, 2, 0},
+    {"rev r0, r0",                  0xBA00, 0x0000, 2, 0},
+    {"cpsid i",                     0xB672, 0x0000, 2, 0},
+    {"nop",                         0xBF00, 0x0000, 2, 0},
+    {"wfe",                         0xBF20, 0x0000, 2, 0},
+    {"wfi",                         0xBF30, 0x0000, 2, 0},
+    // 16-bit instructions which end the basic block.
+    {"beq .",                       0xD0FE, 0x0000, 2, 1},
+    {"blt .",                       0xDBFE, 0x0000, 2, 1},
+    {"udf #0",                      0xDE00, 0x0000, 2, 1},
+    {"svc #0",                      0xDF00, 0x0000, 2, 1},
+    {"b .",                         0xE7FE, 0x0000, 2, 1},
+    {"cbz r0, label",               0xB108, 0x0000, 2, 1},
+    {"cbnz r0, label",              0xB908, 0x0000, 2, 1},
+    {"bx lr",                       0x4770, 0x0000, 2, 1},
+    {"blx r1",                      0x4788, 0x0000, 2, 1},
+    {"add pc, r0",                  0x4487, 0x0000, 2, 1},
+    {"add lr, r0",                  0x4486, 0x0000, 2, 1},
+    {"mov pc, r0",                  0x4687, 0x0000, 2, 1},
+    {"mov pc, lr",                  0x46F7, 0x0000, 2, 1},
+    {"mov lr, r0",                  0x4686, 0x0000, 2, 1},
+    {"pop {pc}",                    0xBD00, 0x0000, 2, 1},
+    {"pop {r4, pc}",                0xBD10, 0x0000, 2, 1},
+    {"bkpt #0",                     0xBE00, 0x0000, 2, 1},
+    {"bkpt #0xab",                  0xBEAB, 0x0000, 2, 1},
+    {"it eq",                       0xBF08, 0x0000, 2, 1},
+    {"ite ne",                      0xBF14, 0x0000, 2, 1},
+    {"itttt gt",                    0xBFC1, 0x0000, 2, 1},
+    // 32-bit instructions which fall through to the next instruction.
+    {"mov.w r0, #0",                0xF04F, 0x0000, 4, 0},
+    {"add.w r0, r0, r1",            0xEB00, 0x0001, 4, 0},
+    {"mul r0, r0, r1",              0xFB00, 0xF001, 4, 0},
+    {"ldr.w r0, [r0]",              0xF8D0, 0x0000, 4, 0},
+    {"ldr.w r0, [pc, #4]",          0xF8DF, 0x0004, 4, 0},
+    {"ldr r0, [sp], #4",            0xF85D, 0x0B04, 4, 0},
+    {"pld [r0]",                    0xF890, 0xF000, 4, 0},
+    {"str.w lr, [r0]",              0xF8C0, 0xE000, 4, 0},
+    {"ldrd r2, r3, [r0]",           0xE9D0, 0x2300, 4, 0},
+    {"ldrex r1, [r0]",              0xE850, 0x1F00, 4, 0},
+    {"push.w {r4, lr}",             0xE92D, 0x4010, 4, 0},
+    {"stmia.w r0, {r0, lr}",        0xE880, 0x4001, 4, 0},
+    {"pop.w {r0, r4}",              0xE8BD, 0x0011, 4, 0},
+    {"vpush {d8}",                  0xED2D, 0x8B02, 4, 0},
+    {"nop.w",                       0xF3AF, 0x8000, 4, 0},
+    {"dsb sy",                      0xF3BF, 0x8F4F, 4, 0},
+    {"isb sy",                      0xF3BF, 0x8F6F, 4, 0},
+    {"mrs r0, psp",                 0xF3EF, 0x8009, 4, 0},
+    {"msr basepri, r0",             0xF380, 0x8811, 4, 0},
+    // 32-bit instructions which end the basic block.
+    {"bl label",                    0xF000, 0xF800, 4, 1},
+    {"bl .",                        0xF7FF, 0xFFFE, 4, 1},
+    {"b.w label",                   0xF000, 0xB800, 4, 1},
+    {"beq.w label",                 0xF000, 0x8000, 4, 1},
+    {"bne.w .",                     0xF47F, 0xAFFE, 4, 1},
+    {"udf.w #0",                    0xF7F0, 0xA000, 4, 1},
+    {"ldr pc, [sp], #4",            0xF85D, 0xFB04, 4, 1},
+    {"ldr.w pc, [pc, #4]",          0xF8DF, 0xF004, 4, 1},
+    {"ldr.w pc, [r0, r0, lsl #2]",  0xF850, 0xF020, 4, 1},
+    {"ldr.w lr, [r0]",              0xF8D0, 0xE000, 4, 1},
+    {"pop.w {r4, pc}",              0xE8BD, 0x8010, 4, 1},
+    {"pop.w {r4, lr}",              0xE8BD, 0x4010, 4, 1},
+    {"ldmdb r0, {r0, pc}",          0xE910, 0x8001, 4, 1},
+    {"tbb [r0, r1]",                0xE8D0, 0xF001, 4, 1},
+    {"tbh [r0, r1, lsl #1]",        0xE8D0, 0xF011, 4, 1}
+};
+
+
+TEST_GROUP(Thumb2)
+{
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+    }
+
+    void setCode(const uint16_t* pHalfWords, size_t halfWordCount)
+    {
+        thumb2Mock_SetCode(0x1000, pHalfWords, halfWordCount);
+    }
+};
+
+TEST(Thumb2, GetInstructionSize_ShouldOnlyReturnFourForThe32BitPrefixes)
+{
+    for (uint32_t prefix = 0 ; prefix < 32 ; prefix++)
+    {
+        uint32_t expectedSize = (prefix == 0x1D || prefix == 0x1E || prefix == 0x1F) ? 4 : 2;
+        CHECK_EQUAL(expectedSize, Thumb2_GetInstructionSize(prefix << 11));
+        CHECK_EQUAL(expectedSize, Thumb2_GetInstructionSize((prefix << 11) | 0x07FF));
+    }
+}
+
+TEST(Thumb2, InstructionTable_ShouldDecodeSizeAndBlockEndForEachInstruction)
+{
+    for (size_t i = 0 ; i < ARRAY_SIZE(g_instructions) ; i++)
+    {
+        const InstructionEntry* pEntry = &g_instructions[i];
+
+        if (pEntry->size != Thumb2_GetInstructionSize(pEntry->halfWord0) ||
+            pEntry->isBlockEnd != Thumb2_IsBlockEndInstruction(pEntry->halfWord0, pEntry->halfWord1))
+        {
+            FAIL(pEntry->pDisassembly);
+        }
+    }
+}
+
+TEST(Thumb2, IsBlockEndInstruction_ShouldIgnoreSecondHalfWordOf16BitInstruction)
+{
+    CHECK_FALSE(Thumb2_IsBlockEndInstruction(0x2000, 0xF800));
+    CHECK_TRUE(Thumb2_IsBlockEndInstruction(0x4770, 0x0000));
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldReturnStartAddressWhenFirstInstructionEndsBlock)
+{
+    static const uint16_t code[] = { 0x4770 };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x1000, Thumb2_FindBasicBlockEnd(0x1000, 0x1010));
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldSkip16And32BitInstructionsUpToBranch)
+{
+    static const uint16_t code[] = { 0x2000, 0xF8D0, 0x0000, 0x1840, 0xF04F, 0x0000, 0xD0FE };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x100C, Thumb2_FindBasicBlockEnd(0x1000, 0x1100));
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldNotTreatSecondHalfWordOf32BitInstructionAsInstruction)
+{
+    static const uint16_t code[] = { 0xF8D0, 0x4770, 0x2000, 0xE7FE };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x1006, Thumb2_FindBasicBlockEnd(0x1000, 0x1100));
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldStopAtIfThenInstruction)
+{
+    static const uint16_t code[] = { 0x2000, 0x4570, 0xBF08, 0x2001 };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x1004, Thumb2_FindBasicBlockEnd(0x1000, 0x1100));
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldStopAtEndAddressWhenNoBranchIsFound)
+{
+    static const uint16_t code[] = { 0x2000, 0x2001, 0x2002, 0x4770 };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x1004, Thumb2_FindBasicBlockEnd(0x1000, 0x1004));
+    CHECK_EQUAL(0x1002, thumb2Mock_GetHighestReadAddress());
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldReturnAddressPast32BitInstructionWhichStraddlesEndAddress)
+{
+    static const uint16_t code[] = { 0x2000, 0xF8D0, 0x0000, 0x4770 };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x1006, Thumb2_FindBasicBlockEnd(0x1000, 0x1004));
+}
+
+TEST(Thumb2, FindBasicBlockEnd_ShouldReadNothingForEmptyRange)
+{
+    static const uint16_t code[] = { 0x2000 };
+    setCode(code, ARRAY_SIZE(code));
+    CHECK_EQUAL(0x1000, Thumb2_FindBasicBlockEnd(0x1000, 0x1000));
+    CHECK_EQUAL(0, thumb2Mock_GetHighestReadAddress());
+}
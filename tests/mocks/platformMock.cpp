@@ -14,6 +14,7 @@
 */
 #include <assert.h>
 #include <signal.h>
+#include <stdio.h>
 #include <string.h>
 
 extern "C"
@@ -41,6 +42,7 @@ static void     commUninitTransmitDataBuffer();
 static uint32_t isReceiveBufferEmpty();
 static void     waitForReceiveData();
 static size_t   getTransmitDataBufferSize();
+static void     clearReceiveBuffersFrom(size_t index);
 
 
 
@@ -78,10 +80,9 @@ void Platform_Init(Token* pParameterTokens)
 
 // Platform_Comm* Instrumentation
 static const char  g_emptyPacket[] = "$#00";
-static Buffer      g_receiveBuffers[2];
+static Buffer      g_receiveBuffers[8];
 static size_t      g_receiveIndex;
-static char*       g_pAlloc1;
-static char*       g_pAlloc2;
+static char*       g_pAllocs[8];
 static char*       g_pTransmitDataBufferStart;
 static char*       g_pTransmitDataBufferEnd;
 static char*       g_pTransmitDataBufferCurr;
@@ -99,25 +100,47 @@ void platformMock_CommInitReceiveData(const char* pDataToReceive1, const char* p
         Buffer_Init(&g_receiveBuffers[1], (char*)pDataToReceive2, strlen(pDataToReceive2));
     else
         Buffer_Init(&g_receiveBuffers[1], (char*)g_emptyPacket, strlen(g_emptyPacket));
+    clearReceiveBuffersFrom(2);
     g_receiveIndex = 0;
 }
 
 void platformMock_CommInitReceiveChecksummedData(const char* pDataToReceive1, const char* pDataToReceive2 /*= NULL*/)
 {
-    g_pAlloc1 = allocateAndCopyChecksummedData(pDataToReceive1);
-    Buffer_Init(&g_receiveBuffers[0], g_pAlloc1, strlen(g_pAlloc1));
+    g_pAllocs[0] = allocateAndCopyChecksummedData(pDataToReceive1);
+    Buffer_Init(&g_receiveBuffers[0], g_pAllocs[0], strlen(g_pAllocs[0]));
     if (pDataToReceive2)
     {
-        g_pAlloc2 = allocateAndCopyChecksummedData(pDataToReceive2);
-        Buffer_Init(&g_receiveBuffers[1], g_pAlloc2, strlen(g_pAlloc2));
+        g_pAllocs[1] = allocateAndCopyChecksummedData(pDataToReceive2);
+        Buffer_Init(&g_receiveBuffers[1], g_pAllocs[1], strlen(g_pAllocs[1]));
     }
     else
     {
         Buffer_Init(&g_receiveBuffers[1], (char*)g_emptyPacket, strlen(g_emptyPacket));
     }
+    clearReceiveBuffersFrom(2);
     g_receiveIndex = 0;
 }
 
+void platformMock_CommInitReceiveChecksummedDataSequence(const char* const* ppDataToReceive, size_t count)
+{
+    size_t i;
+
+    assert ( count <= ARRAY_SIZE(g_receiveBuffers) );
+    for (i = 0 ; i < count ; i++)
+    {
+        g_pAllocs[i] = allocateAndCopyChecksummedData(ppDataToReceive[i]);
+        Buffer_Init(&g_receiveBuffers[i], g_pAllocs[i], strlen(g_pAllocs[i]));
+    }
+    clearReceiveBuffersFrom(count);
+    g_receiveIndex = 0;
+}
+
+static void clearReceiveBuffersFrom(size_t index)
+{
+    for ( ; index < ARRAY_SIZE(g_receiveBuffers) ; index++)
+        Buffer_Init(&g_receiveBuffers[index], NULL, 0);
+}
+
 static char* allocateAndCopyChecksummedData(const char* pData)
 {
     size_t len = strlen(pData) + 2 * countPoundSigns(pData) + 1;
@@ -166,7 +189,7 @@ static void copyChecksummedData(char* pDest, const char* pSrc)
 void platformMock_CommInitTransmitDataBuffer(size_t Size)
 {
     commUninitTransmitDataBuffer();
-    g_pTransmitDataBufferStart = (char*)malloc(Size);
+    g_pTransmitDataBufferStart = (char*)malloc(Size + 1);
     g_pTransmitDataBufferCurr = g_pTransmitDataBufferStart;
     g_pTransmitDataBufferEnd = g_pTransmitDataBufferStart + Size;
 }
@@ -179,6 +202,12 @@ static void commUninitTransmitDataBuffer()
     g_pTransmitDataBufferEnd = NULL;
 }
 
+const char* platformMock_CommGetTransmittedData(void)
+{
+    *g_pTransmitDataBufferCurr = '\0';
+    return g_pTransmitDataBufferStart;
+}
+
 int platformMock_CommDoesTransmittedDataEqual(const char* thisString)
 {
     size_t stringLength = strlen(thisString);
@@ -193,6 +222,54 @@ static size_t getTransmitDataBufferSize()
     return g_pTransmitDataBufferCurr - g_pTransmitDataBufferStart;
 }
 
+const char* platformMock_CommBuildMonitorCommandPacket(const char* pCommand)
+{
+    static char packet[256];
+    char*       p = packet;
+
+    assert ( sizeof("+$qRcmd,#") + strlen(pCommand) * 2 <= sizeof(packet) );
+    p += sprintf(p, "+$qRcmd,");
+    while (*pCommand)
+        p += sprintf(p, "%02x", (unsigned char)*pCommand++);
+    strcpy(p, "#");
+
+    return packet;
+}
+
+void platformMock_CommInitReceiveMonitorCommand(const char* pCommand, int consoleOutputPackets)
+{
+    char acks[128];
+    int  i;
+
+    // gdb acknowledges each console output packet and the final response before continuing.
+    assert ( consoleOutputPackets + sizeof("+$c#") <= sizeof(acks) );
+    for (i = 0 ; i < consoleOutputPackets ; i++)
+        acks[i] = '+';
+    strcpy(&acks[i], "+$c#");
+
+    platformMock_CommInitReceiveChecksummedData(platformMock_CommBuildMonitorCommandPacket(pCommand), acks);
+}
+
+const char* platformMock_CommGetConsoleOutput(void)
+{
+    static char  output[4096];
+    const char*  p = platformMock_CommGetTransmittedData();
+    size_t       length = 0;
+    unsigned int byte;
+
+    while ((p = strstr(p, "$O")) != NULL)
+    {
+        for (p += 2 ; *p != '#' && sscanf(p, "%2x", &byte) == 1 ; p += 2)
+        {
+            assert ( length < sizeof(output) - 1 );
+            output[length++] = (char)byte;
+        }
+    }
+    output[length] = '\0';
+
+    return output;
+}
+
 void platformMock_CommSetInterruptBit(int setValue)
 {
     g_commInterruptBit = setValue;
@@ -435,6 +512,11 @@ PlatformInstructionType __mriPlatform_TypeOfCurrentInstruction(void)
     return g_instructionType;
 }
 
+uint32_t __mriPlatform_GetProgramCounter(void)
+{
+    return g_programCounter;
+}
+
 void __mriPlatform_AdvanceProgramCounterToNextInstruction(void)
 {
     g_advanceProgramCounterToNextInstruction++;
@@ -452,16 +534,55 @@ int __mriPlatform_WasProgramCounterModifiedByUser(void)
     return FALSE;
 }
 
+static int g_refuseResumeCalls;
+
+void platformMock_RefuseResumeCalls(int callCount)
+{
+    g_refuseResumeCalls = callCount;
+}
+
+int __mriPlatform_CanResume(void)
+{
+    if (g_refuseResumeCalls == 0)
+        return TRUE;
+    g_refuseResumeCalls--;
+    return FALSE;
+}
+
 
 
 // Single Stepping stubs called by MRI core.
-static int g_singleStepping;
+static int      g_singleStepping;
+static uint32_t g_blockStepEndAddress;
+static int      g_blockStepCalls;
 
 void __mriPlatform_EnableSingleStep(void)
 {
     g_singleStepping = TRUE;
 }
 
+void __mriPlatform_EnableBlockStep(uint32_t endAddress)
+{
+    g_blockStepCalls++;
+    g_blockStepEndAddress = endAddress;
+    g_singleStepping = TRUE;
+}
+
+int platformMock_GetBlockStepCalls(void)
+{
+    return g_blockStepCalls;
+}
+
+uint32_t platformMock_GetBlockStepEndAddress(void)
+{
+    return g_blockStepEndAddress;
+}
+
+void __mriPlatform_DisableSingleStep(void)
+{
+    g_singleStepping = FALSE;
+}
+
 int __mriPlatform_IsSingleStepping(void)
 {
     return g_singleStepping;
@@ -489,6 +610,55 @@ int __mriPlatform_WasMemoryFaultEncountered(void)
 
 
 
+// Register Read Instrumentation.
+static uint32_t g_registers[PLATFORMMOCK_REGISTER_COUNT];
+
+void platformMock_SetRegister(uint32_t registerNumber, uint32_t value)
+{
+    g_registers[registerNumber] = value;
+}
+
+// Stub called by MRI core.
+__throws uint32_t __mriPlatform_ReadRegister(uint32_t registerNumber)
+{
+    if (registerNumber >= PLATFORMMOCK_REGISTER_COUNT)
+        __throw_and_return(invalidIndexException, 0);
+    return g_registers[registerNumber];
+}
+
+// Stub called by MRI core.
+uint32_t __mriPlatform_GetLinkRegister(void)
+{
+    return g_registers[14];
+}
+
+
+
+// Cycle Counter Instrumentation.
+static uint32_t g_cycleCount;
+static uint32_t g_cycleCountIncrement;
+
+void platformMock_SetCycleCount(uint32_t cycleCount)
+{
+    g_cycleCount = cycleCount;
+}
+
+void platformMock_SetCycleCountIncrement(uint32_t increment)
+{
+    g_cycleCountIncrement = increment;
+}
+
+// Stub called by MRI core.
+uint32_t __mriPlatform_GetCycleCount(void)
+{
+    uint32_t cycleCount = g_cycleCount;
+
+    g_cycleCount += g_cycleCountIncrement;
+    return cycleCount;
+}
+
+
+
 // Context Related Instrumentation.
 static uint32_t g_context[4];
 
@@ -524,6 +694,7 @@ int                    g_clearHardwareBreakpointCalls;
 uint32_t               g_clearHardwareBreakpointAddressArg;
 uint32_t               g_clearHardwareBreakpointKindArg;
 uint32_t               g_clearHardwareBreakpointException;
+int                    g_syncInstructionCacheCalls;
 int                    g_setHardwareWatchpointCalls;
 uint32_t               g_setHardwareWatchpointAddressArg;
 uint32_t               g_setHardwareWatchpointSizeArg;
@@ -575,6 +746,11 @@ void platformMock_ClearHardwareBreakpointException(uint32_t exceptionToThrow)
     g_clearHardwareBreakpointException = exceptionToThrow;    
 }
 
+int platformMock_SyncInstructionCacheCalls(void)
+{
+    return g_syncInstructionCacheCalls;
+}
+
 int platformMock_SetHardwareWatchpointCalls(void)
 {
     return g_setHardwareWatchpointCalls;
@@ -635,6 +811,21 @@ __throws void  __mriPlatform_SetHardwareBreakpoint(uint32_t address, uint32_t ki
         __throw(g_setHardwareBreakpointException);
 }
 
+__throws uint32_t __mriPlatform_GetSoftwareBreakpointMachineCode(uint32_t kind)
+{
+    /* Kind 4 stands in for platforms, like RISC-V, which need a full 32-bit breakpoint instruction. */
+    if (kind == 4)
+        return 0x00100073;
+    if (kind != 2 && kind != 3)
+        __throw_and_return(invalidArgumentException, 0);
+    return 0xbe00;
+}
+
+void __mriPlatform_SyncInstructionCache(void)
+{
+    g_syncInstructionCacheCalls++;
+}
+
 __throws void  __mriPlatform_ClearHardwareBreakpoint(uint32_t address, uint32_t kind)
 {
     g_clearHardwareBreakpointCalls++;
@@ -666,6 +857,71 @@ __throws void  __mriPlatform_ClearHardwareWatchpoint(uint32_t address, uint32_t
 
 
 
+// Value watchpoint test instrumentation.
+static int      g_setHardwareValueWatchpointCalls;
+static uint32_t g_setHardwareValueWatchpointValueArg;
+static int      g_setHardwareValueWatchpointException;
+static int      g_clearHardwareValueWatchpointCalls;
+
+int platformMock_SetHardwareValueWatchpointCalls(void)
+{
+    return g_setHardwareValueWatchpointCalls;
+}
+
+uint32_t platformMock_SetHardwareValueWatchpointValueArg(void)
+{
+    return g_setHardwareValueWatchpointValueArg;
+}
+
+void platformMock_SetHardwareValueWatchpointException(uint32_t exceptionToThrow)
+{
+    g_setHardwareValueWatchpointException = exceptionToThrow;
+}
+
+int platformMock_ClearHardwareValueWatchpointCalls(void)
+{
+    return g_clearHardwareValueWatchpointCalls;
+}
+
+// Stubs called by MRI core.
+__throws void __mriPlatform_SetHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    g_setHardwareValueWatchpointCalls++;
+    g_setHardwareValueWatchpointValueArg = value;
+    if (g_setHardwareValueWatchpointException)
+        __throw(g_setHardwareValueWatchpointException);
+}
+
+__throws void __mriPlatform_ClearHardwareValueWatchpoint(uint32_t address, uint32_t size, uint32_t value)
+{
+    g_clearHardwareValueWatchpointCalls++;
+}
+
+
+
+// Watchpoint hit test instrumentation.
+static int      g_isWatchpointHit;
+static uint32_t g_watchpointHitAddress;
+
+void platformMock_SetWatchpointHit(uint32_t address)
+{
+    g_isWatchpointHit = TRUE;
+    g_watchpointHitAddress = address;
+}
+
+void platformMock_ClearWatchpointHit(void)
+{
+    g_isWatchpointHit = FALSE;
+}
+
+// Stub called by MRI core.
+int __mriPlatform_WasWatchpointHit(uint32_t address)
+{
+    return g_isWatchpointHit && address == g_watchpointHitAddress;
+}
+
+
+
 // Query memory map and feature XML test instrumentation.
 static char g_deviceMemoryMapXml[] = "TEST";
 static char g_targetXml[] = "test!";
@@ -693,6 +949,29 @@ const char*  __mriPlatform_GetTargetXml(void)
 
 
 
+// Memory region table test instrumentation.
+static const PlatformMemoryRegion* g_pMemoryRegions;
+static uint32_t                    g_memoryRegionCount;
+
+void platformMock_SetDeviceMemoryRegions(const PlatformMemoryRegion* pRegions, uint32_t regionCount)
+{
+    g_pMemoryRegions = pRegions;
+    g_memoryRegionCount = regionCount;
+}
+
+// Stubs called by MRI core.
+uint32_t __mriPlatform_GetDeviceMemoryRegionCount(void)
+{
+    return g_memoryRegionCount;
+}
+
+const PlatformMemoryRegion* __mriPlatform_GetDeviceMemoryRegions(void)
+{
+    return g_pMemoryRegions;
+}
+
+
+
 // Semihost Test Instrumentation.
 static int g_semihostCallReturnValue;
 static int g_semihostCallErrno;
@@ -741,7 +1020,13 @@ void platformMock_Init(void)
     g_setProgramCounterCalls = 0;
     g_programCounter = INITIAL_PC;
     g_singleStepping = FALSE;
+    g_blockStepEndAddress = 0;
+    g_blockStepCalls = 0;
     g_callToFail = 0;
+    g_refuseResumeCalls = 0;
+    memset(&g_registers, 0, sizeof(g_registers));
+    g_cycleCount = 0;
+    g_cycleCountIncrement = 0;
     memset(&g_context, 0xff, sizeof(g_context));
     g_setHardwareBreakpointCalls = 0;
     g_setHardwareBreakpointAddressArg = 0;
@@ -751,6 +1036,7 @@ void platformMock_Init(void)
     g_clearHardwareBreakpointAddressArg = 0;
     g_clearHardwareBreakpointKindArg = 0;
     g_clearHardwareBreakpointException = noException;
+    g_syncInstructionCacheCalls = 0;
     g_setHardwareWatchpointCalls = 0;
     g_setHardwareWatchpointAddressArg = 0;
     g_setHardwareWatchpointSizeArg = 0;
@@ -761,15 +1047,26 @@ void platformMock_Init(void)
     g_clearHardwareWatchpointSizeArg = 0;
     g_clearHardwareWatchpointTypeArg = MRI_PLATFORM_WRITE_WATCHPOINT;
     g_clearHardwareWatchpointException = noException;
+    g_setHardwareValueWatchpointCalls = 0;
+    g_setHardwareValueWatchpointValueArg = 0;
+    g_setHardwareValueWatchpointException = noException;
+    g_clearHardwareValueWatchpointCalls = 0;
+    g_isWatchpointHit = FALSE;
+    g_watchpointHitAddress = 0;
     g_semihostCallReturnValue = 0;
+    g_pMemoryRegions = NULL;
+    g_memoryRegionCount = 0;
 }
 
 void platformMock_Uninit(void)
 {
-    free(g_pAlloc1);
-    free(g_pAlloc2);
-    g_pAlloc1 = NULL;
-    g_pAlloc2 = NULL;
+    size_t i;
+
+    for (i = 0 ; i < ARRAY_SIZE(g_pAllocs) ; i++)
+    {
+        free(g_pAllocs[i]);
+        g_pAllocs[i] = NULL;
+    }
     commUninitTransmitDataBuffer();
 }
 
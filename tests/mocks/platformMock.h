@@ -25,8 +25,13 @@ void        platformMock_Uninit(void);
 
 void        platformMock_CommInitReceiveData(const char* pDataToReceive1, const char* pDataToReceive2 = NULL);
 void        platformMock_CommInitReceiveChecksummedData(const char* pDataToReceive1, const char* pDataToReceive2 = NULL);
+void        platformMock_CommInitReceiveChecksummedDataSequence(const char* const* ppDataToReceive, size_t count);
 void        platformMock_CommInitTransmitDataBuffer(size_t Size);
+const char* platformMock_CommGetTransmittedData(void);
 int         platformMock_CommDoesTransmittedDataEqual(const char* thisString);
+const char* platformMock_CommBuildMonitorCommandPacket(const char* pCommand);
+void        platformMock_CommInitReceiveMonitorCommand(const char* pCommand, int consoleOutputPackets);
+const char* platformMock_CommGetConsoleOutput(void);
 void        platformMock_CommSetInterruptBit(int setValue);
 void        platformMock_CommSetShouldWaitForGdbConnect(int setValue);
 void        platformMock_CommSetIsWaitingForGdbToConnectIterations(int iterations);
@@ -52,9 +57,19 @@ void        platformMock_SetTypeOfCurrentInstruction(PlatformInstructionType set
 int         platformMock_AdvanceProgramCounterToNextInstructionCalls(void);
 int         platformMock_SetProgramCounterCalls(void);
 uint32_t    platformMock_GetProgramCounterValue(void);
+void        platformMock_RefuseResumeCalls(int callCount);
+
+int         platformMock_GetBlockStepCalls(void);
+uint32_t    platformMock_GetBlockStepEndAddress(void);
 
 void        platformMock_FaultOnSpecificMemoryCall(int callToFail);
 
+#define PLATFORMMOCK_REGISTER_COUNT 16
+void        platformMock_SetRegister(uint32_t registerNumber, uint32_t value);
+
+void        platformMock_SetCycleCount(uint32_t cycleCount);
+void        platformMock_SetCycleCountIncrement(uint32_t increment);
+
 uint32_t*   platformMock_GetContext(void);
 
 int         platformMock_SetHardwareBreakpointCalls(void);
@@ -67,6 +82,8 @@ uint32_t    platformMock_ClearHardwareBreakpointAddressArg(void);
 uint32_t    platformMock_ClearHardwareBreakpointKindArg(void);
 void        platformMock_ClearHardwareBreakpointException(uint32_t exceptionToThrow);
 
+int         platformMock_SyncInstructionCacheCalls(void);
+
 int                    platformMock_SetHardwareWatchpointCalls(void);
 uint32_t               platformMock_SetHardwareWatchpointAddressArg(void);
 uint32_t               platformMock_SetHardwareWatchpointSizeArg(void);
@@ -79,6 +96,16 @@ uint32_t               platformMock_ClearHardwareWatchpointSizeArg(void);
 PlatformWatchpointType platformMock_ClearHardwareWatchpointTypeArg(void);
 void                   platformMock_ClearHardwareWatchpointException(uint32_t exceptionToThrow);
 
+int         platformMock_SetHardwareValueWatchpointCalls(void);
+uint32_t    platformMock_SetHardwareValueWatchpointValueArg(void);
+void        platformMock_SetHardwareValueWatchpointException(uint32_t exceptionToThrow);
+int         platformMock_ClearHardwareValueWatchpointCalls(void);
+
+void        platformMock_SetWatchpointHit(uint32_t address);
+void        platformMock_ClearWatchpointHit(void);
+
+void        platformMock_SetDeviceMemoryRegions(const PlatformMemoryRegion* pRegions, uint32_t regionCount);
+
 int platformMock_GetSemihostCallReturnValue(void);
 int platformMock_GetSemihostCallErrno(void);
 
@@ -0,0 +1,524 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+extern "C"
+{
+#include <try_catch.h>
+#include <agent.h>
+}
+#include <platformMock.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+TEST_GROUP(Agent)
+{
+    uint8_t m_bytecode[64];
+    size_t  m_length;
+    
+    void setup()
+    {
+        platformMock_Init();
+        m_length = 0;
+    }
+
+    void teardown()
+    {
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+    
+    void emit(uint8_t byte)
+    {
+        m_bytecode[m_length++] = byte;
+    }
+    
+    void emit16(uint16_t value)
+    {
+        emit(value >> 8);
+        emit(value & 0xFF);
+    }
+    
+    void emitConst32(uint32_t value)
+    {
+        emit(0x24);
+        emit16(value >> 16);
+        emit16(value & 0xFFFF);
+    }
+    
+    uint64_t evaluate(const uint8_t* pBytecode, size_t length)
+    {
+        return EvaluateAgentExpression(pBytecode, length);
+    }
+    
+    uint64_t evaluateEmitted(void)
+    {
+        return evaluate(m_bytecode, m_length);
+    }
+    
+    void validateResult(uint64_t expected, const uint8_t* pBytecode, size_t length)
+    {
+        uint64_t result = evaluate(pBytecode, length);
+        LONGS_EQUAL ( noException, getExceptionCode() );
+        CHECK_TRUE ( expected == result );
+    }
+    
+    void validateException(int expectedException, const uint8_t* pBytecode, size_t length)
+    {
+        evaluate(pBytecode, length);
+        LONGS_EQUAL ( expectedException, getExceptionCode() );
+        clearExceptionCode();
+    }
+};
+
+/* Opcodes used in the tests below. */
+#define ADD             0x02
+#define SUB             0x03
+#define MUL             0x04
+#define DIV_SIGNED      0x05
+#define DIV_UNSIGNED    0x06
+#define REM_SIGNED      0x07
+#define REM_UNSIGNED    0x08
+#define LSH             0x09
+#define RSH_SIGNED      0x0a
+#define RSH_UNSIGNED    0x0b
+#define TRACE           0x0c
+#define LOG_NOT         0x0e
+#define BIT_AND         0x0f
+#define BIT_OR          0x10
+#define BIT_XOR         0x11
+#define BIT_NOT         0x12
+#define EQUAL           0x13
+#define LESS_SIGNED     0x14
+#define LESS_UNSIGNED   0x15
+#define EXT             0x16
+#define REF8            0x17
+#define REF16           0x18
+#define REF32           0x19
+#define REF64           0x1a
+#define REF_FLOAT       0x1b
+#define IF_GOTO         0x20
+#define GOTO            0x21
+#define CONST8          0x22
+#define CONST16         0x23
+#define CONST32         0x24
+#define CONST64         0x25
+#define REG             0x26
+#define END             0x27
+#define DUP             0x28
+#define POP             0x29
+#define ZERO_EXT        0x2a
+#define SWAP            0x2b
+#define GETV            0x2c
+#define PICK            0x32
+#define ROT             0x33
+#define PRINTF          0x34
+
+#define MINUS_ONE       CONST8, 0x00, CONST8, 0x01, SUB
+
+TEST(Agent, Const8AndEnd_ShouldReturnConstant)
+{
+    static const uint8_t bytecode[] = { CONST8, 0x81, END };
+    validateResult(0x81, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Const16_ShouldBeBigEndian)
+{
+    static const uint8_t bytecode[] = { CONST16, 0x12, 0x34, END };
+    validateResult(0x1234, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Const32_ShouldBeBigEndian)
+{
+    static const uint8_t bytecode[] = { CONST32, 0x12, 0x34, 0x56, 0x78, END };
+    validateResult(0x12345678, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Const64_ShouldBeBigEndian)
+{
+    static const uint8_t bytecode[] = { CONST64, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, END };
+    validateResult(0x0123456789abcdefULL, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Add)
+{
+    static const uint8_t bytecode[] = { CONST8, 2, CONST8, 3, ADD, END };
+    validateResult(5, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Sub_ShouldSubtractTopFromNextAndWrap)
+{
+    static const uint8_t bytecode[] = { CONST8, 2, CONST8, 3, SUB, END };
+    validateResult(~0ULL, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Mul)
+{
+    static const uint8_t bytecode[] = { CONST8, 6, CONST8, 7, MUL, END };
+    validateResult(42, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, DivSigned)
+{
+    static const uint8_t bytecode[] = { CONST8, 0, CONST8, 7, SUB, CONST8, 2, DIV_SIGNED, END };
+    validateResult((uint64_t)-3LL, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, DivSigned_ByMinusOne_ShouldNegate)
+{
+    static const uint8_t bytecode[] = { CONST8, 7, MINUS_ONE, DIV_SIGNED, END };
+    validateResult((uint64_t)-7LL, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, DivUnsigned)
+{
+    static const uint8_t bytecode[] = { CONST8, 0, CONST8, 7, SUB, CONST8, 2, DIV_UNSIGNED, END };
+    validateResult(0x7FFFFFFFFFFFFFFCULL, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, RemSigned)
+{
+    static const uint8_t bytecode[] = { CONST8, 0, CONST8, 7, SUB, CONST8, 2, REM_SIGNED, END };
+    validateResult((uint64_t)-1LL, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, RemUnsigned)
+{
+    static const uint8_t bytecode[] = { CONST8, 7, CONST8, 4, REM_UNSIGNED, END };
+    validateResult(3, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, DivideByZero_ShouldThrow)
+{
+    static const uint8_t divSigned[] = { CONST8, 7, CONST8, 0, DIV_SIGNED, END };
+    static const uint8_t divUnsigned[] = { CONST8, 7, CONST8, 0, DIV_UNSIGNED, END };
+    static const uint8_t remSigned[] = { CONST8, 7, CONST8, 0, REM_SIGNED, END };
+    static const uint8_t remUnsigned[] = { CONST8, 7, CONST8, 0, REM_UNSIGNED, END };
+    validateException(invalidArgumentException, divSigned, sizeof(divSigned));
+    validateException(invalidArgumentException, divUnsigned, sizeof(divUnsigned));
+    validateException(invalidArgumentException, remSigned, sizeof(remSigned));
+    validateException(invalidArgumentException, remUnsigned, sizeof(remUnsigned));
+}
+
+TEST(Agent, Lsh)
+{
+    static const uint8_t bytecode[] = { CONST8, 3, CONST8, 4, LSH, END };
+    validateResult(0x30, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Lsh_By64OrMore_ShouldReturnZero)
+{
+    static const uint8_t bytecode[] = { CONST8, 3, CONST8, 64, LSH, END };
+    validateResult(0, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, RshSigned_ShouldExtendSignBit)
+{
+    static const uint8_t negative[] = { CONST8, 0, CONST8, 0x40, SUB, CONST8, 4, RSH_SIGNED, END };
+    static const uint8_t positive[] = { CONST8, 0x40, CONST8, 4, RSH_SIGNED, END };
+    static const uint8_t tooFar[] = { CONST8, 0, CONST8, 0x40, SUB, CONST8, 70, RSH_SIGNED, END };
+    validateResult((uint64_t)-4LL, negative, sizeof(negative));
+    validateResult(4, positive, sizeof(positive));
+    validateResult(~0ULL, tooFar, sizeof(tooFar));
+}
+
+TEST(Agent, RshUnsigned_ShouldShiftInZeroes)
+{
+    static const uint8_t bytecode[] = { CONST8, 0, CONST8, 0x40, SUB, CONST8, 60, RSH_UNSIGNED, END };
+    validateResult(0xF, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, LogNot)
+{
+    static const uint8_t ofZero[] = { CONST8, 0, LOG_NOT, END };
+    static const uint8_t ofNonZero[] = { CONST8, 0x80, LOG_NOT, END };
+    validateResult(1, ofZero, sizeof(ofZero));
+    validateResult(0, ofNonZero, sizeof(ofNonZero));
+}
+
+TEST(Agent, BitwiseOperations)
+{
+    static const uint8_t bitAnd[] = { CONST8, 0xF0, CONST8, 0x3C, BIT_AND, END };
+    static const uint8_t bitOr[] = { CONST8, 0xF0, CONST8, 0x3C, BIT_OR, END };
+    static const uint8_t bitXor[] = { CONST8, 0xF0, CONST8, 0x3C, BIT_XOR, END };
+    static const uint8_t bitNot[] = { CONST8, 0xF0, BIT_NOT, END };
+    validateResult(0x30, bitAnd, sizeof(bitAnd));
+    validateResult(0xFC, bitOr, sizeof(bitOr));
+    validateResult(0xCC, bitXor, sizeof(bitXor));
+    validateResult(~0xF0ULL, bitNot, sizeof(bitNot));
+}
+
+TEST(Agent, Equal)
+{
+    static const uint8_t same[] = { CONST8, 5, CONST16, 0, 5, EQUAL, END };
+    static const uint8_t different[] = { CONST8, 5, CONST8, 6, EQUAL, END };
+    validateResult(1, same, sizeof(same));
+    validateResult(0, different, sizeof(different));
+}
+
+TEST(Agent, LessSigned_ShouldTreatMinusOneAsLessThanZero)
+{
+    static const uint8_t bytecode[] = { MINUS_ONE, CONST8, 0, LESS_SIGNED, END };
+    validateResult(1, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, LessUnsigned_ShouldTreatMinusOneAsLargest)
+{
+    static const uint8_t bytecode[] = { MINUS_ONE, CONST8, 0, LESS_UNSIGNED, END };
+    validateResult(0, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Ext_ShouldSignExtendFromSpecifiedBit)
+{
+    static const uint8_t negative[] = { CONST8, 0x80, EXT, 8, END };
+    static const uint8_t positive[] = { CONST16, 0x01, 0x7F, EXT, 8, END };
+    static const uint8_t noop[] = { CONST8, 0x80, EXT, 64, END };
+    validateResult((uint64_t)-128LL, negative, sizeof(negative));
+    validateResult(0x7F, positive, sizeof(positive));
+    validateResult(0x80, noop, sizeof(noop));
+}
+
+TEST(Agent, ZeroExt_ShouldClearUpperBits)
+{
+    static const uint8_t bytecode[] = { MINUS_ONE, ZERO_EXT, 16, END };
+    validateResult(0xFFFF, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Reg_ShouldReadRegisterFromPlatform)
+{
+    static const uint8_t bytecode[] = { REG, 0x00, 0x0F, END };
+    platformMock_SetRegister(15, 0x12345678);
+    validateResult(0x12345678, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Reg_InvalidRegister_ShouldThrow)
+{
+    static const uint8_t bytecode[] = { REG, 0x01, 0x00, END };
+    validateException(invalidIndexException, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, RefOpcodes_ShouldReadLittleEndianMemory)
+{
+    uint8_t  memory[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    uint64_t aligned[1];
+    memcpy(aligned, memory, sizeof(aligned));
+    static const uint8_t refOps[] = { REF8, REF16, REF32, REF64 };
+    static const uint64_t expected[] = { 0x01, 0x2301, 0x67452301, 0xefcdab8967452301ULL };
+
+    for (size_t i = 0 ; i < sizeof(refOps) ; i++)
+    {
+        m_length = 0;
+        emitConst32((uint32_t)(size_t)aligned);
+        emit(refOps[i]);
+        emit(END);
+        uint64_t result = evaluateEmitted();
+        LONGS_EQUAL ( noException, getExceptionCode() );
+        CHECK_TRUE ( expected[i] == result );
+    }
+}
+
+TEST(Agent, RefOpcodes_Unaligned_ShouldReadLittleEndianMemory)
+{
+    uint8_t  memory[12] = { 0x00, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0x00, 0x00, 0x00 };
+    static const uint8_t refOps[] = { REF16, REF32, REF64 };
+    static const uint64_t expected[] = { 0x2301, 0x67452301, 0xefcdab8967452301ULL };
+    uint8_t* pUnaligned = ((size_t)memory & 1) ? memory : memory + 1;
+    if (pUnaligned != memory + 1)
+        memmove(memory, memory + 1, 9);
+
+    for (size_t i = 0 ; i < sizeof(refOps) ; i++)
+    {
+        m_length = 0;
+        emitConst32((uint32_t)(size_t)pUnaligned);
+        emit(refOps[i]);
+        emit(END);
+        uint64_t result = evaluateEmitted();
+        LONGS_EQUAL ( noException, getExceptionCode() );
+        CHECK_TRUE ( expected[i] == result );
+    }
+}
+
+TEST(Agent, Ref_MemoryFault_ShouldThrow)
+{
+    uint32_t memory = 0x12345678;
+    emitConst32((uint32_t)(size_t)&memory);
+    emit(REF32);
+    emit(END);
+    platformMock_FaultOnSpecificMemoryCall(1);
+    evaluateEmitted();
+    LONGS_EQUAL ( memFaultException, getExceptionCode() );
+}
+
+TEST(Agent, Ref_UnmappedMemory_ShouldThrow)
+{
+    uint32_t             memory = 0x12345678;
+    PlatformMemoryRegion region = { (uint32_t)(size_t)&memory + 4, 4, MRI_PLATFORM_MEMORY_RAM };
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    emitConst32((uint32_t)(size_t)&memory);
+    emit(REF32);
+    emit(END);
+    evaluateEmitted();
+    LONGS_EQUAL ( memFaultException, getExceptionCode() );
+}
+
+TEST(Agent, IfGoto_NonZero_ShouldBranch)
+{
+    static const uint8_t bytecode[] = { CONST8, 1, IF_GOTO, 0x00, 0x08, CONST8, 1, END, CONST8, 2, END };
+    validateResult(2, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, IfGoto_Zero_ShouldFallThrough)
+{
+    static const uint8_t bytecode[] = { CONST8, 0, IF_GOTO, 0x00, 0x08, CONST8, 1, END, CONST8, 2, END };
+    validateResult(1, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Goto_ShouldBranch)
+{
+    static const uint8_t bytecode[] = { GOTO, 0x00, 0x06, CONST8, 1, END, CONST8, 3, END };
+    validateResult(3, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Goto_OutOfRange_ShouldThrow)
+{
+    static const uint8_t bytecode[] = { GOTO, 0x00, 0x04, END };
+    validateException(invalidArgumentException, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Goto_InfiniteLoop_ShouldThrowOnceOpcodeLimitIsReached)
+{
+    static const uint8_t bytecode[] = { GOTO, 0x00, 0x00 };
+    validateException(invalidArgumentException, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Dup)
+{
+    static const uint8_t bytecode[] = { CONST8, 4, DUP, MUL, END };
+    validateResult(16, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Pop)
+{
+    static const uint8_t bytecode[] = { CONST8, 4, CONST8, 5, POP, END };
+    validateResult(4, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Swap)
+{
+    static const uint8_t bytecode[] = { CONST8, 4, CONST8, 5, SWAP, SUB, END };
+    validateResult(1, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Pick)
+{
+    static const uint8_t pick0[] = { CONST8, 1, CONST8, 2, CONST8, 3, PICK, 0, END };
+    static const uint8_t pick2[] = { CONST8, 1, CONST8, 2, CONST8, 3, PICK, 2, END };
+    validateResult(3, pick0, sizeof(pick0));
+    validateResult(1, pick2, sizeof(pick2));
+}
+
+TEST(Agent, Pick_BeyondBottomOfStack_ShouldThrow)
+{
+    static const uint8_t bytecode[] = { CONST8, 1, PICK, 1, END };
+    validateException(invalidArgumentException, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, Rot_ShouldMoveTopBelowNextTwo)
+{
+    /* a b c => c a b */
+    static const uint8_t top[] = { CONST8, 1, CONST8, 2, CONST8, 3, ROT, END };
+    static const uint8_t middle[] = { CONST8, 1, CONST8, 2, CONST8, 3, ROT, POP, END };
+    static const uint8_t bottom[] = { CONST8, 1, CONST8, 2, CONST8, 3, ROT, POP, POP, END };
+    validateResult(2, top, sizeof(top));
+    validateResult(1, middle, sizeof(middle));
+    validateResult(3, bottom, sizeof(bottom));
+}
+
+TEST(Agent, StackUnderflow_ShouldThrow)
+{
+    static const uint8_t binary[] = { CONST8, 1, ADD, END };
+    static const uint8_t unary[] = { LOG_NOT, END };
+    static const uint8_t pop[] = { POP, END };
+    static const uint8_t end[] = { END };
+    static const uint8_t rot[] = { CONST8, 1, CONST8, 2, ROT, END };
+    validateException(invalidArgumentException, binary, sizeof(binary));
+    validateException(invalidArgumentException, unary, sizeof(unary));
+    validateException(invalidArgumentException, pop, sizeof(pop));
+    validateException(invalidArgumentException, end, sizeof(end));
+    validateException(invalidArgumentException, rot, sizeof(rot));
+}
+
+TEST(Agent, StackOverflow_ShouldThrow)
+{
+    for (int i = 0 ; i <= MRI_AGENT_STACK_SIZE ; i++)
+    {
+        emit(CONST8);
+        emit(i);
+    }
+    emit(END);
+    evaluateEmitted();
+    LONGS_EQUAL ( invalidArgumentException, getExceptionCode() );
+}
+
+TEST(Agent, FullStack_ShouldSucceed)
+{
+    for (int i = 0 ; i < MRI_AGENT_STACK_SIZE ; i++)
+    {
+        emit(CONST8);
+        emit(i);
+    }
+    emit(END);
+    uint64_t result = evaluateEmitted();
+    LONGS_EQUAL ( noException, getExceptionCode() );
+    CHECK_TRUE ( (uint64_t)(MRI_AGENT_STACK_SIZE - 1) == result );
+}
+
+TEST(Agent, TruncatedOperand_ShouldThrow)
+{
+    static const uint8_t bytecode[] = { CONST32, 0x12, 0x34 };
+    validateException(invalidArgumentException, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, MissingEnd_ShouldThrow)
+{
+    static const uint8_t bytecode[] = { CONST8, 1 };
+    validateException(invalidArgumentException, bytecode, sizeof(bytecode));
+}
+
+TEST(Agent, UnsupportedOpcodes_ShouldThrow)
+{
+    static const uint8_t invalid[] = { 0x00, END };
+    static const uint8_t refFloat[] = { CONST8, 0, REF_FLOAT, END };
+    static const uint8_t trace[] = { CONST8, 0, CONST8, 4, TRACE, END };
+    static const uint8_t getv[] = { GETV, 0x00, 0x01, END };
+    static const uint8_t printfOp[] = { PRINTF, END };
+    static const uint8_t beyondLast[] = { 0x35, END };
+    validateException(invalidArgumentException, invalid, sizeof(invalid));
+    validateException(invalidArgumentException, refFloat, sizeof(refFloat));
+    validateException(invalidArgumentException, trace, sizeof(trace));
+    validateException(invalidArgumentException, getv, sizeof(getv));
+    validateException(invalidArgumentException, printfOp, sizeof(printfOp));
+    validateException(invalidArgumentException, beyondLast, sizeof(beyondLast));
+}
+
+TEST(Agent, ConditionAsGeneratedByGdb_RegisterEqualsConstant)
+{
+    /* gdb's "cond 1 $r3 == 5" */
+    static const uint8_t bytecode[] = { REG, 0x00, 0x03, CONST8, 5, EQUAL, END };
+    platformMock_SetRegister(3, 5);
+    validateResult(1, bytecode, sizeof(bytecode));
+    platformMock_SetRegister(3, 4);
+    validateResult(0, bytecode, sizeof(bytecode));
+}
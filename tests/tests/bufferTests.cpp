@@ -594,6 +594,49 @@ TEST(Buffer, Buffer_ReadUIntegerAsHex_12345678comma)
     validateNoException();
 }
 
+TEST(Buffer, Buffer_ReadUIntegerAsHex_64BitValueKeepsLower32Bits)
+{
+    static const char testString[] = "fffffffffffffff8";
+    uint32_t          value = 0;
+    
+    allocateBuffer(testString);
+    __try
+        value = Buffer_ReadUIntegerAsHex(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    LONGS_EQUAL( 0xfffffff8, value );
+    validateDepletedBufferNoOverrun();
+}
+
+TEST(Buffer, Buffer_ReadUInteger64AsHex_123456789abcdef0comma)
+{
+    static const char testString[] = "123456789abcdef0,";
+    uint64_t          value = 0;
+    
+    allocateBuffer(testString);
+    __try
+        value = Buffer_ReadUInteger64AsHex(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    CHECK( value == 0x123456789abcdef0ULL );
+    LONGS_EQUAL( 1, Buffer_BytesLeft(&m_buffer) );
+    validateNoException();
+}
+
+TEST(Buffer, Buffer_ReadUInteger64AsHex_Empty)
+{
+    static const char testString[] = "";
+    uint64_t          value = ~0ULL;
+    
+    allocateBuffer(testString);
+    __try
+        value = Buffer_ReadUInteger64AsHex(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    CHECK( value == 0 );
+    validateInvalidValueException();
+}
+
 TEST(Buffer, Buffer_WriteUIntegerAsHex_0)
 {
     static const char expectedString[] = "00";
@@ -1071,3 +1114,150 @@ TEST(Buffer, Buffer_MatchesString_NoMatch)
     LONGS_EQUAL( strlen(testString), Buffer_BytesLeft(&m_buffer) );
     validateNoException();
 }
+
+TEST(Buffer, Buffer_MatchesString_MatchFollowedByColon)
+{
+    static const char   testString[] = "StringMatch:";
+    static const char   compareString[] = "StringMatch";
+    
+    allocateBuffer(testString);
+    CHECK_TRUE( Buffer_MatchesString(&m_buffer, compareString, sizeof(compareString)-1) );
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, ':') );
+    validateDepletedBufferNoOverrun();
+}
+
+TEST(Buffer, Buffer_MatchesString_NoMatchWhenFollowedByOtherSeparator)
+{
+    static const char   testString[] = "StringMatch,";
+    static const char   compareString[] = "StringMatch";
+    
+    allocateBuffer(testString);
+    CHECK_FALSE( Buffer_MatchesString(&m_buffer, compareString, sizeof(compareString)-1) );
+    LONGS_EQUAL( strlen(testString), Buffer_BytesLeft(&m_buffer) );
+    validateNoException();
+}
+
+TEST(Buffer, Buffer_MatchesStringFollowedBy_MatchFollowedBySeparatorOrEndOfBuffer)
+{
+    static const char   testString[] = "Match Match";
+    static const char   compareString[] = "Match";
+    
+    allocateBuffer(testString);
+    CHECK_TRUE( Buffer_MatchesStringFollowedBy(&m_buffer, compareString, sizeof(compareString)-1, ' ') );
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, ' ') );
+    CHECK_TRUE( Buffer_MatchesStringFollowedBy(&m_buffer, compareString, sizeof(compareString)-1, ' ') );
+    validateDepletedBufferNoOverrun();
+}
+
+TEST(Buffer, Buffer_MatchesStringFollowedBy_NoMatchWhenFollowedByOtherChar)
+{
+    static const char   testString[] = "StringMatch:";
+    static const char   compareString[] = "StringMatch";
+    
+    allocateBuffer(testString);
+    CHECK_FALSE( Buffer_MatchesStringFollowedBy(&m_buffer, compareString, sizeof(compareString)-1, ',') );
+    LONGS_EQUAL( strlen(testString), Buffer_BytesLeft(&m_buffer) );
+    validateNoException();
+}
+
+TEST(Buffer, Buffer_DecodeHexInPlace_DecodeRemainderOfBuffer)
+{
+    static const char   testString[] = "q,48656c6c6f";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, 'q') );
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, ',') );
+    __try
+        Buffer_DecodeHexInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateNoException();
+    LONGS_EQUAL( 5, Buffer_BytesLeft(&m_buffer) );
+    CHECK_TRUE( 0 == memcmp("q,Hello", m_pCharacterArray, 7) );
+    CHECK_TRUE( Buffer_MatchesString(&m_buffer, "Hello", 5) );
+}
+
+TEST(Buffer, Buffer_DecodeHexInPlace_EmptyRemainder)
+{
+    static const char   testString[] = "q";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, 'q') );
+    __try
+        Buffer_DecodeHexInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateDepletedBufferNoOverrun();
+}
+
+TEST(Buffer, Buffer_DecodeHexInPlace_InvalidHexDigit)
+{
+    static const char   testString[] = "48g5";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    __try
+        Buffer_DecodeHexInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateInvalidHexDigitException();
+}
+
+TEST(Buffer, Buffer_DecodeHexInPlace_OddNumberOfHexDigits)
+{
+    static const char   testString[] = "486";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    __try
+        Buffer_DecodeHexInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateBufferOverrunException();
+}
+
+TEST(Buffer, Buffer_UnescapeBinaryInPlace_UnescapeRemainderOfBuffer)
+{
+    static const char   testString[] = "q:a}\x03}]}\x04z";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, 'q') );
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, ':') );
+    __try
+        Buffer_UnescapeBinaryInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateNoException();
+    LONGS_EQUAL( 5, Buffer_BytesLeft(&m_buffer) );
+    CHECK_TRUE( 0 == memcmp("q:a#}$z", m_pCharacterArray, 7) );
+}
+
+TEST(Buffer, Buffer_UnescapeBinaryInPlace_EmptyRemainder)
+{
+    static const char   testString[] = "q";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    CHECK_TRUE( Buffer_IsNextCharEqualTo(&m_buffer, 'q') );
+    __try
+        Buffer_UnescapeBinaryInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateDepletedBufferNoOverrun();
+}
+
+TEST(Buffer, Buffer_UnescapeBinaryInPlace_TrailingEscapeCharacter)
+{
+    static const char   testString[] = "ab}";
+    
+    m_validateBufferLimits = 0;
+    allocateBuffer(testString);
+    __try
+        Buffer_UnescapeBinaryInPlace(&m_buffer);
+    __catch
+        m_exceptionThrown = 1;
+    validateBufferOverrunException();
+}
@@ -17,10 +17,15 @@ extern "C"
 {
 #include <try_catch.h>
 #include <mri.h>
+#include <breakpoints.h>
+#include <conditions.h>
+#include <platforms.h>
 
 void __mriDebugException(void);
 }
 #include <platformMock.h>
+#include <stdio.h>
+#include <string.h>
 
 // Include C++ headers for test harness.
 #include "CppUTest/TestHarness.h"
@@ -225,4 +230,522 @@ TEST(cmdBreakWatch, InvalidClearHardwareBreakWatchpoint_ShouldReturnEmptyRespons
     CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$#00+") );
     CHECK_EQUAL( 0, platformMock_ClearHardwareBreakpointCalls() );
     CHECK_EQUAL( 0, platformMock_ClearHardwareWatchpointCalls() );
-}
\ No newline at end of file
+}
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_InRam_ShouldOnlyInsertWhileRunning)
+{
+    uint16_t             code[2] = { 0x1234, 0x5678 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)&code[1]);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 0, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x1234, code[0] );
+    CHECK_EQUAL( 0xbe00, code[1] );
+    CHECK_EQUAL( 1, platformMock_SyncInstructionCacheCalls() );
+
+    platformMock_CommInitReceiveChecksummedData("+$?#", "+$s#");
+        __mriDebugException();
+    CHECK_EQUAL( 0x5678, code[1] );
+    CHECK_EQUAL( 2, platformMock_SyncInstructionCacheCalls() );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_SingleStep_ShouldNotInsert)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,3#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$s#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 0x1234, code[0] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_32BitMachineCode_ShouldReplaceWholeInstruction)
+{
+    uint16_t             code[3] = { 0x1234, 0x5678, 0x9abc };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,4#", (uint32_t)(size_t)&code[1]);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 0x1234, code[0] );
+    CHECK_EQUAL( 0x0073, code[1] );
+    CHECK_EQUAL( 0x0010, code[2] );
+
+    platformMock_CommInitReceiveChecksummedData("+$?#", "+$s#");
+        __mriDebugException();
+    CHECK_EQUAL( 0x5678, code[1] );
+    CHECK_EQUAL( 0x9abc, code[2] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_32BitMachineCodeAtEndOfRam_ShouldFallBackToHardwareBreakpoint)
+{
+    uint16_t             code[2] = { 0x1234, 0x5678 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,4#", (uint32_t)(size_t)&code[1]);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 1, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x5678, code[1] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_SameAddressTwice_ShouldStillRestoreOriginalInstruction)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    for (int i = 0 ; i < 2 ; i++)
+    {
+        platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+            __mriDebugException();
+        CHECK_EQUAL( 0xbe00, code[0] );
+    }
+    platformMock_CommInitReceiveChecksummedData("+$?#", "+$s#");
+        __mriDebugException();
+    CHECK_EQUAL( 0x1234, code[0] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_OverwrittenByProgram_ShouldNotRestoreOriginalInstruction)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_EQUAL( 0xbe00, code[0] );
+
+    code[0] = 0x4444;
+    platformMock_CommInitReceiveChecksummedData("+$?#", "+$s#");
+        __mriDebugException();
+    CHECK_EQUAL( 0x4444, code[0] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_LiveRead_ShouldSeeOriginalInstruction)
+{
+    uint16_t             code[2] = { 0x1234, 0x5678 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)&code[1]);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_EQUAL( 0xbe00, code[1] );
+
+    snprintf(packet, sizeof(packet), "$m%08x,4#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a++$34127856#a4") );
+    CHECK_EQUAL( 0xbe00, code[1] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_LiveWrite_ShouldBecomeOriginalInstruction)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+
+    snprintf(packet, sizeof(packet), "$M%08x,2:4444#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a++$OK#9a") );
+    CHECK_EQUAL( 0xbe00, code[0] );
+
+    platformMock_CommInitReceiveChecksummedData("+$?#", "+$s#");
+        __mriDebugException();
+    CHECK_EQUAL( 0x4444, code[0] );
+}
+
+TEST(cmdBreakWatch, LiveRead_WhileSingleStepping_ShouldReturnErrorResponse)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    platformMock_CommInitReceiveChecksummedData("+$s#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+
+    snprintf(packet, sizeof(packet), "$m%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c++$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8") );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_InFlash_ShouldFallBackToHardwareBreakpoint)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_FLASH };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 1, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( (uint32_t)(size_t)code, platformMock_SetHardwareBreakpointAddressArg() );
+    CHECK_EQUAL( 2, platformMock_SetHardwareBreakpointKindArg() );
+    CHECK_EQUAL( 0x1234, code[0] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_RamWhichFaultsOnWrite_ShouldFallBackToHardwareBreakpoint)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 1, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x1234, code[0] );
+}
+
+TEST(cmdBreakWatch, InsertSoftwareBreakpoint_FaultsOnResume_ShouldSkipItAndTellGdbAtNextStop)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    char                 expected[80];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_EQUAL( 0xbe00, code[0] );
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_FaultOnSpecificMemoryCall(1);
+        __mriDebugException();
+    CHECK_EQUAL( 0x1234, code[0] );
+
+    /* The failed breakpoint wasn't inserted so the program's own change must be left alone at the next stop. */
+    code[0] = 0xbe00;
+    platformMock_CommInitReceiveChecksummedData("+", "+$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+        __mriDebugException();
+    snprintf(expected, sizeof(expected), "Couldn't insert breakpoint at 0x%x.\n", (uint32_t)(size_t)code);
+    STRCMP_EQUAL ( expected, platformMock_CommGetConsoleOutput() );
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$T05responseT#7c+") != NULL );
+    CHECK_EQUAL( 0xbe00, code[0] );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_TableFull_ShouldFallBackToHardwareAndOnlyFailWhenItIsFullToo)
+{
+    uint16_t             code[MRI_SOFTWARE_BREAKPOINT_COUNT + 2];
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    for (size_t i = 0 ; i < MRI_SOFTWARE_BREAKPOINT_COUNT + 1 ; i++)
+    {
+        snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)&code[i]);
+        platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        platformMock_CommInitTransmitDataBuffer(128);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    }
+    CHECK_EQUAL( 1, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( (uint32_t)(size_t)&code[MRI_SOFTWARE_BREAKPOINT_COUNT], platformMock_SetHardwareBreakpointAddressArg() );
+
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)&code[MRI_SOFTWARE_BREAKPOINT_COUNT + 1]);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    platformMock_SetHardwareBreakpointException(exceededHardwareResourcesException);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpoint_InvalidKind_ShouldReturnErrorResponse)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,5#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_EQUAL( 0, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x1234, code[0] );
+}
+
+TEST(cmdBreakWatch, RemoveSoftwareBreakpoint_ShouldNotTouchHardwareOrReinsert)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+
+    snprintf(packet, sizeof(packet), "+$z0,%08x,2#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 0, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x1234, code[0] );
+}
+
+TEST(cmdBreakWatch, RemoveSoftwareBreakpoint_NotInTable_ShouldClearHardwareBreakpoint)
+{
+    platformMock_CommInitReceiveChecksummedData("+$z0,12345678,2#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 1, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x12345678, platformMock_ClearHardwareBreakpointAddressArg() );
+    CHECK_EQUAL( 2, platformMock_ClearHardwareBreakpointKindArg() );
+}
+
+/* Agent expression for "$r3 == 5": reg 3, const8 5, equal, end */
+#define R3_EQUALS_5 "X7,26000322051327"
+/* Agent expression for "*(uint32_t*)%08x == 0": const32 %08x, ref32, const8 0, equal, end */
+#define DEREF_EQUALS_0 "Xa,24%08x1922001327"
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_False_ShouldResumeSilentlyAndStepOverBreakpoint)
+{
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 1, platformMock_SetHardwareBreakpointCalls() );
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    CHECK_EQUAL( 1, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( INITIAL_PC, platformMock_ClearHardwareBreakpointAddressArg() );
+    CHECK_EQUAL( 2, platformMock_ClearHardwareBreakpointKindArg() );
+
+    Platform_SetProgramCounter(INITIAL_PC + 2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_EQUAL( 2, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( INITIAL_PC, platformMock_SetHardwareBreakpointAddressArg() );
+    CHECK_EQUAL( 2, platformMock_SetHardwareBreakpointKindArg() );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_True_ShouldStop)
+{
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+
+    platformMock_SetRegister(3, 5);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+    CHECK_EQUAL( 0, platformMock_ClearHardwareBreakpointCalls() );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_AtDifferentAddress_ShouldStop)
+{
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000002,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithMultipleConditions_ShouldStopIfAnyAreTrue)
+{
+    /* gdb doesn't place a ';' between the conditions in the list. */
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;X3,220027" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+
+    Platform_SetProgramCounter(INITIAL_PC + 2);
+        __mriDebugException();
+    Platform_DisableSingleStep();
+    Platform_SetProgramCounter(INITIAL_PC);
+    platformMock_SetRegister(3, 5);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_MemoryFault_ShouldStop)
+{
+    uint32_t value = 1;
+    char     packet[64];
+    snprintf(packet, sizeof(packet), "+$Z1,10000000,2;" DEREF_EQUALS_0 "#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+
+    platformMock_FaultOnSpecificMemoryCall(1);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    LONGS_EQUAL ( noException, getExceptionCode() );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_ResentWithoutCondition_ShouldBecomeUnconditional)
+{
+    /* Keep the condition true while gdb is still talking to the stub at this breakpoint. */
+    platformMock_SetRegister(3, 5);
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2#", "+$c#");
+        __mriDebugException();
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(cmdBreakWatch, RemoveHardwareBreakpointWithCondition_ShouldDiscardCondition)
+{
+    /* Keep the condition true while gdb is still talking to the stub at this breakpoint. */
+    platformMock_SetRegister(3, 5);
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("+$z1,10000000,2#", "+$c#");
+        __mriDebugException();
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(cmdBreakWatch, RemoveHardwareBreakpointWithCondition_ShouldKeepConditionOfSoftwareBreakpointAtSameAddress)
+{
+    /* The Z0 falls back to a hardware breakpoint since INITIAL_PC isn't in RAM.  Its condition is only true when r3 is 5
+       while the condition on the Z1, "0", is never true. */
+    platformMock_SetRegister(3, 5);
+    platformMock_CommInitReceiveChecksummedData("+$Z0,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;X3,220027#", "+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("+$z1,10000000,2#", "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+}
+
+TEST(cmdBreakWatch, SetHardwareAndSoftwareBreakpointsWithConditions_AtSameAddress_ShouldStopIfEitherIsTrue)
+{
+    platformMock_SetRegister(3, 5);
+    platformMock_CommInitReceiveChecksummedData("+$Z0,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;X3,220027#", "+$c#");
+        __mriDebugException();
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_Malformed_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;X7,260003#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_EQUAL( 0, platformMock_SetHardwareBreakpointCalls() );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_ConditionTableFull_ShouldReturnErrorResponse)
+{
+    char packet[64];
+    platformMock_SetRegister(3, 5);
+    for (uint32_t i = 0 ; i < MRI_CONDITIONAL_BREAKPOINT_COUNT ; i++)
+    {
+        snprintf(packet, sizeof(packet), "+$Z1,%08x,2;" R3_EQUALS_5 "#", INITIAL_PC + 2 * i);
+        platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        platformMock_CommInitTransmitDataBuffer(128);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    }
+
+    snprintf(packet, sizeof(packet), "+$Z1,%08x,2;" R3_EQUALS_5 "#", INITIAL_PC + 2 * MRI_CONDITIONAL_BREAKPOINT_COUNT);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+    CHECK_EQUAL( MRI_CONDITIONAL_BREAKPOINT_COUNT, platformMock_SetHardwareBreakpointCalls() );
+}
+
+TEST(cmdBreakWatch, SetHardwareBreakpointWithCondition_HardwareFull_ShouldDiscardCondition)
+{
+    platformMock_SetHardwareBreakpointException(exceededHardwareResourcesException);
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;" R3_EQUALS_5 "#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(cmdBreakWatch, SetSoftwareBreakpointWithCondition_False_ShouldStepOverWithoutTouchingHardware)
+{
+    uint16_t             code[1] = { 0x1234 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)code, sizeof(code), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$Z0,%08x,2;" R3_EQUALS_5 "#", (uint32_t)(size_t)code);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL( 0xbe00, code[0] );
+
+    Platform_SetProgramCounter((uint32_t)(size_t)code);
+    platformMock_SetRegister(3, 4);
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    CHECK_EQUAL( 0x1234, code[0] );
+
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_EQUAL( 0, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0, platformMock_SetHardwareBreakpointCalls() );
+}
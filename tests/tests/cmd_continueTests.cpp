@@ -115,3 +115,83 @@ TEST(cmdContinue, SetSignalCommandWithMissingAddressAfterSemicolon)
     CHECK_EQUAL( 0, platformMock_AdvanceProgramCounterToNextInstructionCalls() );
     CHECK_EQUAL( INITIAL_PC, platformMock_GetProgramCounterValue() );
 }
+
+TEST(cmdContinue, Detach_ShouldRespondWithOKAndResume)
+{
+    platformMock_CommInitReceiveChecksummedData("+$D#", "+");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a") );
+    CHECK_EQUAL( 0, platformMock_AdvanceProgramCounterToNextInstructionCalls() );
+    CHECK_EQUAL( INITIAL_PC, platformMock_GetProgramCounterValue() );
+}
+
+TEST(cmdContinue, Detach_SkipOverHardcodedBreakpoints)
+{
+    platformMock_SetTypeOfCurrentInstruction(MRI_PLATFORM_INSTRUCTION_HARDCODED_BREAKPOINT);
+    platformMock_CommInitReceiveChecksummedData("+$D#", "+");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a") );
+    CHECK_EQUAL( 1, platformMock_AdvanceProgramCounterToNextInstructionCalls() );
+    CHECK_EQUAL( INITIAL_PC + 4, platformMock_GetProgramCounterValue() );
+}
+
+TEST(cmdContinue, Kill_ShouldResumeWithoutResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$k#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 0, platformMock_AdvanceProgramCounterToNextInstructionCalls() );
+    CHECK_EQUAL( INITIAL_PC, platformMock_GetProgramCounterValue() );
+}
+
+#define CANT_RESUME_RESPONSE "$O43616e277420726573756d652066726f6d20746869732073746f702c20726573657420746865207461726765742e0a#11" \
+                             "$" MRI_ERROR_CANT_RESUME "#ab"
+
+TEST(cmdContinue, CantResume_ShouldReturnErrorAndStayHalted)
+{
+    platformMock_SetTypeOfCurrentInstruction(MRI_PLATFORM_INSTRUCTION_HARDCODED_BREAKPOINT);
+    platformMock_RefuseResumeCalls(2);
+    platformMock_CommInitReceiveChecksummedData("+$c#", "++$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" CANT_RESUME_RESPONSE "+") );
+    // Only the second continue, made once the stop could be resumed, skips the hardcoded breakpoint.
+    CHECK_EQUAL( 1, platformMock_AdvanceProgramCounterToNextInstructionCalls() );
+}
+
+TEST(cmdContinue, CantResume_SetSignalShouldReturnError)
+{
+    platformMock_RefuseResumeCalls(2);
+    platformMock_CommInitReceiveChecksummedData("+$C0b;f00d#", "++$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" CANT_RESUME_RESPONSE "+") );
+    CHECK_EQUAL( INITIAL_PC, platformMock_GetProgramCounterValue() );
+}
+
+TEST(cmdContinue, CantResume_StepShouldReturnError)
+{
+    platformMock_RefuseResumeCalls(2);
+    platformMock_CommInitReceiveChecksummedData("+$s#", "++$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" CANT_RESUME_RESPONSE "+") );
+}
+
+TEST(cmdContinue, CantResume_DetachShouldReturnError)
+{
+    platformMock_RefuseResumeCalls(2);
+    platformMock_CommInitReceiveChecksummedData("+$D#", "++$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" CANT_RESUME_RESPONSE "+") );
+}
+
+TEST(cmdContinue, CantResume_KillShouldStayHaltedWithoutResponse)
+{
+    platformMock_RefuseResumeCalls(2);
+    platformMock_CommInitReceiveChecksummedData("+$k#", "$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c++") );
+}
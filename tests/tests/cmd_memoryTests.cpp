@@ -493,3 +493,190 @@ TEST(cmdMemory, BinaryMemoryWrite8_BufferTooSmallForEscapedByte_ReturnErrorRespo
     CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_BUFFER_OVERRUN "#a9+") );
     CHECK_EQUAL ( 0xFF, value );
 }
+
+TEST(cmdMemory, MemoryRead_RamRegion_ShouldOnlyCheckForFaultOnceAtEnd)
+{
+    uint8_t              value[7] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$m%08x,7#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$01020304050607#bc+") );
+}
+
+TEST(cmdMemory, MemoryRead_FlashRegion_FaultShouldReturnNoBytes)
+{
+    uint8_t              value[3] = { 0x01, 0x02, 0x03 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_FLASH };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$m%08x,3#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+}
+
+TEST(cmdMemory, MemoryRead_PeripheralRegion_ShouldCheckForFaultAfterEachAccess)
+{
+    uint8_t              value[3] = { 0x01, 0x02, 0x03 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_PERIPHERAL };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$m%08x,3#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(3);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$0102#c3+") );
+}
+
+TEST(cmdMemory, MemoryRead_RangeRunsOffEndOfRamRegion_ShouldCheckForFaultAfterEachAccess)
+{
+    uint8_t              value[3] = { 0x01, 0x02, 0x03 };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value) - 1, MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$m%08x,3#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(3);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$0102#c3+") );
+}
+
+TEST(cmdMemory, MemoryRead_UnmappedRegion_ShouldReturnErrorWithoutAccessingMemory)
+{
+    uint32_t             value = 0x12345678;
+    PlatformMemoryRegion region = { (uint32_t)((size_t)&value + sizeof(value)), 4, MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$m%08x,4#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+}
+
+TEST(cmdMemory, MemoryWrite_RamRegionUnaligned_ShouldWriteAllBytes)
+{
+    uint8_t              value[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$M%08x,6:010203040506#", (uint32_t)(size_t)value + 1);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL ( 0xFF, value[0] );
+    CHECK_EQUAL ( 0x01, value[1] );
+    CHECK_EQUAL ( 0x02, value[2] );
+    CHECK_EQUAL ( 0x03, value[3] );
+    CHECK_EQUAL ( 0x04, value[4] );
+    CHECK_EQUAL ( 0x05, value[5] );
+    CHECK_EQUAL ( 0x06, value[6] );
+    CHECK_EQUAL ( 0xFF, value[7] );
+}
+
+TEST(cmdMemory, MemoryWrite_RamRegionWithFault_ShouldReturnError)
+{
+    uint32_t             value = 0xFFFFFFFF;
+    PlatformMemoryRegion region = { (uint32_t)(size_t)&value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$M%08x,4:78563412#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+}
+
+TEST(cmdMemory, MemoryWrite_RamRegionTooFewBytesInPacket_ShouldReturnBufferOverrunError)
+{
+    uint32_t             value = 0xFFFFFFFF;
+    PlatformMemoryRegion region = { (uint32_t)(size_t)&value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$M%08x,4:785634#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_BUFFER_OVERRUN "#a9+") );
+    CHECK_EQUAL ( 0xFFFFFFFF, value );
+}
+
+TEST(cmdMemory, MemoryWrite_UnmappedRegion_ShouldReturnErrorAndNotModifyMemory)
+{
+    uint32_t             value = 0xFFFFFFFF;
+    PlatformMemoryRegion region = { (uint32_t)((size_t)&value + sizeof(value)), 4, MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$M%08x,4:78563412#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+    CHECK_EQUAL ( 0xFFFFFFFF, value );
+}
+
+TEST(cmdMemory, BinaryMemoryWrite_RamRegion_ShouldWriteAllBytes)
+{
+    uint8_t              value[5] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$X%08x,5:ABC}%cE#", (uint32_t)(size_t)value, '}' ^ 0x20);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL ( 'A', value[0] );
+    CHECK_EQUAL ( 'B', value[1] );
+    CHECK_EQUAL ( 'C', value[2] );
+    CHECK_EQUAL ( '}', value[3] );
+    CHECK_EQUAL ( 'E', value[4] );
+}
+
+TEST(cmdMemory, BinaryMemoryWrite_UnmappedRegion_ShouldReturnErrorAndNotModifyMemory)
+{
+    uint8_t              value = 0xFF;
+    PlatformMemoryRegion region = { (uint32_t)((size_t)&value + 1), 4, MRI_PLATFORM_MEMORY_FLASH };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$X%08x,1:A#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+    CHECK_EQUAL ( 0xFF, value );
+}
+
+#define TEST_DEVICE_MEMORY(FLASH, ROM, RAM, PERIPHERAL) \
+    FLASH(0x0, 0x10000, 0x1000) \
+    ROM(0x1FFF0000, 0x2000) \
+    RAM(0x20000000, 0x8000) \
+    PERIPHERAL(0x40000000, 0x20000000)
+
+TEST(cmdMemory, DeviceMemoryList_ShouldBuildMatchingMemoryMapXmlAndRegionTable)
+{
+    static const char                 memoryMapXml[] = MRI_MEMORY_MAP_XML(TEST_DEVICE_MEMORY);
+    static const PlatformMemoryRegion regions[] = MRI_MEMORY_REGIONS(TEST_DEVICE_MEMORY);
+
+    STRCMP_EQUAL ( "<?xml version=\"1.0\"?>"
+                   "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" \"http://sourceware.org/gdb/gdb-memory-map.dtd\">"
+                   "<memory-map>"
+                   "<memory type=\"flash\" start=\"0x0\" length=\"0x10000\"> <property name=\"blocksize\">0x1000</property></memory>"
+                   "<memory type=\"rom\" start=\"0x1FFF0000\" length=\"0x2000\"> </memory>"
+                   "<memory type=\"ram\" start=\"0x20000000\" length=\"0x8000\"> </memory>"
+                   "<memory type=\"ram\" start=\"0x40000000\" length=\"0x20000000\"> </memory>"
+                   "</memory-map>", memoryMapXml );
+    CHECK_EQUAL ( 4, sizeof(regions) / sizeof(regions[0]) );
+    CHECK_EQUAL ( 0x00000000, regions[0].start );
+    CHECK_EQUAL ( 0x10000, regions[0].length );
+    CHECK_EQUAL ( MRI_PLATFORM_MEMORY_FLASH, regions[0].type );
+    CHECK_EQUAL ( 0x1FFF0000, regions[1].start );
+    CHECK_EQUAL ( 0x2000, regions[1].length );
+    CHECK_EQUAL ( MRI_PLATFORM_MEMORY_FLASH, regions[1].type );
+    CHECK_EQUAL ( 0x20000000, regions[2].start );
+    CHECK_EQUAL ( 0x8000, regions[2].length );
+    CHECK_EQUAL ( MRI_PLATFORM_MEMORY_RAM, regions[2].type );
+    CHECK_EQUAL ( 0x40000000, regions[3].start );
+    CHECK_EQUAL ( 0x20000000, regions[3].length );
+    CHECK_EQUAL ( MRI_PLATFORM_MEMORY_PERIPHERAL, regions[3].type );
+}
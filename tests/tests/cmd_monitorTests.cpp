@@ -0,0 +1,476 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <compress.h>
+#include <dump.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+#include <stdio.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+#define ARRAY_SIZE(X) (sizeof(X)/sizeof(X[0]))
+
+static int g_staticAddressReference;
+
+TEST_GROUP(cmdMonitor)
+{
+    int     m_expectedException;
+    
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+    
+    void validateExceptionCode(int expectedExceptionCode)
+    {
+        m_expectedException = expectedExceptionCode;
+        LONGS_EQUAL ( expectedExceptionCode, getExceptionCode() );
+    }
+    
+    const char* findTransmittedPacket(const char* pPrefix, int occurrence = 1)
+    {
+        const char* p = platformMock_CommGetTransmittedData();
+        
+        while (p && occurrence-- > 0)
+        {
+            p = strstr(p, pPrefix);
+            if (p && occurrence > 0)
+                p++;
+        }
+        CHECK_TRUE ( p != NULL );
+        return p ? p + strlen(pPrefix) : "";
+    }
+    
+    int doesTransmittedDataEndWith(const char* pSuffix)
+    {
+        const char* pData = platformMock_CommGetTransmittedData();
+        size_t      dataLength = strlen(pData);
+        size_t      suffixLength = strlen(pSuffix);
+        
+        return dataLength >= suffixLength && 0 == strcmp(pData + dataLength - suffixLength, pSuffix);
+    }
+    
+    const uint8_t* pointerFromTargetAddress(uint32_t address)
+    {
+        // Dump buffers are statically allocated in mri so borrow upper 32-bits from a static of our own on 64-bit.
+        return (const uint8_t*)((size_t)address | ((size_t)&g_staticAddressReference & ~(size_t)0xFFFFFFFF));
+    }
+};
+
+TEST(cmdMonitor, UnknownMonitorCommand_ShouldReturnEmptyResponse)
+{
+    platformMock_CommInitReceiveMonitorCommand("bogus 1 2", 0);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$#00+") );
+}
+
+TEST(cmdMonitor, MonitorCommandWithoutComma_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qRcmd#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, MonitorCommandWithInvalidHexText_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qRcmd,66696g6c#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, Fill_WordAligned)
+{
+    uint32_t value[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+    char     command[64];
+    snprintf(command, sizeof(command), "fill %08x 8 deadbeef", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveMonitorCommand(command, 5);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O46696c6c656420#91$O30783038#ef$O206f6620#1b$O30783038#ef"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0xDEADBEEF, value[0] );
+    CHECK_EQUAL ( 0xDEADBEEF, value[1] );
+    CHECK_EQUAL ( 0xFFFFFFFF, value[2] );
+}
+
+TEST(cmdMonitor, Fill_UnalignedStartAndEndWithHexPrefixesAndExtraSpaces)
+{
+    uint8_t  value[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    char     command[64];
+    snprintf(command, sizeof(command), "fill  0x%08x 0x6  0x11223344 ", (uint32_t)(size_t)value + 1);
+    platformMock_CommInitReceiveMonitorCommand(command, 5);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O46696c6c656420#91$O30783036#ed$O206f6620#1b$O30783036#ed"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0xFF, value[0] );
+    CHECK_EQUAL ( 0x33, value[1] );
+    CHECK_EQUAL ( 0x22, value[2] );
+    CHECK_EQUAL ( 0x11, value[3] );
+    CHECK_EQUAL ( 0x44, value[4] );
+    CHECK_EQUAL ( 0x33, value[5] );
+    CHECK_EQUAL ( 0x22, value[6] );
+    CHECK_EQUAL ( 0xFF, value[7] );
+}
+
+TEST(cmdMonitor, Fill_FaultOnSecondWord_ShouldReportFaultAndBytesFilled)
+{
+    uint32_t value[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
+    char     command[64];
+    snprintf(command, sizeof(command), "fill %08x 8 deadbeef", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveMonitorCommand(command, 6);
+    platformMock_FaultOnSpecificMemoryCall(2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O4d656d6f7279206661756c7420656e636f756e74657265642e20#87"
+                                                           "$O46696c6c656420#91$O30783034#eb$O206f6620#1b$O30783038#ef"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0xDEADBEEF, value[0] );
+}
+
+TEST(cmdMonitor, Fill_UnmappedRegion_ShouldReportFaultWithoutWriting)
+{
+    uint32_t             value = 0xFFFFFFFF;
+    PlatformMemoryRegion region = { (uint32_t)((size_t)&value + sizeof(value)), 4, MRI_PLATFORM_MEMORY_RAM };
+    char                 command[64];
+    snprintf(command, sizeof(command), "fill %08x 4 deadbeef", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveMonitorCommand(command, 6);
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O4d656d6f7279206661756c7420656e636f756e74657265642e20#87"
+                                                           "$O46696c6c656420#91$O30783030#e7$O206f6620#1b$O30783034#eb"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0xFFFFFFFF, value );
+}
+
+TEST(cmdMonitor, Fill_RamRegion_ShouldOnlyCheckForFaultOnceAtEnd)
+{
+    uint32_t             value[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 command[64];
+    snprintf(command, sizeof(command), "fill %08x 8 deadbeef", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveMonitorCommand(command, 5);
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O46696c6c656420#91$O30783038#ef$O206f6620#1b$O30783038#ef"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0xDEADBEEF, value[0] );
+    CHECK_EQUAL ( 0xDEADBEEF, value[1] );
+}
+
+TEST(cmdMonitor, Fill_TooFewArguments_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveMonitorCommand("fill 1234 4", 0);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, Fill_TooManyArguments_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveMonitorCommand("fill 1234 4 0 0", 0);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, Fill_InvalidHexArgument_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveMonitorCommand("fill 12g4 4 0", 0);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, Copy_WordAlignedNonOverlapping)
+{
+    uint32_t src[2] = { 0x12345678, 0x9ABCDEF0 };
+    uint32_t dest[3] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+    char     command[64];
+    snprintf(command, sizeof(command), "copy %08x %08x 8", (uint32_t)(size_t)dest, (uint32_t)(size_t)src);
+    platformMock_CommInitReceiveMonitorCommand(command, 5);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O436f7069656420#5f$O30783038#ef$O206f6620#1b$O30783038#ef"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0x12345678, dest[0] );
+    CHECK_EQUAL ( 0x9ABCDEF0, dest[1] );
+    CHECK_EQUAL ( 0xFFFFFFFF, dest[2] );
+}
+
+TEST(cmdMonitor, Copy_OverlappingWithDestinationAfterSource)
+{
+    char     buffer[] = "abcdefgh";
+    char     command[64];
+    snprintf(command, sizeof(command), "copy %08x %08x 6", (uint32_t)(size_t)buffer + 1, (uint32_t)(size_t)buffer);
+    platformMock_CommInitReceiveMonitorCommand(command, 5);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O436f7069656420#5f$O30783036#ed$O206f6620#1b$O30783036#ed"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    STRCMP_EQUAL ( "aabcdefh", buffer );
+}
+
+TEST(cmdMonitor, Copy_OverlappingWithDestinationBeforeSource)
+{
+    char     buffer[] = "abcdefgh";
+    char     command[64];
+    snprintf(command, sizeof(command), "copy %08x %08x 6", (uint32_t)(size_t)buffer, (uint32_t)(size_t)buffer + 2);
+    platformMock_CommInitReceiveMonitorCommand(command, 5);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O436f7069656420#5f$O30783036#ed$O206f6620#1b$O30783036#ed"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    STRCMP_EQUAL ( "cdefghgh", buffer );
+}
+
+TEST(cmdMonitor, Copy_FaultOnSecondRead_ShouldReportFaultAndBytesCopied)
+{
+    uint8_t  src[2] = { 0x12, 0x34 };
+    uint8_t  dest[2] = { 0xFF, 0xFF };
+    char     command[64];
+    snprintf(command, sizeof(command), "copy %08x %08x 2", (uint32_t)(size_t)dest, (uint32_t)(size_t)src);
+    platformMock_CommInitReceiveMonitorCommand(command, 6);
+    platformMock_FaultOnSpecificMemoryCall(3);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O4d656d6f7279206661756c7420656e636f756e74657265642e20#87"
+                                                           "$O436f7069656420#5f$O30783031#e8$O206f6620#1b$O30783032#e9"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+    CHECK_EQUAL ( 0x12, dest[0] );
+    CHECK_EQUAL ( 0xFF, dest[1] );
+}
+
+TEST(cmdMonitor, Copy_TooFewArguments_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveMonitorCommand("copy 1234 5678", 0);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, Dump_ShouldWriteCompressedBlockToHostFileWhenResumed)
+{
+    uint8_t  value[16] = { 'a', 'b', 'c', 'd', 'a', 'b', 'c', 'd', 'a', 'b', 'c', 'd', 'a', 'b', 'c', 'd' };
+    uint8_t  decompressed[16];
+    char     command[64];
+    uint32_t filenameAddress, filenameLength, flags, mode;
+    uint32_t bufferAddress, bufferLength;
+    snprintf(command, sizeof(command), "dump %08x 10 dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$c#", "+$F3#", "+$Ff#", "+$F0#", "+++++" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+        __mriDebugException();
+
+    CHECK_EQUAL ( 4, sscanf(findTransmittedPacket("$Fopen,"), "%x/%x,%x,%x#", &filenameAddress, &filenameLength,
+                                                                               &flags, &mode) );
+    CHECK_EQUAL ( 9, filenameLength );
+    STRCMP_EQUAL ( "dump.bin", (const char*)pointerFromTargetAddress(filenameAddress) );
+    CHECK_EQUAL ( 0x601, flags );
+    CHECK_EQUAL ( 0x180, mode );
+
+    CHECK_EQUAL ( 2, sscanf(findTransmittedPacket("$Fwrite,03,"), "%x,%x#", &bufferAddress, &bufferLength) );
+    const uint8_t* pBlock = pointerFromTargetAddress(bufferAddress);
+    CHECK_EQUAL ( 15, bufferLength );
+    CHECK_EQUAL ( 16, pBlock[0] | pBlock[1] << 8 | pBlock[2] << 16 | pBlock[3] << 24 );
+    CHECK_EQUAL ( 7, pBlock[4] | pBlock[5] << 8 | pBlock[6] << 16 | pBlock[7] << 24 );
+    CHECK_TRUE ( DecompressToMemory(decompressed, sizeof(decompressed), 0,
+                                    pBlock + DUMP_FRAME_HEADER_SIZE, bufferLength - DUMP_FRAME_HEADER_SIZE) );
+    CHECK_TRUE ( 0 == memcmp(value, decompressed, sizeof(value)) );
+
+    CHECK_TRUE ( doesTransmittedDataEndWith("$Fclose,03#eb+"
+                                            "$O44756d70656420#5b$O30783130#e8$O206f6620#1b$O30783130#e8"
+                                            "$O2062797465732e0a#f1") );
+}
+
+TEST(cmdMonitor, Dump_MultipleBlocks_ShouldIssueWriteForEachBlock)
+{
+    uint8_t  value[300];
+    uint8_t  decompressed[300];
+    char     command[64];
+    uint32_t bufferAddress, bufferLength;
+    uint32_t seed = 1;
+    for (size_t i = 0 ; i < sizeof(value) ; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        value[i] = (uint8_t)(seed >> 16);
+    }
+    snprintf(command, sizeof(command), "dump 0x%08x 0x12c dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$c#", "+$F3#", "+$F108#", "+$F38#", "+$F0#", "+++++" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+        __mriDebugException();
+
+    // Random data doesn't compress so the first block is filled and the second holds what is left over.
+    CHECK_EQUAL ( 2, sscanf(findTransmittedPacket("$Fwrite,03,"), "%x,%x#", &bufferAddress, &bufferLength) );
+    CHECK_EQUAL ( 0x108, bufferLength );
+    CHECK_EQUAL ( 2, sscanf(findTransmittedPacket("$Fwrite,03,", 2), "%x,%x#", &bufferAddress, &bufferLength) );
+    CHECK_EQUAL ( 0x38, bufferLength );
+    const uint8_t* pBlock = pointerFromTargetAddress(bufferAddress);
+    uint32_t       firstBlockLength = sizeof(value) - (pBlock[0] | pBlock[1] << 8 | pBlock[2] << 16 | pBlock[3] << 24);
+    memcpy(decompressed, value, firstBlockLength);
+    CHECK_TRUE ( DecompressToMemory(decompressed + firstBlockLength, sizeof(value) - firstBlockLength, firstBlockLength,
+                                    pBlock + DUMP_FRAME_HEADER_SIZE, bufferLength - DUMP_FRAME_HEADER_SIZE) );
+    CHECK_TRUE ( 0 == memcmp(value, decompressed, sizeof(value)) );
+    CHECK_TRUE ( doesTransmittedDataEndWith("$Fclose,03#eb+"
+                                            "$O44756d70656420#5b$O307830313263#b6$O206f6620#1b$O307830313263#b6"
+                                            "$O2062797465732e0a#f1") );
+}
+
+TEST(cmdMonitor, Dump_HostFailsToOpenFile_ShouldReportErrorWithoutWriting)
+{
+    uint8_t  value[16];
+    char     command[64];
+    snprintf(command, sizeof(command), "dump %08x 10 /bogus/dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$c#", "+$F-1,2#", "++++++" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$Fwrite") == NULL );
+    CHECK_TRUE ( doesTransmittedDataEndWith("$O4661696c656420746f206f70656e20686f73742066696c652e20#4c"
+                                            "$O44756d70656420#5b$O30783030#e7$O206f6620#1b$O30783130#e8"
+                                            "$O2062797465732e0a#f1") );
+}
+
+TEST(cmdMonitor, Dump_MemoryFault_ShouldCloseFileAndReportFault)
+{
+    uint8_t  value[16];
+    char     command[64];
+    snprintf(command, sizeof(command), "dump %08x 10 dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$c#", "+$F3#", "+$F0#", "++++++" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+    platformMock_FaultOnSpecificMemoryCall(1);
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$Fwrite") == NULL );
+    CHECK_TRUE ( doesTransmittedDataEndWith("$Fclose,03#eb+"
+                                            "$O4d656d6f7279206661756c7420656e636f756e74657265642e20#87"
+                                            "$O44756d70656420#5b$O30783030#e7$O206f6620#1b$O30783130#e8"
+                                            "$O2062797465732e0a#f1") );
+}
+
+TEST(cmdMonitor, Dump_ControlCDuringWrite_ShouldAbandonDumpAndStopWithSigInt)
+{
+    uint8_t  value[16];
+    char     command[64];
+    snprintf(command, sizeof(command), "dump %08x 10 dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$c#", "+$F3#", "+$F-1,4,C#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$Fclose") == NULL );
+    CHECK_TRUE ( doesTransmittedDataEndWith("$T02responseT#79+") );
+    CHECK_FALSE ( IsMemoryDumpQueued() );
+}
+
+TEST(cmdMonitor, Dump_DetachBeforeResume_ShouldDropDump)
+{
+    uint8_t  value[16];
+    char     command[64];
+    snprintf(command, sizeof(command), "dump %08x 10 dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$D#", "+" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$Fopen") == NULL );
+    CHECK_TRUE ( doesTransmittedDataEndWith("$OK#9a") );
+    CHECK_FALSE ( IsMemoryDumpQueued() );
+}
+
+TEST(cmdMonitor, Dump_KillBeforeResume_ShouldDropDump)
+{
+    uint8_t  value[16];
+    char     command[64];
+    snprintf(command, sizeof(command), "dump %08x 10 dump.bin", (uint32_t)(size_t)value);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket(command), "++$k#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+    platformMock_CommInitTransmitDataBuffer(1024);
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$Fopen") == NULL );
+    CHECK_FALSE ( IsMemoryDumpQueued() );
+}
+
+TEST(cmdMonitor, Dump_MissingFilename_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveMonitorCommand("dump 1234 10", 0);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdMonitor, Dump_FilenameTooLong_ShouldThrow)
+{
+    char filename[DUMP_MAX_FILENAME_SIZE];
+    memset(filename, 'a', sizeof(filename));
+    QueueMemoryDump(filename, 16, filename, sizeof(filename));
+    validateExceptionCode(invalidArgumentException);
+    CHECK_FALSE ( IsMemoryDumpQueued() );
+}
+
+TEST(cmdMonitor, Expedite_SetRegisters_ShouldSendThemInNextTResponse)
+{
+    platformMock_SetRegister(13, 0x10002000);
+    platformMock_SetRegister(15, 0x00000123);
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket("expedite d 0xf"), "+$?#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+"
+                                                           "$T050d:00200010;0f:23010000;#d6+") );
+}
+
+TEST(cmdMonitor, Expedite_Default_ShouldRestorePlatformRegisters)
+{
+    char defaultPacket[64];
+    strcpy(defaultPacket, platformMock_CommBuildMonitorCommandPacket("expedite default"));
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket("expedite d"), defaultPacket, "+$?#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+$OK#9a+$T05responseT#7c+") );
+}
+
+TEST(cmdMonitor, Expedite_NoArguments_ShouldDisplaySelection)
+{
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket("expedite 7 d"), "+$qRcmd,6578706564697465#", "+++++++$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+"
+                                                           "$O457870656469746564207265676973746572733a#cb"
+                                                           "$O20#b1$O30783037#ee$O20#b1$O30783064#ee$O0a#e0$OK#9a+") );
+}
+
+TEST(cmdMonitor, Expedite_InvalidRegister_ShouldReturnErrorAndKeepPlatformRegisters)
+{
+    const char* packets[] = { platformMock_CommBuildMonitorCommandPacket("expedite d 10"), "+$?#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, ARRAY_SIZE(packets));
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+"
+                                                           "$T05responseT#7c+") );
+}
@@ -17,10 +17,12 @@ extern "C"
 {
 #include <try_catch.h>
 #include <mri.h>
+#include <compress.h>
 
 void __mriDebugException(void);
 }
 #include <platformMock.h>
+#include <stdio.h>
 
 // Include C++ headers for test harness.
 #include "CppUTest/TestHarness.h"
@@ -49,6 +51,31 @@ TEST_GROUP(cmdQuery)
         m_expectedException = expectedExceptionCode;
         LONGS_EQUAL ( expectedExceptionCode, getExceptionCode() );
     }
+    
+    char* writeInflatePacket(char* p, void* pDest, uint32_t length, const uint8_t* pCompressed, uint32_t compressedLength,
+                             uint32_t historyLength = 0)
+    {
+        p += sprintf(p, "+$qMriInflate:%08x,%x", (uint32_t)(size_t)pDest, length);
+        if (historyLength > 0)
+            p += sprintf(p, ",%x", historyLength);
+        *p++ = ':';
+        while (compressedLength-- > 0)
+        {
+            uint8_t byte = *pCompressed++;
+            
+            // Escape the packet framing characters like gdb does and the NUL character for the mock's C strings.
+            if (byte == '#' || byte == '$' || byte == '}' || byte == '*' || byte == '\0')
+            {
+                *p++ = '}';
+                byte ^= 0x20;
+            }
+            *p++ = (char)byte;
+        }
+        *p++ = '#';
+        *p = '\0';
+        
+        return p;
+    }
 };
 
 TEST(cmdQuery, QuerySupported)
@@ -56,7 +83,14 @@ TEST(cmdQuery, QuerySupported)
     platformMock_CommInitReceiveChecksummedData("+$qSupported#", "+$c#");
         __mriDebugException();
     CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c"
-                                                           "+$qXfer:memory-map:read+;qXfer:features:read+;PacketSize=89#fc+") );
+                                                           "+$ConditionalBreakpoints+;ConditionalTracepoints+;BreakpointCommands+;PacketSize=89#0a+") );
+}
+
+TEST(cmdQuery, QuerySupported_ShouldAdvertiseConditionalBreakpoints)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qSupported#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "ConditionalBreakpoints+;") != NULL );
 }
 
 TEST(cmdQuery, QueryUnknown_ShouldReturnEmptyResponse)
@@ -184,3 +218,250 @@ TEST(cmdQuery, QueryXferFeatures_VeryLargeRead)
         __mriDebugException();
     CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$ltest!#4d+") );
 }
+
+TEST(cmdQuery, QueryBlockHash_SingleBlock)
+{
+    uint8_t  value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    char     packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,8,100#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$febb9a46#93+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_LastBlockShorterThanBlockSize_ShouldZeroPadFinalWord)
+{
+    uint8_t  value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    char     packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,a,8#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$febb9a46fc5702e9#c8+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_ThreeBlocks)
+{
+    uint8_t  value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    char     packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,a,4#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$1d55bd611ede6825fc5702e9#95+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_UnalignedStart_ShouldHashSameAsAlignedCopyOfData)
+{
+    uint32_t value[3] = {0x04030201, 0x08070605, 0x00000a09};
+    char     packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,8,8#", (uint32_t)(size_t)value + 1);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$1bb96314#fc+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_RamRegion_ShouldOnlyCheckForFaultOnceAtEnd)
+{
+    uint8_t              value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value, sizeof(value), MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,8,8#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    platformMock_FaultOnSpecificMemoryCall(2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$febb9a46#93+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_MemoryFault_ShouldReturnErrorResponse)
+{
+    uint8_t  value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    char     packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,a,4#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_FaultOnSpecificMemoryCall(2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_UnmappedMemory_ShouldReturnErrorResponse)
+{
+    uint8_t              value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    PlatformMemoryRegion region = { (uint32_t)((size_t)value + sizeof(value)), 4, MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,8,8#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_TooManyBlocksForPacketBuffer_ShouldReturnOverflowResponse)
+{
+    uint8_t  value[64];
+    char     packet[64];
+    memset(value, 0, sizeof(value));
+    snprintf(packet, sizeof(packet), "+$qMriBlockHash:%08x,40,1#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_BUFFER_OVERRUN "#a9+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_ZeroBlockSize_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qMriBlockHash:10000000,8,0#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_ZeroLength_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qMriBlockHash:10000000,0,100#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryBlockHash_MissingBlockSize_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qMriBlockHash:10000000,8#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryInflate_LiteralsOnly)
+{
+    uint8_t  value[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value, 3, (const uint8_t*)"\x30" "abc", 4);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_TRUE ( 0 == memcmp(value, "abc\xFF", 4) );
+}
+
+TEST(cmdQuery, QueryInflate_OverlappingMatchWithEscapedZeroByte)
+{
+    uint8_t  value[17];
+    char     packet[64];
+    memset(value, 0xFF, sizeof(value));
+    writeInflatePacket(packet, value, 16, (const uint8_t*)"\x48" "abcd" "\x04\x00", 7);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_TRUE ( 0 == memcmp(value, "abcdabcdabcdabcd\xFF", 17) );
+}
+
+TEST(cmdQuery, QueryInflate_EscapedFramingCharacters)
+{
+    uint8_t  value[3] = {0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value, 3, (const uint8_t*)"\x30" "#$}", 4);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_TRUE ( 0 == memcmp(value, "#$}", 3) );
+}
+
+TEST(cmdQuery, QueryInflate_BackReferenceToDataFromEarlierPacket)
+{
+    uint8_t  value[12] = {'a', 'b', 'c', 'd', 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value + 4, 8, (const uint8_t*)"\x04" "\x04\x00", 3, 4);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_TRUE ( 0 == memcmp(value, "abcdabcdabcd", 12) );
+}
+
+TEST(cmdQuery, QueryInflate_BackReferenceBeforePacketWithoutHistory_ShouldReturnErrorResponse)
+{
+    uint8_t  value[12] = {'a', 'b', 'c', 'd', 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value + 4, 8, (const uint8_t*)"\x04" "\x04\x00", 3);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_TRUE ( 0 == memcmp(value + 4, "\xFF\xFF\xFF\xFF", 4) );
+}
+
+TEST(cmdQuery, QueryInflate_BackReferenceBeyondHistory_ShouldReturnErrorResponse)
+{
+    uint8_t  value[12] = {'a', 'b', 'c', 'd', 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value + 4, 8, (const uint8_t*)"\x04" "\x04\x00", 3, 3);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryInflate_HistoryInUnmappedMemory_ShouldReturnErrorResponse)
+{
+    uint8_t              value[12] = {'a', 'b', 'c', 'd', 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    PlatformMemoryRegion region = { (uint32_t)(size_t)value + 4, 8, MRI_PLATFORM_MEMORY_RAM };
+    char                 packet[64];
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    writeInflatePacket(packet, value + 4, 8, (const uint8_t*)"\x04" "\x04\x00", 3, 4);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+    CHECK_TRUE ( 0 == memcmp(value + 4, "\xFF\xFF\xFF\xFF", 4) );
+}
+
+TEST(cmdQuery, QueryInflate_RoundTripFromCompressor)
+{
+    static const char text[] = "mri downloads compressed images. ";
+    uint8_t           source[256];
+    uint8_t           value[256];
+    uint8_t           compressed[48];
+    uint32_t          compressedLength;
+    uint32_t          hashTable[1 << 8];
+    CompressState     state;
+    char              packet[128];
+    uint32_t          i;
+    
+    for (i = 0 ; i < sizeof(source) ; i++)
+        source[i] = text[i % (sizeof(text) - 1)];
+    memset(value, 0, sizeof(value));
+    Compress_Init(&state, source, sizeof(source), hashTable, 8);
+    compressedLength = Compress_NextBlock(&state, compressed, sizeof(compressed));
+    LONGS_EQUAL ( sizeof(source), state.srcOffset );
+    writeInflatePacket(packet, value, sizeof(value), compressed, compressedLength);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_TRUE ( 0 == memcmp(value, source, sizeof(source)) );
+}
+
+TEST(cmdQuery, QueryInflate_DecompressedLengthMismatch_ShouldReturnErrorResponse)
+{
+    uint8_t  value[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value, 4, (const uint8_t*)"\x30" "abc", 4);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryInflate_MissingDataSeparator_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qMriInflate:10000000,3#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryInflate_TrailingEscapeCharacter_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qMriInflate:10000000,3:}#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdQuery, QueryInflate_MemoryFault_ShouldReturnErrorResponse)
+{
+    uint8_t  value[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    char     packet[64];
+    writeInflatePacket(packet, value, 3, (const uint8_t*)"\x30" "abc", 4);
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_FaultOnSpecificMemoryCall(1);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8+") );
+}
@@ -0,0 +1,386 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <tracepoints.h>
+#include <platforms.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+/* Agent expression for "$r3 == 5": reg 3, const8 5, equal, end */
+#define R3_EQUALS_5 "X7,26000322051327"
+
+TEST_GROUP(cmdTrace)
+{
+    int     m_expectedException;
+    char    m_packets[8][128];
+
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+
+    void runCommands(const char* pCommand1, const char* pCommand2 = NULL, const char* pCommand3 = NULL,
+                     const char* pCommand4 = NULL, const char* pCommand5 = NULL, const char* pCommand6 = NULL,
+                     const char* pCommand7 = NULL)
+    {
+        const char* commands[] = { pCommand1, pCommand2, pCommand3, pCommand4, pCommand5, pCommand6, pCommand7 };
+        const char* packets[8];
+        size_t      count = 0;
+
+        for (size_t i = 0 ; i < sizeof(commands)/sizeof(commands[0]) && commands[i] ; i++)
+        {
+            snprintf(m_packets[count], sizeof(m_packets[count]), "+$%s#", commands[i]);
+            packets[count] = m_packets[count];
+            count++;
+        }
+        packets[count++] = "+$c#";
+        platformMock_CommInitReceiveChecksummedDataSequence(packets, count);
+        platformMock_CommInitTransmitDataBuffer(1024);
+            __mriDebugException();
+    }
+
+    void hitTracepoint(uint32_t address)
+    {
+        Platform_SetProgramCounter(address);
+        platformMock_CommInitTransmitDataBuffer(128);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+        if (!Platform_IsSingleStepping())
+            return;
+
+        Platform_SetProgramCounter(address + 2);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+        Platform_DisableSingleStep();
+    }
+
+    int wasResponseSent(const char* pResponse)
+    {
+        char            packet[256];
+        unsigned char   checksum = 0;
+
+        for (const char* p = pResponse ; *p ; p++)
+            checksum += (unsigned char)*p;
+        snprintf(packet, sizeof(packet), "+$%s#%02x+", pResponse, checksum);
+        return strstr(platformMock_CommGetTransmittedData(), packet) != NULL;
+    }
+
+    int wasTextSent(const char* pText)
+    {
+        return strstr(platformMock_CommGetTransmittedData(), pText) != NULL;
+    }
+};
+
+TEST(cmdTrace, TraceInit_ShouldReturnOK)
+{
+    runCommands("QTinit");
+    CHECK_TRUE ( wasResponseSent("OK") );
+}
+
+TEST(cmdTrace, UnknownTraceCommand_ShouldReturnEmptyResponse)
+{
+    runCommands("QTfoo", "QTro:1000,2000", "Q");
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$#00+$OK#9a+$#00+") );
+}
+
+TEST(cmdTrace, TraceStatus_BeforeAnyTracing_ShouldReportNotRun)
+{
+    runCommands("qTStatus");
+    CHECK_TRUE ( wasResponseSent("T0;tnotrun:0;tframes:00;tcreated:00;tfree:0800;tsize:0800;circular:0;disconn:0") );
+}
+
+TEST(cmdTrace, DefineTracepoint_Malformed_ShouldReturnErrorResponse)
+{
+    runCommands("QTDP:1:10000000:Q:0:0", "QTDP:1,10000000:E:0:0", "QTDP:-2:10000000:M-1,0,4");
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c"
+                                                           "+$" MRI_ERROR_INVALID_ARGUMENT "#a6"
+                                                           "+$" MRI_ERROR_INVALID_ARGUMENT "#a6"
+                                                           "+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdTrace, DefineTracepoint_WithWhileSteppingActions_ShouldReturnErrorResponse)
+{
+    runCommands("QTDP:1:10000000:E:1:0", "QTDP:2:10000000:E:0:0", "QTDP:-2:10000000:S");
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c"
+                                                           "+$" MRI_ERROR_INVALID_ARGUMENT "#a6"
+                                                           "+$OK#9a"
+                                                           "+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdTrace, DefineTracepoint_TooManyActions_ShouldReturnNoFreeBreakpointError)
+{
+    runCommands("QTDP:1:10000000:E:0:0", "QTDP:-1:10000000:Mffffffff,0,4-", "QTDP:-1:10000000:Mffffffff,4,4-",
+                "QTDP:-1:10000000:Mffffffff,8,4-", "QTDP:-1:10000000:Mffffffff,c,4-",
+                "QTDP:-1:10000000:Mffffffff,10,4");
+    CHECK_TRUE ( wasTextSent("+$OK#9a+$OK#9a+$OK#9a+$OK#9a+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+}
+
+TEST(cmdTrace, StartTracing_ShouldSetBreakpointAtEachTracepoint)
+{
+    runCommands("QTinit", "QTDP:1:10000100:E:0:0", "QTDP:2:10000100:E:0:0", "QTDP:3:10000200:D:0:0", "QTStart",
+                "qTStatus");
+    CHECK_TRUE ( wasTextSent("+$OK#9a+$OK#9a+$OK#9a+$OK#9a+$OK#9a+$T1;tframes:00;") );
+    CHECK_EQUAL( 1, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x10000100, platformMock_SetHardwareBreakpointAddressArg() );
+    CHECK_EQUAL( 2, platformMock_SetHardwareBreakpointKindArg() );
+}
+
+TEST(cmdTrace, StartTracing_NoFreeBreakpoints_ShouldReturnErrorAndNotRun)
+{
+    platformMock_SetHardwareBreakpointException(exceededHardwareResourcesException);
+    runCommands("QTDP:1:10000100:E:0:0", "QTStart", "qTStatus");
+    CHECK_TRUE ( wasTextSent("+$OK#9a+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+$T0;tnotrun:0") );
+}
+
+TEST(cmdTrace, StopTracing_ShouldRemoveBreakpoints)
+{
+    runCommands("QTDP:1:10000100:E:0:0", "QTStart", "QTStop", "qTStatus");
+    CHECK_TRUE ( wasTextSent("+$T0;tstop:0") );
+    CHECK_EQUAL( 1, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x10000100, platformMock_ClearHardwareBreakpointAddressArg() );
+}
+
+TEST(cmdTrace, HitTracepoint_ShouldCollectFrameAndResumeSilently)
+{
+    runCommands("QTDP:1:10000100:E:0:0", "QTStart");
+
+    Platform_SetProgramCounter(0x10000100);
+    platformMock_CommInitTransmitDataBuffer(128);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    CHECK_EQUAL( 1, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x10000100, platformMock_ClearHardwareBreakpointAddressArg() );
+
+    Platform_SetProgramCounter(0x10000102);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_EQUAL( 2, platformMock_SetHardwareBreakpointCalls() );
+    CHECK_EQUAL( 0x10000100, platformMock_SetHardwareBreakpointAddressArg() );
+    Platform_DisableSingleStep();
+
+    runCommands("qTStatus", "qTP:1:10000100");
+    CHECK_TRUE ( wasResponseSent("T1;tframes:01;tcreated:01;tfree:07e1;tsize:0800;circular:0;disconn:0") );
+    CHECK_TRUE ( wasResponseSent("V01:0") );
+}
+
+TEST(cmdTrace, HitTracepoint_WithFalseCondition_ShouldNotCollectFrame)
+{
+    runCommands("QTDP:1:10000100:E:0:0:" R3_EQUALS_5, "QTStart");
+
+    platformMock_SetRegister(3, 4);
+    hitTracepoint(0x10000100);
+    platformMock_SetRegister(3, 5);
+    hitTracepoint(0x10000100);
+
+    runCommands("qTStatus", "qTP:1:10000100");
+    CHECK_TRUE ( wasTextSent(";tframes:01;tcreated:01;") );
+    CHECK_TRUE ( wasResponseSent("V01:0") );
+}
+
+TEST(cmdTrace, HitTracepoint_ReachingPassCount_ShouldStopTracing)
+{
+    runCommands("QTDP:1:10000100:E:0:2", "QTStart");
+
+    hitTracepoint(0x10000100);
+    CHECK_EQUAL( 1, platformMock_ClearHardwareBreakpointCalls() );
+    hitTracepoint(0x10000100);
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+
+    runCommands("qTStatus");
+    CHECK_TRUE ( wasTextSent("+$T0;tpasscount:01;tframes:02;tcreated:02;") );
+}
+
+TEST(cmdTrace, SelectFrame_ShouldReturnRegistersAtTimeOfHit)
+{
+    uint32_t* pContext = platformMock_GetContext();
+
+    runCommands("QTDP:1:10000100:E:0:0", "QTStart");
+    pContext[0] = 0x11111111;
+    pContext[1] = 0x22222222;
+    pContext[2] = 0x33333333;
+    pContext[3] = 0x44444444;
+    hitTracepoint(0x10000100);
+    pContext[0] = 0x55555555;
+
+    runCommands("QTFrame:0", "g", "QTFrame:ffffffff", "g");
+    CHECK_TRUE ( wasResponseSent("F00T01") );
+    CHECK_TRUE ( wasResponseSent("11111111222222223333333344444444") );
+    CHECK_TRUE ( wasResponseSent("F-1") );
+    CHECK_TRUE ( wasTextSent("+$55555555") );
+}
+
+TEST(cmdTrace, SelectFrame_OutOfRange_ShouldReturnNoFrame)
+{
+    runCommands("QTFrame:0", "QTFrame:pc:10000100", "QTFrame:xyz");
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$F-1#a4+$F-1#a4"
+                                                           "+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdTrace, FindFrame_ByPcTracepointAndRange)
+{
+    runCommands("QTDP:1:10000100:E:0:0", "QTDP:2:10000200:E:0:0", "QTStart");
+    hitTracepoint(0x10000100);
+    hitTracepoint(0x10000200);
+    hitTracepoint(0x10000100);
+
+    runCommands("QTFrame:pc:10000200", "QTFrame:tdp:1", "QTFrame:range:10000100:10000100",
+                "QTFrame:outside:10000100:10000100", "QTFrame:tdp:3");
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c"
+                                                           "+$F01T02#5d"
+                                                           "+$F02T01#5d"
+                                                           "+$F-1#a4"
+                                                           "+$F01T02#5d"
+                                                           "+$F-1#a4+") );
+}
+
+TEST(cmdTrace, MemoryAction_ShouldCollectMemoryIntoFrame)
+{
+    uint32_t value = 0x12345678;
+    uint32_t other = 0xbaadf00d;
+    char     define[64];
+    char     readValue[32];
+    char     readOther[32];
+
+    snprintf(define, sizeof(define), "QTDP:-1:10000100:Mffffffff,%08x,4", (uint32_t)(size_t)&value);
+    snprintf(readValue, sizeof(readValue), "m%08x,4", (uint32_t)(size_t)&value);
+    snprintf(readOther, sizeof(readOther), "m%08x,4", (uint32_t)(size_t)&other);
+    runCommands("QTDP:1:10000100:E:0:0", define, "QTStart");
+    hitTracepoint(0x10000100);
+    value = 0;
+
+    runCommands("QTFrame:0", readValue, readOther, "QTFrame:ffffffff", readValue);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c"
+                                                           "+$F00T01#5b"
+                                                           "+$78563412#a4"
+                                                           "+$" MRI_ERROR_MEMORY_ACCESS_FAILURE "#a8"
+                                                           "+$F-1#a4"
+                                                           "+$00000000#80+") );
+}
+
+TEST(cmdTrace, MemoryAction_RelativeToRegister_ShouldCollectMemoryIntoFrame)
+{
+    uint32_t values[2] = { 0x11223344, 0x55667788 };
+    char     readValue[32];
+
+    platformMock_SetRegister(1, (uint32_t)(size_t)&values[0]);
+    snprintf(readValue, sizeof(readValue), "m%08x,4", (uint32_t)(size_t)&values[1]);
+    runCommands("QTDP:1:10000100:E:0:0", "QTDP:-1:10000100:M1,4,4", "QTStart");
+    hitTracepoint(0x10000100);
+
+    runCommands("QTFrame:0", readValue);
+    CHECK_TRUE ( wasResponseSent("88776655") );
+}
+
+TEST(cmdTrace, ExpressionAction_ShouldCollectMemoryAndUpdateVariables)
+{
+    uint32_t value = 0x12345678;
+    char     define[80];
+    char     readValue[32];
+
+    /* const32 &value, const8 4, trace, getv 1, const8 1, add, setv 1, tracev 1, end */
+    snprintf(define, sizeof(define), "QTDP:-1:10000100:X15,24%08x22040c2c0001220102" "2d00012e000127",
+             (uint32_t)(size_t)&value);
+    snprintf(readValue, sizeof(readValue), "m%08x,4", (uint32_t)(size_t)&value);
+    runCommands("QTDV:1:5:0:count", "QTDP:1:10000100:E:0:0", define, "QTStart");
+    hitTracepoint(0x10000100);
+    value = 0;
+    hitTracepoint(0x10000100);
+
+    runCommands("qTV:1", "QTFrame:0", "qTV:1", readValue, "qTV:2");
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c"
+                                                           "+$V07#bd"
+                                                           "+$F00T01#5b"
+                                                           "+$V06#bc"
+                                                           "+$78563412#a4"
+                                                           "+$U#55+") );
+}
+
+TEST(cmdTrace, FullBuffer_ShouldStopTracing)
+{
+    uint8_t data[1000];
+    char    define[64];
+
+    memset(data, 0xa5, sizeof(data));
+    snprintf(define, sizeof(define), "QTDP:-1:10000100:Mffffffff,%08x,3e8", (uint32_t)(size_t)data);
+    runCommands("QTDP:1:10000100:E:0:0", define, "QTStart");
+    hitTracepoint(0x10000100);
+    hitTracepoint(0x10000100);
+
+    runCommands("qTStatus");
+    CHECK_TRUE ( wasTextSent("+$T0;tfull:0;tframes:01;tcreated:01;") );
+    CHECK_EQUAL( 2, platformMock_ClearHardwareBreakpointCalls() );
+}
+
+TEST(cmdTrace, CircularBuffer_ShouldDiscardOldestFrames)
+{
+    uint8_t data[1000];
+    char    define[64];
+    char    readData[32];
+
+    snprintf(define, sizeof(define), "QTDP:-1:10000100:Mffffffff,%08x,3e8", (uint32_t)(size_t)data);
+    snprintf(readData, sizeof(readData), "m%08x,1", (uint32_t)(size_t)data);
+    runCommands("QTBuffer:circular:1", "QTDP:1:10000100:E:0:0", define, "QTStart");
+    data[0] = 1;
+    hitTracepoint(0x10000100);
+    data[0] = 2;
+    hitTracepoint(0x10000100);
+    data[0] = 3;
+    hitTracepoint(0x10000100);
+
+    runCommands("qTStatus", "QTFrame:0", readData, "QTFrame:1");
+    CHECK_TRUE ( wasTextSent("+$T1;tframes:01;tcreated:03;") );
+    CHECK_TRUE ( wasResponseSent("03") );
+    CHECK_TRUE ( wasResponseSent("F-1") );
+}
+
+TEST(cmdTrace, UploadTracepoints)
+{
+    runCommands("QTDP:1:10000100:E:0:0", "QTDP:2:10000200:D:0:3", "qTfP", "qTsP", "qTsP", "qTfV");
+    CHECK_TRUE ( wasTextSent("+$T01:10000100:E:0:00#") );
+    CHECK_TRUE ( wasTextSent("+$T02:10000200:D:0:03#") );
+    CHECK_TRUE ( wasTextSent("+$l#6c+$l#6c+") );
+}
+
+TEST(cmdTrace, TraceInit_ShouldDiscardTracepointsAndFrames)
+{
+    runCommands("QTDP:1:10000100:E:0:0", "QTStart");
+    hitTracepoint(0x10000100);
+
+    runCommands("QTinit", "qTStatus", "qTfP", "qTP:1:10000100");
+    CHECK_TRUE ( wasTextSent("+$T0;tnotrun:0;tframes:00;tcreated:00;") );
+    CHECK_TRUE ( wasTextSent("+$l#6c+$#00+") );
+}
@@ -0,0 +1,204 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <platforms.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+TEST_GROUP(cmdVCont)
+{
+    int     m_expectedException;            
+    
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+    
+    void validateExceptionCode(int expectedExceptionCode)
+    {
+        m_expectedException = expectedExceptionCode;
+        LONGS_EQUAL ( expectedExceptionCode, getExceptionCode() );
+    }
+
+    void startRangeStep()
+    {
+        platformMock_CommInitReceiveChecksummedData("+$vCont;r10000000,10000010#");
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+        CHECK_EQUAL( 1, platformMock_GetBlockStepCalls() );
+        platformMock_CommInitTransmitDataBuffer(128);
+    }
+};
+
+TEST(cmdVCont, QuerySupportedActions)
+{
+    platformMock_CommInitReceiveChecksummedData("+$vCont?#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$vCont;c;C;s;S;r#0f+") );
+}
+
+TEST(cmdVCont, UnsupportedVPacket_ShouldReturnEmptyResponse)
+{
+    static const char* packets[] = { "+$vMustReplyEmpty#", "+$vX#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, 3);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$#00+$#00+") );
+}
+
+TEST(cmdVCont, Continue)
+{
+    platformMock_CommInitReceiveChecksummedData("+$vCont;c#");
+        __mriDebugException();
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( INITIAL_PC, platformMock_GetProgramCounterValue() );
+}
+
+TEST(cmdVCont, ContinueWithSignal_ShouldIgnoreLaterActionsInsteadOfReadingThemAsAddress)
+{
+    platformMock_CommInitReceiveChecksummedData("+$vCont;C05;c#");
+        __mriDebugException();
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 0, platformMock_SetProgramCounterCalls() );
+}
+
+TEST(cmdVCont, SingleStepWithThreadId_ShouldOnlyUseFirstAction)
+{
+    platformMock_CommInitReceiveChecksummedData("+$vCont;s:1;c#");
+        __mriDebugException();
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 0, platformMock_GetBlockStepCalls() );
+    CHECK_EQUAL( 0, platformMock_SetProgramCounterCalls() );
+}
+
+TEST(cmdVCont, SingleStepWithSignal)
+{
+    platformMock_CommInitReceiveChecksummedData("+$vCont;S05#");
+        __mriDebugException();
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(cmdVCont, MissingOrUnknownAction_ShouldReturnInvalidArgument)
+{
+    static const char* packets[] = { "+$vCont#", "+$vCont;#", "+$vCont;x#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, 4);
+        __mriDebugException();
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$" MRI_ERROR_INVALID_ARGUMENT "#a6+"
+                                                           "$" MRI_ERROR_INVALID_ARGUMENT "#a6+"
+                                                           "$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdVCont, RangeStepWithMissingEndAddress_ShouldReturnInvalidArgument)
+{
+    static const char* packets[] = { "+$vCont;r10000000#", "+$vCont;r10000000,#", "+$c#" };
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, 3);
+        __mriDebugException();
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+    CHECK_EQUAL( 0, platformMock_GetBlockStepCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$" MRI_ERROR_INVALID_ARGUMENT "#a6+"
+                                                           "$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(cmdVCont, RangeStep_ShouldBlockStepToEndOfRange)
+{
+    platformMock_CommInitReceiveChecksummedData("+$vCont;r10000000,10000010:1#");
+        __mriDebugException();
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 1, platformMock_GetBlockStepCalls() );
+    CHECK_EQUAL( 0x10000010, platformMock_GetBlockStepEndAddress() );
+}
+
+TEST(cmdVCont, RangeStep_ShouldResumeSilentlyWhileInRangeAndStopOnceOutside)
+{
+    startRangeStep();
+
+    Platform_SetProgramCounter(INITIAL_PC + 6);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_EQUAL( 2, platformMock_GetBlockStepCalls() );
+
+    Platform_SetProgramCounter(INITIAL_PC + 0xE);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_EQUAL( 3, platformMock_GetBlockStepCalls() );
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    Platform_SetProgramCounter(INITIAL_PC + 0x10);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 3, platformMock_GetBlockStepCalls() );
+}
+
+TEST(cmdVCont, RangeStep_ShouldStopWhenStepMakesNoProgress)
+{
+    startRangeStep();
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 1, platformMock_GetBlockStepCalls() );
+}
+
+TEST(cmdVCont, RangeStep_ShouldBeCancelledByStopSoLaterSingleStepIsReported)
+{
+    startRangeStep();
+
+    platformMock_CommInitReceiveChecksummedData("+$s#");
+    Platform_SetProgramCounter(INITIAL_PC + 0x20);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    Platform_SetProgramCounter(INITIAL_PC + 2);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_EQUAL( 1, platformMock_GetBlockStepCalls() );
+}
+
+TEST(cmdVCont, RangeStepOverHardcodedBreakpoint_ShouldTreatAdvanceAsTheStep)
+{
+    platformMock_SetTypeOfCurrentInstruction(MRI_PLATFORM_INSTRUCTION_HARDCODED_BREAKPOINT);
+    platformMock_CommInitReceiveChecksummedData("+$vCont;r10000000,10000010#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$T05responseT#7c+") );
+    CHECK_EQUAL( 0, platformMock_GetBlockStepCalls() );
+}
@@ -0,0 +1,192 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+
+extern "C"
+{
+#include "compress.h"
+}
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+TEST_GROUP(Compress)
+{
+    CompressState m_state;
+    uint32_t      m_hashTable[1 << 8];
+    uint8_t       m_source[4096];
+    uint8_t       m_compressed[8192];
+    uint8_t       m_decompressed[4096];
+    uint32_t      m_compressedLength;
+    
+    void setup()
+    {
+        memset(m_source, 0, sizeof(m_source));
+        memset(m_compressed, 0, sizeof(m_compressed));
+        memset(m_decompressed, 0xFF, sizeof(m_decompressed));
+        m_compressedLength = 0;
+    }
+
+    void teardown()
+    {
+    }
+    
+    void fillWithPseudoRandomData(uint8_t* p, size_t length)
+    {
+        uint32_t seed = 0x12345678;
+
+        while (length-- > 0)
+        {
+            seed = seed * 1103515245 + 12345;
+            *p++ = (uint8_t)(seed >> 16);
+        }
+    }
+    
+    void compressAll(uint32_t sourceLength)
+    {
+        Compress_Init(&m_state, m_source, sourceLength, m_hashTable, 8);
+        m_compressedLength = Compress_NextBlock(&m_state, m_compressed, sizeof(m_compressed));
+        LONGS_EQUAL ( sourceLength, m_state.srcOffset );
+    }
+    
+    void validateRoundTripInBlocksOf(uint32_t sourceLength, uint32_t blockSize)
+    {
+        uint32_t decompressedOffset = 0;
+
+        Compress_Init(&m_state, m_source, sourceLength, m_hashTable, 8);
+        while (m_state.srcOffset < sourceLength)
+        {
+            uint32_t blockLength = Compress_NextBlock(&m_state, m_compressed, blockSize);
+            uint32_t decompressedLength = m_state.srcOffset - decompressedOffset;
+
+            CHECK_TRUE ( blockLength <= blockSize );
+            CHECK_TRUE ( decompressedLength > 0 );
+            CHECK_TRUE ( DecompressToMemory(m_decompressed + decompressedOffset, decompressedLength, decompressedOffset,
+                                            m_compressed, blockLength) );
+            decompressedOffset += decompressedLength;
+        }
+        CHECK_TRUE ( 0 == memcmp(m_source, m_decompressed, sourceLength) );
+    }
+};
+
+TEST(Compress, ShortLiteralsOnly)
+{
+    memcpy(m_source, "abc", 3);
+    compressAll(3);
+    LONGS_EQUAL ( 4, m_compressedLength );
+    CHECK_TRUE ( 0 == memcmp(m_compressed, "\x30" "abc", 4) );
+    CHECK_TRUE ( DecompressToMemory(m_decompressed, 3, 0, m_compressed, m_compressedLength) );
+    CHECK_TRUE ( 0 == memcmp(m_decompressed, "abc", 3) );
+}
+
+TEST(Compress, RepeatedPattern_ShouldUseOverlappingMatch)
+{
+    memcpy(m_source, "abcdabcdabcdabcd", 16);
+    compressAll(16);
+    LONGS_EQUAL ( 7, m_compressedLength );
+    CHECK_TRUE ( 0 == memcmp(m_compressed, "\x48" "abcd" "\x04\x00", 7) );
+    CHECK_TRUE ( DecompressToMemory(m_decompressed, 16, 0, m_compressed, m_compressedLength) );
+    CHECK_TRUE ( 0 == memcmp(m_decompressed, m_source, 16) );
+}
+
+TEST(Compress, LongRunOfZeroes_ShouldUseExtendedMatchLength)
+{
+    compressAll(1024);
+    CHECK_TRUE ( m_compressedLength < 16 );
+    CHECK_TRUE ( DecompressToMemory(m_decompressed, 1024, 0, m_compressed, m_compressedLength) );
+    CHECK_TRUE ( 0 == memcmp(m_decompressed, m_source, 1024) );
+}
+
+TEST(Compress, IncompressibleData_ShouldUseExtendedLiteralLength)
+{
+    fillWithPseudoRandomData(m_source, 1000);
+    compressAll(1000);
+    CHECK_TRUE ( m_compressedLength <= 1000 + 1 + 1000 / 255 + 1 );
+    CHECK_TRUE ( DecompressToMemory(m_decompressed, 1000, 0, m_compressed, m_compressedLength) );
+    CHECK_TRUE ( 0 == memcmp(m_decompressed, m_source, 1000) );
+}
+
+TEST(Compress, EmptySource_ShouldProduceNoOutput)
+{
+    compressAll(0);
+    LONGS_EQUAL ( 0, m_compressedLength );
+}
+
+TEST(Compress, RoundTripTextInSmallBlocks_ShouldReferenceEarlierBlocks)
+{
+    static const char text[] = "The quick brown fox jumps over the lazy dog. ";
+    size_t            i;
+
+    for (i = 0 ; i + sizeof(text) - 1 <= sizeof(m_source) ; i += sizeof(text) - 1)
+        memcpy(m_source + i, text, sizeof(text) - 1);
+    validateRoundTripInBlocksOf(sizeof(m_source), 16);
+}
+
+TEST(Compress, RoundTripRandomDataInSmallBlocks)
+{
+    fillWithPseudoRandomData(m_source, sizeof(m_source));
+    validateRoundTripInBlocksOf(sizeof(m_source), 2);
+    validateRoundTripInBlocksOf(sizeof(m_source), 17);
+    validateRoundTripInBlocksOf(sizeof(m_source), 300);
+}
+
+TEST(Compress, RoundTripMixedDataInVariousBlockSizes)
+{
+    uint32_t blockSize;
+
+    fillWithPseudoRandomData(m_source, 512);
+    memcpy(m_source + 1024, m_source, 512);
+    memset(m_source + 2048, 0x55, 600);
+    memcpy(m_source + 3000, m_source + 100, 1000);
+    for (blockSize = 2 ; blockSize < 80 ; blockSize += 7)
+        validateRoundTripInBlocksOf(sizeof(m_source), blockSize);
+}
+
+TEST(Compress, Decompress_OutputShorterThanExpected_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 4, 0, (const uint8_t*)"\x30" "abc", 4) );
+}
+
+TEST(Compress, Decompress_OutputLongerThanExpected_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 2, 0, (const uint8_t*)"\x30" "abc", 4) );
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 5, 0, (const uint8_t*)"\x20" "ab" "\x02\x00", 5) );
+}
+
+TEST(Compress, Decompress_TruncatedLiterals_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 3, 0, (const uint8_t*)"\x30" "ab", 3) );
+}
+
+TEST(Compress, Decompress_TruncatedOffset_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 6, 0, (const uint8_t*)"\x20" "ab" "\x02", 4) );
+}
+
+TEST(Compress, Decompress_TruncatedExtendedLength_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 300, 0, (const uint8_t*)"\xF0\xFF", 2) );
+}
+
+TEST(Compress, Decompress_ZeroOffset_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed, 6, 0, (const uint8_t*)"\x20" "ab" "\x00\x00", 5) );
+}
+
+TEST(Compress, Decompress_OffsetBeforeHistory_ShouldFail)
+{
+    CHECK_FALSE ( DecompressToMemory(m_decompressed + 8, 6, 0, (const uint8_t*)"\x20" "ab" "\x03\x00", 5) );
+    CHECK_TRUE ( DecompressToMemory(m_decompressed + 8, 6, 1, (const uint8_t*)"\x20" "ab" "\x03\x00", 5) );
+}
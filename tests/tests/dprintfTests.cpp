@@ -0,0 +1,378 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <dprintf.h>
+#include <platforms.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+/* Agent expression for "$r3 == 5": reg 3, const8 5, equal, end */
+#define R3_EQUALS_5 "X7,26000322051327"
+
+TEST_GROUP(dprintf)
+{
+    int         m_expectedException;
+    char        m_hex[256];
+    size_t      m_hexLength;
+    char        m_command[sizeof(m_hex) + 16];
+
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+
+    void appendByte(uint8_t byte)
+    {
+        assert ( m_hexLength + 3 <= sizeof(m_hex) );
+        m_hexLength += snprintf(&m_hex[m_hexLength], sizeof(m_hex) - m_hexLength, "%02x", byte);
+    }
+
+    /* Builds the command which gdb sends for dprintf-style agent: each argument is pushed last one first, followed by
+       the channel and function, then the printf opcode with the argument count and format string. */
+    const char* buildDprintfCommand(const char* pFormat, int argCount, const uint64_t* pArgs)
+    {
+        size_t formatLength = strlen(pFormat) + 1;
+
+        m_hexLength = 0;
+        for (int i = argCount - 1 ; i >= 0 ; i--)
+        {
+            int size = 1;
+
+            /* Like gdb, use the smallest const opcode which holds the value. */
+            while (size < 8 && (pArgs[i] >> (size * 8)) != 0)
+                size *= 2;
+            appendByte(0x22 + (size == 1 ? 0 : size == 2 ? 1 : size == 4 ? 2 : 3));
+            for (int shift = (size - 1) * 8 ; shift >= 0 ; shift -= 8)
+                appendByte((uint8_t)(pArgs[i] >> shift));
+        }
+        appendByte(0x22);
+        appendByte(0x00);
+        appendByte(0x22);
+        appendByte(0x00);
+        appendByte(0x34);
+        appendByte((uint8_t)argCount);
+        appendByte((uint8_t)(formatLength >> 8));
+        appendByte((uint8_t)formatLength);
+        for (size_t i = 0 ; i < formatLength ; i++)
+            appendByte((uint8_t)pFormat[i]);
+        appendByte(0x27);
+
+        snprintf(m_command, sizeof(m_command), "X%x,%s", (unsigned int)m_hexLength / 2, m_hex);
+        return m_command;
+    }
+
+    void setDprintf(const char* pPrefix, const char* pFormat, int argCount = 0, const uint64_t* pArgs = NULL)
+    {
+        char packet[sizeof(m_command) + 64];
+
+        snprintf(packet, sizeof(packet), "+$Z1,10000000,2;%scmds:0,%s#",
+                 pPrefix, buildDprintfCommand(pFormat, argCount, pArgs));
+        platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+        platformMock_CommInitTransmitDataBuffer(128);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    }
+
+    void hitDprintf()
+    {
+        Platform_SetProgramCounter(INITIAL_PC);
+        platformMock_CommInitTransmitDataBuffer(128);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+        CHECK_TRUE ( Platform_IsSingleStepping() );
+
+        Platform_SetProgramCounter(INITIAL_PC + 2);
+            __mriDebugException();
+        CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+        Platform_DisableSingleStep();
+    }
+
+    /* Stops the program for real and returns the text from any 'O' packets sent before the stop response. */
+    const char* stopAndGetOutput(int packetCount = 1)
+    {
+        const char* packets[8];
+
+        for (int i = 0 ; i < packetCount ; i++)
+            packets[i] = "+";
+        packets[packetCount] = "+$c#";
+        platformMock_CommInitReceiveChecksummedDataSequence(packets, packetCount + 1);
+        platformMock_CommInitTransmitDataBuffer(1024);
+        Platform_SetProgramCounter(INITIAL_PC + 4);
+            __mriDebugException();
+
+        CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$T05responseT#7c+") != NULL );
+        return platformMock_CommGetConsoleOutput();
+    }
+};
+
+TEST(dprintf, HitDprintf_ShouldResumeSilentlyAndFlushOutputAtNextStop)
+{
+    static const uint64_t args[] = { 42 };
+
+    setDprintf("", "x=%d\n", 1, args);
+    hitDprintf();
+    CHECK_EQUAL( 1, platformMock_ClearHardwareBreakpointCalls() );
+    CHECK_EQUAL( 2, platformMock_SetHardwareBreakpointCalls() );
+    hitDprintf();
+
+    STRCMP_EQUAL ( "x=42\nx=42\n", stopAndGetOutput() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$O783d34320a783d34320a#15$T05responseT#7c+") );
+}
+
+TEST(dprintf, NoDprintfOutput_ShouldSendNoConsolePackets)
+{
+    STRCMP_EQUAL ( "", stopAndGetOutput(0) );
+}
+
+TEST(dprintf, IntegerConversions)
+{
+    static const uint64_t args[] = { 0xfffffffb, 0xfffffffb, 255, 255, 8 };
+
+    setDprintf("", "%d %u %x %X %o", 5, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "-5 4294967291 ff FF 10", stopAndGetOutput() );
+}
+
+TEST(dprintf, AlternateCharAndPointerConversions)
+{
+    static const uint64_t args[] = { 255, 8, 'A', 0x1234 };
+
+    setDprintf("", "%#x %#o %c %p", 4, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "0xff 010 A 0x1234", stopAndGetOutput() );
+}
+
+TEST(dprintf, WidthPrecisionAndFlags)
+{
+    static const uint64_t args[] = { 42, 42, 42, 42, 42, 0 };
+
+    setDprintf("", "[%5d][%-5d][%05d][%+d][%.4x][%.0d]", 6, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "[   42][42   ][00042][+42][002a][]", stopAndGetOutput() );
+}
+
+TEST(dprintf, LengthModifiers)
+{
+    static const uint64_t args[] = { 0x1ffff, 0x1ff, 0xfffffffffffffffeULL, 0x123456789ULL };
+
+    setDprintf("", "%hd %hhu %lld %lx", 4, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "-1 255 -2 23456789", stopAndGetOutput() );
+}
+
+TEST(dprintf, StringsAreReadFromTargetMemory)
+{
+    char     name[] = "motor";
+    uint64_t args[3];
+
+    args[0] = (uint32_t)(size_t)name;
+    args[1] = (uint32_t)(size_t)name;
+    args[2] = (uint32_t)(size_t)name;
+    setDprintf("", "%s=[%.3s][%7s]", 3, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "motor=[mot][  motor]", stopAndGetOutput() );
+}
+
+TEST(dprintf, StringAtUnmappedAddress_ShouldOutputError)
+{
+    char                 name[] = "motor";
+    PlatformMemoryRegion region = { (uint32_t)(size_t)name, sizeof(name), MRI_PLATFORM_MEMORY_RAM };
+    uint64_t             args[] = { (uint32_t)(size_t)name + 0x1000 };
+
+    platformMock_SetDeviceMemoryRegions(&region, 1);
+    setDprintf("", "%s", 1, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "<error>", stopAndGetOutput() );
+}
+
+TEST(dprintf, StringFaultsAfterBeingMeasured_ShouldStopOutputAtFault)
+{
+    char     name[] = "motor";
+    uint64_t args[] = { (uint32_t)(size_t)name };
+
+    setDprintf("", "%s", 1, args);
+    // The first 6 reads measure the string so the 9th is the third character being copied to the output.
+    platformMock_FaultOnSpecificMemoryCall(9);
+    hitDprintf();
+    STRCMP_EQUAL ( "mo", stopAndGetOutput() );
+}
+
+TEST(dprintf, PercentMissingArgumentsAndFloats_ShouldBeOutputAsIs)
+{
+    static const uint64_t args[] = { 0x3ff0000000000000ULL };
+
+    setDprintf("", "100%% %f %d", 1, args);
+    hitDprintf();
+    STRCMP_EQUAL ( "100% %f %d", stopAndGetOutput() );
+}
+
+TEST(dprintf, FullBuffer_ShouldFlushWhileRunning)
+{
+    static const char   line[] = "0123456789abcdefghijklmnopqrstuvwxyzABC\n";
+    static const char*  acks[] = { "+", "+", "+", "+" };
+    const size_t        lineLength = sizeof(line) - 1;
+    const size_t        linesThatFit = MRI_DPRINTF_BUFFER_SIZE / lineLength;
+    char                expected[MRI_DPRINTF_BUFFER_SIZE + sizeof(line)] = "";
+    char                output[sizeof(expected)];
+
+    setDprintf("", line);
+    for (size_t i = 0 ; i < linesThatFit ; i++)
+    {
+        hitDprintf();
+        strcat(expected, line);
+    }
+    strcat(expected, line);
+
+    platformMock_CommInitReceiveChecksummedDataSequence(acks, sizeof(acks)/sizeof(acks[0]));
+    platformMock_CommInitTransmitDataBuffer(1024);
+    Platform_SetProgramCounter(INITIAL_PC);
+        __mriDebugException();
+    CHECK_TRUE ( Platform_IsSingleStepping() );
+    Platform_SetProgramCounter(INITIAL_PC + 2);
+        __mriDebugException();
+    Platform_DisableSingleStep();
+    strcpy(output, platformMock_CommGetConsoleOutput());
+    CHECK_EQUAL ( MRI_DPRINTF_BUFFER_SIZE, strlen(output) );
+
+    strcat(output, stopAndGetOutput());
+    STRCMP_EQUAL ( expected, output );
+}
+
+TEST(dprintf, ConditionFalse_ShouldNotRunCommands)
+{
+    static const uint64_t args[] = { 1 };
+
+    setDprintf(R3_EQUALS_5 ";", "hit %d\n", 1, args);
+    platformMock_SetRegister(3, 4);
+    hitDprintf();
+    platformMock_SetRegister(3, 5);
+    hitDprintf();
+
+    STRCMP_EQUAL ( "hit 1\n", stopAndGetOutput() );
+}
+
+TEST(dprintf, RemoveBreakpoint_ShouldDiscardCommands)
+{
+    setDprintf("", "hit\n");
+    platformMock_CommInitReceiveChecksummedData("+$z1,10000000,2#", "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    Platform_SetProgramCounter(INITIAL_PC + 4);
+        __mriDebugException();
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    Platform_SetProgramCounter(INITIAL_PC);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+}
+
+TEST(dprintf, MalformedCommands_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;cmds:0,Y3,000000#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_EQUAL( 0, platformMock_SetHardwareBreakpointCalls() );
+}
+
+TEST(dprintf, ResentWithMalformedCondition_ShouldDiscardCommands)
+{
+    setDprintf("", "hit\n");
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;X7,260003#", "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    Platform_SetProgramCounter(INITIAL_PC + 4);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    Platform_SetProgramCounter(INITIAL_PC);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+}
+
+TEST(dprintf, SoftwareAndHardwareBreakpointsAtSameAddress_ShouldRunBothCommandLists)
+{
+    char packet[sizeof(m_command) + 64];
+
+    setDprintf("", "one\n");
+    snprintf(packet, sizeof(packet), "+$Z0,10000000,2;cmds:0,%s#", buildDprintfCommand("two\n", 0, NULL));
+    platformMock_CommInitReceiveChecksummedData(packet, "+$c#");
+    platformMock_CommInitTransmitDataBuffer(128);
+    Platform_SetProgramCounter(INITIAL_PC + 4);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+
+    hitDprintf();
+    STRCMP_EQUAL ( "one\ntwo\n", stopAndGetOutput() );
+}
+
+TEST(dprintf, UnknownBreakpointOption_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$Z1,10000000,2;foo#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(dprintf, CommandTableFull_ShouldReturnNoFreeBreakpointError)
+{
+    const char* packets[8];
+    char        buffers[MRI_BREAKPOINT_COMMANDS_COUNT + 1][128];
+    const char* command = buildDprintfCommand("hit", 0, NULL);
+    int         i;
+
+    for (i = 0 ; i <= MRI_BREAKPOINT_COMMANDS_COUNT ; i++)
+        snprintf(buffers[i], sizeof(buffers[i]), "+$Z1,%08x,2;cmds:0,%s#", 0x10000100 + 2 * i, command);
+
+    /* The mock can only queue 8 packets at a time so fill the table across two stops. */
+    for (i = 0 ; i < MRI_BREAKPOINT_COMMANDS_COUNT - 1 ; i++)
+        packets[i] = buffers[i];
+    packets[i] = "+$c#";
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, MRI_BREAKPOINT_COMMANDS_COUNT);
+    platformMock_CommInitTransmitDataBuffer(512);
+        __mriDebugException();
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$" MRI_ERROR_NO_FREE_BREAKPOINT) == NULL );
+
+    packets[0] = buffers[MRI_BREAKPOINT_COMMANDS_COUNT - 1];
+    packets[1] = buffers[MRI_BREAKPOINT_COMMANDS_COUNT];
+    packets[2] = "+$c#";
+    platformMock_CommInitReceiveChecksummedDataSequence(packets, 3);
+    platformMock_CommInitTransmitDataBuffer(512);
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+}
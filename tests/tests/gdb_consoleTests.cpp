@@ -84,4 +84,22 @@ TEST(gdbConsole, WriteHexValueToGdbConsole_SendMaximumValue)
     platformMock_SetCommSharingWithApplication(1);
     WriteHexValueToGdbConsole(~0U);
     CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("0xffffffff") );
-}
\ No newline at end of file
+}
+
+TEST(gdbConsole, WriteSizedStringToGdbConsole_SendOnlyRequestedLengthWhenShared)
+{
+    platformMock_SetCommSharingWithApplication(1);
+    WriteSizedStringToGdbConsole("Test string\n", 4);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("Test") );
+}
+
+TEST(gdbConsole, WriteSizedStringToGdbConsole_SplitAcrossPacketsWhenLargerThanBuffer)
+{
+    static const char* acks[] = { "+", "+", "+" };
+
+    platformMock_SetCommSharingWithApplication(0);
+    platformMock_SetPacketBufferSize(10);
+    platformMock_CommInitReceiveChecksummedDataSequence(acks, sizeof(acks)/sizeof(acks[0]));
+    WriteSizedStringToGdbConsole("Test string", 11);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$O54657374#f8$O20737472#ef$O696e67#c6") );
+}
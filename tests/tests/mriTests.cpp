@@ -112,6 +112,17 @@ TEST(Mri, __mriDebugExceptionShouldEnterAndLeaveIfHandlingSemihostRequest_NoWait
     CHECK_EQUAL( 0, platformMock_DisplayFaultCauseToGdbConsoleCalls() );
 }
 
+TEST(Mri, __mriDebugExceptionShouldReportSemihostRequestToGdbIfStopCantBeResumed)
+{
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_SetIsDebuggeeMakingSemihostCall(1);
+    platformMock_RefuseResumeCalls(1);
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    CHECK_EQUAL( 0, platformMock_GetHandleSemihostRequestCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
 TEST(Mri, __mriDebugExceptionShouldEnterAndLeaveIfHandlingSemihostRequest_WaitAndHaveGdbConnectOnFirstByte)
 {
     __mriInit("MRI_UART_MBED_USB");
@@ -202,3 +213,121 @@ TEST(Mri, __mriDebugException_PacketBufferTooSmallShouldResultInBufferOverrunErr
     CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$" MRI_ERROR_BUFFER_OVERRUN "#a9" 
                                                            "+$" MRI_ERROR_BUFFER_OVERRUN "#a9" "+") );
 }
+
+TEST(Mri, __mriDebugException_MemoryReadSentWhileRunning_ServicedWithoutEnteringDebugger)
+{
+    uint32_t value = 0x12345678;
+    char     packet[64];
+
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    snprintf(packet, sizeof(packet), "$m%08x,4#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_FALSE( Platform_CommCausedInterrupt() );
+    CHECK_EQUAL( 1, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_EQUAL( 1, platformMock_GetLeavingDebuggerCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" "+$78563412#a4") );
+}
+
+TEST(Mri, __mriDebugException_MemoryWriteSentWhileRunning_ServicedWithoutEnteringDebugger)
+{
+    uint32_t value = 0x12345678;
+    char     packet[64];
+
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    snprintf(packet, sizeof(packet), "$M%08x,4:efbeadde#", (uint32_t)(size_t)&value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_EQUAL( 0xdeadbeef, value );
+    CHECK_EQUAL( 1, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" "+$OK#9a") );
+}
+
+TEST(Mri, __mriDebugException_ReadOnlyMonitorCommandSentWhileRunning_ServicedWithoutEnteringDebugger)
+{
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    // monitor watchlog dump
+    platformMock_CommInitReceiveChecksummedData("$qRcmd,77617463686c6f672064756d70#", "++");
+    platformMock_CommInitTransmitDataBuffer(256);
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_EQUAL( 1, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_EQUAL( 1, platformMock_GetLeavingDebuggerCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("+$O5761746368206c6f6720697320656d7074792e0a#74$OK#9a") );
+}
+
+TEST(Mri, __mriDebugException_BlockHashSentWhileRunning_ServicedWithoutEnteringDebugger)
+{
+    uint8_t value[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    char    packet[64];
+
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    snprintf(packet, sizeof(packet), "$qMriBlockHash:%08x,8,100#", (uint32_t)(size_t)value);
+    platformMock_CommInitReceiveChecksummedData(packet, "+");
+    platformMock_CommInitTransmitDataBuffer(256);
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_EQUAL( 1, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_EQUAL( 1, platformMock_GetLeavingDebuggerCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("+$febb9a46#93") );
+}
+
+TEST(Mri, __mriDebugException_WritingMonitorCommandSentWhileRunning_StopsBeforeRunningIt)
+{
+    uint32_t value = 0x12345678;
+    char     command[64];
+    char     packet[160];
+    size_t   i;
+
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    snprintf(command, sizeof(command), "fill %08x 4 deadbeef", (uint32_t)(size_t)&value);
+    strcpy(packet, "$qRcmd,");
+    for (i = 0 ; command[i] ; i++)
+        snprintf(packet + strlen(packet), sizeof(packet) - strlen(packet), "%02x", command[i]);
+    strcat(packet, "#");
+    platformMock_CommInitReceiveChecksummedData(packet, "++++++$c#");
+    platformMock_CommInitTransmitDataBuffer(256);
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_EQUAL( 2, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_EQUAL( 0xdeadbeef, value );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("+$O46696c6c656420#91$O30783034#eb$O206f6620#1b$O30783034#eb"
+                                                           "$O2062797465732e0a#f1$OK#9a+") );
+}
+
+TEST(Mri, __mriDebugException_OtherCommandSentWhileRunning_StopsAndAnswersItInsteadOfStopResponse)
+{
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("$?#", "+$c#");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_EQUAL( 2, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_EQUAL( 2, platformMock_GetLeavingDebuggerCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" "+$T05responseT#7c+") );
+}
+
+TEST(Mri, __mriDebugException_ControlCSentWhileRunning_StopsWithStopResponse)
+{
+    __mriInit("MRI_UART_MBED_USB");
+    platformMock_CommInitReceiveChecksummedData("+$c#");
+        __mriDebugException();
+    platformMock_CommInitReceiveChecksummedData("\x03", "+$c#");
+    platformMock_CommSetInterruptBit(1);
+        __mriDebugException();
+    CHECK_EQUAL( 2, platformMock_GetEnteringDebuggerCalls() );
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+" "$T05responseT#7c+") );
+}
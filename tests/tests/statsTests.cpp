@@ -0,0 +1,222 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <buffer.h>
+#include <stats.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+#include <string.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+TEST_GROUP(stats)
+{
+    int     m_expectedException;
+    char    m_data[512];
+    Buffer  m_buffer;
+
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+        memset(m_data, 0, sizeof(m_data));
+        Buffer_Init(&m_buffer, m_data, sizeof(m_data) - 1);
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+
+    void timeInterval(StatsTimer timer, uint32_t start, uint32_t end)
+    {
+        platformMock_SetCycleCount(start);
+        StartStatsTimer(timer);
+        platformMock_SetCycleCount(end);
+    }
+};
+
+TEST(stats, NothingRecorded_ShouldListFixedEntriesWithZeroes)
+{
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    STRCMP_EQUAL ( "lname,count,min,avg,max\n"
+                   "stop,00,00,00,00\n"
+                   "rx,00,00,00,00\n"
+                   "tx,00,00,00,00\n", m_data );
+}
+
+TEST(stats, RecordStopPacketsAndCommands_ShouldTrackCountMinAvgMax)
+{
+    timeInterval(STATS_TIMER_STOP, 100, 400);
+    RecordStopStats();
+    timeInterval(STATS_TIMER_RECEIVE, 10, 30);
+    RecordPacketReceiveStats();
+    timeInterval(STATS_TIMER_SEND, 10, 50);
+    RecordPacketSendStats();
+    timeInterval(STATS_TIMER_COMMAND, 100, 150);
+    RecordCommandStats('m');
+    timeInterval(STATS_TIMER_COMMAND, 100, 120);
+    RecordCommandStats('m');
+    timeInterval(STATS_TIMER_COMMAND, 0, 0x1000);
+    RecordCommandStats('g');
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    STRCMP_EQUAL ( "lname,count,min,avg,max\n"
+                   "stop,01,012c,012c,012c\n"
+                   "rx,01,14,14,14\n"
+                   "tx,01,28,28,28\n"
+                   "cmd:m,02,14,23,32\n"
+                   "cmd:g,01,1000,1000,1000\n", m_data );
+}
+
+TEST(stats, CycleCounterWrapsDuringInterval_ShouldStillMeasureCorrectly)
+{
+    timeInterval(STATS_TIMER_STOP, 0xFFFFFFF0, 0x10);
+    RecordStopStats();
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    STRCMP_EQUAL ( "lname,count,min,avg,max\n"
+                   "stop,01,20,20,20\n"
+                   "rx,00,00,00,00\n"
+                   "tx,00,00,00,00\n", m_data );
+}
+
+TEST(stats, FileOperations_ShouldBeTimedFromDebugEntryAndOnlyListedOnceUsed)
+{
+    timeInterval(STATS_TIMER_STOP, 0, 0x80);
+    RecordFileOperationStats(STATS_FILE_WRITE);
+    platformMock_SetCycleCount(0x40);
+    RecordFileOperationStats(STATS_FILE_RENAME);
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    STRCMP_EQUAL ( "lname,count,min,avg,max\n"
+                   "stop,00,00,00,00\n"
+                   "rx,00,00,00,00\n"
+                   "tx,00,00,00,00\n"
+                   "file:write,01,80,80,80\n"
+                   "file:rename,01,40,40,40\n", m_data );
+}
+
+TEST(stats, MoreCommandCharactersThanSlots_ShouldDropExtraCommands)
+{
+    char commandChar;
+    for (commandChar = 'a' ; commandChar < 'a' + MRI_STATS_COMMAND_COUNT + 1 ; commandChar++)
+        RecordCommandStats(commandChar);
+    WriteStatsTransferData(&m_buffer, 0, sizeof(m_data));
+    CHECK_TRUE ( strstr(m_data, "cmd:p,01,00,00,00\n") != NULL );
+    CHECK_TRUE ( strstr(m_data, "cmd:q") == NULL );
+}
+
+TEST(stats, Clear_ShouldResetAllEntries)
+{
+    timeInterval(STATS_TIMER_STOP, 0, 0x80);
+    RecordStopStats();
+    RecordFileOperationStats(STATS_FILE_OPEN);
+    RecordCommandStats('c');
+    ClearStats();
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    STRCMP_EQUAL ( "lname,count,min,avg,max\n"
+                   "stop,00,00,00,00\n"
+                   "rx,00,00,00,00\n"
+                   "tx,00,00,00,00\n", m_data );
+}
+
+TEST(stats, TransferDataWindow_ShouldFlagMoreDataUntilEndIsReached)
+{
+    WriteStatsTransferData(&m_buffer, 5, 5);
+    STRCMP_EQUAL ( "mcount", m_data );
+
+    memset(m_data, 0, sizeof(m_data));
+    Buffer_Init(&m_buffer, m_data, sizeof(m_data) - 1);
+    WriteStatsTransferData(&m_buffer, 64, 100);
+    STRCMP_EQUAL ( "l00,00\n", m_data );
+
+    memset(m_data, 0, sizeof(m_data));
+    Buffer_Init(&m_buffer, m_data, sizeof(m_data) - 1);
+    WriteStatsTransferData(&m_buffer, 200, 100);
+    STRCMP_EQUAL ( "l", m_data );
+}
+
+TEST(stats, TransferDataLargerThanBuffer_ShouldTruncateToBufferSize)
+{
+    Buffer_Init(&m_buffer, m_data, 11);
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    STRCMP_EQUAL ( "mname,count", m_data );
+}
+
+TEST(stats, DebugException_ShouldRecordStopCommandsAndPackets)
+{
+    platformMock_SetCycleCountIncrement(1);
+    platformMock_CommInitReceiveChecksummedData("+$g#", "+$c#");
+        __mriDebugException();
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    CHECK_TRUE ( strstr(m_data, "stop,01,") != NULL );
+    CHECK_TRUE ( strstr(m_data, "rx,02,") != NULL );
+    CHECK_TRUE ( strstr(m_data, "tx,02,") != NULL );
+    CHECK_TRUE ( strstr(m_data, "cmd:g,01,") != NULL );
+    CHECK_TRUE ( strstr(m_data, "cmd:c,01,") != NULL );
+}
+
+TEST(stats, MonitorStatsCommand_ShouldSendStatsToGdbConsole)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qRcmd,7374617473#", "+++++$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+"
+                                                           "$O6e616d652c636f756e742c6d696e2c6176672c6d61780a#07"
+                                                           "$O73746f702c30302c30302c30302c30300a#24"
+                                                           "$O72782c30312c30302c30302c30300a#25"
+                                                           "$O74782c30342c30302c30302c30300a#2a"
+                                                           "$OK#9a+") );
+}
+
+TEST(stats, MonitorStatsClearCommand_ShouldResetStats)
+{
+    timeInterval(STATS_TIMER_STOP, 0, 0x80);
+    RecordStopStats();
+    platformMock_CommInitReceiveChecksummedData("+$qRcmd,737461747320636c656172#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    WriteStatsTransferData(&m_buffer, 0, 255);
+    CHECK_TRUE ( strstr(m_data, "stop,01,") != NULL );
+}
+
+TEST(stats, MonitorStatsWithExtraArgument_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qRcmd,7374617473206f6666#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(stats, QueryTransferStats_ShouldReturnRequestedWindow)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qXfer:mri-stats:read::0,4#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$mname#0e+") );
+}
+
+TEST(stats, QueryTransferStatsWithAnnex_ShouldReturnErrorResponse)
+{
+    platformMock_CommInitReceiveChecksummedData("+$qXfer:mri-stats:read:target.xml:0,4#", "+$c#");
+        __mriDebugException();
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
@@ -0,0 +1,229 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <valuewatch.h>
+#include <platforms.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+TEST_GROUP(valueWatch)
+{
+    int         m_expectedException;
+    uint32_t*   m_pValue;
+    uint32_t    m_address;
+
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+        m_pValue = NULL;
+        m_address = 0x20000000;
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+
+    /* mri takes the upper 32-bits of addresses on 64-bit hosts from its stack so watched variables must live on the
+       stack of the test too. */
+    void useVariable(uint32_t* pValue)
+    {
+        m_pValue = pValue;
+        m_address = (uint32_t)(size_t)pValue;
+    }
+
+    void runMonitorCommand(const char* pCommand, int consoleOutputPackets)
+    {
+        platformMock_CommInitReceiveMonitorCommand(pCommand, consoleOutputPackets);
+        platformMock_CommInitTransmitDataBuffer(1024);
+        Platform_SetProgramCounter(INITIAL_PC);
+            __mriDebugException();
+    }
+
+    void watchValue(uint32_t size, uint32_t value)
+    {
+        char command[64];
+
+        snprintf(command, sizeof(command), "watchvalue %08x %x %x", m_address, size, value);
+        runMonitorCommand(command, 1);
+        CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$OK#9a+") != NULL );
+    }
+
+    void hitWatchpoint(uint32_t value)
+    {
+        if (m_pValue)
+            *m_pValue = value;
+        platformMock_SetWatchpointHit(m_address);
+        platformMock_CommInitReceiveChecksummedData("++$c#");
+        platformMock_CommInitTransmitDataBuffer(256);
+        Platform_SetProgramCounter(INITIAL_PC);
+            __mriDebugException();
+        platformMock_ClearWatchpointHit();
+    }
+};
+
+TEST(valueWatch, Arm_ShouldUseHardwareValueMatchWhenAvailable)
+{
+    watchValue(4, 7);
+    CHECK_EQUAL ( 1, platformMock_SetHardwareValueWatchpointCalls() );
+    CHECK_EQUAL ( 7, platformMock_SetHardwareValueWatchpointValueArg() );
+    CHECK_EQUAL ( 0, platformMock_SetHardwareWatchpointCalls() );
+    STRCMP_EQUAL ( "Value watchpoint set with hardware value matching.\n", platformMock_CommGetConsoleOutput() );
+}
+
+TEST(valueWatch, ArmWithoutHardwareValueMatch_ShouldFallBackToWriteWatchpoint)
+{
+    platformMock_SetHardwareValueWatchpointException(exceededHardwareResourcesException);
+    watchValue(2, 7);
+    CHECK_EQUAL ( 1, platformMock_SetHardwareWatchpointCalls() );
+    CHECK_EQUAL ( m_address, platformMock_SetHardwareWatchpointAddressArg() );
+    CHECK_EQUAL ( 2, platformMock_SetHardwareWatchpointSizeArg() );
+    CHECK_EQUAL ( MRI_PLATFORM_WRITE_WATCHPOINT, platformMock_SetHardwareWatchpointTypeArg() );
+    STRCMP_EQUAL ( "Value watchpoint set with software value matching.\n", platformMock_CommGetConsoleOutput() );
+}
+
+TEST(valueWatch, ArmWithNoFreeComparators_ShouldReturnNoFreeBreakpointError)
+{
+    platformMock_SetHardwareValueWatchpointException(exceededHardwareResourcesException);
+    platformMock_SetHardwareWatchpointException(exceededHardwareResourcesException);
+    runMonitorCommand("watchvalue 20000000 4 7", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+}
+
+TEST(valueWatch, ArmWithInvalidAddress_ShouldReturnErrorWithoutFallingBack)
+{
+    platformMock_SetHardwareValueWatchpointException(invalidArgumentException);
+    runMonitorCommand("watchvalue 20000001 4 7", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_EQUAL ( 0, platformMock_SetHardwareWatchpointCalls() );
+}
+
+TEST(valueWatch, BadArguments_ShouldReturnErrorResponse)
+{
+    runMonitorCommand("watchvalue 20000000 4", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    runMonitorCommand("watchvalue 20000000 3 7", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    runMonitorCommand("watchvalue off 1", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_EQUAL ( 0, platformMock_SetHardwareValueWatchpointCalls() );
+}
+
+TEST(valueWatch, HardwareMatch_ShouldStopWithConsoleNote)
+{
+    uint32_t value = 0;
+    char     expected[64];
+
+    useVariable(&value);
+    watchValue(4, 7);
+    hitWatchpoint(7);
+    snprintf(expected, sizeof(expected), "Value watchpoint: 0x07 written to 0x%08x\n", m_address);
+    STRCMP_EQUAL ( expected, platformMock_CommGetConsoleOutput() );
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$T05responseT#7c+") != NULL );
+}
+
+TEST(valueWatch, SoftwareMatch_ShouldResumeSilentlyOnOtherValues)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    platformMock_SetHardwareValueWatchpointException(exceededHardwareResourcesException);
+    watchValue(4, 7);
+
+    hitWatchpoint(6);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    hitWatchpoint(0x107);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+
+    hitWatchpoint(7);
+    CHECK_TRUE ( strncmp(platformMock_CommGetConsoleOutput(), "Value watchpoint: 0x07 written", 30) == 0 );
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$T05responseT#7c+") != NULL );
+}
+
+TEST(valueWatch, SoftwareMatchOnByte_ShouldOnlyCompareWatchedByte)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    platformMock_SetHardwareValueWatchpointException(exceededHardwareResourcesException);
+    watchValue(1, 0x1234);
+
+    hitWatchpoint(0x12);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    hitWatchpoint(0xFFFFFF34);
+    CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$T05responseT#7c+") != NULL );
+}
+
+TEST(valueWatch, OtherWatchpointHit_ShouldStopWithoutConsoleNote)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    platformMock_SetHardwareValueWatchpointException(exceededHardwareResourcesException);
+    watchValue(4, 7);
+    m_address += 4;
+    hitWatchpoint(6);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(valueWatch, Off_ShouldClearHardwareValueWatchpoint)
+{
+    watchValue(4, 7);
+    runMonitorCommand("watchvalue off", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL ( 1, platformMock_ClearHardwareValueWatchpointCalls() );
+    CHECK_EQUAL ( 0, platformMock_ClearHardwareWatchpointCalls() );
+}
+
+TEST(valueWatch, Off_ShouldClearSoftwareWatchpointAndStopCheckingValues)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    platformMock_SetHardwareValueWatchpointException(exceededHardwareResourcesException);
+    watchValue(4, 7);
+    runMonitorCommand("watchvalue off", 0);
+    CHECK_EQUAL ( 0, platformMock_ClearHardwareValueWatchpointCalls() );
+    CHECK_EQUAL ( 1, platformMock_ClearHardwareWatchpointCalls() );
+    CHECK_EQUAL ( m_address, platformMock_ClearHardwareWatchpointAddressArg() );
+
+    hitWatchpoint(6);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(valueWatch, ArmAgain_ShouldReplacePreviousWatchpoint)
+{
+    watchValue(4, 7);
+    watchValue(4, 8);
+    CHECK_EQUAL ( 1, platformMock_ClearHardwareValueWatchpointCalls() );
+    CHECK_EQUAL ( 2, platformMock_SetHardwareValueWatchpointCalls() );
+    CHECK_EQUAL ( 8, platformMock_SetHardwareValueWatchpointValueArg() );
+}
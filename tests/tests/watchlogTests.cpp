@@ -0,0 +1,252 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+extern "C"
+{
+#include <try_catch.h>
+#include <mri.h>
+#include <watchlog.h>
+#include <platforms.h>
+
+void __mriDebugException(void);
+}
+#include <platformMock.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include C++ headers for test harness.
+#include "CppUTest/TestHarness.h"
+
+
+TEST_GROUP(watchlog)
+{
+    int         m_expectedException;
+    uint32_t*   m_pValue;
+    uint32_t    m_address;
+
+    void setup()
+    {
+        m_expectedException = noException;
+        platformMock_Init();
+        __mriInit("MRI_UART_MBED_USB");
+        m_pValue = NULL;
+        m_address = 0x20000000;
+    }
+
+    void teardown()
+    {
+        LONGS_EQUAL ( m_expectedException, getExceptionCode() );
+        clearExceptionCode();
+        platformMock_Uninit();
+    }
+
+    void runMonitorCommand(const char* pCommand, int consoleOutputPackets)
+    {
+        platformMock_CommInitReceiveMonitorCommand(pCommand, consoleOutputPackets);
+        platformMock_CommInitTransmitDataBuffer(4096);
+        Platform_SetProgramCounter(INITIAL_PC);
+            __mriDebugException();
+    }
+
+    /* mri takes the upper 32-bits of addresses on 64-bit hosts from its stack so watched variables must live on the
+       stack of the test too. */
+    void useVariable(uint32_t* pValue)
+    {
+        m_pValue = pValue;
+        m_address = (uint32_t)(size_t)pValue;
+    }
+
+    void armWatchLog()
+    {
+        char command[64];
+
+        snprintf(command, sizeof(command), "watchlog %08x", m_address);
+        runMonitorCommand(command, 3);
+        CHECK_TRUE ( strstr(platformMock_CommGetTransmittedData(), "$OK#9a+") != NULL );
+    }
+
+    void hitWatchpoint(uint32_t address, uint32_t pc, uint32_t lr, uint32_t value, uint32_t cycles)
+    {
+        if (m_pValue)
+            *m_pValue = value;
+        platformMock_SetWatchpointHit(address);
+        platformMock_SetRegister(14, lr);
+        platformMock_SetCycleCount(cycles);
+        Platform_SetProgramCounter(pc);
+        platformMock_CommInitReceiveChecksummedData("+$c#");
+        platformMock_CommInitTransmitDataBuffer(128);
+            __mriDebugException();
+        platformMock_ClearWatchpointHit();
+    }
+};
+
+TEST(watchlog, Arm_ShouldSetWriteWatchpointWithDefaultSizeOf4)
+{
+    armWatchLog();
+    CHECK_EQUAL ( 1, platformMock_SetHardwareWatchpointCalls() );
+    CHECK_EQUAL ( m_address, platformMock_SetHardwareWatchpointAddressArg() );
+    CHECK_EQUAL ( 4, platformMock_SetHardwareWatchpointSizeArg() );
+    CHECK_EQUAL ( MRI_PLATFORM_WRITE_WATCHPOINT, platformMock_SetHardwareWatchpointTypeArg() );
+    CHECK_TRUE ( strncmp(platformMock_CommGetConsoleOutput(), "Logging writes to 0x", 20) == 0 );
+}
+
+TEST(watchlog, ArmWithSizeAndHexPrefix_ShouldSetWatchpointOfThatSize)
+{
+    runMonitorCommand("watchlog 0x20000002 0x2", 3);
+    CHECK_EQUAL ( 0x20000002, platformMock_SetHardwareWatchpointAddressArg() );
+    CHECK_EQUAL ( 2, platformMock_SetHardwareWatchpointSizeArg() );
+    STRCMP_EQUAL ( "Logging writes to 0x20000002.\n", platformMock_CommGetConsoleOutput() );
+}
+
+TEST(watchlog, ArmWithInvalidSize_ShouldReturnErrorWithoutSettingWatchpoint)
+{
+    runMonitorCommand("watchlog 20000000 8", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    CHECK_EQUAL ( 0, platformMock_SetHardwareWatchpointCalls() );
+}
+
+TEST(watchlog, ArmWithoutFreeComparator_ShouldReturnNoFreeBreakpointError)
+{
+    platformMock_SetHardwareWatchpointException(exceededHardwareResourcesException);
+    runMonitorCommand("watchlog 20000000", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_NO_FREE_BREAKPOINT "#aa+") );
+}
+
+TEST(watchlog, BadArguments_ShouldReturnErrorResponse)
+{
+    runMonitorCommand("watchlog", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    runMonitorCommand("watchlog 20000000 4 4", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+    runMonitorCommand("watchlog dump now", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$" MRI_ERROR_INVALID_ARGUMENT "#a6+") );
+}
+
+TEST(watchlog, DumpEmptyLog)
+{
+    runMonitorCommand("watchlog dump", 1);
+    STRCMP_EQUAL ( "Watch log is empty.\n", platformMock_CommGetConsoleOutput() );
+}
+
+TEST(watchlog, Hit_ShouldRecordEntryAndResumeWithoutStopping)
+{
+    uint32_t value = 0;
+    char     expected[128];
+
+    useVariable(&value);
+    armWatchLog();
+    hitWatchpoint(m_address, 0x10000102, 0x10000201, 7, 0x12345678);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+    CHECK_FALSE ( Platform_IsSingleStepping() );
+
+    runMonitorCommand("watchlog dump", 2);
+    snprintf(expected, sizeof(expected),
+             "Watch log for 0x%08x: 0x01 entries, 0x00 overwritten\n"
+             "pc=0x10000102 lr=0x10000201 value=0x07 cycles=0x12345678\n", m_address);
+    STRCMP_EQUAL ( expected, platformMock_CommGetConsoleOutput() );
+}
+
+TEST(watchlog, HitOnOtherWatchpoint_ShouldStopInGdb)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    armWatchLog();
+    hitWatchpoint(m_address + 4, INITIAL_PC, 0, 7, 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+}
+
+TEST(watchlog, ByteSizedWatch_ShouldOnlyLogWrittenByte)
+{
+    uint32_t value = 0;
+    char     command[64];
+
+    useVariable(&value);
+    snprintf(command, sizeof(command), "watchlog %08x 1", m_address);
+    runMonitorCommand(command, 3);
+    hitWatchpoint(m_address, INITIAL_PC, 0, 0x12345678, 0);
+
+    runMonitorCommand("watchlog dump", 2);
+    CHECK_TRUE ( strstr(platformMock_CommGetConsoleOutput(), "value=0x78 ") != NULL );
+}
+
+TEST(watchlog, FullLog_ShouldOverwriteOldestEntries)
+{
+    uint32_t value = 0;
+    uint32_t i;
+
+    useVariable(&value);
+
+    armWatchLog();
+    for (i = 0 ; i < MRI_WATCHLOG_ENTRIES + 2 ; i++)
+        hitWatchpoint(m_address, 0x10000000 + i, 0, i, 0);
+
+    runMonitorCommand("watchlog dump", MRI_WATCHLOG_ENTRIES + 1);
+    const char* pOutput = platformMock_CommGetConsoleOutput();
+    CHECK_TRUE ( strstr(pOutput, ": 0x20 entries, 0x02 overwritten\n") != NULL );
+    CHECK_TRUE ( strstr(pOutput, "\npc=0x10000002 ") != NULL );
+    CHECK_TRUE ( strstr(pOutput, "pc=0x10000001 ") == NULL );
+    CHECK_TRUE ( strstr(pOutput, "pc=0x10000021 ") != NULL );
+}
+
+TEST(watchlog, Clear_ShouldEmptyLogButStayArmed)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    armWatchLog();
+    hitWatchpoint(m_address, INITIAL_PC, 0, 1, 0);
+    runMonitorCommand("watchlog clear", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    runMonitorCommand("watchlog dump", 1);
+    STRCMP_EQUAL ( "Watch log is empty.\n", platformMock_CommGetConsoleOutput() );
+
+    hitWatchpoint(m_address, INITIAL_PC, 0, 2, 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("") );
+}
+
+TEST(watchlog, Off_ShouldClearWatchpointAndKeepLog)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    armWatchLog();
+    hitWatchpoint(m_address, INITIAL_PC, 0, 1, 0);
+    runMonitorCommand("watchlog off", 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+$OK#9a+") );
+    CHECK_EQUAL ( 1, platformMock_ClearHardwareWatchpointCalls() );
+    CHECK_EQUAL ( m_address, platformMock_ClearHardwareWatchpointAddressArg() );
+
+    hitWatchpoint(m_address, INITIAL_PC, 0, 2, 0);
+    CHECK_TRUE ( platformMock_CommDoesTransmittedDataEqual("$T05responseT#7c+") );
+    runMonitorCommand("watchlog dump", 2);
+    CHECK_TRUE ( strstr(platformMock_CommGetConsoleOutput(), "value=0x01 ") != NULL );
+}
+
+TEST(watchlog, ArmAgain_ShouldReplacePreviousWatchpointAndDiscardLog)
+{
+    uint32_t value = 0;
+
+    useVariable(&value);
+    armWatchLog();
+    hitWatchpoint(m_address, INITIAL_PC, 0, 1, 0);
+    runMonitorCommand("watchlog 20000000", 3);
+    CHECK_EQUAL ( 1, platformMock_ClearHardwareWatchpointCalls() );
+    CHECK_EQUAL ( m_address, platformMock_ClearHardwareWatchpointAddressArg() );
+    CHECK_EQUAL ( 0x20000000, platformMock_SetHardwareWatchpointAddressArg() );
+
+    runMonitorCommand("watchlog dump", 1);
+    STRCMP_EQUAL ( "Watch log is empty.\n", platformMock_CommGetConsoleOutput() );
+}
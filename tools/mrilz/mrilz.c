@@ -0,0 +1,191 @@
+/* Copyright 2026 The MRI contributors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host tool which compresses binary images for the qMriInflate packet and expands compressed files back out. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compress.h"
+
+
+#define MAX_IMAGE_SIZE          (16 * 1024 * 1024)
+#define DEFAULT_MAX_BLOCK_SIZE  4096
+#define HASH_BITS               16
+#define FRAME_HEADER_SIZE       8
+
+static uint8_t  g_input[MAX_IMAGE_SIZE];
+static uint8_t  g_output[MAX_IMAGE_SIZE];
+static uint32_t g_hashTable[1 << HASH_BITS];
+
+static void     displayUsage(void);
+static size_t   readFile(const char* pFilename, uint8_t* pBuffer, size_t bufferSize);
+static void     writeFile(const char* pFilename, const uint8_t* pBuffer, size_t length);
+static size_t   compressImage(size_t inputLength, uint32_t maxBlockSize);
+static size_t   decompressImage(size_t inputLength);
+static void     writeUInt32(uint8_t* p, uint32_t value);
+static uint32_t readUInt32(const uint8_t* p);
+int main(int argc, char** argv)
+{
+    size_t inputLength;
+    size_t outputLength;
+
+    if (argc < 4)
+    {
+        displayUsage();
+        return 1;
+    }
+
+    inputLength = readFile(argv[2], g_input, sizeof(g_input));
+    if (0 == strcmp(argv[1], "compress"))
+    {
+        uint32_t maxBlockSize = argc > 4 ? (uint32_t)strtoul(argv[4], NULL, 0) : DEFAULT_MAX_BLOCK_SIZE;
+
+        if (maxBlockSize < 2)
+        {
+            fprintf(stderr, "error: maximum block size must be at least 2 bytes.\n");
+            return 1;
+        }
+        outputLength = compressImage(inputLength, maxBlockSize);
+    }
+    else if (0 == strcmp(argv[1], "decompress"))
+    {
+        outputLength = decompressImage(inputLength);
+    }
+    else
+    {
+        displayUsage();
+        return 1;
+    }
+    writeFile(argv[3], g_output, outputLength);
+
+    return 0;
+}
+
+static void displayUsage(void)
+{
+    fprintf(stderr, "Usage: mrilz compress inputFile outputFile [maxBlockSize]\n"
+                    "       mrilz decompress inputFile outputFile\n"
+                    "\n"
+                    "Compressed files are a series of blocks.  Each block starts with its 32-bit little endian\n"
+                    "decompressed and compressed lengths, followed by the compressed data.  The compressed data of\n"
+                    "each block is no larger than maxBlockSize bytes (default %u) so that it can be sent to mri in a\n"
+                    "single qMriInflate packet.  Files written by \"monitor dump\" use the same format.\n",
+                    DEFAULT_MAX_BLOCK_SIZE);
+}
+
+static size_t readFile(const char* pFilename, uint8_t* pBuffer, size_t bufferSize)
+{
+    FILE*  pFile = fopen(pFilename, "rb");
+    size_t length;
+
+    if (!pFile)
+    {
+        fprintf(stderr, "error: failed to open %s\n", pFilename);
+        exit(1);
+    }
+    length = fread(pBuffer, 1, bufferSize, pFile);
+    if (!feof(pFile))
+    {
+        fprintf(stderr, "error: %s is larger than %u bytes.\n", pFilename, (unsigned int)bufferSize);
+        exit(1);
+    }
+    fclose(pFile);
+
+    return length;
+}
+
+static void writeFile(const char* pFilename, const uint8_t* pBuffer, size_t length)
+{
+    FILE* pFile = fopen(pFilename, "wb");
+
+    if (!pFile || length != fwrite(pBuffer, 1, length, pFile))
+    {
+        fprintf(stderr, "error: failed to write %s\n", pFilename);
+        exit(1);
+    }
+    fclose(pFile);
+}
+
+static size_t compressImage(size_t inputLength, uint32_t maxBlockSize)
+{
+    CompressState state;
+    size_t        outputLength = 0;
+
+    Compress_Init(&state, g_input, (uint32_t)inputLength, g_hashTable, HASH_BITS);
+    while (state.srcOffset < inputLength)
+    {
+        uint32_t srcOffset = state.srcOffset;
+        uint32_t blockSize = maxBlockSize;
+        uint32_t compressedLength;
+
+        if (blockSize > sizeof(g_output) - outputLength - FRAME_HEADER_SIZE)
+        {
+            fprintf(stderr, "error: compressed image is larger than %u bytes.\n", (unsigned int)sizeof(g_output));
+            exit(1);
+        }
+        compressedLength = Compress_NextBlock(&state, g_output + outputLength + FRAME_HEADER_SIZE, blockSize);
+        writeUInt32(g_output + outputLength, state.srcOffset - srcOffset);
+        writeUInt32(g_output + outputLength + 4, compressedLength);
+        outputLength += FRAME_HEADER_SIZE + compressedLength;
+    }
+
+    return outputLength;
+}
+
+static size_t decompressImage(size_t inputLength)
+{
+    size_t inputOffset = 0;
+    size_t outputLength = 0;
+
+    while (inputOffset < inputLength)
+    {
+        uint32_t decompressedLength;
+        uint32_t compressedLength;
+
+        if (inputLength - inputOffset < FRAME_HEADER_SIZE)
+            break;
+        decompressedLength = readUInt32(g_input + inputOffset);
+        compressedLength = readUInt32(g_input + inputOffset + 4);
+        inputOffset += FRAME_HEADER_SIZE;
+        if (compressedLength > inputLength - inputOffset || decompressedLength > sizeof(g_output) - outputLength)
+            break;
+        if (!DecompressToMemory(g_output + outputLength, decompressedLength, (uint32_t)outputLength,
+                                g_input + inputOffset, compressedLength))
+        {
+            break;
+        }
+        inputOffset += compressedLength;
+        outputLength += decompressedLength;
+    }
+    if (inputOffset != inputLength)
+    {
+        fprintf(stderr, "error: corrupt compressed data at offset %u.\n", (unsigned int)inputOffset);
+        exit(1);
+    }
+
+    return outputLength;
+}
+
+static void writeUInt32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t readUInt32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}